@@ -22,6 +22,11 @@ public abstract class AggregatorNode extends GroupingExpression {
         this.exp = exp;
     }
 
+    protected AggregatorNode(String image, String label, Integer level, GroupingExpression exp, ConstantValue<?> arg) {
+        super(image + "(" + exp.toString() + ", " + arg.toString() + ")", label, level);
+        this.exp = exp;
+    }
+
     /**
      * Returns the expression that this node aggregates on.
      *
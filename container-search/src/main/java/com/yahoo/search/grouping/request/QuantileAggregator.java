@@ -0,0 +1,45 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.search.grouping.request;
+
+/**
+ * This class represents a quantile-aggregator in a {@link GroupingExpression}. It evaluates to an estimate of the
+ * value at the given quantile (e.g. 0.5 for the median) of the values that the contained expression evaluated to over
+ * all the inputs.
+ */
+public class QuantileAggregator extends AggregatorNode {
+
+    private final double quantile;
+
+    /**
+     * Constructs a new instance of this class.
+     *
+     * @param expression the expression to aggregate on.
+     * @param quantile   the quantile to estimate, in the range [0, 1].
+     */
+    public QuantileAggregator(GroupingExpression expression, double quantile) {
+        this(null, null, expression, quantile);
+    }
+
+    private QuantileAggregator(String label, Integer level, GroupingExpression expression, double quantile) {
+        super("quantile", label, level, expression, new DoubleValue(quantile));
+        if (quantile < 0.0 || quantile > 1.0) {
+            throw new IllegalArgumentException("Quantile must be in the range [0, 1], got " + quantile + ".");
+        }
+        this.quantile = quantile;
+    }
+
+    /**
+     * Returns the quantile to estimate.
+     *
+     * @return The quantile.
+     */
+    public double getQuantile() {
+        return quantile;
+    }
+
+    @Override
+    public QuantileAggregator copy() {
+        return new QuantileAggregator(getLabel(), getLevelOrNull(), getExpression().copy(), quantile);
+    }
+
+}
@@ -63,6 +63,7 @@ import com.yahoo.search.grouping.request.NormalizeSubjectFunction;
 import com.yahoo.search.grouping.request.NowFunction;
 import com.yahoo.search.grouping.request.OrFunction;
 import com.yahoo.search.grouping.request.PredefinedFunction;
+import com.yahoo.search.grouping.request.QuantileAggregator;
 import com.yahoo.search.grouping.request.RawValue;
 import com.yahoo.search.grouping.request.RelevanceValue;
 import com.yahoo.search.grouping.request.ReverseFunction;
@@ -94,6 +95,7 @@ import com.yahoo.searchlib.aggregation.ExpressionCountAggregationResult;
 import com.yahoo.searchlib.aggregation.HitsAggregationResult;
 import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
+import com.yahoo.searchlib.aggregation.QuantileAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
@@ -235,6 +237,11 @@ class ExpressionConverter {
                     .setSummaryClass(summaryName != null ? summaryName : defaultSummaryName)
                     .setExpression(new ConstantNode(new IntegerResultNode(0)));
         }
+        if (exp instanceof QuantileAggregator) {
+            return new QuantileAggregationResult()
+                    .setQuantiles(((QuantileAggregator)exp).getQuantile())
+                    .setExpression(toExpressionNode(((QuantileAggregator)exp).getExpression()));
+        }
         if (exp instanceof StandardDeviationAggregator) {
             return new StandardDeviationAggregationResult()
                     .setExpression(toExpressionNode(((StandardDeviationAggregator) exp).getExpression()));
@@ -28,6 +28,7 @@ import com.yahoo.searchlib.aggregation.Hit;
 import com.yahoo.searchlib.aggregation.HitsAggregationResult;
 import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
+import com.yahoo.searchlib.aggregation.QuantileAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
@@ -253,6 +254,9 @@ class ResultBuilder {
                 return ((MinAggregationResult)execResult).getMin().getValue();
             } else if (execResult instanceof SumAggregationResult) {
                 return ((SumAggregationResult) execResult).getSum().getValue();
+            } else if (execResult instanceof QuantileAggregationResult) {
+                QuantileAggregationResult quantile = (QuantileAggregationResult) execResult;
+                return quantile.getQuantile(quantile.getQuantiles()[0]);
             } else if (execResult instanceof StandardDeviationAggregationResult) {
                 return ((StandardDeviationAggregationResult) execResult).getStandardDeviation();
             } else if (execResult instanceof XorAggregationResult) {
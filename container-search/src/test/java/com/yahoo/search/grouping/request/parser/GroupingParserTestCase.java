@@ -112,6 +112,7 @@ public class GroupingParserTestCase {
                                             "pow",
                                             "precision",
                                             "predefined",
+                                            "quantile",
                                             "relevance",
                                             "reverse",
                                             "sin",
@@ -579,6 +580,11 @@ public class GroupingParserTestCase {
         assertIllegalArgument("all(group(debugwait(artist, 3.3, lol)))",
                               "Encountered \" <IDENTIFIER> \"lol\"\" at line 1, column 34");
         assertParse("all(group(artist) each(output(stddev(simple))))");
+        assertParse("all(group(artist) each(output(quantile(length, 0.5), quantile(length, 0.99))))");
+        assertParse("all(group(artist) each(output(quantile(length, 1))))",
+                    "all(group(artist) each(output(quantile(length, 1.0))))");
+        assertIllegalArgument("all(group(artist) each(output(quantile(length, 2))))",
+                              "Quantile must be in the range [0, 1], got 2.0.");
     }
 
     @Test
@@ -9,6 +9,7 @@ import org.junit.Test;
 
 import java.util.*;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertTrue;
 import static org.junit.Assert.fail;
@@ -28,6 +29,19 @@ public class RequestBuilderTestCase {
        assertLayout("all(group(a) each(each(output(summary()))))", "[[{ Attribute, result = [Hits] }]]");
        assertLayout("all(group(a) each(output(xor(b))))", "[[{ Attribute, result = [Xor] }]]");
        assertLayout("all(group(a) each(output(stddev(b))))", "[[{ Attribute, result = [StandardDeviation] }]]");
+       assertLayout("all(group(a) each(output(quantile(b, 0.5))))", "[[{ Attribute, result = [Quantile] }]]");
+    }
+
+    @Test
+    public void requireThatQuantileAggregationResultIsSupported() {
+        RequestBuilder builder = new RequestBuilder(0);
+        builder.setRootOperation(GroupingOperation.fromString("all(group(foo) each(output(quantile(bar, 0.99))))"));
+        builder.build();
+        AggregationResult aggr = builder.getRequestList().get(0).getLevels().get(0).getGroupPrototype()
+                                        .getAggregationResults().get(0);
+        assertTrue(aggr instanceof QuantileAggregationResult);
+        assertArrayEquals(new double[] { 0.99 }, ((QuantileAggregationResult)aggr).getQuantiles(), 0.0);
+        assertEquals(new AttributeNode("bar"), aggr.getExpression());
     }
 
     @Test
@@ -57,6 +57,7 @@ public class ResultBuilderTestCase {
         assertResult("69", new MinAggregationResult(new IntegerResultNode(69)));
         assertResult("69", new SumAggregationResult(new IntegerResultNode(69)));
         assertResult("69", new XorAggregationResult(69));
+        assertResult("69.0", new QuantileAggregationResult().setQuantiles(0.5).add(69));
         assertResult("69", new ExpressionCountAggregationResult(new SparseSketch(), sketch -> 69));
     }
 
@@ -407,6 +407,39 @@ TEST("require that fast forest evaluation is correct for all tree size categorie
     }
 }
 
+TEST("require that fast forest batch evaluation matches evaluation of one document at a time") {
+    for (size_t tree_size: std::vector<size_t>({7,15,30,61,127})) {
+        vespalib::string expression = Model().max_features(35).less_percent(100).invert_percent(50).make_forest(127, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            TEST_STATE(forest->impl_name().c_str());
+            size_t num_params = function->num_params();
+            size_t num_docs = 21;
+            std::vector<float> params(num_params * num_docs);
+            for (size_t f = 0; f < num_params; ++f) {
+                for (size_t d = 0; d < num_docs; ++d) {
+                    params[(f * num_docs) + d] = ((d + f) % 7 == 0)
+                                                 ? std::numeric_limits<float>::quiet_NaN()
+                                                 : float((d * 13 + f * 7) % 10) / 10.0;
+                }
+            }
+            std::vector<double> results(num_docs, 0.0);
+            auto ctx = forest->create_context();
+            forest->eval_batch(*ctx, &params[0], num_docs, &results[0]);
+            for (size_t d = 0; d < num_docs; ++d) {
+                std::vector<double> inputs(num_params);
+                for (size_t f = 0; f < num_params; ++f) {
+                    inputs[f] = params[(f * num_docs) + d];
+                }
+                EXPECT_EQUAL(results[d], eval_ff(*forest, *ctx, inputs));
+                EXPECT_EQUAL(results[d], eval_double(*function, inputs));
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that GDBT expressions can be detected") {
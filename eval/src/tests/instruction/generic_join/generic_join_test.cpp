@@ -5,6 +5,7 @@
 #include <vespa/eval/instruction/generic_join.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/mixed/packed_mixed_tensor_builder_factory.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -50,9 +51,10 @@ TensorSpec simple_tensor_join(const TensorSpec &a, const TensorSpec &b, join_fun
     return engine.to_spec(result);
 }
 
-TensorSpec perform_generic_join(const TensorSpec &a, const TensorSpec &b, join_fun_t function) {
+TensorSpec perform_generic_join(const TensorSpec &a, const TensorSpec &b, join_fun_t function,
+                                const ValueBuilderFactory &factory = SimpleValueBuilderFactory::get())
+{
     Stash stash;
-    const auto &factory = SimpleValueBuilderFactory::get();
     auto lhs = value_from_spec(a, factory);
     auto rhs = value_from_spec(b, factory);
     auto my_op = GenericJoin::make_instruction(lhs->type(), rhs->type(), function, factory, stash);
@@ -116,4 +118,18 @@ TEST(GenericJoinTest, generic_join_works_for_simple_values) {
     }
 }
 
+TEST(GenericJoinTest, generic_join_works_for_packed_mixed_tensors) {
+    const auto &factory = PackedMixedTensorBuilderFactory::get();
+    for (size_t i = 0; i < join_layouts.size(); i += 2) {
+        TensorSpec lhs = spec(join_layouts[i], Div16(N()));
+        TensorSpec rhs = spec(join_layouts[i + 1], Div16(N()));
+        for (auto fun: {operation::Add::f, operation::Mul::f}) {
+            SCOPED_TRACE(fmt("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+            auto expect = simple_tensor_join(lhs, rhs, fun);
+            auto actual = perform_generic_join(lhs, rhs, fun, factory);
+            EXPECT_EQ(actual, expect);
+        }
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,78 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/instruction/generic_merge.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/mixed/packed_mixed_tensor_builder_factory.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::instruction;
+using namespace vespalib::eval::test;
+
+using vespalib::make_string_short::fmt;
+
+std::vector<Layout> merge_layouts = {
+    {},                                                 {},
+    {x(5)},                                             {x(5)},
+    {x(3),y(5)},                                        {x(3),y(5)},
+    float_cells({x(3),y(5)}),                           {x(3),y(5)},
+    {x(3),y(5)},                                        float_cells({x(3),y(5)}),
+    {x({"a","b","c"})},                                 {x({"a","b","c"})},
+    {x({"a","b","c"})},                                 {x({"c","d"})},
+    {x({"a","b","c"})},                                 {x({"d","e"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              {x({"b","c"}),y({"foo","bar"})},
+    float_cells({x({"a","b"}),y({"foo","bar","baz"})}), {x({"b","c"}),y({"foo","bar"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              float_cells({x({"b","c"}),y({"foo","bar"})}),
+    {x(3),y({"foo", "bar"})},                           {x(3),y({"bar", "baz"})},
+    {x({"a","b","c"}),y(5)},                            {x({"b","c","d"}),y(5)},
+    float_cells({x({"a","b","c"}),y(5)}),               float_cells({x({"b","c","d"}),y(5)})
+};
+
+TensorSpec simple_tensor_merge(const TensorSpec &a, const TensorSpec &b, join_fun_t function) {
+    Stash stash;
+    const auto &engine = SimpleTensorEngine::ref();
+    auto lhs = engine.from_spec(a);
+    auto rhs = engine.from_spec(b);
+    const auto &result = engine.merge(*lhs, *rhs, function, stash);
+    return engine.to_spec(result);
+}
+
+TensorSpec perform_generic_merge(const TensorSpec &a, const TensorSpec &b, join_fun_t function,
+                                 const ValueBuilderFactory &factory)
+{
+    Stash stash;
+    auto lhs = value_from_spec(a, factory);
+    auto rhs = value_from_spec(b, factory);
+    auto my_op = GenericMerge::make_instruction(lhs->type(), rhs->type(), function, factory, stash);
+    InterpretedFunction::EvalSingle single(my_op);
+    return spec_from_value(single.eval(std::vector<Value::CREF>({*lhs,*rhs})));
+}
+
+void test_generic_merge(const ValueBuilderFactory &factory) {
+    ASSERT_TRUE((merge_layouts.size() % 2) == 0);
+    for (size_t i = 0; i < merge_layouts.size(); i += 2) {
+        TensorSpec lhs = spec(merge_layouts[i], N());
+        TensorSpec rhs = spec(merge_layouts[i + 1], Div16(N()));
+        for (auto fun: {operation::Add::f, operation::Mul::f, operation::Sub::f, operation::Max::f}) {
+            SCOPED_TRACE(fmt("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+            auto expect = simple_tensor_merge(lhs, rhs, fun);
+            auto actual = perform_generic_merge(lhs, rhs, fun, factory);
+            EXPECT_EQ(actual, expect);
+        }
+    }
+}
+
+TEST(GenericMergeTest, generic_merge_works_for_simple_values) {
+    test_generic_merge(SimpleValueBuilderFactory::get());
+}
+
+TEST(GenericMergeTest, generic_merge_works_for_packed_mixed_tensors) {
+    test_generic_merge(PackedMixedTensorBuilderFactory::get());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,103 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/instruction/generic_reduce.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/mixed/packed_mixed_tensor_builder_factory.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::instruction;
+using namespace vespalib::eval::test;
+
+using vespalib::make_string_short::fmt;
+
+std::vector<Layout> layouts = {
+    {},
+    {x(3)},
+    {x(3),y(5)},
+    {x(3),y(5),z(7)},
+    float_cells({x(3),y(5),z(7)}),
+    {x({"a","b","c"})},
+    {x({"a","b","c"}),y({"foo","bar"})},
+    {x({"a","b","c"}),y({"foo","bar"}),z({"i","j","k","l"})},
+    float_cells({x({"a","b","c"}),y({"foo","bar"}),z({"i","j","k","l"})}),
+    {x(3),y({"foo", "bar"}),z(7)},
+    {x({"a","b","c"}),y(5),z({"i","j","k","l"})},
+    float_cells({x({"a","b","c"}),y(5),z({"i","j","k","l"})})
+};
+
+TensorSpec simple_tensor_reduce(const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dims) {
+    Stash stash;
+    const auto &engine = SimpleTensorEngine::ref();
+    auto lhs = engine.from_spec(a);
+    const auto &result = engine.reduce(*lhs, aggr, dims, stash);
+    return engine.to_spec(result);
+}
+
+TensorSpec perform_generic_reduce(const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dims,
+                                  const ValueBuilderFactory &factory)
+{
+    Stash stash;
+    auto lhs = value_from_spec(a, factory);
+    auto my_op = GenericReduce::make_instruction(lhs->type(), aggr, dims, factory, stash);
+    InterpretedFunction::EvalSingle single(my_op);
+    return spec_from_value(single.eval(std::vector<Value::CREF>({*lhs})));
+}
+
+TEST(GenericReduceTest, dense_reduce_plan_can_be_created) {
+    auto type = ValueType::from_spec("tensor(a[2],aa{},b[3],c[4],d[5],e[6],f[7],g{})");
+    auto plan = DenseReducePlan(type, type.reduce({"b", "c", "f"}));
+    std::vector<size_t> expect_keep_loop = {2,5*6};
+    std::vector<size_t> expect_keep_stride = {3*4*5*6*7,7};
+    std::vector<size_t> expect_reduce_loop = {3*4,7};
+    std::vector<size_t> expect_reduce_stride = {5*6*7,1};
+    EXPECT_EQ(plan.in_size, 2*3*4*5*6*7);
+    EXPECT_EQ(plan.out_size, 2*5*6);
+    EXPECT_EQ(plan.keep_loop, expect_keep_loop);
+    EXPECT_EQ(plan.keep_stride, expect_keep_stride);
+    EXPECT_EQ(plan.reduce_loop, expect_reduce_loop);
+    EXPECT_EQ(plan.reduce_stride, expect_reduce_stride);
+}
+
+TEST(GenericReduceTest, sparse_reduce_plan_can_be_created) {
+    auto type = ValueType::from_spec("tensor(a{},b[3],c{},d[5],e{},f[7],g{})");
+    auto plan = SparseReducePlan(type, type.reduce({"a", "d", "e"}));
+    std::vector<size_t> expect_keep_dims = {1,3};
+    EXPECT_EQ(plan.num_mapped_dims, 4);
+    EXPECT_EQ(plan.keep_dims, expect_keep_dims);
+}
+
+void test_generic_reduce(const ValueBuilderFactory &factory) {
+    for (const Layout &layout: layouts) {
+        TensorSpec input = spec(layout, Div16(N()));
+        for (Aggr aggr: {Aggr::SUM, Aggr::AVG, Aggr::MIN, Aggr::MAX}) {
+            for (const Domain &domain: layout) {
+                SCOPED_TRACE(fmt("\n===\nLAYOUT: %s\nAGGR: %s\nDIM: %s\n===\n", input.to_string().c_str(),
+                                 AggrNames::name_of(aggr)->c_str(), domain.dimension.c_str()));
+                auto expect = simple_tensor_reduce(input, aggr, {domain.dimension});
+                auto actual = perform_generic_reduce(input, aggr, {domain.dimension}, factory);
+                EXPECT_EQ(actual, expect);
+            }
+            SCOPED_TRACE(fmt("\n===\nLAYOUT: %s\nAGGR: %s\nDIM: all\n===\n", input.to_string().c_str(),
+                             AggrNames::name_of(aggr)->c_str()));
+            auto expect = simple_tensor_reduce(input, aggr, {});
+            auto actual = perform_generic_reduce(input, aggr, {}, factory);
+            EXPECT_EQ(actual, expect);
+        }
+    }
+}
+
+TEST(GenericReduceTest, generic_reduce_works_for_simple_values) {
+    test_generic_reduce(SimpleValueBuilderFactory::get());
+}
+
+TEST(GenericReduceTest, generic_reduce_works_for_packed_mixed_tensors) {
+    test_generic_reduce(PackedMixedTensorBuilderFactory::get());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,97 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_fused_reduce_function.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::eval::tensor_function;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a", spec(1.5))
+        .add("b", spec(2.5))
+        .add("sparse", spec({x({"a","b"})}, N()))
+        .add("mixed", spec({x({"a"}),y(5)}, N()))
+        .add_vector("x", 5)
+        .add_vector("y", 3)
+        .add_matrix("x", 5, "y", 3)
+        .add("x5y3_2", spec({x(5),y(3)}, Div16(N())))
+        .add("x5y3f_2", spec(float_cells({x(5),y(3)}), Div16(N())));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t num_children) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQ(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQ(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    ASSERT_EQ(info.size(), 1u);
+    EXPECT_TRUE(info[0]->result_is_mutable());
+    EXPECT_EQ(info[0]->num_children(), num_children);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQ(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQ(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST(FusedReduceTest, join_chain_ending_in_full_reduce_is_fused) {
+    verify_optimized("reduce(x5y3*x5y3_2+a,sum)", 3);
+    verify_optimized("reduce(x5y3f*x5y3f_2+a,sum)", 3);
+    verify_optimized("reduce(x5y3*x5y3_2+x5y3,sum)", 3);
+    verify_optimized("reduce(max(x5y3-x5y3_2,b)/a,max)", 4);
+}
+
+TEST(FusedReduceTest, map_and_join_chain_ending_in_full_reduce_is_fused) {
+    verify_optimized("reduce(sqrt(x5y3)*x5y3_2,avg)", 2);
+    verify_optimized("reduce(exp(-x5y3),avg)", 1);
+    verify_optimized("reduce(relu(x5y3f-a),min)", 2);
+}
+
+TEST(FusedReduceTest, plain_dot_product_is_left_to_dot_product_optimizer) {
+    verify_not_optimized("reduce(x5*x5,sum)");
+}
+
+TEST(FusedReduceTest, partial_reduce_is_not_fused) {
+    verify_not_optimized("reduce(x5y3*x5y3_2+a,sum,x)");
+}
+
+TEST(FusedReduceTest, join_with_broadcast_is_kept_as_input) {
+    verify_optimized("reduce(x5y3*x5+a,sum)", 2);
+    verify_not_optimized("reduce(x5y3*x5,max)");
+}
+
+TEST(FusedReduceTest, join_with_mixed_cell_types_is_kept_as_input) {
+    verify_optimized("reduce(x5y3*x5y3f+a,sum)", 2);
+    verify_not_optimized("reduce(x5y3*x5y3f,sum)");
+}
+
+TEST(FusedReduceTest, non_dense_input_is_not_fused) {
+    verify_not_optimized("reduce(sparse*sparse+a,sum)");
+    verify_not_optimized("reduce(mixed*mixed+a,sum)");
+}
+
+TEST(FusedReduceTest, custom_lambda_is_not_fused) {
+    verify_not_optimized("reduce(map(x5y3,f(x)(x*x+1)),sum)");
+}
+
+TEST(FusedReduceTest, custom_lambda_below_fusible_join_is_kept_as_input) {
+    verify_optimized("reduce(map(x5y3,f(x)(x*x+1))*x5y3_2+a,sum)", 3);
+    verify_optimized("reduce(sqrt(join(x5y3,x5y3_2,f(x,y)(x*y+1)))*a,max)", 2);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_combiner.h>
+#include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+namespace vespalib::tensor::test {
+
+// join by combining all pairs of cells, used as reference
+inline Tensor::UP
+nestedLoopJoin(const SparseTensor &lhs, const SparseTensor &rhs, double (*func)(double, double))
+{
+    DirectSparseTensorBuilder builder(lhs.combineDimensionsWith(rhs));
+    sparse::TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
+    for (const auto &lhsCell : lhs.my_cells()) {
+        for (const auto &rhsCell : rhs.my_cells()) {
+            if (addressCombiner.combine(lhsCell.first, rhsCell.first)) {
+                builder.insertCell(addressCombiner.getAddressRef(), func(lhsCell.second, rhsCell.second));
+            }
+        }
+    }
+    return builder.build();
+}
+
+inline eval::TensorSpec
+makeSpec(const vespalib::string &type, const std::vector<vespalib::string> &dims,
+         const std::vector<size_t> &sizes, size_t stride)
+{
+    eval::TensorSpec spec(type);
+    size_t numCells = 1;
+    for (size_t size : sizes) {
+        numCells *= size;
+    }
+    for (size_t i = 0; i < numCells; i += stride) {
+        eval::TensorSpec::Address address;
+        size_t rest = i;
+        for (size_t d = 0; d < dims.size(); ++d) {
+            address.emplace(dims[d], make_string("l%zu", rest % sizes[d]));
+            rest /= sizes[d];
+        }
+        spec.add(address, 1.0 + (i % 17));
+    }
+    return spec;
+}
+
+}
@@ -0,0 +1,30 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_join_utils.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/tensor/test/test_utils.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using vespalib::BenchmarkTimer;
+using vespalib::eval::operation::Mul;
+using vespalib::tensor::test::makeSpec;
+using vespalib::tensor::test::makeTensor;
+using vespalib::tensor::test::nestedLoopJoin;
+using namespace vespalib::tensor;
+
+constexpr double budget = 0.5;
+
+TEST(SparseTensorJoinBench, join_with_partial_overlap) {
+    for (size_t shared : {16, 64, 256}) {
+        auto lhs = makeTensor<SparseTensor>(makeSpec("tensor(x{},y{})", {"x", "y"}, {32, shared}, 1));
+        auto rhs = makeTensor<SparseTensor>(makeSpec("tensor(y{},z{})", {"y", "z"}, {shared, 16}, 1));
+        EXPECT_EQ(nestedLoopJoin(*lhs, *rhs, Mul::f)->toSpec(), lhs->join(Mul::f, *rhs)->toSpec());
+        double nested = BenchmarkTimer::benchmark([&](){ nestedLoopJoin(*lhs, *rhs, Mul::f); }, budget);
+        double indexed = BenchmarkTimer::benchmark([&](){ lhs->join(Mul::f, *rhs); }, budget);
+        fprintf(stderr, "%zu shared labels: nested loop join: %g ms, indexed join: %g ms\n",
+                shared, nested * 1000.0, indexed * 1000.0);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,57 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_join_utils.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/tensor/test/test_utils.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using vespalib::eval::TensorSpec;
+using vespalib::eval::operation::Add;
+using vespalib::eval::operation::Mul;
+using vespalib::eval::operation::Sub;
+using vespalib::tensor::test::makeSpec;
+using vespalib::tensor::test::makeTensor;
+using vespalib::tensor::test::nestedLoopJoin;
+using namespace vespalib::tensor;
+
+namespace {
+
+void
+verifyJoin(const TensorSpec &lhsSpec, const TensorSpec &rhsSpec)
+{
+    auto lhs = makeTensor<SparseTensor>(lhsSpec);
+    auto rhs = makeTensor<SparseTensor>(rhsSpec);
+    for (auto func : {Add::f, Sub::f, Mul::f}) {
+        auto expect = nestedLoopJoin(*lhs, *rhs, func);
+        auto actual = lhs->join(func, *rhs);
+        ASSERT_TRUE(actual);
+        EXPECT_EQ(expect->toSpec(), actual->toSpec());
+        auto swapped_expect = nestedLoopJoin(*rhs, *lhs, func);
+        auto swapped_actual = rhs->join(func, *lhs);
+        ASSERT_TRUE(swapped_actual);
+        EXPECT_EQ(swapped_expect->toSpec(), swapped_actual->toSpec());
+    }
+}
+
+}
+
+TEST(SparseTensorJoinTest, join_with_partial_overlap_matches_nested_loop_join) {
+    verifyJoin(makeSpec("tensor(x{},y{})", {"x", "y"}, {7, 5}, 1),
+               makeSpec("tensor(y{},z{})", {"y", "z"}, {6, 3}, 2));
+    verifyJoin(makeSpec("tensor(a{},x{},y{})", {"a", "x", "y"}, {2, 5, 4}, 3),
+               makeSpec("tensor(x{},y{},z{})", {"x", "y", "z"}, {4, 5, 3}, 1));
+    verifyJoin(makeSpec("tensor(x{})", {"x"}, {10}, 1),
+               makeSpec("tensor(x{},y{})", {"x", "y"}, {12, 4}, 1));
+}
+
+TEST(SparseTensorJoinTest, join_without_overlap_matches_nested_loop_join) {
+    verifyJoin(makeSpec("tensor(x{})", {"x"}, {6}, 1),
+               makeSpec("tensor(y{})", {"y"}, {4}, 1));
+}
+
+TEST(SparseTensorJoinTest, join_with_empty_tensor_gives_empty_result) {
+    verifyJoin(TensorSpec("tensor(x{},y{})"),
+               makeSpec("tensor(y{},z{})", {"y", "z"}, {6, 3}, 1));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
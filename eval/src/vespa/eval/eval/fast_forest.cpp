@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -143,10 +144,14 @@ template <> vespalib::string fixed_impl_name<uint64_t>() { return "ff-fixed<64>"
 template <typename T>
 constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 
+// number of documents evaluated together in batch mode
+constexpr size_t batch_block = 8;
+
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> block_masks;
+    FixedContext(size_t num_trees) : masks(num_trees), block_masks() {}
 };
 
 template <typename T>
@@ -200,6 +205,8 @@ struct FixedForest : FastForest {
     vespalib::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_block(FixedContext<T> &context, const float *params, size_t stride, size_t num_docs, double *results) const;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -335,13 +342,81 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+// Evaluate up to 'batch_block' documents with one mask per tree per
+// document. Each comparison node is checked against all documents at
+// once, and the node masks are applied to the documents where the
+// feature value is not less than the node value. Documents with a
+// missing feature value are handled separately using the default
+// masks.
+template <typename T>
+void
+FixedForest<T>::eval_block(FixedContext<T> &context, const float *params, size_t stride, size_t num_docs, double *results) const
+{
+    typedef T BlockMask __attribute__ ((vector_size (batch_block * sizeof(T)), aligned (sizeof(T))));
+    typedef float BlockValue __attribute__ ((vector_size (batch_block * sizeof(float))));
+    assert(num_docs <= batch_block);
+    BlockMask *ctx_masks = reinterpret_cast<BlockMask *>(&context.block_masks[0]);
+    for (uint32_t tree = 0; tree < _num_trees; ++tree) {
+        ctx_masks[tree] = BlockMask{} - 1;
+    }
+    const Mask *mask_pos = &_masks[0];
+    for (size_t f = 0; f < _mask_sizes.size(); ++f) {
+        const Mask *mask_end = mask_pos + _mask_sizes[f];
+        BlockValue features{};
+        bool any_value = false;
+        float max_value = 0.0;
+        for (size_t d = 0; d < num_docs; ++d) {
+            float feature = params[(f * stride) + d];
+            if (std::isnan(feature)) {
+                for (size_t i = _default_offsets[f]; i < _default_offsets[f + 1]; ++i) {
+                    ctx_masks[_default_masks[i].tree][d] &= _default_masks[i].bits;
+                }
+                features[d] = -std::numeric_limits<float>::infinity();
+            } else {
+                features[d] = feature;
+                max_value = any_value ? std::max(max_value, feature) : feature;
+                any_value = true;
+            }
+        }
+        if (any_value) {
+            for (const Mask *pos = mask_pos; (pos < mask_end) && !(max_value < pos->value); ++pos) {
+                BlockMask apply = __builtin_convertvector(features >= pos->value, BlockMask);
+                ctx_masks[pos->tree] &= (pos->bits | ~apply);
+            }
+        }
+        mask_pos = mask_end;
+    }
+    const float *leafs = &_padded_leafs[0];
+    for (size_t d = 0; d < num_docs; ++d) {
+        results[d] = 0.0;
+    }
+    for (uint32_t tree = 0; tree < _num_trees; ++tree, leafs += _max_leafs) {
+        for (size_t d = 0; d < num_docs; ++d) {
+            results[d] += leafs[get_lsb(T(ctx_masks[tree][d]))];
+        }
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    auto &ctx = static_cast<FixedContext<T>&>(context);
+    ctx.block_masks.resize(_num_trees * batch_block);
+    for (size_t offset = 0; offset < num_docs; offset += batch_block) {
+        size_t block_size = std::min(batch_block, num_docs - offset);
+        eval_block(ctx, params + offset, num_docs, block_size, results + offset);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
 
 struct MultiWordContext : FastForest::Context {
     std::vector<uint32_t> words;
-    MultiWordContext(size_t size) : words(size) {}
+    std::vector<float> row;
+    MultiWordContext(size_t size) : words(size), row() {}
 };
 
 struct MultiWordForest : FastForest {
@@ -440,6 +515,7 @@ struct MultiWordForest : FastForest {
     vespalib::string impl_name() const override { return "ff-multiword"; }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 MultiWordForest::MultiWordForest(const State &state)
@@ -620,6 +696,20 @@ MultiWordForest::eval(Context &context, const float *params) const
     return get_result(ctx_words);
 }
 
+void
+MultiWordForest::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    auto &ctx = static_cast<MultiWordContext&>(context);
+    const size_t num_params = _mask_sizes.size();
+    ctx.row.resize(num_params);
+    for (size_t d = 0; d < num_docs; ++d) {
+        for (size_t f = 0; f < num_params; ++f) {
+            ctx.row[f] = params[(f * num_docs) + d];
+        }
+        results[d] = eval(context, &ctx.row[0]);
+    }
+}
+
 }
 
 //-----------------------------------------------------------------------------
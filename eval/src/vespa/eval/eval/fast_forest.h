@@ -36,6 +36,10 @@ public:
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+    // Evaluate the forest for multiple documents. Parameters are
+    // stored per feature; 'params[f * num_docs + d]' is the value of
+    // feature 'f' for document 'd'.
+    virtual void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const = 0;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
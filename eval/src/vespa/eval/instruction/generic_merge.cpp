@@ -0,0 +1,148 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "generic_merge.h"
+#include <vespa/eval/eval/inline_operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/typify.h>
+#include <cassert>
+
+namespace vespalib::eval::instruction {
+
+using State = InterpretedFunction::State;
+using Instruction = InterpretedFunction::Instruction;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename IN> uint64_t wrap_param(const IN &value_in) {
+    const T &value = value_in;
+    static_assert(sizeof(uint64_t) == sizeof(&value));
+    return (uint64_t)&value;
+}
+
+template <typename T> const T &unwrap_param(uint64_t param) {
+    return *((const T *)param);
+}
+
+//-----------------------------------------------------------------------------
+
+struct MergeParam {
+    ValueType res_type;
+    join_fun_t function;
+    size_t num_mapped_dims;
+    size_t dense_subspace_size;
+    std::vector<size_t> all_view_dims;
+    const ValueBuilderFactory &factory;
+    MergeParam(const ValueType &lhs_type, const ValueType &rhs_type,
+               join_fun_t function_in, const ValueBuilderFactory &factory_in)
+        : res_type(ValueType::merge(lhs_type, rhs_type)),
+          function(function_in),
+          num_mapped_dims(res_type.count_mapped_dimensions()),
+          dense_subspace_size(res_type.dense_subspace_size()),
+          all_view_dims(num_mapped_dims),
+          factory(factory_in)
+    {
+        assert(!res_type.is_error());
+        for (size_t i = 0; i < num_mapped_dims; ++i) {
+            all_view_dims[i] = i;
+        }
+    }
+    ~MergeParam();
+};
+MergeParam::~MergeParam() = default;
+
+//-----------------------------------------------------------------------------
+
+// Contains the addresses used to visit all subspaces of one value
+// and look up the same subspace in the other.
+struct MergeAddress {
+    std::vector<vespalib::stringref>        address;
+    std::vector<vespalib::stringref*>       fetch_address;
+    std::vector<const vespalib::stringref*> lookup_address;
+    std::vector<vespalib::stringref*>       no_address;
+    MergeAddress(size_t num_mapped_dims)
+        : address(num_mapped_dims), fetch_address(), lookup_address(), no_address()
+    {
+        for (auto &label: address) {
+            fetch_address.push_back(&label);
+            lookup_address.push_back(&label);
+        }
+    }
+    ~MergeAddress();
+};
+MergeAddress::~MergeAddress() = default;
+
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+void my_generic_merge_op(State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<MergeParam>(param_in);
+    Fun fun(param.function);
+    const Value &lhs = state.peek(1);
+    const Value &rhs = state.peek(0);
+    auto lhs_cells = lhs.cells().typify<LCT>();
+    auto rhs_cells = rhs.cells().typify<RCT>();
+    const size_t subspace_size = param.dense_subspace_size;
+    auto builder = param.factory.create_value_builder<OCT>(param.res_type, param.num_mapped_dims, subspace_size,
+                                                           lhs.index().size() + rhs.index().size());
+    MergeAddress addr(param.num_mapped_dims);
+    size_t lhs_subspace;
+    size_t rhs_subspace;
+    auto outer = lhs.index().create_view({});
+    auto inner = rhs.index().create_view(param.all_view_dims);
+    outer->lookup({});
+    while (outer->next_result(addr.fetch_address, lhs_subspace)) {
+        OCT *dst = builder->add_subspace(addr.address).begin();
+        const LCT *lhs_src = &lhs_cells[lhs_subspace * subspace_size];
+        inner->lookup(addr.lookup_address);
+        if (inner->next_result(addr.no_address, rhs_subspace)) {
+            const RCT *rhs_src = &rhs_cells[rhs_subspace * subspace_size];
+            for (size_t i = 0; i < subspace_size; ++i) {
+                dst[i] = fun(lhs_src[i], rhs_src[i]);
+            }
+        } else {
+            for (size_t i = 0; i < subspace_size; ++i) {
+                dst[i] = lhs_src[i];
+            }
+        }
+    }
+    outer = rhs.index().create_view({});
+    inner = lhs.index().create_view(param.all_view_dims);
+    outer->lookup({});
+    while (outer->next_result(addr.fetch_address, rhs_subspace)) {
+        inner->lookup(addr.lookup_address);
+        if (!inner->next_result(addr.no_address, lhs_subspace)) {
+            OCT *dst = builder->add_subspace(addr.address).begin();
+            const RCT *rhs_src = &rhs_cells[rhs_subspace * subspace_size];
+            for (size_t i = 0; i < subspace_size; ++i) {
+                dst[i] = rhs_src[i];
+            }
+        }
+    }
+    auto &result = state.stash.create<std::unique_ptr<Value>>(builder->build(std::move(builder)));
+    const Value &result_ref = *(result.get());
+    state.pop_pop_push(result_ref);
+};
+
+struct SelectGenericMergeOp {
+    template <typename LCT, typename RCT, typename OCT, typename Fun> static auto invoke() {
+        return my_generic_merge_op<LCT,RCT,OCT,Fun>;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace <unnamed>
+
+using MergeTypify = TypifyValue<TypifyCellType,operation::TypifyOp2>;
+
+Instruction
+GenericMerge::make_instruction(const ValueType &lhs_type, const ValueType &rhs_type, join_fun_t function,
+                               const ValueBuilderFactory &factory, Stash &stash)
+{
+    auto &param = stash.create<MergeParam>(lhs_type, rhs_type, function, factory);
+    auto fun = typify_invoke<4,MergeTypify,SelectGenericMergeOp>(lhs_type.cell_type(), rhs_type.cell_type(), param.res_type.cell_type(), function);
+    return Instruction(fun, wrap_param<MergeParam>(param));
+}
+
+} // namespace
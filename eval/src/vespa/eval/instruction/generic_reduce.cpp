@@ -0,0 +1,233 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "generic_reduce.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/typify.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib::eval::instruction {
+
+using State = InterpretedFunction::State;
+using Instruction = InterpretedFunction::Instruction;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename IN> uint64_t wrap_param(const IN &value_in) {
+    const T &value = value_in;
+    static_assert(sizeof(uint64_t) == sizeof(&value));
+    return (uint64_t)&value;
+}
+
+template <typename T> const T &unwrap_param(uint64_t param) {
+    return *((const T *)param);
+}
+
+//-----------------------------------------------------------------------------
+
+struct ReduceParam {
+    ValueType res_type;
+    SparseReducePlan sparse_plan;
+    DenseReducePlan dense_plan;
+    const ValueBuilderFactory &factory;
+    ReduceParam(const ValueType &type, const std::vector<vespalib::string> &dimensions,
+                const ValueBuilderFactory &factory_in)
+        : res_type(type.reduce(dimensions)),
+          sparse_plan(type, res_type),
+          dense_plan(type, res_type),
+          factory(factory_in)
+    {
+        assert(!res_type.is_error());
+    }
+    ~ReduceParam();
+};
+ReduceParam::~ReduceParam() = default;
+
+//-----------------------------------------------------------------------------
+
+// Groups the dense subspaces of the input on the labels of the kept
+// mapped dimensions. The subspaces of each group are stored
+// contiguously in 'subspaces', in the order they were visited.
+struct SparseReduceState {
+    std::vector<vespalib::stringref>          full_address;
+    std::vector<vespalib::stringref*>         fetch_address;
+    std::vector<std::vector<vespalib::string>> group_address;
+    std::vector<size_t>                       group_offset;
+    std::vector<size_t>                       subspaces;
+
+    SparseReduceState(const SparseReducePlan &plan, const Value::Index &index)
+        : full_address(plan.num_mapped_dims),
+          fetch_address(),
+          group_address(),
+          group_offset(),
+          subspaces()
+    {
+        for (auto &label: full_address) {
+            fetch_address.push_back(&label);
+        }
+        vespalib::hash_map<vespalib::string, size_t> group_of_key;
+        std::vector<size_t> group_of_subspace(index.size());
+        std::vector<size_t> group_size;
+        vespalib::string key;
+        auto view = index.create_view({});
+        view->lookup({});
+        size_t subspace;
+        while (view->next_result(fetch_address, subspace)) {
+            key.clear();
+            for (size_t dim: plan.keep_dims) {
+                key.append(full_address[dim]);
+                key.push_back('\0');
+            }
+            auto pos = group_of_key.find(key);
+            if (pos == group_of_key.end()) {
+                pos = group_of_key.insert(std::make_pair(key, group_address.size())).first;
+                auto &addr = group_address.emplace_back();
+                for (size_t dim: plan.keep_dims) {
+                    addr.emplace_back(full_address[dim]);
+                }
+                group_size.push_back(0);
+            }
+            group_of_subspace[subspace] = pos->second;
+            ++group_size[pos->second];
+        }
+        group_offset.resize(group_size.size() + 1, 0);
+        for (size_t i = 0; i < group_size.size(); ++i) {
+            group_offset[i + 1] = group_offset[i] + group_size[i];
+        }
+        subspaces.resize(index.size());
+        std::vector<size_t> fill_pos(group_offset.begin(), group_offset.end() - 1);
+        for (size_t i = 0; i < group_of_subspace.size(); ++i) {
+            subspaces[fill_pos[group_of_subspace[i]]++] = i;
+        }
+    }
+    ~SparseReduceState();
+    size_t num_groups() const { return group_address.size(); }
+    ConstArrayRef<size_t> subspaces_of(size_t group) const {
+        return ConstArrayRef<size_t>(&subspaces[group_offset[group]], group_offset[group + 1] - group_offset[group]);
+    }
+};
+SparseReduceState::~SparseReduceState() = default;
+
+template <typename ICT, typename OCT, typename AGGR>
+void my_generic_reduce_op(State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<ReduceParam>(param_in);
+    const Value &value = state.peek(0);
+    auto cells = value.cells().typify<ICT>();
+    SparseReduceState sparse(param.sparse_plan, value.index());
+    const size_t keep_dims = param.sparse_plan.keep_dims.size();
+    auto builder = param.factory.create_value_builder<OCT>(param.res_type, keep_dims, param.dense_plan.out_size,
+                                                           std::max(sparse.num_groups(), size_t(1)));
+    std::vector<vespalib::stringref> out_address(keep_dims);
+    for (size_t group = 0; group < sparse.num_groups(); ++group) {
+        for (size_t i = 0; i < keep_dims; ++i) {
+            out_address[i] = sparse.group_address[group][i];
+        }
+        auto group_subspaces = sparse.subspaces_of(group);
+        OCT *dst = builder->add_subspace(out_address).begin();
+        auto reduce_cells = [&](size_t keep_offset) {
+            AGGR aggr;
+            bool first = true;
+            auto aggr_cell = [&](size_t idx) {
+                if (first) {
+                    aggr.first(cells[idx]);
+                    first = false;
+                } else {
+                    aggr.next(cells[idx]);
+                }
+            };
+            for (size_t subspace: group_subspaces) {
+                param.dense_plan.execute_reduce(param.dense_plan.in_size * subspace + keep_offset, aggr_cell);
+            }
+            *dst++ = aggr.result();
+        };
+        param.dense_plan.execute_keep(reduce_cells);
+    }
+    if ((sparse.num_groups() == 0) && (keep_dims == 0)) {
+        for (OCT &cell: builder->add_subspace(out_address)) {
+            cell = OCT{};
+        }
+    }
+    auto &result = state.stash.create<std::unique_ptr<Value>>(builder->build(std::move(builder)));
+    const Value &result_ref = *(result.get());
+    state.pop_push(result_ref);
+};
+
+struct SelectGenericReduceOp {
+    template <typename ICT, typename OCT, typename AGGR> static auto invoke() {
+        return my_generic_reduce_op<ICT, OCT, typename AGGR::template templ<OCT>>;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace <unnamed>
+
+//-----------------------------------------------------------------------------
+
+DenseReducePlan::DenseReducePlan(const ValueType &type, const ValueType &res_type)
+    : in_size(1), out_size(1), keep_loop(), keep_stride(), reduce_loop(), reduce_stride()
+{
+    enum class Case { NONE, KEEP, REDUCE };
+    Case prev_case = Case::NONE;
+    auto dims = type.nontrivial_indexed_dimensions();
+    // visit dimensions from the innermost one, combining adjacent
+    // dimensions of the same kind into a single loop
+    for (size_t i = dims.size(); i-- > 0; ) {
+        Case my_case = (res_type.dimension_index(dims[i].name) == ValueType::Dimension::npos)
+                       ? Case::REDUCE : Case::KEEP;
+        auto &loop = (my_case == Case::KEEP) ? keep_loop : reduce_loop;
+        auto &stride = (my_case == Case::KEEP) ? keep_stride : reduce_stride;
+        if (my_case == prev_case) {
+            loop.back() *= dims[i].size;
+        } else {
+            loop.push_back(dims[i].size);
+            stride.push_back(in_size);
+            prev_case = my_case;
+        }
+        in_size *= dims[i].size;
+        if (my_case == Case::KEEP) {
+            out_size *= dims[i].size;
+        }
+    }
+    std::reverse(keep_loop.begin(), keep_loop.end());
+    std::reverse(keep_stride.begin(), keep_stride.end());
+    std::reverse(reduce_loop.begin(), reduce_loop.end());
+    std::reverse(reduce_stride.begin(), reduce_stride.end());
+}
+
+DenseReducePlan::~DenseReducePlan() = default;
+
+//-----------------------------------------------------------------------------
+
+SparseReducePlan::SparseReducePlan(const ValueType &type, const ValueType &res_type)
+    : num_mapped_dims(type.count_mapped_dimensions()), keep_dims()
+{
+    auto dims = type.mapped_dimensions();
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (res_type.dimension_index(dims[i].name) != ValueType::Dimension::npos) {
+            keep_dims.push_back(i);
+        }
+    }
+}
+
+SparseReducePlan::~SparseReducePlan() = default;
+
+//-----------------------------------------------------------------------------
+
+using ReduceTypify = TypifyValue<TypifyCellType,TypifyAggr>;
+
+Instruction
+GenericReduce::make_instruction(const ValueType &type, Aggr aggr, const std::vector<vespalib::string> &dimensions,
+                                const ValueBuilderFactory &factory, Stash &stash)
+{
+    auto &param = stash.create<ReduceParam>(type, dimensions, factory);
+    auto fun = typify_invoke<3,ReduceTypify,SelectGenericReduceOp>(type.cell_type(), param.res_type.cell_type(), aggr);
+    return Instruction(fun, wrap_param<ReduceParam>(param));
+}
+
+} // namespace
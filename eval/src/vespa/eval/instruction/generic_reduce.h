@@ -0,0 +1,85 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/eval/aggr.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib { class Stash; }
+namespace vespalib::eval { struct ValueBuilderFactory; }
+
+namespace vespalib::eval::instruction {
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Plan for how to reduce a dense subspace. The kept dimensions are
+ * traversed by 'execute_keep' in the order the reduced cells will be
+ * stored in the result. For each of them, 'execute_reduce' visits
+ * all input cells that are aggregated into that result cell. Adjacent
+ * dimensions of the same kind are combined into a single loop.
+ **/
+struct DenseReducePlan {
+    size_t in_size;
+    size_t out_size;
+    std::vector<size_t> keep_loop;
+    std::vector<size_t> keep_stride;
+    std::vector<size_t> reduce_loop;
+    std::vector<size_t> reduce_stride;
+    DenseReducePlan(const ValueType &type, const ValueType &res_type);
+    ~DenseReducePlan();
+    template <typename F> void execute_keep(F &&f) const {
+        execute(0, 0, keep_loop, keep_stride, std::forward<F>(f));
+    }
+    template <typename F> void execute_reduce(size_t offset, F &&f) const {
+        execute(0, offset, reduce_loop, reduce_stride, std::forward<F>(f));
+    }
+private:
+    template <typename F> static void execute(size_t idx, size_t offset, const std::vector<size_t> &loop,
+                                              const std::vector<size_t> &stride, F &&f)
+    {
+        if (idx == loop.size()) {
+            f(offset);
+        } else if ((idx + 1) == loop.size()) {
+            for (size_t i = 0; i < loop[idx]; ++i, offset += stride[idx]) {
+                f(offset);
+            }
+        } else {
+            for (size_t i = 0; i < loop[idx]; ++i, offset += stride[idx]) {
+                execute(idx + 1, offset, loop, stride, std::forward<F>(f));
+            }
+        }
+    }
+};
+
+/**
+ * Plan for how to reduce the sparse part (all mapped dimensions) of
+ * a value. 'keep_dims' lists the mapped dimensions (by index) that
+ * are present in the result.
+ **/
+struct SparseReducePlan {
+    size_t num_mapped_dims;
+    std::vector<size_t> keep_dims;
+    SparseReducePlan(const ValueType &type, const ValueType &res_type);
+    ~SparseReducePlan();
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Reduce a value of any type. The input is traversed once to group
+ * the dense subspaces on the labels of the kept mapped dimensions,
+ * and each group is then aggregated one dense subspace at a time.
+ **/
+struct GenericReduce {
+    static InterpretedFunction::Instruction
+    make_instruction(const ValueType &type, Aggr aggr, const std::vector<vespalib::string> &dimensions,
+                     const ValueBuilderFactory &factory, Stash &stash);
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace
@@ -9,6 +9,7 @@
 #include "dense/dense_tensor.h"
 #include "dense/typed_dense_tensor_builder.h"
 #include "dense/dense_dot_product_function.h"
+#include "dense/dense_fused_reduce_function.h"
 #include "dense/dense_xw_product_function.h"
 #include "dense/dense_matmul_function.h"
 #include "dense/dense_multi_matmul_function.h"
@@ -279,6 +280,7 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
             child.set(DenseXWProductFunction::optimize(child.get(), stash));
             child.set(DenseMatMulFunction::optimize(child.get(), stash));
             child.set(DenseMultiMatMulFunction::optimize(child.get(), stash));
+            child.set(DenseFusedReduceFunction::optimize(child.get(), stash));
             nodes.pop_back();
         }
     }
@@ -0,0 +1,244 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_fused_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/visit_stuff.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/typify.h>
+#include <cassert>
+#include <optional>
+
+namespace vespalib::tensor {
+
+using eval::Aggr;
+using eval::CompileCache;
+using eval::CompiledFunction;
+using eval::Function;
+using eval::PassParams;
+using eval::TensorEngine;
+using eval::TensorFunction;
+using eval::TypifyAggr;
+using eval::ValueType;
+using eval::as;
+using vespalib::make_string;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+using Child = TensorFunction::Child;
+using Instruction = eval::InterpretedFunction::Instruction;
+using State = eval::InterpretedFunction::State;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+template <typename CT, typename AGGR>
+void my_fused_reduce_op(State &state, uint64_t param) {
+    const auto &self = *((const DenseFusedReduceFunction::Self *)(param));
+    const size_t num_params = self.is_tensor.size();
+    std::vector<double> args(num_params, 0.0);
+    std::vector<std::pair<double *, const CT *>> inputs;
+    for (size_t i = 0; i < num_params; ++i) {
+        const eval::Value &value = state.peek(num_params - 1 - i);
+        if (self.is_tensor[i]) {
+            inputs.emplace_back(&args[i], DenseTensorView::typify_cells<CT>(value).cbegin());
+        } else {
+            args[i] = value.as_double();
+        }
+    }
+    auto fun = self.token->get().get_function();
+    AGGR aggr;
+    for (size_t cell = 0; cell < self.num_cells; ++cell) {
+        for (const auto &input: inputs) {
+            *input.first = input.second[cell];
+        }
+        if (cell == 0) {
+            aggr.first(fun(&args[0]));
+        } else {
+            aggr.next(fun(&args[0]));
+        }
+    }
+    state.pop_n_push(num_params, state.stash.create<eval::DoubleValue>(aggr.result()));
+}
+
+struct MyFusedReduceOp {
+    template <typename CT, typename AGGR>
+    static auto invoke() { return my_fused_reduce_op<CT, typename AGGR::template templ<double>>; }
+};
+
+//-----------------------------------------------------------------------------
+
+std::optional<vespalib::string> expr_of_op1(map_fun_t fun, const vespalib::string &a) {
+    if (fun == Neg::f)     { return make_string("(-%s)", a.c_str()); }
+    if (fun == Exp::f)     { return make_string("exp(%s)", a.c_str()); }
+    if (fun == Log::f)     { return make_string("log(%s)", a.c_str()); }
+    if (fun == Sqrt::f)    { return make_string("sqrt(%s)", a.c_str()); }
+    if (fun == Fabs::f)    { return make_string("fabs(%s)", a.c_str()); }
+    if (fun == Tanh::f)    { return make_string("tanh(%s)", a.c_str()); }
+    if (fun == Sigmoid::f) { return make_string("sigmoid(%s)", a.c_str()); }
+    if (fun == Relu::f)    { return make_string("relu(%s)", a.c_str()); }
+    if (fun == Inv::f)     { return make_string("(1/%s)", a.c_str()); }
+    if (fun == Square::f)  { return make_string("(%s*%s)", a.c_str(), a.c_str()); }
+    if (fun == Cube::f)    { return make_string("(%s*%s*%s)", a.c_str(), a.c_str(), a.c_str()); }
+    return std::nullopt;
+}
+
+std::optional<vespalib::string> expr_of_op2(join_fun_t fun, const vespalib::string &a, const vespalib::string &b) {
+    if (fun == Add::f) { return make_string("(%s+%s)", a.c_str(), b.c_str()); }
+    if (fun == Sub::f) { return make_string("(%s-%s)", a.c_str(), b.c_str()); }
+    if (fun == Mul::f) { return make_string("(%s*%s)", a.c_str(), b.c_str()); }
+    if (fun == Div::f) { return make_string("(%s/%s)", a.c_str(), b.c_str()); }
+    if (fun == Pow::f) { return make_string("pow(%s,%s)", a.c_str(), b.c_str()); }
+    if (fun == Min::f) { return make_string("min(%s,%s)", a.c_str(), b.c_str()); }
+    if (fun == Max::f) { return make_string("max(%s,%s)", a.c_str(), b.c_str()); }
+    return std::nullopt;
+}
+
+// Collects the elementwise operations below a reduce as a scalar
+// expression. Dense tensors with the same type as the input of the
+// reduce and scalars become parameters of the expression. This also
+// goes for operations that cannot be expressed, like custom lambdas.
+struct Fuser {
+    const ValueType &input_type;
+    std::vector<Child> children;
+    std::vector<bool> is_tensor;
+    std::vector<vespalib::string> params;
+    size_t num_ops;
+    Fuser(const ValueType &input_type_in)
+        : input_type(input_type_in), children(), is_tensor(), params(), num_ops(0) {}
+    ~Fuser();
+    bool is_elementwise(const ValueType &type) const {
+        return (type.is_double() || (type.dimensions() == input_type.dimensions()));
+    }
+    vespalib::string add_param(const TensorFunction &node, bool tensor) {
+        params.push_back(make_string("p%zu", params.size()));
+        children.emplace_back(node);
+        is_tensor.push_back(tensor);
+        return params.back();
+    }
+    // forget the parameters and operations collected by a failed attempt
+    void rollback(size_t num_params, size_t num_ops_in) {
+        children.erase(children.begin() + num_params, children.end());
+        is_tensor.resize(num_params);
+        params.resize(num_params);
+        num_ops = num_ops_in;
+    }
+    std::optional<vespalib::string> fuse(const TensorFunction &node) {
+        const ValueType &type = node.result_type();
+        if (type.is_double()) {
+            return add_param(node, false);
+        }
+        size_t num_params = params.size();
+        size_t num_ops_before = num_ops;
+        if (auto map = as<Map>(node)) {
+            if (is_elementwise(map->child().result_type()) && expr_of_op1(map->function(), "a")) {
+                if (auto a = fuse(map->child())) {
+                    ++num_ops;
+                    return expr_of_op1(map->function(), a.value());
+                }
+                rollback(num_params, num_ops_before);
+            }
+        }
+        if (auto join = as<Join>(node)) {
+            if (is_elementwise(join->lhs().result_type()) && is_elementwise(join->rhs().result_type()) &&
+                expr_of_op2(join->function(), "a", "b"))
+            {
+                auto a = fuse(join->lhs());
+                auto b = a ? fuse(join->rhs()) : std::nullopt;
+                if (a && b) {
+                    ++num_ops;
+                    return expr_of_op2(join->function(), a.value(), b.value());
+                }
+                rollback(num_params, num_ops_before);
+            }
+        }
+        if (type == input_type) {
+            return add_param(node, true);
+        }
+        return std::nullopt;
+    }
+};
+Fuser::~Fuser() = default;
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseFusedReduceFunction::Self::Self(Aggr aggr_in, size_t num_cells_in, std::vector<bool> is_tensor_in,
+                                     CompileCache::Token::UP token_in)
+    : aggr(aggr_in),
+      num_cells(num_cells_in),
+      is_tensor(std::move(is_tensor_in)),
+      token(std::move(token_in))
+{
+}
+
+DenseFusedReduceFunction::Self::~Self() = default;
+
+DenseFusedReduceFunction::DenseFusedReduceFunction(const ValueType &input_type, std::vector<Child> children,
+                                                   std::vector<bool> is_tensor, Aggr aggr,
+                                                   const Function &function)
+    : TensorFunction(),
+      _result_type(ValueType::double_type()),
+      _input_type(input_type),
+      _children(std::move(children)),
+      _expression(function.dump()),
+      _self(aggr, input_type.dense_subspace_size(), std::move(is_tensor),
+            CompileCache::compile(function, PassParams::ARRAY))
+{
+    assert(_children.size() == _self.is_tensor.size());
+    assert(function.num_params() == _children.size());
+}
+
+DenseFusedReduceFunction::~DenseFusedReduceFunction() = default;
+
+void
+DenseFusedReduceFunction::push_children(std::vector<Child::CREF> &target) const
+{
+    for (const Child &c : _children) {
+        target.emplace_back(c);
+    }
+}
+
+Instruction
+DenseFusedReduceFunction::compile_self(const TensorEngine &, Stash &) const
+{
+    static_assert(sizeof(uint64_t) == sizeof(&_self));
+    using MyTypify = TypifyValue<eval::TypifyCellType,TypifyAggr>;
+    auto op = typify_invoke<2,MyTypify,MyFusedReduceOp>(_input_type.cell_type(), _self.aggr);
+    return Instruction(op, (uint64_t)&_self);
+}
+
+void
+DenseFusedReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    TensorFunction::visit_self(visitor);
+    ::visit(visitor, "aggr", _self.aggr);
+    ::visit(visitor, "expression", _expression);
+}
+
+const TensorFunction &
+DenseFusedReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && reduce->result_type().is_double()) {
+        const ValueType &input_type = reduce->child().result_type();
+        if (input_type.is_dense() && !input_type.dimensions().empty()) {
+            Fuser fuser(input_type);
+            auto expression = fuser.fuse(reduce->child());
+            if (expression && (fuser.num_ops > 0)) {
+                auto function = Function::parse(fuser.params, expression.value());
+                if (!function->has_error() && !CompiledFunction::detect_issues(*function)) {
+                    return stash.create<DenseFusedReduceFunction>(input_type, std::move(fuser.children),
+                                                                  std::move(fuser.is_tensor), reduce->aggr(),
+                                                                  *function);
+                }
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
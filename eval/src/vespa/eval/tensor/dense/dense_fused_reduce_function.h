@@ -0,0 +1,53 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/aggr.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function reducing all dimensions of a chain of elementwise
+ * map/join operations over dense tensors with the same dimensions
+ * (and scalars). The elementwise operations are compiled into a
+ * single scalar function that is applied to each cell position
+ * before aggregating, avoiding intermediate tensors.
+ **/
+class DenseFusedReduceFunction : public eval::TensorFunction
+{
+public:
+    struct Self {
+        eval::Aggr aggr;
+        size_t num_cells;
+        std::vector<bool> is_tensor;
+        eval::CompileCache::Token::UP token;
+        Self(eval::Aggr aggr_in, size_t num_cells_in, std::vector<bool> is_tensor_in,
+             eval::CompileCache::Token::UP token_in);
+        ~Self();
+    };
+private:
+    eval::ValueType _result_type;
+    eval::ValueType _input_type;
+    std::vector<Child> _children;
+    vespalib::string _expression;
+    Self _self;
+public:
+    DenseFusedReduceFunction(const eval::ValueType &input_type, std::vector<Child> children,
+                             std::vector<bool> is_tensor, eval::Aggr aggr,
+                             const eval::Function &function);
+    ~DenseFusedReduceFunction() override;
+    const eval::ValueType &result_type() const override { return _result_type; }
+    const eval::ValueType &input_type() const { return _input_type; }
+    const vespalib::string &expression() const { return _expression; }
+    eval::Aggr aggr() const { return _self.aggr; }
+    size_t num_children() const { return _children.size(); }
+    void push_children(std::vector<Child::CREF> &children) const override;
+    eval::InterpretedFunction::Instruction compile_self(const eval::TensorEngine &engine, Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    bool result_is_mutable() const override { return true; }
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
@@ -1,11 +1,19 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "packed_mixed_tensor.h"
+#include <vespa/vespalib/util/overload.h>
+#include <algorithm>
 
 namespace vespalib::eval::packed_mixed_tensor {
 
 /*********************************************************************************/
 
+/**
+ * View that looks up the subspaces matching a partial address. The
+ * mappings are re-sorted on the labels of the view dimensions when
+ * the view is created, so that each lookup is a binary search
+ * followed by a scan of the matching range only.
+ **/
 class PackedMixedTensorIndexView : public Value::Index::View
 {
 private:
@@ -13,81 +21,105 @@ private:
     const std::vector<size_t> _view_dims;
     std::vector<uint32_t> _lookup_enums;
     std::vector<uint32_t> _full_enums;
+    // label enums of the view dimensions for each mapping, by sortid
+    std::vector<uint32_t> _view_enums;
+    // sortids ordered by (view enums, sortid)
+    std::vector<uint32_t> _order;
     size_t _index;
+    size_t _end;
 
     size_t num_full_dims() const { return _mappings.num_mapped_dims(); }
     size_t num_view_dims() const { return _view_dims.size(); }
     size_t num_rest_dims() const { return num_full_dims() - num_view_dims(); }
+    const uint32_t *view_enums_of(uint32_t sortid) const {
+        return &_view_enums[sortid * num_view_dims()];
+    }
+    int compare_view_enums(const uint32_t *a, const uint32_t *b) const {
+        for (size_t i = 0; i < num_view_dims(); ++i) {
+            if (a[i] < b[i]) return -1;
+            if (a[i] > b[i]) return 1;
+        }
+        return 0;
+    }
 public:
     PackedMixedTensorIndexView(const PackedMappings& mappings,
-                               const std::vector<size_t> &dims)
-        : _mappings(mappings),
-          _view_dims(dims),
-          _lookup_enums(),
-          _index(0)
-    {
-        _lookup_enums.reserve(num_view_dims());
-        _full_enums.resize(num_full_dims());
-    }
+                               const std::vector<size_t> &dims);
 
     void lookup(const std::vector<const vespalib::stringref*> &addr) override;
     bool next_result(const std::vector<vespalib::stringref*> &addr_out, size_t &idx_out) override;
     ~PackedMixedTensorIndexView() override = default;
 };
 
+PackedMixedTensorIndexView::PackedMixedTensorIndexView(const PackedMappings& mappings,
+                                                       const std::vector<size_t> &dims)
+    : _mappings(mappings),
+      _view_dims(dims),
+      _lookup_enums(),
+      _full_enums(),
+      _view_enums(),
+      _order(),
+      _index(0),
+      _end(0)
+{
+    _lookup_enums.reserve(num_view_dims());
+    _full_enums.resize(num_full_dims());
+    _view_enums.reserve(_mappings.size() * num_view_dims());
+    _order.reserve(_mappings.size());
+    for (uint32_t sortid = 0; sortid < _mappings.size(); ++sortid) {
+        _mappings.fill_enums_by_sortid(sortid, _full_enums);
+        for (size_t dim : _view_dims) {
+            _view_enums.push_back(_full_enums[dim]);
+        }
+        _order.push_back(sortid);
+    }
+    std::stable_sort(_order.begin(), _order.end(), [this](uint32_t a, uint32_t b)
+                     { return (compare_view_enums(view_enums_of(a), view_enums_of(b)) < 0); });
+}
+
 void
 PackedMixedTensorIndexView::lookup(const std::vector<const vespalib::stringref*> &addr)
 {
     _index = 0;
+    _end = 0;
     assert(addr.size() == num_view_dims());
     _lookup_enums.clear();
     for (const vespalib::stringref * label_ptr : addr) {
         int32_t label_enum = _mappings.label_store().find_label(*label_ptr);
         if (label_enum < 0) {
             // cannot match
-            _index = _mappings.size();
-            break;
+            return;
         }
         _lookup_enums.push_back(label_enum);
     }
+    const uint32_t *to_find = _lookup_enums.data();
+    auto range = std::equal_range(_order.begin(), _order.end(), to_find, overload
+            {
+                [this](uint32_t sortid, const uint32_t *key) { return (compare_view_enums(view_enums_of(sortid), key) < 0); },
+                [this](const uint32_t *key, uint32_t sortid) { return (compare_view_enums(key, view_enums_of(sortid)) < 0); }
+            });
+    _index = range.first - _order.begin();
+    _end = range.second - _order.begin();
 }
 
 bool
 PackedMixedTensorIndexView::next_result(const std::vector<vespalib::stringref*> &addr_out, size_t &idx_out)
 {
     assert(addr_out.size() == num_rest_dims());
-    while (_index < _mappings.size()) {
-        idx_out = _mappings.fill_enums_by_sortid(_index++, _full_enums);
-        bool couldmatch = true;
-        size_t vd_idx = 0;
-        size_t ao_idx = 0;
-        for (size_t i = 0; i < num_full_dims(); ++i) {
-            if (vd_idx < num_view_dims()) {
-                size_t next_view_dim = _view_dims[vd_idx];
-                if (i == next_view_dim) {
-                    if (_lookup_enums[vd_idx] == _full_enums[i]) {
-                        // match in this dimension
-                        ++vd_idx;
-                        continue;
-                    } else {
-                        // does not match
-                        couldmatch = false;
-                        break;
-                    }
-                }
-            }
-            // not a view dimension:
-            uint32_t label_enum = _full_enums[i];
-            *addr_out[ao_idx] = _mappings.label_store().get_label(label_enum);
-            ++ao_idx;
-        }
-        if (couldmatch) {
-            assert(vd_idx == num_view_dims());
-            assert(ao_idx == num_rest_dims());
-            return true;
+    if (_index >= _end) {
+        return false;
+    }
+    idx_out = _mappings.fill_enums_by_sortid(_order[_index++], _full_enums);
+    size_t vd_idx = 0;
+    size_t ao_idx = 0;
+    for (size_t i = 0; i < num_full_dims(); ++i) {
+        if ((vd_idx < num_view_dims()) && (i == _view_dims[vd_idx])) {
+            ++vd_idx;
+            continue;
         }
+        *addr_out[ao_idx++] = _mappings.label_store().get_label(_full_enums[i]);
     }
-    return false;
+    assert(ao_idx == num_rest_dims());
+    return true;
 }
 
 /*********************************************************************************/
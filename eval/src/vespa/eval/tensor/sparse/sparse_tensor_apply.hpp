@@ -4,21 +4,50 @@
 
 #include "sparse_tensor_apply.h"
 #include "sparse_tensor_address_combiner.h"
+#include "sparse_tensor_overlap_index.h"
 #include "direct_sparse_tensor_builder.h"
 
 namespace vespalib::tensor::sparse {
 
+/**
+ * Join by looking up the cells of the probe tensor in an index of the
+ * cells of the other tensor, grouped on the overlapping dimensions.
+ */
+template <bool indexIsLhs, typename Function>
+void
+applyIndexed(DirectSparseTensorBuilder &builder, TensorAddressCombiner &addressCombiner,
+             const SparseTensor &indexed, const SparseTensor &probe, Function &&func)
+{
+    SparseTensorOverlapIndex index(indexed, SparseTensorOverlapIndex::nonOverlappingDimensions(indexed.fast_type(), probe.fast_type()));
+    TensorAddressReducer keyBuilder(probe.fast_type(), SparseTensorOverlapIndex::nonOverlappingDimensions(probe.fast_type(), indexed.fast_type()));
+    for (const auto &probeCell : probe.my_cells()) {
+        keyBuilder.reduce(probeCell.first);
+        for (const auto &indexedCell : index.lookup(keyBuilder.getAddressRef())) {
+            const auto &lhsCell = indexIsLhs ? indexedCell : probeCell;
+            const auto &rhsCell = indexIsLhs ? probeCell : indexedCell;
+            if (addressCombiner.combine(lhsCell.first, rhsCell.first)) {
+                builder.insertCell(addressCombiner.getAddressRef(), func(lhsCell.second, rhsCell.second));
+            }
+        }
+    }
+}
+
 template <typename Function>
 std::unique_ptr<Tensor>
 apply(const SparseTensor &lhs, const SparseTensor &rhs, Function &&func)
 {
     DirectSparseTensorBuilder builder(lhs.combineDimensionsWith(rhs));
     TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
-    size_t estimatedCells = (lhs.my_cells().size() * rhs.my_cells().size());
     if (addressCombiner.numOverlappingDimensions() != 0) {
-        estimatedCells = std::min(lhs.my_cells().size(), rhs.my_cells().size());
+        builder.reserve(std::min(lhs.my_cells().size(), rhs.my_cells().size())*2);
+        if (lhs.my_cells().size() <= rhs.my_cells().size()) {
+            applyIndexed<true>(builder, addressCombiner, lhs, rhs, func);
+        } else {
+            applyIndexed<false>(builder, addressCombiner, rhs, lhs, func);
+        }
+        return builder.build();
     }
-    builder.reserve(estimatedCells*2);
+    builder.reserve(lhs.my_cells().size() * rhs.my_cells().size() * 2);
     for (const auto &lhsCell : lhs.my_cells()) {
         for (const auto &rhsCell : rhs.my_cells()) {
             bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
@@ -0,0 +1,96 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_tensor_overlap_index.h"
+#include <vespa/eval/eval/value_type.h>
+
+namespace vespalib::tensor::sparse {
+
+namespace {
+
+size_t
+calcNumSlots(size_t numCells)
+{
+    size_t numSlots = 16;
+    while (numSlots < (numCells * 2)) {
+        numSlots <<= 1;
+    }
+    return numSlots;
+}
+
+}
+
+uint32_t
+SparseTensorOverlapIndex::findOrInsert(SparseTensorAddressRef key)
+{
+    for (uint32_t slot = key.hash() & mask(); ; slot = (slot + 1) & mask()) {
+        uint32_t groupIdx = _slots[slot];
+        if (groupIdx == 0) {
+            _groups.emplace_back(SparseTensorAddressRef(key, _stash));
+            _slots[slot] = _groups.size();
+            return _groups.size() - 1;
+        }
+        if (_groups[groupIdx - 1].key == key) {
+            return groupIdx - 1;
+        }
+    }
+}
+
+SparseTensorOverlapIndex::SparseTensorOverlapIndex(const SparseTensor &tensor,
+                                                   const std::vector<vespalib::string> &nonOverlapping)
+    : _stash(SparseTensor::STASH_CHUNK_SIZE),
+      _slots(calcNumSlots(tensor.my_cells().size()), 0),
+      _groups(),
+      _cells(tensor.my_cells().size())
+{
+    TensorAddressReducer keyBuilder(tensor.fast_type(), nonOverlapping);
+    std::vector<uint32_t> cellGroups;
+    cellGroups.reserve(tensor.my_cells().size());
+    for (const auto &cell : tensor.my_cells()) {
+        keyBuilder.reduce(cell.first);
+        uint32_t groupIdx = findOrInsert(keyBuilder.getAddressRef());
+        ++_groups[groupIdx].size;
+        cellGroups.push_back(groupIdx);
+    }
+    uint32_t begin = 0;
+    for (auto &group : _groups) {
+        group.begin = begin;
+        begin += group.size;
+        group.size = 0;
+    }
+    size_t cellIdx = 0;
+    for (const auto &cell : tensor.my_cells()) {
+        Group &group = _groups[cellGroups[cellIdx++]];
+        _cells[group.begin + group.size++] = cell;
+    }
+}
+
+SparseTensorOverlapIndex::~SparseTensorOverlapIndex() = default;
+
+std::vector<vespalib::string>
+SparseTensorOverlapIndex::nonOverlappingDimensions(const eval::ValueType &type, const eval::ValueType &other)
+{
+    std::vector<vespalib::string> result;
+    for (const auto &dim : type.dimensions()) {
+        if (other.dimension_index(dim.name) == eval::ValueType::Dimension::npos) {
+            result.push_back(dim.name);
+        }
+    }
+    return result;
+}
+
+ConstArrayRef<SparseTensorOverlapIndex::Cell>
+SparseTensorOverlapIndex::lookup(SparseTensorAddressRef key) const
+{
+    for (uint32_t slot = key.hash() & mask(); ; slot = (slot + 1) & mask()) {
+        uint32_t groupIdx = _slots[slot];
+        if (groupIdx == 0) {
+            return ConstArrayRef<Cell>();
+        }
+        const Group &group = _groups[groupIdx - 1];
+        if (group.key == key) {
+            return ConstArrayRef<Cell>(&_cells[group.begin], group.size);
+        }
+    }
+}
+
+}
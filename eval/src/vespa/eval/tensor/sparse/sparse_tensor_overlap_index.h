@@ -0,0 +1,60 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "sparse_tensor.h"
+#include "sparse_tensor_address_reducer.h"
+#include <vespa/vespalib/util/arrayref.h>
+
+namespace vespalib::tensor::sparse {
+
+/**
+ * Index of the cells in a sparse tensor, grouped on their labels in the
+ * dimensions shared with another tensor. Joining two tensors with partial
+ * dimensional overlap can then visit only the pairs of cells with matching
+ * labels instead of all pairs.
+ *
+ * The groups are kept in a flat open addressing table keyed on the
+ * (already calculated) hash of the serialized overlap labels, and the
+ * cells of each group are stored contiguously.
+ */
+class SparseTensorOverlapIndex
+{
+public:
+    using Cell = std::pair<SparseTensorAddressRef, double>;
+private:
+    struct Group {
+        SparseTensorAddressRef key;
+        uint32_t begin;
+        uint32_t size;
+        Group(SparseTensorAddressRef key_in) : key(key_in), begin(0), size(0) {}
+    };
+    Stash                 _stash;
+    std::vector<uint32_t> _slots;
+    std::vector<Group>    _groups;
+    std::vector<Cell>     _cells;
+
+    uint32_t mask() const { return _slots.size() - 1; }
+    uint32_t findOrInsert(SparseTensorAddressRef key);
+public:
+    /**
+     * Index the cells of the given tensor on all its dimensions except
+     * the ones listed in nonOverlapping.
+     */
+    SparseTensorOverlapIndex(const SparseTensor &tensor, const std::vector<vespalib::string> &nonOverlapping);
+    ~SparseTensorOverlapIndex();
+
+    /**
+     * Returns the cells with the given labels in the overlapping dimensions.
+     * The key is an address with only those dimensions, as produced by a
+     * TensorAddressReducer removing the non-overlapping dimensions of the
+     * other tensor.
+     */
+    ConstArrayRef<Cell> lookup(SparseTensorAddressRef key) const;
+    size_t numGroups() const { return _groups.size(); }
+
+    static std::vector<vespalib::string> nonOverlappingDimensions(const eval::ValueType &type,
+                                                                  const eval::ValueType &other);
+};
+
+}
@@ -60,6 +60,18 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if this attribute is allowed to be paged out to disk.
+     * If so, parts of its data structures are allocated in swap files.
+     */
+    bool paged() const { return _paged; }
+
+    /**
+     * Check if a docid index sorted by value should be kept for this attribute.
+     * Only used for single value numeric attributes without fast-search.
+     */
+    bool sortedIndex() const { return _sortedIndex; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     Config & setHuge(bool v)                         { _huge = v; return *this;}
@@ -110,6 +122,8 @@ public:
 
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
+    Config & setPaged(bool v) { _paged = v; return *this; }
+    Config & setSortedIndex(bool v) { _sortedIndex = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -125,6 +139,8 @@ private:
     bool           _isFilter;
     bool           _fastAccess;
     bool           _mutable;
+    bool           _paged;
+    bool           _sortedIndex;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
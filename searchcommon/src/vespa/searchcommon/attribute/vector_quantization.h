@@ -0,0 +1,14 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+namespace search::attribute {
+
+/**
+ * Compressed representation of the vectors kept alongside a nearest neighbor index.
+ * The compressed vectors are used during graph traversal, while the final candidates
+ * are re-scored against the original cells.
+ */
+enum class VectorQuantization { None, Int8, Product };
+
+}
@@ -128,7 +128,8 @@ Schema::Field::operator!=(const Field &rhs) const
 Schema::IndexField::IndexField(vespalib::stringref name, DataType dt)
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _bit_packed_doc_ids(false)
 {
 }
 
@@ -136,14 +137,16 @@ Schema::IndexField::IndexField(vespalib::stringref name, DataType dt,
                                CollectionType ct)
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _bit_packed_doc_ids(false)
 {
 }
 
 Schema::IndexField::IndexField(const std::vector<vespalib::string> &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _bit_packed_doc_ids(ConfigParser::parse<bool>("bitpackeddocids", lines, false))
 {
 }
 
@@ -158,6 +161,7 @@ Schema::IndexField::write(vespalib::asciistream & os, vespalib::stringref prefix
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "bitpackeddocids " << (_bit_packed_doc_ids ? "true" : "false") << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -170,7 +174,8 @@ Schema::IndexField::operator==(const IndexField &rhs) const
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _bit_packed_doc_ids == rhs._bit_packed_doc_ids;
 }
 
 bool
@@ -178,7 +183,8 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _bit_packed_doc_ids != rhs._bit_packed_doc_ids;
 }
 
 Schema::FieldSet::FieldSet(const std::vector<vespalib::string> & lines) :
@@ -81,6 +81,7 @@ public:
         uint32_t _avgElemLen;
         // TODO: Remove when posting list format with interleaved features is made default
         bool _interleaved_features;
+        bool _bit_packed_doc_ids;
 
     public:
         IndexField(vespalib::stringref name, DataType dt);
@@ -99,12 +100,17 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_bit_packed_doc_ids(bool value) {
+            _bit_packed_doc_ids = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    vespalib::stringref prefix) const override;
 
         uint32_t getAvgElemLen() const { return _avgElemLen; }
         bool use_interleaved_features() const { return _interleaved_features; }
+        bool use_bit_packed_doc_ids() const { return _bit_packed_doc_ids; }
 
         bool operator==(const IndexField &rhs) const;
         bool operator!=(const IndexField &rhs) const;
@@ -25,6 +25,7 @@
 #include <vespa/searchcore/proton/server/summaryadapter.h>
 #include <vespa/searchcore/proton/matching/querylimiter.h>
 #include <vespa/searchlib/common/gatecallback.h>
+#include <vespa/searchlib/docstore/cachestats.h>
 #include <vespa/searchlib/engine/docsumapi.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
@@ -475,6 +476,54 @@ TEST_F("requireThatAdapterHandlesMultipleDocuments", Fixture)
 }
 
 
+TEST_F("requireThatAdapterPrefetchesDocumentsThroughTheDocumentCache", Fixture)
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").startSummaryField("a").addInt(1000).endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").startSummaryField("a").addInt(2000).endField();
+    bc.endDocument(1);
+
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, f.getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(f.getResultConfig())->getFieldCache("class1"),
+                             f.getMarkupFields(), true);
+    dsa.prefetch({0, 1, 2});
+    CacheStats stats = bc._str.getCacheStats();
+    EXPECT_EQUAL(0u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+    EXPECT_EQUAL(2u, stats.elements);
+    EXPECT_EQUAL(1000u, getResult(dsa, 0)->GetEntry("a")->_intval);
+    EXPECT_EQUAL(2000u, getResult(dsa, 1)->GetEntry("a")->_intval);
+    EXPECT_TRUE(dsa.getMappedDocsum(2).pt() == nullptr);
+    EXPECT_EQUAL(3u, bc._str.getCacheStats().lookups());
+    // Not prefetched again, served by the document cache.
+    EXPECT_EQUAL(1000u, getResult(dsa, 0)->GetEntry("a")->_intval);
+    EXPECT_EQUAL(1u, bc._str.getCacheStats().hits);
+}
+
+TEST_F("requireThatAdapterDoesNotPrefetchWithoutBatchPrefetch", Fixture)
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").startSummaryField("a").addInt(1000).endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").startSummaryField("a").addInt(2000).endField();
+    bc.endDocument(1);
+
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, f.getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(f.getResultConfig())->getFieldCache("class1"),
+                             f.getMarkupFields());
+    dsa.prefetch({0, 1});
+    EXPECT_EQUAL(0u, bc._str.getCacheStats().lookups());
+    EXPECT_EQUAL(2000u, getResult(dsa, 1)->GetEntry("a")->_intval);
+    EXPECT_EQUAL(1u, bc._str.getCacheStats().misses);
+}
+
 TEST_F("requireThatAdapterHandlesDocumentIdField", Fixture)
 {
     Schema s;
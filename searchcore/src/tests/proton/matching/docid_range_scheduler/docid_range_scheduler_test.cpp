@@ -305,4 +305,77 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(4, 1, 16);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 15u);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 6)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(9, 10)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(13, 14)));
+    EXPECT_EQUAL(scheduler.total_size(0), 1u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 11u);
+}
+
+TEST("require that the work stealing scheduler claims chunks of decreasing size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 2, 41);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 11)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(11, 16)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(16, 18)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(18, 20)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(20, 21)));
+    EXPECT_EQUAL(scheduler.total_size(0), 20u);
+}
+
+TEST("require that the work stealing scheduler steals the upper half of the largest unclaimed range") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 31);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 14)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(21, 24)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(14, 16)));
+    // thread 2 runs out of work: 0 has [4,11) unclaimed, 1 has [16,21) and 2 has [24,31)
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(24, 26)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 17u);
+    for (uint32_t docid = 26; docid < 31; ++docid) {
+        TEST_DO(verify_range(scheduler.next_range(2), DocidRange(docid, docid + 1)));
+    }
+    // steals [7,11) from thread 0, and claims it in chunks
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(7, 8)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 5)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 10u);
+}
+
+TEST_MT_FFF("require that the work stealing scheduler assigns each docid exactly once",
+            4, WorkStealingDocidRangeScheduler(num_threads, 1, 10001),
+            std::vector<std::vector<uint32_t>>(num_threads), TimeBomb(60))
+{
+    for (DocidRange range = f1.first_range(thread_id);
+         !range.empty();
+         range = f1.next_range(thread_id))
+    {
+        if (thread_id == 0) {
+            // slow thread that other threads should steal work from
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (uint32_t docid = range.begin; docid < range.end; ++docid) {
+            f2[thread_id].push_back(docid);
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        std::vector<uint32_t> seen(10001, 0);
+        for (const auto &docids: f2) {
+            for (uint32_t docid: docids) {
+                ++seen[docid];
+            }
+        }
+        EXPECT_EQUAL(0u, seen[0]);
+        for (uint32_t docid = 1; docid < 10001; ++docid) {
+            EXPECT_EQUAL(1u, seen[docid]);
+        }
+        EXPECT_EQUAL(0u, f1.unassigned_size());
+    }
+    EXPECT_EQUAL(f1.total_size(thread_id), f2[thread_id].size());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -172,7 +172,7 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
 
     MatchingStats::Partition subPart;
     subPart.docsCovered(7).docsMatched(3).docsRanked(2).docsReRanked(1)
-        .active_time(1.0).wait_time(0.5);
+        .active_time(1.0).wait_time(0.5).busy_time(0.75).idle_time(0.25);
     EXPECT_EQUAL(0u, subPart.softDoomed());
     EXPECT_EQUAL(0u, subPart.softDoomed(false).softDoomed());
     EXPECT_EQUAL(1u, subPart.softDoomed(true).softDoomed());
@@ -190,6 +190,10 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0.5, subPart.wait_time_min());
     EXPECT_EQUAL(1.0, subPart.active_time_max());
     EXPECT_EQUAL(0.5, subPart.wait_time_max());
+    EXPECT_EQUAL(0.75, subPart.busy_time_avg());
+    EXPECT_EQUAL(0.25, subPart.idle_time_avg());
+    EXPECT_EQUAL(1u, subPart.busy_time_count());
+    EXPECT_EQUAL(1u, subPart.idle_time_count());
 
     all1.merge_partition(subPart, 0);
     EXPECT_EQUAL(7u, all1.docidSpaceCovered());
@@ -211,6 +215,8 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0.5, all1.getPartition(0).wait_time_min());
     EXPECT_EQUAL(1.0, all1.getPartition(0).active_time_max());
     EXPECT_EQUAL(0.5, all1.getPartition(0).wait_time_max());
+    EXPECT_EQUAL(0.75, all1.getPartition(0).busy_time_avg());
+    EXPECT_EQUAL(0.25, all1.getPartition(0).idle_time_avg());
     EXPECT_EQUAL(1u, all1.getPartition(0).softDoomed());
     EXPECT_EQUAL(1000ns, all1.getPartition(0).doomOvertime());
 
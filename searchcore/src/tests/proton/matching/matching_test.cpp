@@ -98,6 +98,16 @@ vespalib::string make_same_element_stack_dump(const vespalib::string &a1_term, c
     return StackDumpCreator::create(*builder.build());
 }
 
+vespalib::string make_wand_stack_dump(const vespalib::string &field, const vespalib::string &common_term,
+                                      const vespalib::string &rare_term, uint32_t target_hits)
+{
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addWandTerm(2, field, 1, search::query::Weight(1), target_hits, 0, 1.0);
+    builder.addStringTerm(common_term, field, 2, search::query::Weight(1));
+    builder.addStringTerm(rare_term, field, 3, search::query::Weight(1));
+    return StackDumpCreator::create(*builder.build());
+}
+
 //-----------------------------------------------------------------------------
 
 const uint32_t NUM_DOCS = 1000;
@@ -240,6 +250,20 @@ struct MyWorld {
         searchContext.attr().addResult("a1", term, result);
     }
 
+    void add_wand_results(const vespalib::string &common_term, const vespalib::string &rare_term) {
+        // once the first hits are scored, the common term alone can not reach the wand threshold
+        FakeResult common_result;
+        FakeResult rare_result;
+        for (uint32_t i = 2; i < NUM_DOCS; i += 2) {
+            common_result.doc(i).weight(1);
+        }
+        for (uint32_t i = 2; i <= 40; i += 2) {
+            rare_result.doc(i).weight(1000);
+        }
+        searchContext.attr().addResult("a1", common_term, common_result.minMax(1, 1));
+        searchContext.attr().addResult("a1", rare_term, rare_result.minMax(1000, 1000));
+    }
+
     void add_same_element_results(const vespalib::string &my_a1_term, const vespalib::string &my_f1_0_term) {
         auto my_a1_result   = make_elem_result({{10, {1}}, {20, {2, 3}}, {21, {2}}});
         auto my_f1_0_result = make_elem_result({{10, {2}}, {20, {1, 2}}, {21, {2}}});
@@ -475,6 +499,29 @@ TEST("require that ranking is performed (multi-threaded)") {
     }
 }
 
+TEST("require that batch ranking gives the same parallel wand result as ranking each hit") {
+    SearchReply::UP reply[2];
+    for (bool batch: {false, true}) {
+        MyWorld world;
+        world.basicSetup();
+        world.add_wand_results("common", "rare");
+        // a constant score can be batched, the (extended) a1 attribute makes ranking fall back to each hit
+        world.set_property(indexproperties::rank::FirstPhase::NAME,
+                           batch ? "value(1)" : "rankingExpression(\"attribute(a1)*0+1\")");
+        SearchRequest::SP request = world.createRequest(make_wand_stack_dump("a1", "common", "rare", 10));
+        reply[batch] = world.performSearch(request, 1);
+        // the wand threshold is raised by the scores of unpacked hits
+        EXPECT_LESS(world.matchingStats.docsMatched(), 100u);
+    }
+    EXPECT_EQUAL(reply[0]->totalHitCount, reply[1]->totalHitCount);
+    ASSERT_EQUAL(reply[0]->hits.size(), reply[1]->hits.size());
+    EXPECT_EQUAL(10u, reply[1]->hits.size());
+    for (size_t i = 0; i < reply[1]->hits.size(); ++i) {
+        EXPECT_EQUAL(reply[0]->hits[i].gid, reply[1]->hits[i].gid);
+        EXPECT_EQUAL(reply[0]->hits[i].metric, reply[1]->hits[i].metric);
+    }
+}
+
 TEST("require that re-ranking is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -14,6 +14,7 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
 
 #include <vespa/log/log.h>
@@ -36,12 +37,16 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     std::shared_ptr<const DocumentTypeRepo> repo_sp;
     int remove_handled;
+    std::vector<SerialNum> removed_serials;
 
     MyFeedView();
     ~MyFeedView() override;
 
     const std::shared_ptr<const DocumentTypeRepo> &getDocumentTypeRepo() const override { return repo_sp; }
-    void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handleRemove(FeedToken , const RemoveOperation &op) override {
+        ++remove_handled;
+        removed_serials.push_back(op.getSerialNum());
+    }
 };
 
 MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
@@ -67,6 +72,7 @@ struct Fixture
     MemoryConfigStore config_store;
     BucketDBOwner _bucketDB;
     bucketdb::BucketDBHandler _bucketDBHandler;
+    vespalib::ThreadStackExecutor decode_executor;
     ReplayTransactionLogState state;
 
     Fixture();
@@ -81,7 +87,8 @@ Fixture::Fixture()
       config_store(),
       _bucketDB(),
       _bucketDBHandler(_bucketDB),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store)
+      decode_executor(4, 128 * 1024),
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, decode_executor)
 {
 }
 Fixture::~Fixture() = default;
@@ -94,18 +101,20 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    explicit RemoveOperationContext(search::SerialNum serial);
+    explicit RemoveOperationContext(search::SerialNum serial, size_t num_entries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, size_t num_entries)
     : doc_id("id:ns:doctypename::bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet(std::make_unique<Packet>(0xf000))
 {
     op.serialize(str);
     ConstBufferRef buf(str.data(), str.wp());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (size_t i = 0; i < num_entries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() = default;
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -137,6 +146,20 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that entries decoded in parallel are replayed in serial number order", Fixture)
+{
+    RemoveOperationContext opCtx(10, 1000);
+    auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, nullptr);
+    InstantExecutor executor;
+
+    f.state.receive(wrap, executor);
+    EXPECT_EQUAL(1000, f.feed_view1.remove_handled);
+    ASSERT_EQUAL(1000u, f.feed_view1.removed_serials.size());
+    for (size_t i = 0; i < f.feed_view1.removed_serials.size(); ++i) {
+        EXPECT_EQUAL(10u + i, f.feed_view1.removed_serials[i]);
+    }
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -136,6 +136,16 @@ logAttributeTooOld(const AttributeHeader &header, uint64_t flushedSerialNum, uin
         header.getFileName().c_str(), flushedSerialNum, serialNum);
 }
 
+bool
+use_executor_for_load(const AttributeVector &attr)
+{
+    // Building a nearest neighbor index while loading is costly and can be spread across multiple threads.
+    const auto &cfg = attr.getConfig();
+    return (cfg.basicType().type() == BasicType::Type::TENSOR &&
+            cfg.hnsw_index_params().has_value() &&
+            cfg.hnsw_index_params().value().multi_threaded_indexing());
+}
+
 void
 logAttributeWrongType(const AttributeVector::SP &attr, const AttributeHeader &header)
 {
@@ -193,7 +203,7 @@ AttributeInitializer::loadAttribute(const AttributeVectorSP &attr,
     assert(attr->hasLoadData());
     vespalib::Timer timer;
     EventLogger::loadAttributeStart(_documentSubDbName, attr->getName());
-    if (!attr->load()) {
+    if (!attr->load(use_executor_for_load(*attr) ? _shared_executor : nullptr)) {
         LOG(warning, "Could not load attribute vector '%s' from disk. Returning empty attribute vector",
             attr->getBaseFileName().c_str());
         return false;
@@ -234,12 +244,14 @@ AttributeInitializer::AttributeInitializer(const std::shared_ptr<AttributeDirect
                                            const vespalib::string &documentSubDbName,
                                            const AttributeSpec &spec,
                                            uint64_t currentSerialNum,
-                                           const IAttributeFactory &factory)
+                                           const IAttributeFactory &factory,
+                                           vespalib::Executor *shared_executor)
     : _attrDir(attrDir),
       _documentSubDbName(documentSubDbName),
       _spec(spec),
       _currentSerialNum(currentSerialNum),
       _factory(factory),
+      _shared_executor(shared_executor),
       _header(),
       _header_ok(false)
 {
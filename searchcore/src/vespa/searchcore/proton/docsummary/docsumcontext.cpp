@@ -61,6 +61,23 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocuments(const IDocsumWriter::ResolveClassInfo & rci)
+{
+    if (rci.mustSkip || rci.allGenerated) {
+        return;
+    }
+    std::vector<uint32_t> docIds;
+    docIds.reserve(_docsumState._docsumcnt);
+    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    _docsumStore.prefetch(docIds);
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,6 +87,7 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocuments(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -107,13 +125,14 @@ vespalib::Slime::UP
 DocsumContext::createSlimeReply()
 {
     _docsumWriter.InitState(_attrMgr, &_docsumState);
+    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
+                                                                         _docsumStore.getSummaryClassId());
+    prefetchDocuments(rci);
     const size_t estimatedChunkSize(std::min(0x200000ul, _docsumState._docsumcnt*0x400ul));
     vespalib::Slime::UP response(std::make_unique<vespalib::Slime>(makeSlimeParams(estimatedChunkSize)));
     Cursor & root = response->setObject();
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
-    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
-                                                                         _docsumStore.getSummaryClassId());
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
         uint32_t docId = _docsumState._docsumbuf[i];
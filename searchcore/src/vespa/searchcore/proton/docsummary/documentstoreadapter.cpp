@@ -7,6 +7,7 @@
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -21,6 +22,21 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+class PrefetchVisitor : public search::IDocumentVisitor
+{
+public:
+    explicit PrefetchVisitor(vespalib::hash_map<uint32_t, Document::UP> &documents)
+        : _documents(documents)
+    { }
+    void visit(uint32_t lid, Document::UP doc) override {
+        _documents[lid] = std::move(doc);
+    }
+    bool allowVisitCaching() const override { return false; }
+    bool allowDocumentCaching() const override { return true; }
+private:
+    vespalib::hash_map<uint32_t, Document::UP> &_documents;
+};
+
 }
 
 bool
@@ -149,7 +165,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const ResultConfig & resultConfig,
                      const vespalib::string & resultClassName,
                      const FieldCache::CSP & fieldCache,
-                     const std::set<vespalib::string> &markupFields)
+                     const std::set<vespalib::string> &markupFields,
+                     bool batchPrefetch)
     : _docStore(docStore),
       _repo(repo),
       _resultConfig(resultConfig),
@@ -157,7 +174,9 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                    LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _batchPrefetch(batchPrefetch),
+      _prefetched()
 {
 }
 
@@ -170,7 +189,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return DocsumStoreValue();
@@ -186,4 +212,20 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen, std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    _prefetched.clear();
+    if ( ! _batchPrefetch || (docIds.size() < 2)) {
+        return;
+    }
+    _prefetched.resize(docIds.size() * 2);
+    // Requested docs missing from the store are left as empty entries to avoid reading them again.
+    for (uint32_t docId : docIds) {
+        _prefetched[docId];
+    }
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.visit(docIds, _repo, visitor);
+}
+
 } // namespace proton
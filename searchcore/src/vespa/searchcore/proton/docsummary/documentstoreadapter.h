@@ -8,6 +8,7 @@
 #include <vespa/searchsummary/docsummary/resultpacker.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
@@ -21,6 +22,8 @@ private:
     search::docsummary::ResultPacker         _resultPacker;
     FieldCache::CSP                          _fieldCache;
     const std::set<vespalib::string>       & _markupFields;
+    bool                                     _batchPrefetch;
+    vespalib::hash_map<uint32_t, document::Document::UP> _prefetched;
 
     bool
     writeStringField(const char * buf,
@@ -40,7 +43,8 @@ public:
                          const search::docsummary::ResultConfig &resultConfig,
                          const vespalib::string &resultClassName,
                          const FieldCache::CSP &fieldCache,
-                         const std::set<vespalib::string> &markupFields);
+                         const std::set<vespalib::string> &markupFields,
+                         bool batchPrefetch = false);
     ~DocumentStoreAdapter();
 
     const search::docsummary::ResultClass *getResultClass() const {
@@ -49,6 +53,7 @@ public:
 
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t> & docIds) override;
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
@@ -83,7 +83,7 @@ SummaryManager::SummarySetup::
 SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName, const SummaryConfig & summaryCfg,
              const SummarymapConfig & summarymapCfg, const JuniperrcConfig & juniperCfg,
              search::IAttributeManager::SP attributeMgr, search::IDocumentStore::SP docStore,
-             std::shared_ptr<const DocumentTypeRepo> repo)
+             std::shared_ptr<const DocumentTypeRepo> repo, bool batchPrefetch)
     : _docsumWriter(),
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _juniperProps(juniperCfg),
@@ -92,7 +92,8 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
       _docStore(std::move(docStore)),
       _fieldCacheRepo(),
       _repo(repo),
-      _markupFields()
+      _markupFields(),
+      _batchPrefetch(batchPrefetch)
 {
     auto resultConfig = std::make_unique<ResultConfig>();
     if (!resultConfig->ReadConfig(summaryCfg, make_string("SummaryManager(%s)", baseDir.c_str()).c_str())) {
@@ -133,7 +134,8 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
 IDocsumStore::UP
 SummaryManager::SummarySetup::createDocsumStore(const vespalib::string &resultClassName) {
     return std::make_unique<DocumentStoreAdapter>(*_docStore, *_repo, getResultConfig(), resultClassName,
-                                                  _fieldCacheRepo->getFieldCache(resultClassName), _markupFields);
+                                                  _fieldCacheRepo->getFieldCache(resultClassName), _markupFields,
+                                                  _batchPrefetch);
 }
 
 
@@ -143,7 +145,7 @@ SummaryManager::createSummarySetup(const SummaryConfig & summaryCfg, const Summa
                                    const search::IAttributeManager::SP &attributeMgr)
 {
     return std::make_shared<SummarySetup>(_baseDir, _docTypeName, summaryCfg, summarymapCfg,
-                                          juniperCfg, attributeMgr, _docStore, repo);
+                                          juniperCfg, attributeMgr, _docStore, repo, _batchPrefetch);
 }
 
 SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDocumentStore::Config & storeConfig,
@@ -155,7 +157,8 @@ SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDoc
       _docTypeName(docTypeName),
       _docStore(),
       _tuneFileSummary(tuneFileSummary),
-      _currentSerial(0u)
+      _currentSerial(0u),
+      _batchPrefetch(storeConfig.getLogConfig().getReadConcurrency() > 1)
 {
     _docStore = std::make_shared<LogDocumentStore>(executor, baseDir, storeConfig, growStrategy, tuneFileSummary,
                                                    fileHeaderContext, tlSyncer, std::move(bucketizer));
@@ -34,6 +34,7 @@ public:
         FieldCacheRepo::UP                    _fieldCacheRepo;
         const std::shared_ptr<const document::DocumentTypeRepo>  _repo;
         std::set<vespalib::string>            _markupFields;
+        bool                                  _batchPrefetch;
     public:
         SummarySetup(const vespalib::string & baseDir,
                      const DocTypeName & docTypeName,
@@ -42,7 +43,8 @@ public:
                      const vespa::config::search::summary::JuniperrcConfig & juniperCfg,
                      search::IAttributeManager::SP attributeMgr,
                      search::IDocumentStore::SP docStore,
-                     std::shared_ptr<const document::DocumentTypeRepo> repo);
+                     std::shared_ptr<const document::DocumentTypeRepo> repo,
+                     bool batchPrefetch);
 
         search::docsummary::IDocsumWriter & getDocsumWriter() const override { return *_docsumWriter; }
         search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
@@ -60,6 +62,7 @@ private:
     std::shared_ptr<search::IDocumentStore> _docStore;
     const search::TuneFileSummary  _tuneFileSummary;
     uint64_t                       _currentSerial;
+    bool                           _batchPrefetch; // Only worth it when chunks are read concurrently
 
 public:
     typedef std::shared_ptr<SummaryManager> SP;
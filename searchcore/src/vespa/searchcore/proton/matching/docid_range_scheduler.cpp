@@ -160,4 +160,91 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::claim(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    uint64_t old_todo = worker.todo.load(std::memory_order_relaxed);
+    for (;;) {
+        DocidRange todo = unpack(old_todo);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        // Large chunks keep the number of (search iterator) range
+        // initializations down, while the unclaimed remainder stays
+        // available for stealing.
+        size_t chunk = std::min(todo.size(), std::max(size_t(_min_task), todo.size() / _workers.size()));
+        DocidRange range(todo.begin, todo.begin + chunk);
+        if (worker.todo.compare_exchange_weak(old_todo, pack(DocidRange(range.end, todo.end)))) {
+            worker.assigned += range.size();
+            return range;
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_todo = 0;
+        size_t max_size = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            uint64_t todo = _workers[i].todo.load(std::memory_order_relaxed);
+            if (unpack(todo).size() > max_size) {
+                victim = i;
+                victim_todo = todo;
+                max_size = unpack(todo).size();
+            }
+        }
+        if ((max_size < (2 * _min_task)) || (max_size < 2)) {
+            // the owners will finish the small remaining ranges themselves
+            return false;
+        }
+        DocidRange todo = unpack(victim_todo);
+        uint32_t split = todo.begin + (todo.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(victim_todo, pack(DocidRange(todo.begin, split)))) {
+            // the stolen range can be stolen from us in turn
+            _workers[thread_id].todo.store(pack(DocidRange(split, todo.end)), std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(_splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    do {
+        DocidRange range = claim(thread_id);
+        if (!range.empty()) {
+            return range;
+        }
+    } while (steal(thread_id));
+    return DocidRange();
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
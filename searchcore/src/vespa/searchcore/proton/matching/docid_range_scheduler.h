@@ -204,4 +204,47 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A work-stealing scheduler that begins by giving each thread an
+ * equal part of the docid space. Each thread claims its part in
+ * chunks of decreasing size. A thread running out of work steals
+ * the upper half of the unclaimed part belonging to the thread with
+ * the most unclaimed work, without any cooperation from that
+ * thread. This keeps threads busy even when the busy thread is stuck
+ * in long seeks or spends a long time ranking clustered hits.
+ *
+ * Claiming and stealing is lock-free (one compare-and-swap per
+ * range) and idle threads never block. Since ranges are handed out
+ * in chunks, workers must support processing docid ranges in
+ * non-increasing order, like with the adaptive scheduler.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    // Unclaimed docid range owned by a single thread, packed as (begin << 32) | end
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        Worker() : todo(0), assigned(0) {}
+    };
+    DocidRangeSplitter  _splitter;
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    static uint64_t pack(DocidRange range) { return ((uint64_t(range.begin) << 32) | range.end); }
+    static DocidRange unpack(uint64_t value) { return DocidRange(uint32_t(value >> 32), uint32_t(value)); }
+    VESPA_DLL_LOCAL DocidRange claim(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 }
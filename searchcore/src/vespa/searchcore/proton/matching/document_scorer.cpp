@@ -7,6 +7,7 @@ using search::feature_t;
 using search::fef::FeatureResolver;
 using search::fef::RankProgram;
 using search::fef::LazyValue;
+using search::queryeval::HitCollector;
 using search::queryeval::SearchIterator;
 
 namespace proton::matching {
@@ -26,7 +27,8 @@ extractScoreFeature(const RankProgram &rankProgram)
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _useBatch(rankProgram.can_batch_seeds())
 {
 }
 
@@ -36,4 +38,14 @@ DocumentScorer::score(uint32_t docId)
     return doScore(docId);
 }
 
+void
+DocumentScorer::score_batch(vespalib::ConstArrayRef<uint32_t> docIds, vespalib::ArrayRef<feature_t> scores)
+{
+    if (_useBatch) {
+        _scoreFeature.as_numbers(docIds, scores);
+    } else {
+        HitCollector::DocumentScorer::score_batch(docIds, scores);
+    }
+}
+
 }
@@ -12,12 +12,15 @@ namespace proton::matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking match data.
  * The calculateScore() function is always called in increasing docId order.
+ * When the rank program supports batch evaluation, documents are scored
+ * in batch without unpacking match data.
  */
 class DocumentScorer : public search::queryeval::HitCollector::DocumentScorer
 {
 private:
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    bool _useBatch;
 
 public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
@@ -29,6 +32,7 @@ public:
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+    void score_batch(vespalib::ConstArrayRef<uint32_t> docIds, vespalib::ArrayRef<search::feature_t> scores) override;
 };
 
 }
@@ -75,17 +75,43 @@ MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollec
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _use_batch_ranking(tools.rank_program().can_batch_seeds()),
+      _batch_docids(),
+      _batch_scores(),
       _ranking(tools.rank_program()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom())
 {
+    if (_use_batch_ranking) {
+        _batch_docids.reserve(batch_size);
+        _batch_scores.reserve(batch_size);
+    }
 }
 
 template <bool use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    addScoredHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::rankBatch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _batch_scores.resize(_batch_docids.size());
+    _score_feature.as_numbers(_batch_docids, _batch_scores);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addScoredHit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::addScoredHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -150,6 +176,15 @@ MatchThread::try_share(DocidRange &docid_range, uint32_t next_docid) {
     return false;
 }
 
+DocidRange
+MatchThread::next_range(double &idle_time_s)
+{
+    WaitTimer next_range_timer(idle_time_s);
+    DocidRange docid_range = scheduler.next_range(thread_id);
+    next_range_timer.done();
+    return docid_range;
+}
+
 template <typename Strategy, bool do_rank, bool do_limit, bool do_share_work, bool use_rank_drop_limit>
 uint32_t
 MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &docid_range)
@@ -159,8 +194,13 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
+            // unpack may update iterator state (like the wand threshold), even when ranking does not use match data
             search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.useBatchRanking()) {
+                context.batchRankHit<use_rank_drop_limit>(docId);
+            } else {
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -175,6 +215,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.rankBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -186,10 +229,13 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
     Context context(matchParams.rankDropLimit, tools, hits, num_threads);
-    for (DocidRange docid_range = scheduler.first_range(thread_id);
-         !docid_range.empty();
-         docid_range = scheduler.next_range(thread_id))
-    {
+    double idle_time_s = 0.0;
+    const double wait_time_before_s = wait_time_s;
+    vespalib::Timer match_loop_time;
+    WaitTimer first_range_timer(idle_time_s);
+    DocidRange docid_range = scheduler.first_range(thread_id);
+    first_range_timer.done();
+    for (; !docid_range.empty(); docid_range = next_range(idle_time_s)) {
         if (!softDoomed) {
             uint32_t lastCovered = inner_match_loop<Strategy, do_rank, do_limit, do_share_work, use_rank_drop_limit>(context, tools, docid_range);
             softDoomed = (lastCovered < docid_range.end);
@@ -199,6 +245,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
             docsCovered += std::min(lastCovered, docid_range.end) - docid_range.begin;
         }
     }
+    // waiting for other threads when limiting matches is neither busy nor idle time
+    double busy_time_s = vespalib::to_s(match_loop_time.elapsed()) - idle_time_s - (wait_time_s - wait_time_before_s);
     uint32_t matches = context.matches;
     if (do_limit && context.isBelowLimit()) {
         const size_t searchedSoFar = scheduler.total_size(thread_id);
@@ -207,6 +255,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
         estimate_match_frequency(matches, searchedSoFar);
         tools.match_limiter().updateDocIdSpaceEstimate(searchedSoFar, 0);
     }
+    thread_stats.busy_time(busy_time_s).idle_time(idle_time_s);
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
@@ -448,6 +497,7 @@ MatchThread::run()
     total_time_s = vespalib::to_s(total_time.elapsed());
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
     trace->addEvent(4, "Start thread merge");
+    resultProcessor.mergeGrouping(thread_id, *resultContext);
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
     trace->addEvent(4, "MatchThread::run Done");
 }
@@ -70,6 +70,16 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <bool use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <bool use_rank_drop_limit>
+        void batchRankHit(uint32_t docId) {
+            _batch_docids.push_back(docId);
+            if (__builtin_expect(_batch_docids.size() == batch_size, false)) {
+                rankBatch<use_rank_drop_limit>();
+            }
+        }
+        template <bool use_rank_drop_limit>
+        void rankBatch();
+        bool useBatchRanking() const { return _use_batch_ranking; }
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -77,8 +87,14 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        static constexpr size_t batch_size = 256;
+        template <bool use_rank_drop_limit>
+        void addScoredHit(uint32_t docId, double score);
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        bool            _use_batch_ranking;
+        std::vector<uint32_t> _batch_docids;
+        std::vector<search::feature_t> _batch_scores;
         RankProgram    &_ranking;
         double          _rankDropLimit;
         HitCollector   &_hits;
@@ -90,6 +106,7 @@ private:
 
     bool any_idle() const { return (idle_observer.get() > 0); }
     bool try_share(DocidRange &docid_range, uint32_t next_docid) __attribute__((noinline));
+    DocidRange next_range(double &idle_time_s) __attribute__((noinline));
 
     template <typename Strategy, bool do_rank, bool do_limit, bool do_share_work, bool use_rank_drop_limit>
     uint32_t inner_match_loop(Context &context, MatchTools &tools, DocidRange &docid_range) __attribute__((noinline));
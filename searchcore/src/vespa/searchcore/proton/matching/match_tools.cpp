@@ -69,7 +69,8 @@ extractDiversityParams(const RankSetup &rankSetup, const Properties &rankPropert
 AttributeBlueprintParams
 extractAttributeBlueprintParams(const RankSetup& rank_setup, const Properties &rankProperties)
 {
-    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()));
+    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()),
+                                    NearestNeighborExploreKMaxAdjustmentFactor::lookup(rankProperties, rank_setup.get_nearest_neighbor_explore_k_max_adjustment_factor()));
 }
 
 } // namespace proton::matching::<unnamed>
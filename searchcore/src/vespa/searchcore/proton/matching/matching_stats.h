@@ -65,6 +65,8 @@ public:
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
+        Avg    _busy_time;
+        Avg    _idle_time;
         friend MatchingStats;
     public:
         Partition()
@@ -75,7 +77,9 @@ public:
               _softDoomed(0),
               _doomOvertime(),
               _active_time(),
-              _wait_time() { }
+              _wait_time(),
+              _busy_time(),
+              _idle_time() { }
 
         Partition &docsCovered(size_t value) { _docsCovered = value; return *this; }
         size_t docsCovered() const { return _docsCovered; }
@@ -100,6 +104,17 @@ public:
         size_t wait_time_count() const { return _wait_time.count(); }
         double wait_time_min() const { return _wait_time.min(); }
         double wait_time_max() const { return _wait_time.max(); }
+        // Time spent matching docid ranges, and time spent waiting for the scheduler to hand out more of them
+        Partition &busy_time(double time_s) { _busy_time.set(time_s); return *this; }
+        double busy_time_avg() const { return _busy_time.avg(); }
+        size_t busy_time_count() const { return _busy_time.count(); }
+        double busy_time_min() const { return _busy_time.min(); }
+        double busy_time_max() const { return _busy_time.max(); }
+        Partition &idle_time(double time_s) { _idle_time.set(time_s); return *this; }
+        double idle_time_avg() const { return _idle_time.avg(); }
+        size_t idle_time_count() const { return _idle_time.count(); }
+        double idle_time_min() const { return _idle_time.min(); }
+        double idle_time_max() const { return _idle_time.max(); }
 
         Partition &add(const Partition &rhs) {
             _docsCovered += rhs.docsCovered();
@@ -111,6 +126,8 @@ public:
 
             _active_time.add(rhs._active_time);
             _wait_time.add(rhs._wait_time);
+            _busy_time.add(rhs._busy_time);
+            _idle_time.add(rhs._idle_time);
             return *this;
         }
     };
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/common/geo_location_parser.h>
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/multibitvectoriterator.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.query");
@@ -246,6 +247,7 @@ Query::handle_global_filters(uint32_t docid_limit, double global_filter_limit)
         auto constraint = Blueprint::FilterConstraint::UPPER_BOUND;
         bool strict = true;
         auto filter_iterator = _blueprint->createFilterSearch(strict, constraint);
+        filter_iterator = search::queryeval::MultiBitVectorIteratorBase::optimize(std::move(filter_iterator));
         filter_iterator->initRange(1, docid_limit);
         auto white_list = filter_iterator->get_hits(1);
         auto global_filter = GlobalFilter::create(std::move(white_list));
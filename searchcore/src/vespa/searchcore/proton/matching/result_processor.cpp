@@ -8,6 +8,8 @@
 #include <vespa/searchlib/common/docstamp.h>
 #include <vespa/searchlib/uca/ucaconverter.h>
 #include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <vespa/vespalib/util/rendezvous.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.result_processor");
@@ -16,6 +18,7 @@ using search::attribute::IAttributeContext;
 using search::grouping::GroupingSession;
 using search::grouping::GroupingContext;
 using search::grouping::SessionId;
+using search::aggregation::Group;
 
 namespace proton::matching {
 
@@ -55,6 +58,83 @@ ResultProcessor::GroupingSource::merge(Source &s) {
     }
 }
 
+class ResultProcessor::GroupingMerger
+{
+private:
+    struct ThreadState {
+        size_t                          thread_id;
+        GroupingContext                &ctx;
+        std::vector<std::vector<Group>> partitions; // [grouping][partition]
+        std::vector<Group>              merged;     // [grouping]
+        ThreadState(size_t thread_id_in, GroupingContext &ctx_in)
+            : thread_id(thread_id_in), ctx(ctx_in), partitions(), merged() {}
+    };
+    using States = std::vector<ThreadState *>;
+
+    struct Exchange : vespalib::Rendezvous<ThreadState *, States> {
+        Exchange(size_t n) : vespalib::Rendezvous<ThreadState *, States>(n) {}
+        void mingle() override {
+            States all(size());
+            for (size_t i = 0; i < size(); ++i) {
+                all[in(i)->thread_id] = in(i);
+            }
+            for (size_t i = 0; i < size(); ++i) {
+                out(i) = all;
+            }
+        }
+    };
+
+    struct Combine : vespalib::Rendezvous<ThreadState *, bool> {
+        Combine(size_t n) : vespalib::Rendezvous<ThreadState *, bool>(n) {}
+        void mingle() override {
+            States all(size());
+            for (size_t i = 0; i < size(); ++i) {
+                all[in(i)->thread_id] = in(i);
+                out(i) = true;
+            }
+            GroupingContext::GroupingList &list = all[0]->ctx.getGroupingList();
+            for (size_t g = 0; g < list.size(); ++g) {
+                std::vector<Group *> merged;
+                for (ThreadState *state : all) {
+                    if (state != all[0]) {
+                        list[g]->merge(*state->ctx.getGroupingList()[g]);
+                    }
+                    merged.push_back(&state->merged[g]);
+                }
+                list[g]->root().adoptChildren(merged);
+            }
+        }
+    };
+
+    size_t   _num_threads;
+    Exchange _exchange;
+    Combine  _combine;
+
+public:
+    GroupingMerger(size_t num_threads)
+        : _num_threads(num_threads),
+          _exchange(num_threads),
+          _combine(num_threads)
+    { }
+
+    void merge(size_t thread_id, GroupingContext &ctx) {
+        ThreadState state(thread_id, ctx);
+        GroupingContext::GroupingList &list = ctx.getGroupingList();
+        for (const auto &grouping : list) {
+            state.partitions.push_back(grouping->partition(_num_threads));
+        }
+        States all = _exchange.rendezvous(&state);
+        for (size_t g = 0; g < list.size(); ++g) {
+            std::vector<Group *> parts;
+            for (ThreadState *other : all) {
+                parts.push_back(&other->partitions[g][thread_id]);
+            }
+            state.merged.push_back(list[g]->mergePartition(parts));
+        }
+        _combine.rendezvous(&state);
+    }
+};
+
 ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
                                  const search::IDocumentMetaStore &metaStore,
                                  SessionManager &sessionMgr,
@@ -70,7 +150,8 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
       _sortSpec(sortSpec),
       _offset(offset),
       _hits(hits),
-      _wasMerged(false)
+      _wasMerged(false),
+      _groupingMerger()
 {
     if (!_groupingContext.empty()) {
         _groupingSession = std::make_unique<GroupingSession>(sessionId, _groupingContext, attrContext);
@@ -87,6 +168,9 @@ ResultProcessor::prepareThreadContextCreation(size_t num_threads)
     }
     if (_groupingSession) {
         _groupingSession->prepareThreadContextCreation(num_threads);
+        if (num_threads > 1) {
+            _groupingMerger = std::make_unique<GroupingMerger>(num_threads);
+        }
     }
 }
 
@@ -102,6 +186,15 @@ ResultProcessor::createThreadContext(const vespalib::Doom & hardDoom, size_t thr
     return std::make_unique<Context>(std::move(sort), std::move(result), std::move(groupingContext));
 }
 
+void
+ResultProcessor::mergeGrouping(size_t thread_id, Context &context)
+{
+    if (_groupingMerger && context.grouping) {
+        _groupingMerger->merge(thread_id, *context.grouping);
+        context.groupingSource.ctx = nullptr;
+    }
+}
+
 ResultProcessor::Result::UP
 ResultProcessor::makeReply(PartialResultUP full_result)
 {
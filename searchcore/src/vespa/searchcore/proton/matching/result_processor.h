@@ -80,6 +80,8 @@ public:
     };
 
 private:
+    class GroupingMerger;
+
     IAttributeContext                     &_attrContext;
     const search::IDocumentMetaStore      &_metaStore;
     SessionManager                        &_sessionMgr;
@@ -89,6 +91,7 @@ private:
     size_t                                 _offset;
     size_t                                 _hits;
     bool                                   _wasMerged;
+    std::unique_ptr<GroupingMerger>        _groupingMerger;
 
 public:
     ResultProcessor(IAttributeContext &attrContext,
@@ -103,6 +106,17 @@ public:
     size_t countFS4Hits();
     void prepareThreadContextCreation(size_t num_threads);
     Context::UP createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey);
+
+    /**
+     * Merge the grouping results of all threads into the grouping
+     * context of thread 0. This must be called by all threads. The
+     * first level groups are partitioned by the hash of their id, and
+     * each thread merges and prunes one partition. The grouping source
+     * of the context is cleared afterwards, since there is nothing
+     * left for the merge director to do with it.
+     **/
+    void mergeGrouping(size_t thread_id, Context &context);
+
     std::unique_ptr<Result> makeReply(PartialResultUP full_result);
 };
 
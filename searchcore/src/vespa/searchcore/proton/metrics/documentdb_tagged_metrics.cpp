@@ -60,7 +60,9 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::CacheMetrics::Cache
       elements("elements", {}, "Number of elements in the cache", this),
       hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
       lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
-      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this)
+      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this),
+      admissions("admissions", {}, "Number of elements let into the cache by the admission policy", this),
+      rejections("rejections", {}, "Number of elements kept out of the cache by the admission policy", this)
 {
 }
 
@@ -173,7 +175,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
     docsRanked("docs_ranked", {}, "Number of documents ranked (first phase)", this),
     docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
     activeTime("active_time", {}, "Time (sec) spent doing actual work", this),
-    waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this)
+    waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this),
+    busyTime("busy_time", {}, "Time (sec) spent matching docid ranges", this),
+    idleTime("idle_time", {}, "Time (sec) spent waiting for more docid ranges to match", this)
 { }
 
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::~DocIdPartition() = default;
@@ -188,6 +192,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
                            stats.wait_time_min(), stats.wait_time_max());
+    busyTime.addValueBatch(stats.busy_time_avg(), stats.busy_time_count(),
+                           stats.busy_time_min(), stats.busy_time_max());
+    idleTime.addValueBatch(stats.idle_time_avg(), stats.idle_time_count(),
+                           stats.idle_time_min(), stats.idle_time_max());
 }
 
 void
@@ -57,6 +57,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongAverageMetric hitRate;
                 metrics::LongCountMetric lookups;
                 metrics::LongCountMetric invalidations;
+                metrics::LongCountMetric admissions;
+                metrics::LongCountMetric rejections;
 
                 CacheMetrics(metrics::MetricSet *parent);
                 ~CacheMetrics() override;
@@ -126,6 +128,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongCountMetric docsReRanked;
                 metrics::DoubleAverageMetric activeTime;
                 metrics::DoubleAverageMetric waitTime;
+                metrics::DoubleAverageMetric busyTime;
+                metrics::DoubleAverageMetric idleTime;
 
                 using UP = std::unique_ptr<DocIdPartition>;
                 DocIdPartition(const vespalib::string &name, metrics::MetricSet *parent);
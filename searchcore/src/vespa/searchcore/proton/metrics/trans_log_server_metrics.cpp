@@ -13,7 +13,10 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      commitBatchSize("commit_batch_size", {}, "The number of entries written per group commit", this),
+      syncLatency("sync_latency", {}, "The time (in seconds) spent syncing a group commit to disk", this),
+      _lastStats()
 {
 }
 
@@ -25,6 +28,15 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    if (stats.numCommits > _lastStats.numCommits) {
+        commitBatchSize.set(double(stats.numCommitEntries - _lastStats.numCommitEntries) /
+                            (stats.numCommits - _lastStats.numCommits));
+    }
+    if (stats.numSyncs > _lastStats.numSyncs) {
+        syncLatency.set((stats.totalSyncTime - _lastStats.totalSyncTime).count() /
+                        (stats.numSyncs - _lastStats.numSyncs));
+    }
+    _lastStats = stats;
 }
 
 void
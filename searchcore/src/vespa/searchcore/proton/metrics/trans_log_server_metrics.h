@@ -18,11 +18,15 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::DoubleValueMetric commitBatchSize;
+        metrics::DoubleValueMetric syncLatency;
 
         typedef std::unique_ptr<DomainMetrics> UP;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
         ~DomainMetrics();
         void update(const search::transactionlog::DomainInfo &stats);
+    private:
+        search::transactionlog::DomainInfo _lastStats;
     };
 
 private:
@@ -256,6 +256,8 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
     updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.cache.hitRate);
     updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.cache.lookups);
     updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.cache.invalidations);
+    updateCountMetric(cacheStats.admissions, lastCacheStats.admissions, metrics.cache.admissions);
+    updateCountMetric(cacheStats.rejections, lastCacheStats.rejections, metrics.cache.rejections);
     lastCacheStats = cacheStats;
 }
 
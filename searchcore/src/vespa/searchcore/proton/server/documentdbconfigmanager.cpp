@@ -176,6 +176,19 @@ derive(ProtonConfig::Summary::Cache::UpdateStrategy strategy) {
     return DocumentStore::Config::UpdateStrategy::INVALIDATE;
 }
 
+vespalib::CachePolicy
+derive(ProtonConfig::Summary::Cache::Policy policy) {
+    switch (policy) {
+        case ProtonConfig::Summary::Cache::Policy::LRU:
+            return vespalib::CachePolicy::LRU;
+        case ProtonConfig::Summary::Cache::Policy::SLRU:
+            return vespalib::CachePolicy::SLRU;
+        case ProtonConfig::Summary::Cache::Policy::W_TINY_LFU:
+            return vespalib::CachePolicy::W_TINY_LFU;
+    }
+    return vespalib::CachePolicy::LRU;
+}
+
 DocumentStore::Config
 getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo)
 {
@@ -184,7 +197,8 @@ getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo
                       : cache.maxbytes;
     return DocumentStore::Config(deriveCompression(cache.compression), maxBytes, cache.initialentries)
             .allowVisitCaching(cache.allowvisitcaching)
-            .updateStrategy(derive(cache.updateStrategy));
+            .updateStrategy(derive(cache.updateStrategy))
+            .cachePolicy(derive(cache.policy));
 }
 
 LogDocumentStore::Config
@@ -199,7 +213,9 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
-            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
+            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread)
+            .setReadConcurrency(summary.read.concurrency)
+            .setCompressionDictionarySize(chunk.compression.dictionary.maxbytes);
     return LogDocumentStore::Config(config, logConfig);
 }
 
@@ -9,7 +9,7 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
-#include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/lambdatask.h>
 
 #include <vespa/log/log.h>
@@ -19,18 +19,18 @@ using search::transactionlog::Packet;
 using search::transactionlog::client::RPC;
 using search::SerialNum;
 using vespalib::Executor;
-using vespalib::makeClosure;
 using vespalib::makeLambdaTask;
-using vespalib::makeTask;
 using vespalib::make_string;
 using proton::bucketdb::IBucketDBHandler;
 
 namespace proton {
 
 namespace {
-typedef vespalib::Closure1<const Packet::Entry &>::UP EntryHandler;
+
+using OperationList = std::vector<std::unique_ptr<FeedOperation>>;
 
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
+const size_t DECODE_BATCH_SIZE = 64;
 
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
@@ -47,17 +47,93 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
     }
 }
 
+/**
+ * Decodes the entries in [begin, end) in batches. The calling thread decodes
+ * the first batch while the rest are decoded by the given executor.
+ */
+OperationList
+decodeEntries(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+              const document::DocumentTypeRepo &repo, Executor &executor)
+{
+    OperationList ops(end - begin);
+    size_t numBatches = (end - begin + DECODE_BATCH_SIZE - 1) / DECODE_BATCH_SIZE;
+    std::vector<std::exception_ptr> errors(numBatches);
+    auto decodeBatch = [&](size_t batch) {
+        try {
+            size_t batchEnd = std::min(end, begin + (batch + 1) * DECODE_BATCH_SIZE);
+            for (size_t i(begin + batch * DECODE_BATCH_SIZE); i < batchEnd; ++i) {
+                ops[i - begin] = ReplayPacketDispatcher::decodeEntry(entries[i], repo);
+            }
+        } catch (...) {
+            errors[batch] = std::current_exception();
+        }
+    };
+    vespalib::CountDownLatch latch(numBatches - 1);
+    for (size_t batch(1); batch < numBatches; ++batch) {
+        Executor::Task::UP rejected = executor.execute(makeLambdaTask([&decodeBatch, &latch, batch]() {
+            decodeBatch(batch);
+            latch.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    decodeBatch(0);
+    latch.await();
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return ops;
+}
+
 void
-handlePacket(PacketWrapper & wrap, EntryHandler entryHandler)
+replayEntry(ReplayPacketDispatcher &dispatcher, IReplayPacketHandler &packet_handler,
+            const Packet::Entry &entry, const FeedOperation *decoded)
 {
+    // Called by handlePacket() in executor thread.
+    LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
+    if (decoded != nullptr) {
+        dispatcher.replay(*decoded);
+    } else {
+        dispatcher.replayEntry(entry);
+    }
+    packet_handler.optionalCommit(entry.serial());
+}
+
+void
+handlePacket(PacketWrapper & wrap, IReplayPacketHandler &packet_handler, Executor &decode_executor)
+{
+    std::vector<Packet::Entry> entries;
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
     while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        entryHandler->call(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    ReplayPacketDispatcher dispatcher(packet_handler);
+    for (size_t i(0); i < entries.size(); ) {
+        /*
+         * New config entries might change the document type repo, so only the
+         * entries in between them are decoded ahead of being replayed.
+         */
+        size_t end(i);
+        while ((end < entries.size()) && ReplayPacketDispatcher::canDecode(entries[end])) {
+            ++end;
+        }
+        OperationList ops;
+        if (end > i) {
+            ops = decodeEntries(entries, i, end, packet_handler.getDeserializeRepo(), decode_executor);
+        } else {
+            end = i + 1;
+        }
+        for (size_t j(i); j < end; ++j) {
+            replayEntry(dispatcher, packet_handler, entries[j], ops.empty() ? nullptr : ops[j - i].get());
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entries[j].serial());
+            }
         }
+        i = end;
     }
     wrap.result = RPC::OK;
     wrap.gate.countDown();
@@ -133,15 +209,6 @@ public:
     }
 };
 
-void startDispatch(IReplayPacketHandler *packet_handler, const Packet::Entry &entry) {
-    // Called by handlePacket() in executor thread.
-    LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
-
-    ReplayPacketDispatcher dispatcher(*packet_handler);
-    dispatcher.replayEntry(entry);
-    packet_handler->optionalCommit(entry.serial());
-}
-
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -149,18 +216,21 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        Executor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store))
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store)),
+      _decode_executor(decode_executor)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
-    executor.execute(makeLambdaTask([wrap = wrap, dispatch = std::move(closure)] () mutable { handlePacket(*wrap, std::move(dispatch)); }));
+    executor.execute(makeLambdaTask([this, wrap = wrap] () {
+        handlePacket(*wrap, *_packet_handler, _decode_executor);
+    }));
 }
 
 }  // namespace proton
@@ -44,17 +44,21 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ * The entries of a packet are decoded in parallel using the decode executor,
+ * and then sent to the feed view in serial number order.
  */
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor &_decode_executor;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
             IFeedView *& feed_view_ptr,
             bucketdb::IBucketDBHandler &bucketDBHandler,
             IReplayConfig &replay_config,
-            FeedConfigStore &config_store);
+            FeedConfigStore &config_store,
+            vespalib::Executor &decode_executor);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
@@ -31,6 +31,7 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/host_name.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/random.h>
 #include <vespa/vespalib/net/state_server.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
@@ -287,6 +288,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     }
     _protonDiskLayout = std::make_unique<ProtonDiskLayout>(protonConfig.basedir, protonConfig.tlsspec);
     vespalib::chdir(protonConfig.basedir);
+    vespalib::alloc::MmapFileAllocatorFactory::instance().setup(protonConfig.basedir + "/swapfiles");
     _tls->start();
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, flush.idleinterval*1000);
@@ -4,6 +4,7 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
 
 namespace proton {
 
@@ -19,9 +20,6 @@ private:
     typedef search::transactionlog::Packet Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +28,20 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Dispatches an operation that has already been decoded by decodeEntry().
+     */
+    void replay(const FeedOperation &op);
+
+    /**
+     * Deserializes a packet entry into a feed operation without dispatching it.
+     * This has no side effects and can be done outside the thread doing the replay.
+     * New config entries must be replayed in order by replayEntry() and are not supported here.
+     */
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry,
+                                                      const document::DocumentTypeRepo &repo);
+    static bool canDecode(const Packet::Entry &entry);
 };
 
 } // namespace proton
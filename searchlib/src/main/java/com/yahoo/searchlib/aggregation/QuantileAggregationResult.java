@@ -0,0 +1,233 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * This is an aggregated result holding a t-digest sketch of the values of an expression, used to estimate quantiles
+ * such as the median or the 99th percentile. The sketch is populated by the search nodes and merged here.
+ */
+public class QuantileAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 98, QuantileAggregationResult.class);
+    private static final double DEFAULT_COMPRESSION = 100.0;
+
+    private double[] quantiles = new double[0];
+    private double compression = DEFAULT_COMPRESSION;
+    private double min = Double.POSITIVE_INFINITY;
+    private double max = Double.NEGATIVE_INFINITY;
+    // Centroids as (mean, weight) pairs, ordered by mean.
+    private List<double[]> centroids = new ArrayList<>();
+
+    @SuppressWarnings("UnusedDeclaration")
+    public QuantileAggregationResult() {
+    }
+
+    public QuantileAggregationResult setQuantiles(double... quantiles) {
+        this.quantiles = quantiles.clone();
+        return this;
+    }
+
+    public double[] getQuantiles() {
+        return quantiles.clone();
+    }
+
+    /** Adds a single value to the sketch. For test purposes, as values are normally added by the search nodes. */
+    public QuantileAggregationResult add(double value) {
+        centroids.add(new double[] { value, 1.0 });
+        min = Math.min(min, value);
+        max = Math.max(max, value);
+        compress();
+        return this;
+    }
+
+    public double getCount() {
+        double count = 0.0;
+        for (double[] c : centroids) {
+            count += c[1];
+        }
+        return count;
+    }
+
+    /**
+     * Estimates the value at the given quantile (0 &lt;= q &lt;= 1).
+     *
+     * @return the estimate, or NaN if no values have been aggregated
+     */
+    public double getQuantile(double q) {
+        if (centroids.isEmpty()) {
+            return Double.NaN;
+        }
+        if (centroids.size() == 1) {
+            return centroids.get(0)[0];
+        }
+        double index = Math.max(0.0, Math.min(1.0, q)) * getCount();
+        double[] first = centroids.get(0);
+        if (index < first[1] / 2.0) {
+            return min + (first[0] - min) * index / (first[1] / 2.0);
+        }
+        double weightSoFar = first[1] / 2.0;
+        for (int i = 0; i + 1 < centroids.size(); i++) {
+            double[] a = centroids.get(i);
+            double[] b = centroids.get(i + 1);
+            double delta = (a[1] + b[1]) / 2.0;
+            if (weightSoFar + delta > index) {
+                return a[0] + (b[0] - a[0]) * (index - weightSoFar) / delta;
+            }
+            weightSoFar += delta;
+        }
+        double[] last = centroids.get(centroids.size() - 1);
+        double z = Math.min(index - weightSoFar, last[1] / 2.0);
+        return last[0] + (max - last[0]) * z / (last[1] / 2.0);
+    }
+
+    @Override
+    public ResultNode getRank() {
+        if (centroids.isEmpty()) {
+            return new FloatResultNode(0);
+        }
+        return new FloatResultNode(getQuantile(quantiles.length > 0 ? quantiles[0] : 0.5));
+    }
+
+    @Override
+    protected void onMerge(AggregationResult result) {
+        QuantileAggregationResult other = (QuantileAggregationResult) result;
+        if (other.centroids.isEmpty()) {
+            return;
+        }
+        for (double[] c : other.centroids) {
+            centroids.add(c.clone());
+        }
+        min = Math.min(min, other.min);
+        max = Math.max(max, other.max);
+        compress();
+    }
+
+    /** Merges adjacent centroids as long as they stay within the size limit given by the arcsine scale function. */
+    private void compress() {
+        if (centroids.size() < 2) {
+            return;
+        }
+        centroids.sort(Comparator.comparingDouble(c -> c[0]));
+        double total = getCount();
+        List<double[]> merged = new ArrayList<>();
+        double[] current = centroids.get(0).clone();
+        double weightSoFar = 0.0;
+        double limit = quantileLimit(0.0);
+        for (int i = 1; i < centroids.size(); i++) {
+            double[] next = centroids.get(i);
+            if (weightSoFar + current[1] + next[1] <= limit * total) {
+                current[1] += next[1];
+                current[0] += (next[0] - current[0]) * next[1] / current[1];
+            } else {
+                weightSoFar += current[1];
+                merged.add(current);
+                limit = quantileLimit(weightSoFar / total);
+                current = next.clone();
+            }
+        }
+        merged.add(current);
+        centroids = merged;
+    }
+
+    private double quantileLimit(double q) {
+        double k = compression / (2.0 * Math.PI) * Math.asin(2.0 * q - 1.0) + 1.0;
+        if (k >= compression / 4.0) {
+            return 1.0;
+        }
+        return (Math.sin(k * 2.0 * Math.PI / compression) + 1.0) / 2.0;
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        buf.putInt(null, quantiles.length);
+        for (double q : quantiles) {
+            buf.putDouble(null, q);
+        }
+        buf.putDouble(null, compression);
+        buf.putDouble(null, min);
+        buf.putDouble(null, max);
+        buf.putInt(null, centroids.size());
+        for (double[] c : centroids) {
+            buf.putDouble(null, c[0]);
+            buf.putDouble(null, c[1]);
+        }
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        quantiles = new double[buf.getInt(null)];
+        for (int i = 0; i < quantiles.length; i++) {
+            quantiles[i] = buf.getDouble(null);
+        }
+        compression = buf.getDouble(null);
+        min = buf.getDouble(null);
+        max = buf.getDouble(null);
+        int numCentroids = buf.getInt(null);
+        centroids = new ArrayList<>(numCentroids);
+        for (int i = 0; i < numCentroids; i++) {
+            double mean = buf.getDouble(null);
+            double weight = buf.getDouble(null);
+            centroids.add(new double[] { mean, weight });
+        }
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        QuantileAggregationResult other = (QuantileAggregationResult) obj;
+        if (!Arrays.equals(quantiles, other.quantiles) || compression != other.compression ||
+            min != other.min || max != other.max || centroids.size() != other.centroids.size())
+        {
+            return false;
+        }
+        for (int i = 0; i < centroids.size(); i++) {
+            if (!Arrays.equals(centroids.get(i), other.centroids.get(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    @Override
+    public QuantileAggregationResult clone() {
+        QuantileAggregationResult obj = (QuantileAggregationResult) super.clone();
+        obj.quantiles = quantiles.clone();
+        obj.centroids = new ArrayList<>(centroids.size());
+        for (double[] c : centroids) {
+            obj.centroids.add(c.clone());
+        }
+        return obj;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("quantiles", quantiles);
+        visitor.visit("count", getCount());
+        visitor.visit("centroids", centroids.size());
+    }
+
+    @Override
+    public int hashCode() {
+        int result = super.hashCode();
+        result = 31 * result + Arrays.hashCode(quantiles);
+        result = 31 * result + centroids.size();
+        return result;
+    }
+}
@@ -0,0 +1,39 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class QuantileAggregationResultTest {
+
+    @Test
+    public void rank_is_first_requested_quantile() {
+        QuantileAggregationResult aggregationResult = new QuantileAggregationResult().setQuantiles(0.9, 0.5);
+        assertEquals(0, aggregationResult.getRank().getFloat(), 0);
+        assertTrue(Double.isNaN(aggregationResult.getQuantile(0.5)));
+        for (int i = 1; i <= 100; i++) {
+            aggregationResult.add(i);
+        }
+        assertEquals(aggregationResult.getQuantile(0.9), aggregationResult.getRank().getFloat(), 0);
+        assertEquals(90, aggregationResult.getRank().getFloat(), 1);
+        assertEquals(1, aggregationResult.getQuantile(0), 0);
+        assertEquals(100, aggregationResult.getQuantile(1), 0);
+    }
+
+    @Test
+    public void merge_estimates_quantiles_of_union() {
+        QuantileAggregationResult low = new QuantileAggregationResult().setQuantiles(0.5);
+        QuantileAggregationResult high = new QuantileAggregationResult().setQuantiles(0.5);
+        for (int i = 1; i <= 500; i++) {
+            low.add(i);
+            high.add(500 + i);
+        }
+        low.merge(high);
+        assertEquals(1000, low.getCount(), 0);
+        assertEquals(500, low.getQuantile(0.5), 5);
+        assertEquals(990, low.getQuantile(0.99), 5);
+    }
+
+}
@@ -248,6 +248,51 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST("require that QuantileAggregationResult rank is the first requested quantile") {
+    QuantileAggregationResult aggr;
+    aggr.setQuantiles({0.5, 0.99});
+    for (int64_t i = 1; i <= 101; ++i) {
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).
+                aggregate(DocId(i), HitRank(0));
+    }
+    EXPECT_APPROX(51.0, aggr.getRank().getFloat(), 0.5);
+    EXPECT_APPROX(100.0, aggr.getQuantile(0.99), 1.0);
+    EXPECT_EQUAL(101.0, aggr.getDigest().getCount());
+}
+
+TEST("require that QuantileAggregationResult can be merged") {
+    QuantileAggregationResult aggr1;
+    aggr1.setExpression(createVectorFloat(std::vector<double>({1.0, 2.0, 3.0}))).
+            aggregate(DocId(42), HitRank(21));
+    QuantileAggregationResult aggr2;
+    aggr2.setExpression(createVectorFloat(std::vector<double>({4.0, 5.0}))).
+            aggregate(DocId(43), HitRank(8));
+
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(5.0, aggr1.getDigest().getCount());
+    EXPECT_EQUAL(1.0, aggr1.getDigest().getMin());
+    EXPECT_EQUAL(5.0, aggr1.getDigest().getMax());
+    EXPECT_EQUAL(3.0, aggr1.getRank().getFloat());
+}
+
+TEST("require that QuantileAggregationResult can be serialized") {
+    QuantileAggregationResult aggr1;
+    aggr1.setQuantiles({0.9}).
+            setExpression(createVectorFloat(std::vector<double>({1.5, 100.25, 30.125}))).
+            aggregate(DocId(42), HitRank(21));
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr2 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr2);
+    EXPECT_TRUE(os.empty());
+    EXPECT_TRUE(aggr1.getQuantiles() == aggr2->getQuantiles());
+    EXPECT_TRUE(aggr1.getDigest() == aggr2->getDigest());
+    EXPECT_EQUAL(aggr1.getRank().getFloat(), aggr2->getRank().getFloat());
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
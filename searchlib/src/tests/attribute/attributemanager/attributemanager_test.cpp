@@ -271,6 +271,18 @@ AttributeManagerTest::testConfigConvert()
         a.ismutable = true;
         EXPECT_TRUE(CC::convert(a).isMutable());
     }
+    { // paged
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).paged());
+        a.paged = true;
+        EXPECT_TRUE(CC::convert(a).paged());
+    }
+    { // sorted index
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).sortedIndex());
+        a.sortedindex = true;
+        EXPECT_TRUE(CC::convert(a).sortedIndex());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -2,6 +2,7 @@
 
 #include <vespa/searchcommon/attribute/search_context_params.h>
 #include <vespa/searchlib/attribute/imported_search_context.h>
+#include <vespa/searchlib/common/compressed_bitvector.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
@@ -404,6 +405,22 @@ TEST_F("Bit vector from search cache is used if found", SearchCacheFixture)
     EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
 }
 
+TEST_F("Compressed bit vector from search cache is used if found", SearchCacheFixture)
+{
+    std::vector<uint32_t> docIds({2, 6});
+    auto compressed = CompressedBitVector::create(docIds, f.get_imported_attr()->getNumDocs());
+    f.imported_attr->getSearchCache()->insert("5678",
+                                              std::make_shared<BitVectorSearchCache::Entry>(IDocumentMetaStoreContext::IReadGuard::UP(),
+                                                                                             std::move(compressed),
+                                                                                             f.get_imported_attr()->getNumDocs()));
+    auto ctx = f.create_context(word_term("5678"));
+    ctx->fetchPostings(queryeval::ExecuteInfo::TRUE);
+    TermFieldMatchData match;
+    auto iter = f.create_strict_iterator(*ctx, match);
+    TEST_DO(f.assertSearch({2, 6}, *iter));
+    EXPECT_EQUAL(0u, f.document_meta_store->get_read_guard_cnt);
+}
+
 void
 assertBitVector(const std::vector<uint32_t> &expDocIds, const BitVector &bitVector)
 {
@@ -270,6 +270,11 @@ private:
     void requireThatOutOfBoundsSearchTermGivesZeroHits(const vespalib::string &name, const Config &cfg, int64_t maxValue);
     void requireThatOutOfBoundsSearchTermGivesZeroHits();
 
+    template <typename VectorType, typename ValueType>
+    void requireThatStrictFilterSearchScansValues(const vespalib::string & name, const Config & cfg, uint32_t numDocs,
+                                                  const std::vector<vespalib::string> & terms);
+    void requireThatStrictFilterSearchScansValues();
+
     void single_bool_attribute_search_context_handles_true_and_false_queries();
     void single_bool_attribute_search_iterator_handles_true_and_false_queries();
 
@@ -1823,6 +1828,75 @@ SearchContextTest::requireThatOutOfBoundsSearchTermGivesZeroHits()
     }
 }
 
+template <typename VectorType, typename ValueType>
+void
+SearchContextTest::requireThatStrictFilterSearchScansValues(const vespalib::string & name, const Config & cfg,
+                                                            uint32_t numDocs, const std::vector<vespalib::string> & terms)
+{
+    Config filterCfg(cfg);
+    filterCfg.setIsFilter(true);
+    AttributePtr plain = AttributeFactory::createAttribute(name, cfg);
+    AttributePtr filter = AttributeFactory::createAttribute(name + "-filter", filterCfg);
+    for (const AttributePtr & attr : {plain, filter}) {
+        addDocs(*attr, numDocs);
+        auto & vec = dynamic_cast<VectorType &>(*attr);
+        for (uint32_t doc = 1; doc <= numDocs; ++doc) {
+            // Every 7th document keeps the undefined value
+            if ((doc % 7) != 0) {
+                EXPECT_TRUE(vec.update(doc, ValueType((doc * 13) % 50) - 10));
+            }
+        }
+        attr->commit(true);
+    }
+    uint32_t docIdLimit = filter->getCommittedDocIdLimit();
+    for (const vespalib::string & term : terms) {
+        for (bool strict : {false, true}) {
+            TEST_STATE(vespalib::make_string("term=%s, strict=%s", term.c_str(), strict ? "true" : "false").c_str());
+            TermFieldMatchData md;
+            SearchContextPtr plainSc = getSearch(*plain, term);
+            SearchContextPtr filterSc = getSearch(*filter, term);
+            plainSc->fetchPostings(queryeval::ExecuteInfo::create(strict, 1.0));
+            filterSc->fetchPostings(queryeval::ExecuteInfo::create(strict, 1.0));
+            SearchBasePtr plainIt = plainSc->createIterator(&md, strict);
+            SearchBasePtr filterIt = filterSc->createIterator(&md, strict);
+            EXPECT_EQUAL(strict, dynamic_cast<const BitVectorIterator *>(filterIt.get()) != nullptr);
+            SimpleResult expected;
+            SimpleResult actual;
+            if (strict) {
+                expected.searchStrict(*plainIt, docIdLimit);
+                actual.searchStrict(*filterIt, docIdLimit);
+            } else {
+                expected.search(*plainIt, docIdLimit);
+                actual.search(*filterIt, docIdLimit);
+            }
+            EXPECT_LESS(0u, expected.getHitCount());
+            EXPECT_EQUAL(expected, actual);
+        }
+    }
+}
+
+void
+SearchContextTest::requireThatStrictFilterSearchScansValues()
+{
+    std::vector<vespalib::string> intTerms = {"[0;20]", "<5", "-8", "[-10;39]"};
+    std::vector<vespalib::string> floatTerms = {"[0.5;20]", "<5", "-8", "[-10;39]"};
+    for (uint32_t numDocs : {10u, 127u, 1000u}) {
+        TEST_STATE(vespalib::make_string("numDocs=%u", numDocs).c_str());
+        requireThatStrictFilterSearchScansValues<IntegerAttribute, largeint_t>
+            ("s-int8", Config(BasicType::INT8, CollectionType::SINGLE), numDocs, intTerms);
+        requireThatStrictFilterSearchScansValues<IntegerAttribute, largeint_t>
+            ("s-int16", Config(BasicType::INT16, CollectionType::SINGLE), numDocs, intTerms);
+        requireThatStrictFilterSearchScansValues<IntegerAttribute, largeint_t>
+            ("s-int32", Config(BasicType::INT32, CollectionType::SINGLE), numDocs, intTerms);
+        requireThatStrictFilterSearchScansValues<IntegerAttribute, largeint_t>
+            ("s-int64", Config(BasicType::INT64, CollectionType::SINGLE), numDocs, intTerms);
+        requireThatStrictFilterSearchScansValues<FloatingPointAttribute, double>
+            ("s-float", Config(BasicType::FLOAT, CollectionType::SINGLE), numDocs, floatTerms);
+        requireThatStrictFilterSearchScansValues<FloatingPointAttribute, double>
+            ("s-double", Config(BasicType::DOUBLE, CollectionType::SINGLE), numDocs, floatTerms);
+    }
+}
+
 class BoolAttributeFixture {
 private:
     search::SingleBoolAttribute _attr;
@@ -2034,6 +2108,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatInvalidSearchTermGivesZeroHits());
     TEST_DO(requireThatFlagAttributeHandlesTheByteRange());
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
+    TEST_DO(requireThatStrictFilterSearchScansValues());
     TEST_DO(single_bool_attribute_search_context_handles_true_and_false_queries());
     TEST_DO(single_bool_attribute_search_iterator_handles_true_and_false_queries());
 
@@ -0,0 +1,192 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.hpp>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/sorted_value_index.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchcommon/attribute/config.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("sorted_value_index_test");
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::FloatingPointAttribute;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::attribute::SortedValueIndex;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+
+using DocIds = std::vector<uint32_t>;
+
+TEST(SortedValueIndexTest, range_lookup_covers_slice_of_index)
+{
+    std::vector<int32_t> values = { 5, 3, 7, 3, std::numeric_limits<int32_t>::min(), 9, 1 };
+    SortedValueIndex<int32_t> index;
+    index.build(&values[0], values.size());
+    EXPECT_EQ(6u, index.size());
+    int32_t low = 3;
+    int32_t high = 7;
+    EXPECT_EQ(4u, index.lookupRange(low, high, 0));
+    low = 10;
+    high = 20;
+    EXPECT_EQ(0u, index.lookupRange(low, high, 0));
+    low = 7;
+    high = 3;
+    EXPECT_EQ(0u, index.lookupRange(low, high, 0));
+}
+
+TEST(SortedValueIndexTest, range_limit_narrows_range_to_lowest_or_highest_values)
+{
+    std::vector<int32_t> values = { 5, 3, 7, 3, 8, 9, 1 };
+    SortedValueIndex<int32_t> index;
+    index.build(&values[0], values.size());
+    int32_t low = 2;
+    int32_t high = 100;
+    // All documents with the boundary value are included
+    EXPECT_EQ(2u, index.lookupRange(low, high, 1));
+    EXPECT_EQ(3, low);
+    EXPECT_EQ(3, high);
+    low = 2;
+    high = 100;
+    EXPECT_EQ(3u, index.lookupRange(low, high, -3));
+    EXPECT_EQ(7, low);
+    EXPECT_EQ(9, high);
+    low = 2;
+    high = 100;
+    EXPECT_EQ(6u, index.lookupRange(low, high, 10));
+    EXPECT_EQ(3, low);
+    EXPECT_EQ(9, high);
+}
+
+TEST(SortedValueIndexTest, update_moves_document_in_index)
+{
+    SortedValueIndex<double> index;
+    double undefined = search::attribute::getUndefined<double>();
+    index.update(1, undefined, 2.5);
+    index.update(2, undefined, 4.5);
+    index.update(1, 2.5, 6.5);
+    index.update(2, 4.5, undefined);
+    index.freeze();
+    EXPECT_EQ(1u, index.size());
+    double low = 0.0;
+    double high = 5.0;
+    EXPECT_EQ(0u, index.lookupRange(low, high, 0));
+    high = 10.0;
+    EXPECT_EQ(1u, index.lookupRange(low, high, 0));
+}
+
+class SortedValueIndexAttributeTest : public ::testing::Test {
+protected:
+    std::shared_ptr<AttributeVector> _plain;
+    std::shared_ptr<AttributeVector> _indexed;
+
+    SortedValueIndexAttributeTest()
+        : _plain(AttributeFactory::createAttribute("plain", Config(BasicType::INT64))),
+          _indexed(AttributeFactory::createAttribute("indexed", Config(BasicType::INT64).setSortedIndex(true)))
+    {
+        _plain->addReservedDoc();
+        _indexed->addReservedDoc();
+    }
+
+    void populate(uint32_t numDocs) {
+        for (auto attr : { _plain, _indexed }) {
+            attr->addDocs(numDocs);
+            auto &ia = dynamic_cast<IntegerAttribute &>(*attr);
+            for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+                if ((docId % 7) != 0) {
+                    ia.update(docId, (docId * 37) % 1000);
+                }
+            }
+            attr->commit();
+        }
+    }
+
+    void update(uint32_t docId, int64_t value) {
+        for (auto attr : { _plain, _indexed }) {
+            dynamic_cast<IntegerAttribute &>(*attr).update(docId, value);
+            attr->commit();
+        }
+    }
+
+    void clear(uint32_t docId) {
+        for (auto attr : { _plain, _indexed }) {
+            attr->clearDoc(docId);
+            attr->commit();
+        }
+    }
+
+    static DocIds search(const AttributeVector &attr, const vespalib::string &term, bool strict) {
+        auto ctx = attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD), SearchContextParams());
+        TermFieldMatchData md;
+        ctx->fetchPostings(ExecuteInfo::create(strict));
+        auto itr = ctx->createIterator(&md, strict);
+        uint32_t docIdLimit = attr.getCommittedDocIdLimit();
+        itr->initRange(1, docIdLimit);
+        DocIds result;
+        for (uint32_t docId = 1; docId < docIdLimit; ++docId) {
+            if (itr->seek(docId)) {
+                result.push_back(docId);
+            }
+        }
+        return result;
+    }
+
+    void assertSameHits(const vespalib::string &term) {
+        SCOPED_TRACE(term);
+        for (bool strict : { true, false }) {
+            DocIds expected = search(*_plain, term, strict);
+            EXPECT_EQ(expected, search(*_indexed, term, strict));
+        }
+    }
+};
+
+TEST_F(SortedValueIndexAttributeTest, range_and_equality_terms_match_same_documents)
+{
+    populate(5000);
+    for (const char *term : { "[100;200]", "[;50]", "[900;]", "[0;1000]", "370", "371", "[2000;3000]" }) {
+        assertSameHits(term);
+    }
+    update(10, 150);
+    update(20, 5000);
+    clear(30);
+    for (const char *term : { "[100;200]", "150", "5000", "[;]" }) {
+        assertSameHits(term);
+    }
+}
+
+TEST_F(SortedValueIndexAttributeTest, range_limit_returns_documents_with_lowest_or_highest_values)
+{
+    populate(100);
+    auto ctx = _indexed->getSearch(std::make_unique<QueryTermSimple>("[;;5]", QueryTermSimple::WORD), SearchContextParams());
+    EXPECT_EQ(5u, ctx->approximateHits());
+    EXPECT_EQ(DocIds({1, 29, 55, 82, 83}), search(*_indexed, "[;;5]", true));
+    EXPECT_EQ(DocIds({27, 54, 81}), search(*_indexed, "[;;-3]", false));
+    EXPECT_EQ(DocIds({2, 29, 83}), search(*_indexed, "[70;;3]", false));
+}
+
+TEST(SortedValueIndexFloatTest, float_range_uses_index)
+{
+    auto attr = AttributeFactory::createAttribute("f", Config(BasicType::FLOAT).setSortedIndex(true));
+    attr->addReservedDoc();
+    attr->addDocs(10);
+    auto &fa = dynamic_cast<FloatingPointAttribute &>(*attr);
+    for (uint32_t docId = 1; docId <= 10; ++docId) {
+        fa.update(docId, docId * 0.5);
+    }
+    attr->commit();
+    auto ctx = attr->getSearch(std::make_unique<QueryTermSimple>("[1.0;2.5]", QueryTermSimple::WORD), SearchContextParams());
+    EXPECT_EQ(4u, ctx->approximateHits());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -24,6 +24,8 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 
 #include <vespa/log/log.h>
@@ -48,6 +50,7 @@ using search::tensor::NearestNeighborIndexFactory;
 using search::tensor::NearestNeighborIndexSaver;
 using search::tensor::PrepareResult;
 using search::tensor::TensorAttribute;
+using vespalib::alloc::MmapFileAllocatorFactory;
 using vespalib::eval::TensorSpec;
 using vespalib::eval::ValueType;
 using vespalib::tensor::DefaultTensorEngine;
@@ -120,6 +123,8 @@ private:
     generation_t _trim_gen;
     mutable size_t _memory_usage_cnt;
     int _index_value;
+    std::vector<Neighbor> _top_k_result;
+    mutable uint32_t _last_explore_k;
 
 public:
     MockNearestNeighborIndex(const DocVectorAccess& vectors)
@@ -131,7 +136,9 @@ public:
           _transfer_gen(std::numeric_limits<generation_t>::max()),
           _trim_gen(std::numeric_limits<generation_t>::max()),
           _memory_usage_cnt(0),
-          _index_value(0)
+          _index_value(0),
+          _top_k_result(),
+          _last_explore_k(0)
     {
     }
     void clear() {
@@ -172,6 +179,14 @@ public:
     void expect_complete_add(uint32_t exp_docid, const DoubleVector& exp_vector) const {
         expect_entry(exp_docid, exp_vector, _complete_adds);
     }
+    void expect_prepare_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _prepare_adds);
+    }
+    void expect_complete_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _complete_adds);
+    }
+    void set_top_k_result(const std::vector<Neighbor>& result) { _top_k_result = result; }
+    uint32_t get_last_explore_k() const { return _last_explore_k; }
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
@@ -225,17 +240,17 @@ public:
     std::vector<Neighbor> find_top_k(uint32_t k, vespalib::tensor::TypedCells vector, uint32_t explore_k) const override {
         (void) k;
         (void) vector;
-        (void) explore_k;
-        return std::vector<Neighbor>();
+        _last_explore_k = explore_k;
+        return _top_k_result;
     }
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, vespalib::tensor::TypedCells vector,
                                                  const search::BitVector& filter, uint32_t explore_k) const override
     {
         (void) k;
         (void) vector;
-        (void) explore_k;
         (void) filter;
-        return std::vector<Neighbor>();
+        _last_explore_k = explore_k;
+        return _top_k_result;
     }
 
     
@@ -247,9 +262,11 @@ class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
     std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                size_t vector_size,
                                                ValueType::CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override {
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override {
         (void) vector_size;
         (void) params;
+        (void) memory_allocator;
         assert(cell_type == ValueType::CellType::DOUBLE);
         return std::make_unique<MockNearestNeighborIndex>(vectors);
     }
@@ -257,12 +274,14 @@ class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
 
 const vespalib::string test_dir = "test_data/";
 const vespalib::string attr_name = test_dir + "my_attr";
+const vespalib::string swap_dir = test_dir + "swapfiles";
 
 struct FixtureTraits {
     bool use_dense_tensor_attribute = false;
     bool use_direct_tensor_attribute = false;
     bool enable_hnsw_index = false;
     bool use_mock_index = false;
+    bool paged = false;
 
     FixtureTraits dense() && {
         use_dense_tensor_attribute = true;
@@ -284,6 +303,14 @@ struct FixtureTraits {
         return *this;
     }
 
+    FixtureTraits paged_hnsw() && {
+        use_dense_tensor_attribute = true;
+        enable_hnsw_index = true;
+        use_mock_index = false;
+        paged = true;
+        return *this;
+    }
+
     FixtureTraits direct() && {
         use_dense_tensor_attribute = false;
         use_direct_tensor_attribute = true;
@@ -324,6 +351,7 @@ struct Fixture {
             _cfg.set_distance_metric(DistanceMetric::Euclidean);
             _cfg.set_hnsw_index_params(HnswIndexParams(4, 20, DistanceMetric::Euclidean));
         }
+        _cfg.setPaged(traits.paged);
         setup();
     }
 
@@ -452,10 +480,10 @@ struct Fixture {
         EXPECT_TRUE(saveok);
     }
 
-    void load() {
+    void load(vespalib::Executor *executor = nullptr) {
         _tensorAttr = makeAttr();
         _attr = _tensorAttr;
-        bool loadok = _attr->load();
+        bool loadok = _attr->load(executor);
         EXPECT_TRUE(loadok);
     }
 
@@ -746,6 +774,66 @@ TEST_F("Hnsw index is integrated in dense tensor attribute and can be saved and
     expect_level_0(1, index_b.get_node(2));
 }
 
+TEST_F("Hnsw index is reconstructed using executor when loading without saved index", DenseTensorAttributeHnswIndex)
+{
+    f.set_tensor(1, vec_2d(3, 5));
+    f.set_tensor(2, vec_2d(7, 9));
+    f.set_tensor(3, vec_2d(8, 10));
+    f.save();
+    EXPECT_TRUE(vespalib::unlink(attr_name + ".nnidx"));
+
+    vespalib::ThreadStackExecutor executor(2, 128 * 1024);
+    f.load(&executor);
+    auto &index = f.hnsw_index();
+    for (uint32_t docid = 1; docid <= 3; ++docid) {
+        EXPECT_GREATER_EQUAL(index.get_node(docid).size(), 1u);
+    }
+    auto result = index.find_top_k(1, f.as_dense_tensor().get_vector(3), 10);
+    ASSERT_EQUAL(1u, result.size());
+    EXPECT_EQUAL(3u, result[0].docid);
+}
+
+/**
+ * Lets paged attributes allocate swap files in the test directory.
+ */
+struct SwapFilesSetup {
+    SwapFilesSetup() { MmapFileAllocatorFactory::instance().setup(swap_dir); }
+    ~SwapFilesSetup() { MmapFileAllocatorFactory::instance().setup(""); }
+};
+
+class DenseTensorAttributePagedHnswIndex : public SwapFilesSetup, public Fixture {
+public:
+    DenseTensorAttributePagedHnswIndex() : SwapFilesSetup(), Fixture(vec_2d_spec, FixtureTraits().paged_hnsw()) {}
+};
+
+TEST_F("Swap files are not used when dense tensor attribute is not paged", SwapFilesSetup)
+{
+    (void) f;
+    Fixture attr_fixture(vec_2d_spec, FixtureTraits().hnsw());
+    attr_fixture.set_tensor(1, vec_2d(3, 5));
+    EXPECT_FALSE(vespalib::isDirectory(swap_dir));
+}
+
+TEST_F("Paged dense tensor attribute keeps tensors and hnsw index in swap files", DenseTensorAttributePagedHnswIndex)
+{
+    EXPECT_TRUE(vespalib::isDirectory(swap_dir));
+    f.set_tensor(1, vec_2d(3, 5));
+    f.set_tensor(2, vec_2d(7, 9));
+    f.set_tensor(3, vec_2d(8, 10));
+    f.assertGetTensor(vec_2d(7, 9), 2);
+    auto &index_a = f.hnsw_index();
+    expect_level_0(2, index_a.get_node(1));
+    f.save();
+
+    f.load();
+    f.assertGetTensor(vec_2d(3, 5), 1);
+    f.assertGetTensor(vec_2d(8, 10), 3);
+    auto &index_b = f.hnsw_index();
+    expect_level_0(2, index_b.get_node(1));
+    auto result = index_b.find_top_k(1, f.as_dense_tensor().get_vector(3), 10);
+    ASSERT_EQUAL(1u, result.size());
+    EXPECT_EQUAL(3u, result[0].docid);
+}
 
 class DenseTensorAttributeMockIndex : public Fixture {
 public:
@@ -866,6 +954,20 @@ TEST_F("onLoad() reconstructs nearest neighbor index if save file does not exist
     index.expect_adds({{1, {3, 5}}, {2, {7, 9}}});
 }
 
+TEST_F("onLoad() reconstructs nearest neighbor index in two phases when executor is given", DenseTensorAttributeMockIndex)
+{
+    f.set_example_tensors();
+    f.save();
+    EXPECT_FALSE(vespalib::fileExists(attr_name + ".nnidx"));
+
+    vespalib::ThreadStackExecutor executor(1, 128 * 1024);
+    f.load(&executor); // index is reconstructed by preparing adds in executor and completing them in load thread
+    auto& index = f.mock_index();
+    index.expect_adds({});
+    index.expect_prepare_adds({{1, {3, 5}}, {2, {7, 9}}});
+    index.expect_complete_adds({{1, {3, 5}}, {2, {7, 9}}});
+}
+
 TEST_F("onLoads() ignores saved nearest neighbor index if not enabled in config", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -930,13 +1032,15 @@ public:
         return std::unique_ptr<QueryTensor>(tensor);
     }
 
-    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05) {
+    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05,
+                                                             uint32_t explore_additional_hits = 5,
+                                                             double explore_k_max_adjustment_factor = 20.0) {
         search::queryeval::FieldSpec field("foo", 0, 0);
         auto bp = std::make_unique<NearestNeighborBlueprint>(
             field,
             as_dense_tensor(),
             createDenseTensor(vec_2d(17, 42)),
-            3, true, 5, brute_force_limit);
+            3, true, explore_additional_hits, brute_force_limit, explore_k_max_adjustment_factor);
         EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
         EXPECT_TRUE(bp->may_approximate());
         return bp;
@@ -950,6 +1054,8 @@ TEST_F("NN blueprint handles empty filter", NearestNeighborBlueprintFixture)
     bp->set_global_filter(*empty_filter);
     EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
     EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::INDEX_TOP_K, bp->get_algorithm());
+    EXPECT_EQUAL(8u, f.mock_index().get_last_explore_k());
 }
 
 TEST_F("NN blueprint handles strong filter", NearestNeighborBlueprintFixture)
@@ -961,7 +1067,9 @@ TEST_F("NN blueprint handles strong filter", NearestNeighborBlueprintFixture)
     auto strong_filter = GlobalFilter::create(std::move(filter));
     bp->set_global_filter(*strong_filter);
     EXPECT_EQUAL(1u, bp->getState().estimate().estHits);
-    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_FALSE(bp->may_approximate());
+    // Fewer documents pass the filter than the index search is estimated to visit.
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
 }
 
 TEST_F("NN blueprint handles weak filter", NearestNeighborBlueprintFixture)
@@ -977,8 +1085,9 @@ TEST_F("NN blueprint handles weak filter", NearestNeighborBlueprintFixture)
     filter->invalidateCachedCount();
     auto weak_filter = GlobalFilter::create(std::move(filter));
     bp->set_global_filter(*weak_filter);
-    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
-    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(5u, bp->getState().estimate().estHits);
+    EXPECT_FALSE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
 }
 
 TEST_F("NN blueprint handles strong filter triggering brute force search", NearestNeighborBlueprintFixture)
@@ -989,8 +1098,84 @@ TEST_F("NN blueprint handles strong filter triggering brute force search", Neare
     filter->invalidateCachedCount();
     auto strong_filter = GlobalFilter::create(std::move(filter));
     bp->set_global_filter(*strong_filter);
-    EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(1u, bp->getState().estimate().estHits);
+    EXPECT_FALSE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
+}
+
+std::shared_ptr<GlobalFilter>
+make_filter_with_docs_1_to_10()
+{
+    auto filter = search::BitVector::create(11);
+    for (uint32_t docid = 1; docid <= 10; ++docid) {
+        filter->setBit(docid);
+    }
+    filter->invalidateCachedCount();
+    return GlobalFilter::create(std::move(filter));
+}
+
+TEST_F("NN blueprint uses index search with filter when most documents pass the filter", NearestNeighborBlueprintFixture)
+{
+    f.mock_index().set_top_k_result({{1, 1.0}, {2, 2.0}, {3, 3.0}});
+    auto bp = f.make_blueprint(0.05, 0);
+    bp->set_global_filter(*make_filter_with_docs_1_to_10());
+    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
+    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::INDEX_TOP_K_WITH_FILTER, bp->get_algorithm());
+    EXPECT_EQUAL(3u, bp->get_explore_k());
+    EXPECT_EQUAL(3u, f.mock_index().get_last_explore_k());
+}
+
+TEST_F("NN blueprint falls back to brute force search when index search with filter finds too few hits", NearestNeighborBlueprintFixture)
+{
+    f.mock_index().set_top_k_result({{1, 1.0}});
+    auto bp = f.make_blueprint(0.05, 0);
+    bp->set_global_filter(*make_filter_with_docs_1_to_10());
+    EXPECT_EQUAL(10u, bp->getState().estimate().estHits);
+    EXPECT_FALSE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
+}
+
+std::shared_ptr<GlobalFilter>
+make_filter_with_docs_1_to_6()
+{
+    auto filter = search::BitVector::create(11);
+    for (uint32_t docid = 1; docid <= 6; ++docid) {
+        filter->setBit(docid);
+    }
+    filter->invalidateCachedCount();
+    return GlobalFilter::create(std::move(filter));
+}
+
+TEST_F("NN blueprint compares filter hits with documents visited by index search using explore_k from query", NearestNeighborBlueprintFixture)
+{
+    f.mock_index().set_top_k_result({{1, 1.0}, {2, 2.0}, {3, 3.0}});
+    // explore_k 3 visits 3 * 11 / 6 = 5.5 documents, fewer than the 6 passing the filter
+    auto bp = f.make_blueprint(0.05, 0);
+    bp->set_global_filter(*make_filter_with_docs_1_to_6());
+    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
+    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::INDEX_TOP_K_WITH_FILTER, bp->get_algorithm());
+    // explore_k 4 visits 4 * 11 / 6 = 7.3 documents, more than the 6 passing the filter
+    bp = f.make_blueprint(0.05, 1);
+    bp->set_global_filter(*make_filter_with_docs_1_to_6());
+    EXPECT_EQUAL(6u, bp->getState().estimate().estHits);
     EXPECT_FALSE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
+    EXPECT_EQUAL(4u, bp->get_explore_k());
+}
+
+TEST_F("NN blueprint adjusts explore_k by filter hit ratio, limited by max adjustment factor", NearestNeighborBlueprintFixture)
+{
+    f.mock_index().set_top_k_result({{1, 1.0}, {2, 2.0}, {3, 3.0}});
+    auto bp = f.make_blueprint(0.05, 0, 20.0);
+    bp->set_global_filter(*make_filter_with_docs_1_to_6());
+    EXPECT_EQUAL(5u, bp->get_explore_k());
+    EXPECT_EQUAL(5u, f.mock_index().get_last_explore_k());
+    bp = f.make_blueprint(0.05, 0, 1.5);
+    bp->set_global_filter(*make_filter_with_docs_1_to_6());
+    EXPECT_EQUAL(4u, bp->get_explore_k());
+    EXPECT_EQUAL(4u, f.mock_index().get_last_explore_k());
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,165 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/common/compressed_bitvector.h>
+#include <vespa/searchlib/common/compressed_bitvector_iterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/log/log.h>
+
+LOG_SETUP("compressed_bitvector_test");
+
+using search::BitVector;
+using search::CompressedBitVector;
+using search::CompressedBitVectorIterator;
+using search::fef::TermFieldMatchData;
+
+namespace {
+
+constexpr uint32_t chunk = CompressedBitVector::ChunkSize;
+
+/*
+ * Chunk 0 is sparse, chunk 1 is dense, chunk 2 has long runs, chunk 3 is
+ * empty and chunk 4 is partial.
+ */
+BitVector::UP
+makeBitVector(uint32_t seed)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(seed);
+    auto bv = BitVector::create(4 * chunk + 1234);
+    for (uint32_t i = 0; i < chunk; i += 1 + rnd.lrand48() % 2000) {
+        bv->setBit(i);
+    }
+    for (uint32_t i = chunk; i < 2 * chunk; ++i) {
+        if ((rnd.lrand48() % 3) != 0) {
+            bv->setBit(i);
+        }
+    }
+    for (uint32_t i = 2 * chunk; i < 3 * chunk; i += 5000) {
+        bv->setInterval(i + rnd.lrand48() % 100, i + 1000 + rnd.lrand48() % 2000);
+    }
+    for (uint32_t i = 4 * chunk; i < bv->size(); i += 1 + rnd.lrand48() % 10) {
+        bv->setBit(i);
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+void
+assertEqual(const BitVector &exp, const BitVector &act)
+{
+    ASSERT_EQUAL(exp.size(), act.size());
+    EXPECT_EQUAL(exp.countTrueBits(), act.countTrueBits());
+    for (uint32_t i = act.getStartIndex(); i < act.size(); ++i) {
+        if (exp.testBit(i) != act.testBit(i)) {
+            TEST_ERROR(vespalib::make_string("bit %u differs", i).c_str());
+            return;
+        }
+    }
+}
+
+}
+
+TEST("require that compressed bit vector has same bits as source")
+{
+    auto bv = makeBitVector(1);
+    auto cbv = CompressedBitVector::create(*bv);
+    EXPECT_EQUAL(bv->size(), cbv->size());
+    EXPECT_EQUAL(bv->countTrueBits(), cbv->countTrueBits());
+    for (uint32_t i = 0; i < bv->size(); ++i) {
+        ASSERT_EQUAL(bv->testBit(i), cbv->testBit(i));
+    }
+    for (uint32_t docId = 0, i = 0; docId < bv->size(); docId += 1 + (i++ % 37)) {
+        ASSERT_EQUAL(bv->getNextTrueBit(docId), cbv->getNextTrueBit(docId));
+    }
+    EXPECT_EQUAL(4 * chunk, cbv->getNextTrueBit(3 * chunk + 4000));
+    EXPECT_LESS(cbv->getMemoryUsage(), bv->sizeBytes());
+}
+
+TEST("require that compressed bit vector can be created from docids")
+{
+    std::vector<uint32_t> docIds({1, 5, 65535, 65536, 200000});
+    auto cbv = CompressedBitVector::create(docIds, 200001);
+    EXPECT_EQUAL(5u, cbv->countTrueBits());
+    EXPECT_TRUE(cbv->testBit(65535));
+    EXPECT_FALSE(cbv->testBit(65537));
+    EXPECT_EQUAL(65536u, cbv->getNextTrueBit(65536));
+    EXPECT_EQUAL(200000u, cbv->getNextTrueBit(65537));
+    EXPECT_EQUAL(200001u, cbv->getNextTrueBit(200001));
+}
+
+TEST("require that and/or into bit vector matches plain bit vector operations")
+{
+    auto a = makeBitVector(1);
+    auto cbv = CompressedBitVector::create(*a);
+    auto b = makeBitVector(2);
+    {
+        auto exp = BitVector::create(*b);
+        exp->andWith(*a);
+        auto act = BitVector::create(*b);
+        cbv->andInto(*act);
+        TEST_DO(assertEqual(*exp, *act));
+    }
+    {
+        auto exp = BitVector::create(*b);
+        exp->orWith(*a);
+        auto act = BitVector::create(*b);
+        cbv->orInto(*act);
+        TEST_DO(assertEqual(*exp, *act));
+    }
+    {
+        auto exp = BitVector::create(*b, chunk + 77, 3 * chunk + 5);
+        exp->andWith(*a);
+        auto act = BitVector::create(*b, chunk + 77, 3 * chunk + 5);
+        cbv->andInto(*act);
+        TEST_DO(assertEqual(*exp, *act));
+    }
+}
+
+TEST("require that and/or of compressed bit vectors matches plain bit vector operations")
+{
+    auto a = makeBitVector(1);
+    auto b = makeBitVector(2);
+    auto ca = CompressedBitVector::create(*a);
+    auto cb = CompressedBitVector::create(*b);
+    auto andExp = BitVector::create(*a);
+    andExp->andWith(*b);
+    auto andAct = BitVector::create(a->size());
+    CompressedBitVector::andOf(*ca, *cb)->orInto(*andAct);
+    TEST_DO(assertEqual(*andExp, *andAct));
+    auto orExp = BitVector::create(*a);
+    orExp->orWith(*b);
+    auto orAct = BitVector::create(a->size());
+    auto orResult = CompressedBitVector::orOf(*ca, *cb);
+    orResult->orInto(*orAct);
+    TEST_DO(assertEqual(*orExp, *orAct));
+    EXPECT_EQUAL(orExp->countTrueBits(), orResult->countTrueBits());
+}
+
+TEST("require that iterator finds all hits")
+{
+    auto bv = makeBitVector(3);
+    auto cbv = CompressedBitVector::create(*bv);
+    for (bool strict : {false, true}) {
+        TermFieldMatchData tfmd;
+        auto itr = CompressedBitVectorIterator::create(cbv.get(), bv->size(), tfmd, strict);
+        itr->initRange(1, bv->size());
+        uint32_t numHits = 0;
+        for (uint32_t docId = 1; docId < bv->size(); ++docId) {
+            bool hit = itr->seek(docId);
+            ASSERT_EQUAL(bv->testBit(docId), hit);
+            if (hit) {
+                ++numHits;
+                itr->unpack(docId);
+                EXPECT_EQUAL(docId, tfmd.getDocId());
+            }
+        }
+        EXPECT_EQUAL(bv->countTrueBits() - (bv->testBit(0) ? 1 : 0), numHits);
+        itr->initRange(1, bv->size());
+        auto hits = itr->get_hits(1);
+        EXPECT_EQUAL(numHits, hits->countTrueBits());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -5,6 +5,11 @@
 #include <vespa/searchlib/docstore/cachestats.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <map>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -45,6 +50,65 @@ struct NullDataStore : IDataStore {
     void shrinkLidSpace() override {}
 };
 
+struct MapDataStore : NullDataStore {
+    std::map<uint32_t, vespalib::string> _docs;
+    mutable size_t _singleReads;
+    mutable size_t _batchReads;
+    MapDataStore() : NullDataStore(), _docs(), _singleReads(0), _batchReads(0) {}
+    ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override {
+        ++_singleReads;
+        auto found = _docs.find(lid);
+        if (found == _docs.end()) {
+            return 0;
+        }
+        buffer.writeBytes(found->second.data(), found->second.size());
+        return found->second.size();
+    }
+    void read(const LidVector & lids, IBufferVisitor & visitor) const override {
+        ++_batchReads;
+        for (uint32_t lid : lids) {
+            auto found = _docs.find(lid);
+            if (found != _docs.end()) {
+                visitor.visit(lid, vespalib::ConstBufferRef(found->second.data(), found->second.size()));
+            }
+        }
+    }
+    void write(uint64_t, uint32_t lid, const void * buffer, size_t len) override {
+        _docs[lid] = vespalib::string(static_cast<const char *>(buffer), len);
+    }
+    void remove(uint64_t, uint32_t lid) override { _docs.erase(lid); }
+};
+
+struct CollectingVisitor : IDocumentVisitor {
+    std::vector<uint32_t> _lids;
+    bool _allowDocumentCaching;
+    CollectingVisitor(bool allowDocumentCaching) : _lids(), _allowDocumentCaching(allowDocumentCaching) {}
+    void visit(uint32_t lid, DocumentUP doc) override {
+        EXPECT_TRUE(doc);
+        _lids.push_back(lid);
+    }
+    bool allowVisitCaching() const override { return false; }
+    bool allowDocumentCaching() const override { return _allowDocumentCaching; }
+};
+
+void
+writeDocs(DocumentStore & store, std::initializer_list<uint32_t> lids) {
+    for (uint32_t lid : lids) {
+        vespalib::asciistream id;
+        id << "id:ns:document::" << lid;
+        document::Document doc(*repo.getDocumentType("document"), document::DocumentId(id.str()));
+        store.write(lid, lid, doc);
+    }
+}
+
+std::vector<uint32_t>
+visitDocs(const DocumentStore & store, const IDocumentStore::LidVector & lids, bool allowDocumentCaching) {
+    CollectingVisitor visitor(allowDocumentCaching);
+    store.visit(lids, repo, visitor);
+    std::sort(visitor._lids.begin(), visitor._lids.end());
+    return visitor._lids;
+}
+
 TEST_FFF("require that uncache docstore lookups are counted",
          DocumentStore::Config(CompressionConfig::NONE, 0, 0),
          NullDataStore(), DocumentStore(f1, f2))
@@ -63,6 +127,58 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+TEST_FFF("require that visit with document caching reads misses as one batch and adds them to the cache",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         MapDataStore(), DocumentStore(f1, f2))
+{
+    writeDocs(f3, {1, 2, 3, 4});
+    EXPECT_TRUE(f3.read(1, repo));
+    EXPECT_EQUAL(1u, f2._singleReads);
+    EXPECT_TRUE(std::vector<uint32_t>({1, 2, 3}) == visitDocs(f3, {1, 2, 3}, true));
+    EXPECT_EQUAL(1u, f2._singleReads);
+    EXPECT_EQUAL(1u, f2._batchReads);
+    CacheStats stats = f3.getCacheStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+    EXPECT_EQUAL(3u, stats.elements);
+
+    EXPECT_TRUE(std::vector<uint32_t>({1, 2, 3}) == visitDocs(f3, {1, 2, 3}, true));
+    EXPECT_EQUAL(1u, f2._batchReads);
+    EXPECT_TRUE(f3.read(2, repo));
+    EXPECT_EQUAL(1u, f2._singleReads);
+    stats = f3.getCacheStats();
+    EXPECT_EQUAL(5u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+}
+
+TEST_FFF("require that missing documents are looked up through the cache when visiting with document caching",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         MapDataStore(), DocumentStore(f1, f2))
+{
+    writeDocs(f3, {1, 2});
+    EXPECT_TRUE(std::vector<uint32_t>({1, 2}) == visitDocs(f3, {1, 2, 7}, true));
+    EXPECT_EQUAL(1u, f2._batchReads);
+    EXPECT_EQUAL(1u, f2._singleReads);
+    CacheStats stats = f3.getCacheStats();
+    EXPECT_EQUAL(0u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+    EXPECT_EQUAL(2u, stats.elements);
+}
+
+TEST_FFF("require that visit without document caching bypasses the cache",
+         DocumentStore::Config(CompressionConfig::NONE, 100000, 100),
+         MapDataStore(), DocumentStore(f1, f2))
+{
+    writeDocs(f3, {1, 2});
+    EXPECT_TRUE(f3.read(1, repo));
+    EXPECT_TRUE(std::vector<uint32_t>({1, 2}) == visitDocs(f3, {1, 2}, false));
+    EXPECT_EQUAL(1u, f2._batchReads);
+    CacheStats stats = f3.getCacheStats();
+    EXPECT_EQUAL(0u, stats.hits);
+    EXPECT_EQUAL(1u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -70,6 +186,7 @@ TEST("require that DocumentStore::Config equality operator detects inequality")
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 99));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100001, 100));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::LZ4, 100000, 100));
+    EXPECT_FALSE(C() == C().cachePolicy(vespalib::CachePolicy::W_TINY_LFU));
 }
 
 TEST("require that LogDocumentStore::Config equality operator detects inequality") {
@@ -7,8 +7,10 @@
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <iomanip>
 #include <iostream>
+#include <map>
 
 #include <vespa/log/log.h>
 #include <vespa/vespalib/util/compressionconfig.h>
@@ -119,7 +121,9 @@ struct WriteFixture : public FixtureBase {
 
     WriteFixture(const vespalib::string &baseName,
                  uint32_t docIdLimit,
-                 bool dirCleanup = true)
+                 bool dirCleanup = true,
+                 const CompressionConfig &compression = CompressionConfig(),
+                 FileChunk::CompressionDictionarySP dictionary = FileChunk::CompressionDictionarySP())
         : FixtureBase(baseName, dirCleanup),
           chunk(executor,
                 FileChunk::FileId(0),
@@ -127,11 +131,12 @@ struct WriteFixture : public FixtureBase {
                 baseName,
                 serialNum,
                 docIdLimit,
-                WriteableFileChunk::Config(CompressionConfig(), 0x1000),
+                WriteableFileChunk::Config(compression, 0x1000),
                 tuneFile,
                 fileHeaderCtx,
                 &bucketizer,
-                false)
+                false,
+                std::move(dictionary))
     {
         dir.cleanup(dirCleanup);
     }
@@ -238,6 +243,71 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
 }
 
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
+
+struct SampleCollector : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> buffers;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        buffers[lid] = vespalib::string(buffer.c_str(), buffer.size());
+    }
+};
+
+vespalib::string
+getDocument(uint32_t lid)
+{
+    std::ostringstream oss;
+    oss << "{\"id\":\"id:test:music::" << lid << "\",\"fields\":{\"title\":\"title " << lid * 7
+        << "\",\"artist\":\"artist " << lid % 13 << "\",\"year\":" << 1950 + lid % 70 << "}}";
+    return oss.str();
+}
+
+ZStdDictionary::SP
+trainDictionary()
+{
+    std::vector<vespalib::string> docs;
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (uint32_t lid = 0; lid < 1000; ++lid) {
+        docs.push_back(getDocument(lid));
+    }
+    for (const auto &doc : docs) {
+        samples.emplace_back(doc.c_str(), doc.size());
+    }
+    return ZStdDictionary::train(samples, 4096, 9);
+}
+
+TEST("require that compression dictionary is written to and read from dat file header")
+{
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    {
+        WriteFixture f("tmp", 1000, false, CompressionConfig(CompressionConfig::ZSTD, 9, 90), dictionary);
+        EXPECT_EQUAL(dictionary.get(), f.chunk.getCompressionDictionary().get());
+        for (uint32_t lid = 1; lid < 100; ++lid) {
+            vespalib::string doc = getDocument(lid);
+            f.chunk.append(f.nextSerialNum(), lid, doc.c_str(), doc.size());
+        }
+        f.flush();
+    }
+    {
+        ReadFixture f("tmp");
+        f.updateLidMap(1000);
+        f.chunk.enableRead();
+        ASSERT_TRUE(f.chunk.getCompressionDictionary());
+        EXPECT_EQUAL(dictionary->getId(), f.chunk.getCompressionDictionary()->getId());
+        SampleCollector collector;
+        f.chunk.sample(1000000, collector);
+        EXPECT_EQUAL(99u, collector.buffers.size());
+        for (const auto &entry : collector.buffers) {
+            EXPECT_EQUAL(getDocument(entry.first), entry.second);
+        }
+    }
+}
+
+TEST("require that compression dictionary is ignored when not using zstd")
+{
+    WriteFixture f("tmp", 1000, true, CompressionConfig(CompressionConfig::LZ4), trainDictionary());
+    EXPECT_FALSE(f.chunk.getCompressionDictionary());
+}
 
 TEST("require that operator == detects inequality") {
     using C = WriteableFileChunk::Config;
@@ -273,6 +273,68 @@ void fetchAndTest(IDataStore & datastore, uint32_t lid, const void *a, size_t sz
     EXPECT_TRUE(memcmp(a, buf.getData(), sz) == 0);
 }
 
+vespalib::string
+genDocument(uint32_t lid)
+{
+    std::ostringstream oss;
+    oss << "{\"id\":\"id:test:music::" << lid << "\",\"fields\":{\"title\":\"title " << lid * 7
+        << "\",\"artist\":\"artist " << lid % 13 << "\",\"year\":" << 1950 + lid % 70 << "}}";
+    return oss.str();
+}
+
+void
+fetchAndTestDocuments(IDataStore & datastore, uint32_t numDocs)
+{
+    for (uint32_t lid(2); lid < numDocs; lid += 2) {
+        vespalib::string doc = genDocument(lid);
+        TEST_DO(fetchAndTest(datastore, lid, doc.c_str(), doc.size()));
+    }
+}
+
+TEST("require that compression dictionary is trained on compaction and used for new files") {
+    DirectoryHandler tmpDir("dictionary");
+    vespalib::ThreadStackExecutor executor(1, 128*1024);
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    LogDataStore::Config config;
+    config.setMaxFileSize(50000).setMaxDiskBloatFactor(0.1).setMaxBucketSpread(1000.0)
+            .setCompressionDictionarySize(4096)
+            .compactCompression({CompressionConfig::ZSTD})
+            .setFileConfig({{CompressionConfig::ZSTD, 9, 90}, 4096});
+    const uint32_t numDocs = 4000;
+    {
+        LogDataStore datastore(executor, "dictionary", config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        SerialNum serialNum(0);
+        for (uint32_t lid(1); lid < numDocs; lid++) {
+            vespalib::string doc = genDocument(lid);
+            datastore.write(++serialNum, lid, doc.c_str(), doc.size());
+        }
+        datastore.flush(datastore.initFlush(serialNum));
+        for (uint32_t lid(1); lid < numDocs; lid += 2) {
+            datastore.remove(++serialNum, lid);
+        }
+        datastore.flush(datastore.initFlush(serialNum));
+        EXPECT_FALSE(datastore.getCompressionDictionary());
+        datastore.compact(serialNum);
+        EXPECT_TRUE(datastore.getCompressionDictionary());
+        fetchAndTestDocuments(datastore, numDocs);
+        // The dictionary is stored in the header of files created after training.
+        for (uint32_t lid(numDocs); lid < 2 * numDocs; lid += 2) {
+            vespalib::string doc = genDocument(lid);
+            datastore.write(++serialNum, lid, doc.c_str(), doc.size());
+        }
+        datastore.flush(datastore.initFlush(serialNum));
+        fetchAndTestDocuments(datastore, 2 * numDocs);
+    }
+    {
+        LogDataStore datastore(executor, "dictionary", config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        EXPECT_TRUE(datastore.getCompressionDictionary());
+        fetchAndTestDocuments(datastore, 2 * numDocs);
+    }
+}
+
 TEST("testTruncatedIdxFile"){
     LogDataStore::Config config;
     DummyFileHeaderContext fileHeaderContext;
@@ -811,11 +873,18 @@ TEST("testBucketDensityComputer") {
 }
 
 LogDataStore::Config
-getBasicConfig(size_t maxFileSize)
+getBasicConfig(size_t maxFileSize, uint32_t readConcurrency)
 {
-    return LogDataStore::Config().setMaxFileSize(maxFileSize);
+    return LogDataStore::Config().setMaxFileSize(maxFileSize).setReadConcurrency(readConcurrency);
 }
 
+struct BufferCollector : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> buffers;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        buffers[lid] = vespalib::string(buffer.c_str(), buffer.size());
+    }
+};
+
 vespalib::string
 genData(uint32_t lid, size_t numBytes)
 {
@@ -842,13 +911,14 @@ struct Fixture {
 
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
-            size_t maxFileSize = 4096 * 2)
+            size_t maxFileSize = 4096 * 2,
+            uint32_t readConcurrency = 1)
         : executor(1, 0x20000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, getBasicConfig(maxFileSize, readConcurrency), GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -903,6 +973,18 @@ struct Fixture {
             }
         }
     }
+    void assertBatchContent(const std::set<uint32_t> &lids, uint32_t docIdLimit) {
+        IDataStore::LidVector request;
+        for (uint32_t lid = 0; lid < docIdLimit; ++lid) {
+            request.push_back(lid);
+        }
+        BufferCollector collector;
+        store.read(request, collector);
+        EXPECT_EQUAL(lids.size(), collector.buffers.size());
+        for (uint32_t lid : lids) {
+            EXPECT_EQUAL(genData(lid, 1024), collector.buffers[lid]);
+        }
+    }
 };
 
 TEST("require that docIdLimit is updated when inserting entries")
@@ -970,6 +1052,22 @@ TEST("require that lid space can be compacted and entries from old files skipped
     }
 }
 
+TEST("require that batch read gives same content with and without read concurrency")
+{
+    for (uint32_t readConcurrency : {1u, 4u}) {
+        Fixture f("tmp", true, 4096 * 2, readConcurrency);
+        f.write(10);
+        f.writeUntilNewChunk(100);
+        f.write(20);
+        f.writeUntilNewChunk(200);
+        f.flush();
+        f.write(30).write(31);
+        TEST_DO(f.assertBatchContent({10,100,101,102,20,200,201,202,30,31}, 300));
+        f.compactLidSpace(100);
+        TEST_DO(f.assertBatchContent({10,20,30,31}, 300));
+    }
+}
+
 TEST_F("require that getLid() is protected by docIdLimit", Fixture)
 {
     f.write(1);
@@ -1052,6 +1150,8 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxDiskBloatFactor(0.3));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
+    EXPECT_FALSE(C() == C().setReadConcurrency(4));
+    EXPECT_FALSE(C() == C().setCompressionDictionarySize(4096));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
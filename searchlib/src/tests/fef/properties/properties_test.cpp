@@ -319,6 +319,16 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.work_stealing_scheduler
+            EXPECT_EQUAL(matching::WorkStealingScheduler::NAME, vespalib::string("vespa.matching.work_stealing_scheduler"));
+            EXPECT_EQUAL(matching::WorkStealingScheduler::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_FALSE(matching::WorkStealingScheduler::check(p));
+            EXPECT_TRUE(matching::WorkStealingScheduler::check(p, true));
+            p.add("vespa.matching.work_stealing_scheduler", "true");
+            EXPECT_TRUE(matching::WorkStealingScheduler::check(p));
+            EXPECT_TRUE(matching::WorkStealingScheduler::check(p, false));
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -17,6 +17,7 @@
 using namespace search::fef;
 using namespace search::fef::test;
 using namespace search::features;
+using search::feature_t;
 
 uint32_t default_docid = 1;
 
@@ -391,4 +392,67 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+std::vector<feature_t> get_batch(const RankProgram &program, const std::vector<uint32_t> &docids) {
+    std::vector<feature_t> scores(docids.size(), 0.0);
+    program.get_seeds().resolve(0).as_numbers(docids, scores);
+    return scores;
+}
+
+void verify_batch(const RankProgram &program, const std::vector<uint32_t> &docids,
+                  const std::vector<feature_t> &expect)
+{
+    auto scores = get_batch(program, docids);
+    ASSERT_EQUAL(expect.size(), scores.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQUAL(expect[i], scores[i]);
+    }
+}
+
+TEST_F("require that batch evaluation calculates the same scores as per document evaluation", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+value(3)").compile();
+    EXPECT_TRUE(f1.program.can_batch_seeds());
+    std::vector<uint32_t> docids({1, 5, 7, 100});
+    auto scores = get_batch(f1.program, docids);
+    ASSERT_EQUAL(docids.size(), scores.size());
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQUAL(scores[i], docids[i] * 2.0 + 3.0);
+        EXPECT_EQUAL(scores[i], f1.get(docids[i]));
+    }
+}
+
+TEST_F("require that const seeds can be batch evaluated", Fixture()) {
+    f1.add_expr("rank", "value(7)").compile();
+    EXPECT_TRUE(f1.program.can_batch_seeds());
+    TEST_DO(verify_batch(f1.program, {3, 4}, {7.0, 7.0}));
+}
+
+TEST_F("require that executors without batch support prevent batch evaluation", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid+ivalue(3)").compile();
+    EXPECT_FALSE(f1.program.can_batch_seeds());
+    TEST_DO(verify_batch(f1.program, {1, 2}, {4.0, 5.0}));
+}
+
+TEST_F("require that lazy ranking expressions prevent batch evaluation", Fixture()) {
+    f1.lazy_expressions(true).add_expr("rank", "docid*2").compile();
+    EXPECT_FALSE(f1.program.can_batch_seeds());
+}
+
+TEST_F("require that overridden features prevent batch evaluation", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2").override(expr_feature("rank"), 5.0).compile();
+    EXPECT_FALSE(f1.program.can_batch_seeds());
+    TEST_DO(verify_batch(f1.program, {1, 2}, {5.0, 5.0}));
+}
+
+TEST_F("require that fast-forest gbdt evaluation supports batch evaluation", Fixture()) {
+    f1.use_fast_forest().add_expr("rank", "if(docid<2,1,2)+if(docid<5,10,20)").compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
+    EXPECT_TRUE(f1.program.can_batch_seeds());
+    TEST_DO(verify_batch(f1.program, {1, 3, 7}, {11.0, 12.0, 22.0}));
+}
+
+TEST_F("require that object seeds prevent batch evaluation", Fixture()) {
+    f1.add("box(docid)").compile();
+    EXPECT_FALSE(f1.program.can_batch_seeds());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -5,6 +5,12 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.hpp>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/aggregation/columnar_grouper.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
@@ -159,6 +165,8 @@ public:
                    const Group &expect);
     bool testMerge(const Grouping &a, const Grouping &b, const Grouping &c,
                    const Group &expect);
+    bool testPartitionedMerge(const std::vector<Grouping> &groupings, uint32_t numPartitions,
+                              const Group &expect);
     bool testPrune(const Grouping &a, const Grouping &b,
                    const Group &expect);
     bool testPartialMerge(const Grouping &a, const Grouping &b,
@@ -185,6 +193,7 @@ public:
     void testThatNanIsConverted();
     void testNanSorting();
     void testAttributeMapLookup();
+    void testEnumAttributeGrouping();
     int Main() override;
 private:
     void testAggregationSimple(AggregationContext & ctx, const AggregationResult & aggr, const ResultNode & ir, const vespalib::string &name);
@@ -242,7 +251,11 @@ Test::testMerge(const Grouping &a, const Grouping &b,
     tmp.merge(tmpB);
     tmp.postMerge();
     tmp.sortById();
-    return EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
+    bool ok = EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
+    for (uint32_t numPartitions : {1, 3}) {
+        ok = testPartitionedMerge({a, b}, numPartitions, expect) && ok;
+    }
+    return ok;
 }
 
 /**
@@ -294,7 +307,46 @@ Test::testMerge(const Grouping &a, const Grouping &b, const Grouping &c,
     tmp.merge(tmpC);
     tmp.postMerge();
     tmp.sortById();
-    return EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
+    bool ok = EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
+    for (uint32_t numPartitions : {1, 2, 4}) {
+        ok = testPartitionedMerge({a, b, c}, numPartitions, expect) && ok;
+    }
+    return ok;
+}
+
+/**
+ * Merge the given grouping requests one partition at a time, like the
+ * match threads do, and verify that the resulting group tree matches
+ * the expected value.
+ **/
+bool
+Test::testPartitionedMerge(const std::vector<Grouping> &groupings, uint32_t numPartitions,
+                           const Group &expect)
+{
+    std::vector<Grouping> tmp = groupings; // create local copies
+    std::vector<std::vector<Group>> partitions;
+    for (Grouping &g : tmp) {
+        partitions.push_back(g.partition(numPartitions));
+    }
+    std::vector<Group> merged;
+    for (uint32_t p = 0; p < numPartitions; ++p) {
+        std::vector<Group *> parts;
+        for (std::vector<Group> &partition : partitions) {
+            parts.push_back(&partition[p]);
+        }
+        merged.push_back(tmp[p % tmp.size()].mergePartition(parts));
+    }
+    for (size_t i = 1; i < tmp.size(); ++i) {
+        tmp[0].merge(tmp[i]);
+    }
+    std::vector<Group *> mergedParts;
+    for (Group &g : merged) {
+        mergedParts.push_back(&g);
+    }
+    tmp[0].root().adoptChildren(mergedParts);
+    tmp[0].postMerge();
+    tmp[0].sortById();
+    return EXPECT_EQUAL(tmp[0].getRoot().asString(), expect.asString());
 }
 
 //-----------------------------------------------------------------------------
@@ -1946,6 +1998,89 @@ Test::testAttributeMapLookup()
     testAggregationSimple(ctx, MaxAggregationResult(), Int64ResultNode(100), "smap{attribute(key2)}.weight");
 }
 
+namespace {
+
+GroupingLevel
+createEnumGL(bool useEnum, int64_t maxGroups)
+{
+    auto classify = MU<AttributeNode>("estr");
+    classify->useEnumOptimization(useEnum);
+    GroupingLevel level;
+    level.setMaxGroups(maxGroups);
+    level.setExpression(std::move(classify));
+    level.addResult(createAggr<CountAggregationResult>(MU<ConstantNode>(MU<Int64ResultNode>(0))));
+    level.addResult(createAggr<SumAggregationResult>(MU<AttributeNode>("eint")));
+    level.addResult(createAggr<MinAggregationResult>(MU<AttributeNode>("efloat")));
+    level.addResult(createAggr<MaxAggregationResult>(MU<AttributeNode>("eint")));
+    level.addResult(createAggr<AverageAggregationResult>(MU<AttributeNode>("efloat")));
+    level.addOrderBy(MU<AggregationRefNode>(1), false);
+    return level;
+}
+
+Grouping
+createEnumGrouping(bool useEnum, int64_t maxGroups)
+{
+    Grouping request;
+    request.setFirstLevel(0).setLastLevel(1).addLevel(createEnumGL(useEnum, maxGroups));
+    request.setRoot(Group().addResult(createAggr<SumAggregationResult>(MU<AttributeNode>("eint"))));
+    return request;
+}
+
+}
+
+/**
+ * Verify that grouping on a single-value enum attribute with simple
+ * aggregations (handled by the columnar grouper) gives the same result
+ * as grouping on the string values.
+ **/
+void
+Test::testEnumAttributeGrouping()
+{
+    const uint32_t numDocs = 1000;
+    AggregationContext ctx;
+    auto estr = AttributeFactory::createAttribute("estr", Config(BasicType::STRING));
+    auto eint = AttributeFactory::createAttribute("eint", Config(BasicType::INT64));
+    auto efloat = AttributeFactory::createAttribute("efloat", Config(BasicType::DOUBLE));
+    for (AttributeVector::SP attr : {estr, eint, efloat}) {
+        attr->addReservedDoc();
+        attr->addDocs(numDocs - 1);
+    }
+    for (uint32_t docid = 1; docid < numDocs; ++docid) {
+        static_cast<StringAttribute &>(*estr).update(docid, make_string("group%u", (docid * 7) % 37).c_str());
+        static_cast<IntegerAttribute &>(*eint).update(docid, (docid * 13) % 101 - 50);
+        static_cast<FloatingPointAttribute &>(*efloat).update(docid, docid * 0.25);
+        ctx.result().add(docid, (docid * 17) % 89);
+    }
+    for (AttributeVector::SP attr : {estr, eint, efloat}) {
+        attr->commit();
+        ctx.add(attr);
+    }
+    for (int64_t maxGroups : {-1, 5}) {
+        Grouping fast = createEnumGrouping(true, maxGroups);
+        Grouping generic = createEnumGrouping(false, maxGroups);
+        ctx.setup(fast);
+        ctx.setup(generic);
+        fast.preAggregate(false);
+        generic.preAggregate(false);
+        EXPECT_TRUE(ColumnarGrouper::create(fast));
+        EXPECT_FALSE(ColumnarGrouper::create(generic));
+        fast.postAggregate();
+        generic.postAggregate();
+        fast.aggregate(ctx.result().hits(), ctx.result().size());
+        generic.aggregate(ctx.result().hits(), ctx.result().size());
+        EXPECT_EQUAL(maxGroups == -1 ? 37u : 5u, fast.getRoot().getChildrenSize());
+        EXPECT_EQUAL(generic.getRoot().asString(), fast.getRoot().asString());
+    }
+    {
+        Grouping request = createEnumGrouping(true, -1);
+        request.levels()[0].addResult(createAggr<XorAggregationResult>(MU<AttributeNode>("eint")));
+        ctx.setup(request);
+        request.preAggregate(false);
+        EXPECT_FALSE(ColumnarGrouper::create(request));
+        request.postAggregate();
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 struct RunDiff { ~RunDiff() { system("diff -u lhs.out rhs.out > diff.txt"); }};
@@ -1979,6 +2114,7 @@ Test::Main()
     testThatNanIsConverted();
     testNanSorting();
     testAttributeMapLookup();
+    TEST_DO(testEnumAttributeGrouping());
     TEST_DONE();
 }
 
@@ -0,0 +1,105 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for tdigest.
+
+#include <vespa/log/log.h>
+LOG_SETUP("tdigest_test");
+
+#include <vespa/searchlib/grouping/tdigest.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <algorithm>
+#include <cmath>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+std::vector<double>
+makeValues(size_t n, long seed)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(seed);
+    std::vector<double> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(rnd.lrand48() % 100000);
+    }
+    return values;
+}
+
+double
+exactQuantile(std::vector<double> values, double q)
+{
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, size_t(q * values.size()))];
+}
+
+TEST("require that empty tdigest has no quantiles") {
+    TDigest digest;
+    EXPECT_TRUE(digest.empty());
+    EXPECT_TRUE(std::isnan(digest.quantile(0.5)));
+}
+
+TEST("require that tdigest with a single value returns it for all quantiles") {
+    TDigest digest;
+    digest.add(42.0);
+    EXPECT_EQUAL(42.0, digest.quantile(0.0));
+    EXPECT_EQUAL(42.0, digest.quantile(0.5));
+    EXPECT_EQUAL(42.0, digest.quantile(1.0));
+}
+
+TEST("require that tdigest estimates quantiles with bounded size") {
+    std::vector<double> values = makeValues(100000, 1);
+    TDigest digest;
+    for (double v : values) {
+        digest.add(v);
+    }
+    EXPECT_EQUAL(100000.0, digest.getCount());
+    EXPECT_LESS(digest.getCentroids().size(), 200u);
+    for (double q : {0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+        EXPECT_APPROX(exactQuantile(values, q), digest.quantile(q), 500.0);
+    }
+    EXPECT_EQUAL(*std::min_element(values.begin(), values.end()), digest.quantile(0.0));
+    EXPECT_EQUAL(*std::max_element(values.begin(), values.end()), digest.quantile(1.0));
+}
+
+TEST("require that merged tdigests estimate quantiles of the union") {
+    std::vector<double> all;
+    TDigest merged;
+    for (long seed = 1; seed <= 8; ++seed) {
+        std::vector<double> values = makeValues(10000, seed);
+        TDigest part;
+        for (double v : values) {
+            part.add(v);
+        }
+        merged.merge(part);
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    EXPECT_EQUAL(80000.0, merged.getCount());
+    EXPECT_LESS(merged.getCentroids().size(), 200u);
+    for (double q : {0.01, 0.5, 0.99}) {
+        EXPECT_APPROX(exactQuantile(all, q), merged.quantile(q), 500.0);
+    }
+}
+
+TEST("require that tdigest can be (de)serialized") {
+    TDigest digest;
+    for (double v : makeValues(1000, 3)) {
+        digest.add(v);
+    }
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    digest.serialize(serializer);
+    TDigest digest2(10.0);
+    digest2.deserialize(serializer);
+    EXPECT_TRUE(stream.empty());
+    EXPECT_TRUE(digest == digest2);
+    EXPECT_EQUAL(digest.quantile(0.75), digest2.quantile(0.75));
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
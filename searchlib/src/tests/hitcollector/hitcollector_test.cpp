@@ -23,6 +23,16 @@ struct BasicScorer : public HitCollector::DocumentScorer
     }
 };
 
+struct BatchScorer : public BasicScorer
+{
+    std::vector<std::vector<uint32_t>> batches;
+    explicit BatchScorer(feature_t scoreDelta) : BasicScorer(scoreDelta), batches() {}
+    void score_batch(vespalib::ConstArrayRef<uint32_t> docIds, vespalib::ArrayRef<feature_t> scores) override {
+        batches.emplace_back(docIds.begin(), docIds.end());
+        BasicScorer::score_batch(docIds, scores);
+    }
+};
+
 struct PredefinedScorer : public HitCollector::DocumentScorer
 {
     ScoreMap _scores;
@@ -217,6 +227,18 @@ TEST_F("testReRank - descending", DescendingScoreFixture)
     TEST_DO(checkResult(*rs, f.expBv.get()));
 }
 
+TEST_F("require that documents are re-ranked as a single batch in doc id order", DescendingScoreFixture)
+{
+    f.addHits();
+    BatchScorer scorer(200);
+    EXPECT_EQUAL(5u, f.hc.reRank(scorer, extract(f.hc.getSortedHitSequence(5))));
+    ASSERT_EQUAL(1u, scorer.batches.size());
+    EXPECT_TRUE(std::vector<uint32_t>({0, 1, 2, 3, 4}) == scorer.batches[0]);
+    std::unique_ptr<ResultSet> rs = f.hc.getResultSet();
+    EXPECT_EQUAL(200.0, rs->getArray()[0]._rankValue);
+    EXPECT_EQUAL(204.0, rs->getArray()[4]._rankValue);
+}
+
 TEST_F("testReRank - partial", AscendingScoreFixture)
 {
     f.addHits();
@@ -5,12 +5,14 @@
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <cinttypes>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
+using search::queryeval::BlockMaxPostingInfo;
 using search::queryeval::SearchIterator;
 
 using namespace search::index;
@@ -57,6 +59,53 @@ test_fake(const std::string& posting_type,
     validate_posting_list_for_word(*posting, word);
 }
 
+void
+validate_block_max_weights_for_word(const std::string& posting_type,
+                                    const Schema& schema,
+                                    const FakeWord& word)
+{
+    std::unique_ptr<FPFactory> factory(getFPFactory(posting_type, schema));
+    std::vector<const FakeWord *> words;
+    words.push_back(&word);
+    factory->setup(words);
+    auto posting = factory->make(word);
+
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    md.setNeedNormalFeatures(true);
+    md.setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+    std::unique_ptr<SearchIterator> iterator(posting->createIterator(tfmda));
+    auto block_max = dynamic_cast<const BlockMaxPostingInfo *>(iterator->getPostingInfo());
+    ASSERT_TRUE(block_max != nullptr);
+    iterator->initFullRange();
+    // Max weight reported for the current block and max weight actually seen in it
+    uint32_t block_end = 0;
+    int32_t block_max_weight = 0;
+    int32_t seen_max_weight = std::numeric_limits<int32_t>::min();
+    for (const auto& doc : word._postings) {
+        ASSERT_TRUE(iterator->seek(doc._docId));
+        iterator->unpack(doc._docId);
+        if (doc._docId > block_end) {
+            if (block_end != 0) {
+                EXPECT_EQ(block_max_weight, seen_max_weight);
+            }
+            block_end = block_max->get_block_max_weight(doc._docId, block_max_weight);
+            seen_max_weight = std::numeric_limits<int32_t>::min();
+            ASSERT_LE(doc._docId, block_end);
+        }
+        for (const auto& pos : md) {
+            EXPECT_LE(pos.getElementWeight(), block_max_weight);
+            seen_max_weight = std::max(seen_max_weight, pos.getElementWeight());
+        }
+    }
+    EXPECT_EQ(block_max_weight, seen_max_weight);
+    int32_t tail_max_weight = 0;
+    uint32_t tail_end = block_max->get_block_max_weight(word._postings.back()._docId + 1, tail_max_weight);
+    EXPECT_EQ(word._docIdLimit - 1, tail_end);
+    EXPECT_EQ(0, tail_max_weight);
+}
+
 struct PostingListTest : public ::testing::Test {
     uint32_t num_docs;
     std::vector<std::string> posting_types;
@@ -119,6 +168,14 @@ struct PostingListTest : public ::testing::Test {
         }
     }
 
+    void run_block_max() {
+        for (const auto& type : {"Zc4SkipPosOccBE.cf.bm", "Zc4SkipPosOccLE.cf.bm"}) {
+            validate_block_max_weights_for_word(type, word_set.getSchema(), *word2);
+            validate_block_max_weights_for_word(type, word_set.getSchema(), *word3);
+            validate_block_max_weights_for_word(type, word_set.getSchema(), *word4);
+        }
+    }
+
 };
 
 TEST_F(PostingListTest, verify_posting_list_iterators_over_single_value_field)
@@ -139,4 +196,16 @@ TEST_F(PostingListTest, verify_posting_list_iterators_over_weighted_set_field)
     run();
 }
 
+TEST_F(PostingListTest, verify_block_max_weights_over_single_value_field)
+{
+    setup(false, false);
+    run_block_max();
+}
+
+TEST_F(PostingListTest, verify_block_max_weights_over_weighted_set_field)
+{
+    setup(true, true);
+    run_block_max();
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
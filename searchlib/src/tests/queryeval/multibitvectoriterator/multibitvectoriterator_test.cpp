@@ -342,6 +342,12 @@ Test::searchAndCompare(SearchIterator::UP s, uint32_t docIdLimit)
         for (size_t i(0); i < a.size(); i++) {
             EXPECT_EQUAL(a[i], b[i]);
         }
+        s->initRange(1, docIdLimit);
+        BitVector::UP hits = s->get_hits(1);
+        EXPECT_EQUAL(a.size(), hits->countTrueBits());
+        for (uint32_t docId : a) {
+            EXPECT_TRUE(hits->testBit(docId));
+        }
     }
 }
 
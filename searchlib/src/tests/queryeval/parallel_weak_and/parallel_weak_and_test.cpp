@@ -689,4 +689,112 @@ TEST("verify search iterator conformance") {
     }
 }
 
+/**
+ * Fake search exposing max weights per block of documents (given as
+ * last docid and max weight for each block) and counting unpacks.
+ **/
+class BlockMaxSearch : public FakeSearch, public BlockMaxPostingInfo
+{
+private:
+    std::vector<std::pair<uint32_t, int32_t>> _blocks;
+    uint32_t &_unpacks;
+
+    static search::fef::TermFieldMatchDataArray makeArray(TermFieldMatchData &tfmd) {
+        search::fef::TermFieldMatchDataArray array;
+        array.add(&tfmd);
+        return array;
+    }
+public:
+    BlockMaxSearch(const FakeResult &result, TermFieldMatchData &tfmd,
+                   const std::vector<std::pair<uint32_t, int32_t>> &blocks, uint32_t &unpacks)
+        : FakeSearch("<tag>", "<field>", "<term>", result, makeArray(tfmd)),
+          _blocks(blocks),
+          _unpacks(unpacks)
+    {}
+    void doUnpack(uint32_t docid) override {
+        ++_unpacks;
+        FakeSearch::doUnpack(docid);
+    }
+    const PostingInfo *getPostingInfo() const override {
+        return _blocks.empty() ? nullptr : static_cast<const BlockMaxPostingInfo *>(this);
+    }
+    uint32_t get_block_max_weight(uint32_t docId, int32_t &maxWeight) const override {
+        for (const auto &block : _blocks) {
+            if (docId <= block.first) {
+                maxWeight = block.second;
+                return block.first;
+            }
+        }
+        maxWeight = 0;
+        return search::endDocId - 1;
+    }
+};
+
+struct BlockMaxFixture
+{
+    SharedWeakAndPriorityQueue heap;
+    TermFieldMatchData         rootMatchData;
+    uint32_t                   unpacks;
+    FakeResult                 result;
+
+    BlockMaxFixture(bool use_block_max, bool strict)
+        : heap(1),
+          rootMatchData(),
+          unpacks(0),
+          result()
+    {
+        FakeResult a;
+        FakeResult b;
+        for (uint32_t docid = 1; docid <= 64; ++docid) {
+            int32_t weight = (docid == 10) ? 50 : ((docid == 60) ? 60 : 1);
+            a.doc(docid).weight(weight).pos(0);
+            b.doc(docid).weight(1).pos(0);
+        }
+        std::vector<std::pair<uint32_t, int32_t>> a_blocks;
+        std::vector<std::pair<uint32_t, int32_t>> b_blocks;
+        if (use_block_max) {
+            a_blocks = {{16, 50}, {32, 1}, {48, 1}, {64, 60}};
+            b_blocks = {{64, 1}};
+        }
+        MatchDataLayout layout;
+        TermFieldHandle a_handle = layout.allocTermField(0);
+        TermFieldHandle b_handle = layout.allocTermField(0);
+        MatchData::UP childrenMatchData = layout.createMatchData();
+        TermFieldMatchData *a_tfmd = childrenMatchData->resolveTermField(a_handle);
+        TermFieldMatchData *b_tfmd = childrenMatchData->resolveTermField(b_handle);
+        wand::Terms terms;
+        terms.push_back(wand::Term(new BlockMaxSearch(a, *a_tfmd, a_blocks, unpacks), 1, 64, a_tfmd));
+        terms.push_back(wand::Term(new BlockMaxSearch(b, *b_tfmd, b_blocks, unpacks), 1, 64, b_tfmd));
+        MatchParams matchParams(heap, 0, 1.0, 1);
+        SearchIterator::UP search(ParallelWeakAndSearch::create(terms, matchParams,
+                                                                RankParams(rootMatchData, std::move(childrenMatchData)),
+                                                                strict));
+        if (strict) {
+            result = doSearch(*search, rootMatchData);
+        } else {
+            search->initFullRange();
+            for (uint32_t docid = 1; docid <= 64; ++docid) {
+                if (search->seek(docid)) {
+                    search->unpack(docid);
+                    result.doc(docid).score(rootMatchData.getRawScore());
+                }
+            }
+        }
+    }
+};
+
+TEST("require that blocks that cannot beat the score threshold are skipped") {
+    for (bool strict : {true, false}) {
+        BlockMaxFixture plain(false, strict);
+        BlockMaxFixture block_max(true, strict);
+        FakeResult expect = FakeResult()
+                            .doc(1).score(2)
+                            .doc(10).score(51)
+                            .doc(60).score(61);
+        EXPECT_EQUAL(expect, plain.result);
+        EXPECT_EQUAL(expect, block_max.result);
+        EXPECT_LESS(block_max.unpacks, plain.unpacks);
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
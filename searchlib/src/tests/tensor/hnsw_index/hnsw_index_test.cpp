@@ -7,6 +7,11 @@
 #include <vespa/searchlib/tensor/hnsw_index.h>
 #include <vespa/searchlib/tensor/random_level_generator.h>
 #include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index_saver.h>
+#include <vespa/searchlib/tensor/product_quantizer.h>
+#include <vespa/searchlib/tensor/scalar_int8_quantizer.h>
+#include <vespa/searchlib/util/bufferwriter.h>
+#include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -21,6 +26,9 @@ using namespace search::tensor;
 using namespace vespalib::slime;
 using vespalib::Slime;
 using search::BitVector;
+using search::BufferWriter;
+using search::attribute::DistanceMetric;
+using search::fileutil::LoadedBuffer;
 
 
 template <typename FloatType>
@@ -51,6 +59,29 @@ struct LevelGenerator : public RandomLevelGenerator {
     uint32_t max_level() override { return level; }
 };
 
+class VectorBufferWriter : public BufferWriter {
+private:
+    char tmp[1024];
+public:
+    std::vector<char> output;
+    VectorBufferWriter() {
+        setup(tmp, 1024);
+    }
+    ~VectorBufferWriter() {}
+    void flush() override {
+        for (size_t i = 0; i < usedLen(); ++i) {
+            output.push_back(tmp[i]);
+        }
+        rewind();
+    }
+};
+
+VectorQuantizer::UP
+make_product_quantizer(uint32_t num_centroids = ProductQuantizer::max_centroids)
+{
+    return std::make_unique<ProductQuantizer>(DistanceMetric::Euclidean, 2, 1, num_centroids, 5);
+}
+
 using FloatVectors = MyDocVectorAccess<float>;
 using FloatSqEuclideanDistance = SquaredEuclideanDistance<float>;
 using HnswIndexUP = std::unique_ptr<HnswIndex>;
@@ -77,12 +108,16 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    HnswIndexUP make_index(bool heuristic_select_neighbors, VectorQuantizer::UP quantizer) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
-        index = std::make_unique<HnswIndex>(vectors, std::make_unique<FloatSqEuclideanDistance>(),
-                                            std::move(generator),
-                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors));
+        return std::make_unique<HnswIndex>(vectors, std::make_unique<FloatSqEuclideanDistance>(),
+                                           std::move(generator),
+                                           HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors),
+                                           std::move(quantizer));
+    }
+    void init(bool heuristic_select_neighbors, VectorQuantizer::UP quantizer = VectorQuantizer::UP()) {
+        index = make_index(heuristic_select_neighbors, std::move(quantizer));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -99,6 +134,18 @@ public:
         gen_handler.updateFirstUsedGeneration();
         index->trim_hold_lists(gen_handler.getFirstUsedGeneration());
     }
+    std::vector<char> save_index() const {
+        auto saver = index->make_saver();
+        VectorBufferWriter writer;
+        saver->save(writer);
+        return writer.output;
+    }
+    HnswIndexUP load_index(std::vector<char> data, VectorQuantizer::UP quantizer) {
+        auto result = make_index(false, std::move(quantizer));
+        LoadedBuffer buffer(&data[0], data.size());
+        EXPECT_TRUE(result->load(buffer));
+        return result;
+    }
     void set_filter(std::vector<uint32_t> docids) {
         uint32_t sz = 10;
         global_filter = BitVector::create(sz);
@@ -220,6 +267,135 @@ TEST_F(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_select_ne
     expect_top_3(9, {3, 2});
 }
 
+TEST_F(HnswIndexTest, 2d_vectors_searched_using_int8_quantized_vectors_are_rescored)
+{
+    init(false, std::make_unique<ScalarInt8Quantizer>(DistanceMetric::Euclidean, 2));
+    ASSERT_TRUE(index->quantized_vectors() != nullptr);
+    EXPECT_TRUE(index->quantized_vectors()->ready());
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    expect_top_3(2, {2, 1, 3});
+    expect_top_3(5, {5, 6, 2});
+    expect_top_3(9, {7, 3, 2});
+    auto qv = vectors.get_vector(4);
+    auto candidates = index->top_k_candidates(qv, 3, nullptr);
+    // Distances are calculated using the original cells.
+    for (const auto & hit : candidates.peek()) {
+        EXPECT_DOUBLE_EQ(index->distance_function()->calc(qv, vectors.get_vector(hit.docid)), hit.distance);
+    }
+    set_filter({2,3,4,6});
+    expect_top_3(5, {6, 2});
+    expect_top_3(9, {3, 2});
+}
+
+TEST_F(HnswIndexTest, product_quantizer_is_trained_when_enough_documents_are_added)
+{
+    init(false, make_product_quantizer());
+    EXPECT_FALSE(index->quantized_vectors()->ready());
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        add_document(docid);
+    }
+    index->sync_quantizer_training();
+    commit();
+    EXPECT_FALSE(index->quantized_vectors()->ready());
+    add_document(5);
+    // Training is done in the background, and the quantized vectors are made ready by the writer thread.
+    index->sync_quantizer_training();
+    commit();
+    EXPECT_TRUE(index->quantized_vectors()->ready());
+    add_document(6);
+    add_document(7);
+    // The codebook is trained on docs 1-5, so docs 6 and 7 are only approximated.
+    // All docs are explored, and re-scoring using the original cells gives the exact top 3.
+    auto result = index->find_top_k(3, vectors.get_vector(6), 10);
+    ASSERT_EQ(3, result.size());
+    EXPECT_EQ(2, result[0].docid);
+    EXPECT_EQ(5, result[1].docid);
+    EXPECT_EQ(6, result[2].docid);
+    {
+        Slime actualSlime;
+        SlimeInserter inserter(actualSlime);
+        index->get_state(inserter);
+        const auto &root = actualSlime.get();
+        EXPECT_EQ("product", root["quantization"]["type"].asString().make_string());
+        EXPECT_EQ(6, root["quantization"]["code_size"].asLong());
+        EXPECT_TRUE(root["quantization"]["ready"].asBool());
+    }
+}
+
+TEST_F(HnswIndexTest, quantized_vectors_are_saved_and_loaded_together_with_graph)
+{
+    init(false, make_product_quantizer());
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    index->sync_quantizer_training();
+    commit();
+    ASSERT_TRUE(index->quantized_vectors()->ready());
+    auto data = save_index();
+    auto copy = load_index(data, make_product_quantizer());
+    ASSERT_TRUE(copy->quantized_vectors()->ready());
+    auto result = copy->find_top_k(3, vectors.get_vector(6), 10);
+    ASSERT_EQ(3, result.size());
+    EXPECT_EQ(2, result[0].docid);
+    EXPECT_EQ(5, result[1].docid);
+    EXPECT_EQ(6, result[2].docid);
+    // The codes are not recreated from the original cells, which are changed here.
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        vectors.set(docid, {0, 0});
+    }
+    copy = load_index(data, make_product_quantizer());
+    ASSERT_TRUE(copy->quantized_vectors()->ready());
+    size_t code_size = index->quantized_vectors()->quantizer().code_size();
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        EXPECT_EQ(0, memcmp(index->quantized_vectors()->get(docid), copy->quantized_vectors()->get(docid), code_size));
+    }
+}
+
+TEST_F(HnswIndexTest, quantized_vectors_added_after_saver_is_created_are_not_saved)
+{
+    init(false, make_product_quantizer());
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    index->sync_quantizer_training();
+    commit();
+    size_t code_size = index->quantized_vectors()->quantizer().code_size();
+    std::vector<uint8_t> codes(index->quantized_vectors()->get_codes().cbegin(),
+                               index->quantized_vectors()->get_codes().cbegin() + 8 * code_size);
+    auto guard = take_read_guard();
+    auto saver = index->make_saver();
+    add_document(8);
+    add_document(9);
+    EXPECT_EQ(10 * code_size, index->quantized_vectors()->get_codes().size());
+    VectorBufferWriter writer;
+    saver->save(writer);
+    auto copy = load_index(writer.output, make_product_quantizer());
+    ASSERT_TRUE(copy->quantized_vectors()->ready());
+    EXPECT_EQ(7, copy->count_reachable_nodes());
+    auto copy_codes = copy->quantized_vectors()->get_codes();
+    ASSERT_EQ(codes.size(), copy_codes.size());
+    EXPECT_EQ(0, memcmp(codes.data(), copy_codes.cbegin(), codes.size()));
+}
+
+TEST_F(HnswIndexTest, quantized_vectors_are_recreated_on_load_when_saved_with_other_quantizer)
+{
+    init(false, make_product_quantizer());
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        add_document(docid);
+    }
+    index->sync_quantizer_training();
+    commit();
+    auto data = save_index();
+    auto copy = load_index(data, make_product_quantizer(4));
+    EXPECT_TRUE(copy->quantized_vectors()->ready());
+    EXPECT_EQ(7, copy->count_reachable_nodes());
+    copy = load_index(data, std::make_unique<ScalarInt8Quantizer>(DistanceMetric::Euclidean, 2));
+    EXPECT_TRUE(copy->quantized_vectors()->ready());
+    EXPECT_EQ(7, copy->count_reachable_nodes());
+}
+
 TEST_F(HnswIndexTest, 2d_vectors_inserted_and_removed)
 {
     init(false);
@@ -0,0 +1,163 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/vector_quantizer_factory.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_quantization_benchmark");
+
+/**
+ * Measures recall, query latency and memory usage of a hnsw index
+ * searched with and without quantized vectors.
+ *
+ * Usage: hnsw_quantization_benchmark [num_docs] [dims] [num_queries]
+ */
+
+using namespace search::tensor;
+using search::attribute::DistanceMetric;
+using search::attribute::VectorQuantization;
+using vespalib::eval::ValueType;
+using vespalib::tensor::TypedCells;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr uint32_t top_k = 10;
+constexpr uint32_t explore_k = 100;
+constexpr uint32_t max_links = 16;
+
+double
+elapsed_ms(clock_type::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+class BenchVectors : public DocVectorAccess {
+private:
+    size_t _dims;
+    std::vector<float> _cells;
+public:
+    BenchVectors(size_t num_vectors, size_t dims, uint64_t seed)
+        : _dims(dims),
+          _cells((num_vectors + 1) * dims)
+    {
+        // Vectors are clustered around a set of random centers, which is closer to real embeddings than uniform data.
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<float> center_dist(0.0, 1.0);
+        std::normal_distribution<float> noise_dist(0.0, 0.25);
+        std::vector<float> centers(100 * dims);
+        for (auto& cell : centers) {
+            cell = center_dist(rng);
+        }
+        for (size_t docid = 1; docid <= num_vectors; ++docid) {
+            const float* center = &centers[(rng() % 100) * dims];
+            for (size_t i = 0; i < dims; ++i) {
+                _cells[docid * dims + i] = center[i] + noise_dist(rng);
+            }
+        }
+    }
+    TypedCells get_vector(uint32_t docid) const override {
+        return TypedCells(vespalib::ConstArrayRef<float>(&_cells[docid * _dims], _dims));
+    }
+    size_t num_vectors() const { return (_cells.size() / _dims) - 1; }
+};
+
+std::vector<uint32_t>
+exact_top_k(const BenchVectors& docs, const DistanceFunction& distance, const TypedCells& query)
+{
+    std::vector<std::pair<double, uint32_t>> all;
+    all.reserve(docs.num_vectors());
+    for (uint32_t docid = 1; docid <= docs.num_vectors(); ++docid) {
+        all.emplace_back(distance.calc(query, docs.get_vector(docid)), docid);
+    }
+    std::partial_sort(all.begin(), all.begin() + top_k, all.end());
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < top_k; ++i) {
+        result.push_back(all[i].second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+const char*
+to_string(VectorQuantization variant)
+{
+    switch (variant) {
+    case VectorQuantization::None: return "none";
+    case VectorQuantization::Int8: return "int8";
+    case VectorQuantization::Product: return "product";
+    }
+    return "unknown";
+}
+
+void
+run_benchmark(VectorQuantization variant, DistanceMetric metric, const BenchVectors& docs, const BenchVectors& queries,
+              const std::vector<std::vector<uint32_t>>& expected)
+{
+    size_t dims = docs.get_vector(1).size;
+    HnswIndex index(docs, make_distance_function(metric, ValueType::CellType::FLOAT),
+                    std::make_unique<InvLogLevelGenerator>(max_links),
+                    HnswIndex::Config(max_links * 2, max_links, 200, 10000, true),
+                    make_vector_quantizer(variant, metric, dims));
+    auto build_start = clock_type::now();
+    for (uint32_t docid = 1; docid <= docs.num_vectors(); ++docid) {
+        index.add_document(docid);
+    }
+    // Waits for background training of the quantizer, and lets the writer thread encode all documents (as done on commit).
+    index.sync_quantizer_training();
+    index.transfer_hold_lists(0);
+    double build_ms = elapsed_ms(build_start);
+    size_t hits = 0;
+    auto query_start = clock_type::now();
+    for (uint32_t i = 1; i <= queries.num_vectors(); ++i) {
+        auto result = index.find_top_k(top_k, queries.get_vector(i), explore_k);
+        const auto& exp = expected[i - 1];
+        for (const auto& neighbor : result) {
+            hits += std::binary_search(exp.begin(), exp.end(), neighbor.docid) ? 1 : 0;
+        }
+    }
+    double query_ms = elapsed_ms(query_start) / queries.num_vectors();
+    double recall = double(hits) / (queries.num_vectors() * top_k);
+    size_t vector_bytes = docs.num_vectors() * dims * sizeof(float);
+    const auto* quantized = index.quantized_vectors();
+    size_t traversal_bytes = (quantized != nullptr) ? docs.num_vectors() * quantized->quantizer().code_size() : vector_bytes;
+    fprintf(stderr, "quantization=%-8s build=%8.0f ms  query=%7.3f ms  recall@%u=%.4f  traversal vector memory=%6.2f MB (%.1fx)\n",
+            to_string(variant), build_ms, query_ms, top_k, recall,
+            traversal_bytes / (1024.0 * 1024.0), double(vector_bytes) / traversal_bytes);
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+    size_t num_docs = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 20000;
+    size_t dims = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 128;
+    size_t num_queries = (argc > 3) ? strtoul(argv[3], nullptr, 0) : 200;
+    fprintf(stderr, "docs=%zu dims=%zu queries=%zu explore_k=%u\n", num_docs, dims, num_queries, explore_k);
+    BenchVectors docs(num_docs, dims, 0x1234deadbeef5678uLL);
+    BenchVectors queries(num_queries, dims, 0x8765beefdead4321uLL);
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular}) {
+        fprintf(stderr, "distance metric: %s\n", (metric == DistanceMetric::Euclidean) ? "euclidean" : "angular");
+        auto distance = make_distance_function(metric, ValueType::CellType::FLOAT);
+        std::vector<std::vector<uint32_t>> expected;
+        for (uint32_t i = 1; i <= num_queries; ++i) {
+            expected.push_back(exact_top_k(docs, *distance, queries.get_vector(i)));
+        }
+        for (auto variant : {VectorQuantization::None, VectorQuantization::Int8, VectorQuantization::Product}) {
+            run_benchmark(variant, metric, docs, queries, expected);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/product_quantizer.h>
+#include <vespa/searchlib/tensor/scalar_int8_quantizer.h>
+#include <vespa/searchlib/tensor/vector_quantizer_factory.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <random>
+#include <vector>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vector_quantizer_test");
+
+using namespace search::tensor;
+using search::attribute::DistanceMetric;
+using search::attribute::VectorQuantization;
+using vespalib::eval::ValueType;
+using vespalib::tensor::TypedCells;
+
+using FloatVector = std::vector<float>;
+
+std::vector<FloatVector>
+make_random_vectors(size_t num_vectors, size_t dims)
+{
+    std::mt19937_64 rng(0x1234deadbeef5678uLL);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<FloatVector> result(num_vectors, FloatVector(dims));
+    for (auto& vector : result) {
+        for (auto& cell : vector) {
+            cell = dist(rng);
+        }
+    }
+    return result;
+}
+
+TypedCells cells(const FloatVector& vector) { return TypedCells(vespalib::ConstArrayRef<float>(vector)); }
+
+std::vector<uint8_t>
+encode(const VectorQuantizer& quantizer, const FloatVector& vector)
+{
+    std::vector<uint8_t> code(quantizer.code_size());
+    quantizer.encode(cells(vector), code.data());
+    return code;
+}
+
+void
+expect_approximate_distances(const VectorQuantizer& quantizer, DistanceMetric metric,
+                             const std::vector<FloatVector>& vectors, double max_relative_error)
+{
+    auto exact = make_distance_function(metric, ValueType::CellType::FLOAT);
+    const auto& query = vectors[0];
+    auto approx = quantizer.make_distance(cells(query));
+    for (size_t i = 1; i < vectors.size(); ++i) {
+        auto code = encode(quantizer, vectors[i]);
+        double exp = exact->calc(cells(query), cells(vectors[i]));
+        double act = approx->calc(code.data());
+        EXPECT_NEAR(exp, act, max_relative_error * std::max(1.0, exp)) << "vector " << i;
+    }
+}
+
+TEST(VectorQuantizerTest, factory_creates_quantizer_for_supported_metrics)
+{
+    EXPECT_FALSE(make_vector_quantizer(VectorQuantization::None, DistanceMetric::Euclidean, 8));
+    EXPECT_EQ("int8", vespalib::string(make_vector_quantizer(VectorQuantization::Int8, DistanceMetric::Angular, 8)->name()));
+    EXPECT_EQ("product", vespalib::string(make_vector_quantizer(VectorQuantization::Product, DistanceMetric::InnerProduct, 8)->name()));
+    EXPECT_FALSE(make_vector_quantizer(VectorQuantization::Int8, DistanceMetric::Hamming, 8));
+    EXPECT_FALSE(make_vector_quantizer(VectorQuantization::Product, DistanceMetric::GeoDegrees, 2));
+}
+
+TEST(VectorQuantizerTest, int8_quantizer_has_expected_code_size)
+{
+    ScalarInt8Quantizer quantizer(DistanceMetric::Euclidean, 768);
+    EXPECT_EQ(776, quantizer.code_size());
+    EXPECT_EQ(0, quantizer.wanted_training_samples());
+}
+
+TEST(VectorQuantizerTest, int8_quantizer_approximates_distances)
+{
+    auto vectors = make_random_vectors(50, 64);
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular}) {
+        ScalarInt8Quantizer quantizer(metric, 64);
+        expect_approximate_distances(quantizer, metric, vectors, 0.05);
+    }
+}
+
+TEST(VectorQuantizerTest, int8_quantizer_approximates_inner_product_distance_for_normalized_vectors)
+{
+    auto vectors = make_random_vectors(50, 64);
+    for (auto& vector : vectors) {
+        double norm_sq = 0.0;
+        for (float cell : vector) {
+            norm_sq += cell * cell;
+        }
+        for (float& cell : vector) {
+            cell /= std::sqrt(norm_sq);
+        }
+    }
+    ScalarInt8Quantizer quantizer(DistanceMetric::InnerProduct, 64);
+    expect_approximate_distances(quantizer, DistanceMetric::InnerProduct, vectors, 0.05);
+}
+
+TEST(VectorQuantizerTest, int8_quantizer_handles_zero_vector)
+{
+    ScalarInt8Quantizer quantizer(DistanceMetric::Euclidean, 3);
+    FloatVector zero{0, 0, 0};
+    FloatVector other{1, 2, 2};
+    auto code = encode(quantizer, zero);
+    EXPECT_NEAR(9.0, quantizer.make_distance(cells(other))->calc(code.data()), 0.01);
+}
+
+TEST(VectorQuantizerTest, product_quantizer_has_expected_code_size)
+{
+    ProductQuantizer quantizer(DistanceMetric::Euclidean, 768);
+    EXPECT_EQ(192, quantizer.num_subspaces());
+    EXPECT_EQ(196, quantizer.code_size());
+    ProductQuantizer uneven(DistanceMetric::Euclidean, 10, 4);
+    EXPECT_EQ(3, uneven.num_subspaces());
+}
+
+TEST(VectorQuantizerTest, product_quantizer_gives_exact_distances_when_training_samples_fit_in_codebook)
+{
+    auto vectors = make_random_vectors(100, 10);
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular}) {
+        ProductQuantizer quantizer(metric, 10, 4, ProductQuantizer::max_centroids, 100);
+        std::vector<TypedCells> samples;
+        for (const auto& vector : vectors) {
+            samples.push_back(cells(vector));
+        }
+        quantizer.train(samples);
+        expect_approximate_distances(quantizer, metric, vectors, 1e-5);
+    }
+}
+
+TEST(VectorQuantizerTest, product_quantizer_approximates_distances_after_kmeans_training)
+{
+    auto vectors = make_random_vectors(2000, 16);
+    ProductQuantizer quantizer(DistanceMetric::Euclidean, 16, 2, ProductQuantizer::max_centroids, 2000);
+    std::vector<TypedCells> samples;
+    for (const auto& vector : vectors) {
+        samples.push_back(cells(vector));
+    }
+    quantizer.train(samples);
+    auto exact = make_distance_function(DistanceMetric::Euclidean, ValueType::CellType::FLOAT);
+    auto approx = quantizer.make_distance(cells(vectors[0]));
+    double sum_error = 0.0;
+    double sum_exact = 0.0;
+    for (size_t i = 1; i < vectors.size(); ++i) {
+        auto code = encode(quantizer, vectors[i]);
+        sum_error += std::abs(exact->calc(cells(vectors[0]), cells(vectors[i])) - approx->calc(code.data()));
+        sum_exact += exact->calc(cells(vectors[0]), cells(vectors[i]));
+    }
+    EXPECT_LT(sum_error / sum_exact, 0.1);
+}
+
+TEST(VectorQuantizerTest, product_quantizer_supports_fewer_centroids)
+{
+    auto vectors = make_random_vectors(100, 8);
+    ProductQuantizer quantizer(DistanceMetric::Euclidean, 8, 2, 16, 100);
+    EXPECT_EQ(16, quantizer.num_centroids());
+    std::vector<TypedCells> samples;
+    for (const auto& vector : vectors) {
+        samples.push_back(cells(vector));
+    }
+    quantizer.train(samples);
+    for (const auto& vector : vectors) {
+        auto code = encode(quantizer, vector);
+        for (size_t i = 0; i < quantizer.num_subspaces(); ++i) {
+            EXPECT_LT(code[ProductQuantizer::header_size + i], 16);
+        }
+    }
+    EXPECT_EQ(256, ProductQuantizer(DistanceMetric::Euclidean, 8, 2, 1000).num_centroids());
+}
+
+TEST(VectorQuantizerTest, product_quantizer_state_is_saved_and_loaded)
+{
+    auto vectors = make_random_vectors(300, 8);
+    ProductQuantizer quantizer(DistanceMetric::Euclidean, 8, 2, 256, 300);
+    std::vector<TypedCells> samples;
+    for (const auto& vector : vectors) {
+        samples.push_back(cells(vector));
+    }
+    quantizer.train(samples);
+    vespalib::nbostream os;
+    quantizer.save_state(os);
+    ProductQuantizer copy(DistanceMetric::Euclidean, 8, 2, 256, 300);
+    vespalib::nbostream is(os.peek(), os.size());
+    EXPECT_TRUE(copy.load_state(is));
+    EXPECT_EQ(0, is.size());
+    for (const auto& vector : vectors) {
+        EXPECT_EQ(encode(quantizer, vector), encode(copy, vector));
+    }
+    ProductQuantizer other(DistanceMetric::Euclidean, 8, 4, 256, 300);
+    vespalib::nbostream other_is(os.peek(), os.size());
+    EXPECT_FALSE(other.load_state(other_is));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
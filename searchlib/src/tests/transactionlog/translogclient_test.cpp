@@ -739,8 +739,84 @@ TEST("test sending a lot of data async") {
     }
 }
 
+TEST("test group commit batches appends into fewer writes") {
+    const unsigned int NUM_PACKETS = 1000;
+    const unsigned int NUM_ENTRIES = 10;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const vespalib::string MANY("many-grouped");
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test14", 18377, ".", fileHeaderContext,
+                        DomainConfig().setPartSizeLimit(0x80000).setFSyncOnCommit(true)
+                                      .setGroupCommit(true).setGroupCommitWindow(10ms));
+    TransLogClient tls("tcp/localhost:18377");
+    createDomainTest(tls, MANY, 0);
+    auto s1 = openDomainTest(tls, MANY);
+    fillDomainTest(tlss, MANY, NUM_PACKETS, NUM_ENTRIES);
+    TEST_DO(assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+    DomainInfo info = tlss.getDomainStats()[MANY];
+    EXPECT_EQUAL(TOTAL_NUM_ENTRIES, info.numCommitEntries);
+    EXPECT_LESS(info.numCommits, NUM_PACKETS);
+    EXPECT_EQUAL(info.numCommits, info.numSyncs);
+}
 
+TEST("test group commit writes rpc commits without waiting for the window") {
+    const unsigned int NUM_PACKETS = 10;
+    const unsigned int NUM_ENTRIES = 10;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const vespalib::string RPC_GROUPED("rpc-grouped");
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test15", 18377, ".", fileHeaderContext,
+                        DomainConfig().setPartSizeLimit(0x80000)
+                                      .setGroupCommit(true).setGroupCommitWindow(100s));
+    TransLogClient tls("tcp/localhost:18377");
+    createDomainTest(tls, RPC_GROUPED, 0);
+    auto s1 = openDomainTest(tls, RPC_GROUPED);
+    auto start = std::chrono::steady_clock::now();
+    fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < 100s);
+    TEST_DO(assertStatus(*s1, 1, TOTAL_NUM_ENTRIES, TOTAL_NUM_ENTRIES));
+    DomainInfo info = tlss.getDomainStats()[RPC_GROUPED];
+    EXPECT_EQUAL(TOTAL_NUM_ENTRIES, info.numCommitEntries);
+    EXPECT_EQUAL(NUM_PACKETS, info.numCommits);
+}
 
+TEST("test group commit holds back acks of entries it failed to write") {
+    const vespalib::string FAILING("failing-grouped");
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test16", 18377, ".", fileHeaderContext,
+                        DomainConfig().setPartSizeLimit(0x80000)
+                                      .setGroupCommit(true).setGroupCommitWindow(10ms));
+    TransLogClient tls("tcp/localhost:18377");
+    createDomainTest(tls, FAILING, 0);
+    auto domainWriter = tlss.getWriter(FAILING);
+    // Entries out of order pass the range check on append, but are rejected when written.
+    size_t value(0);
+    vespalib::nbostream os;
+    Packet::Entry(2, 1, vespalib::ConstBufferRef((const char *)&value, sizeof(value))).serialize(os);
+    Packet::Entry(1, 1, vespalib::ConstBufferRef((const char *)&value, sizeof(value))).serialize(os);
+    Packet failing(os.data(), os.size());
+    Counter inFlight(0);
+    domainWriter->append(failing, std::make_shared<CountDone>(inFlight));
+    {
+        auto keep = domainWriter->startCommit(std::make_shared<CountDone>(inFlight));
+    }
+    SerialNum serial(3);
+    for (;; serial++) {
+        Packet p(DEFAULT_PACKET_SIZE);
+        p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef((const char *)&value, sizeof(value))));
+        try {
+            domainWriter->append(p, std::make_shared<CountDone>(inFlight));
+        } catch (const std::runtime_error &) {
+            break;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQUAL(serial - 1, inFlight.load());
+    EXPECT_EXCEPTION(auto keep = domainWriter->startCommit(std::make_shared<CountDone>(inFlight)),
+                     std::runtime_error, "stopped writing after a failed commit");
+    EXPECT_EQUAL(serial - 1, inFlight.load());
+    EXPECT_EQUAL(0u, tlss.getDomainStats()[FAILING].numCommits);
+}
 
 TEST("testErase") {
     const unsigned int NUM_PACKETS = 1000;
@@ -47,6 +47,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(std::make_shared<ExpressionTree>()),
@@ -637,6 +638,79 @@ StandardDeviationAggregationResult::visitMembers(vespalib::ObjectVisitor &visito
     visit(visitor, "sumOfSquared", _sumOfSquared);
 }
 
+QuantileAggregationResult::QuantileAggregationResult()
+    : AggregationResult(), _quantiles(), _digest(), _rank()
+{ }
+
+QuantileAggregationResult::~QuantileAggregationResult() = default;
+
+const ResultNode &
+QuantileAggregationResult::onGetRank() const
+{
+    double q = _quantiles.empty() ? 0.5 : _quantiles[0];
+    _rank.set(_digest.empty() ? 0.0 : _digest.quantile(q));
+    return _rank;
+}
+
+void
+QuantileAggregationResult::onMerge(const AggregationResult &r) {
+    const auto & result = Identifiable::cast<const QuantileAggregationResult &>(r);
+    _digest.merge(result._digest);
+}
+
+void
+QuantileAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const auto & vector = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(vector.size()); i < m; i++) {
+            _digest.add(vector.get(i).getFloat());
+        }
+    } else {
+        _digest.add(result.getFloat());
+    }
+}
+
+void
+QuantileAggregationResult::onReset()
+{
+    _digest = TDigest(_digest.getCompression());
+}
+
+Serializer &
+QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    os << static_cast<uint32_t>(_quantiles.size());
+    for (double q : _quantiles) {
+        os << q;
+    }
+    _digest.serialize(os);
+    return os;
+}
+
+Deserializer &
+QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    uint32_t numQuantiles(0);
+    is >> numQuantiles;
+    _quantiles.resize(numQuantiles);
+    for (double & q : _quantiles) {
+        is >> q;
+    }
+    _digest.deserialize(is);
+    return is;
+}
+
+void
+QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "quantiles", _quantiles);
+    visit(visitor, "count", _digest.getCount());
+    visit(visitor, "centroids", _digest.getCentroids().size());
+}
+
 }
 
 // this function was added by ../../forcelink.sh
@@ -17,6 +17,11 @@ public:
     const NumericResultNode & getAverage() const;
     const NumericResultNode & getSum() const { return *_sum; }
     uint64_t getCount()                const { return _count; }
+    AverageAggregationResult & add(const ResultNode & sum, uint64_t count) {
+        _sum->add(sum);
+        _count += count;
+        return *this;
+    }
 private:
     const ResultNode & onGetRank() const override { return getAverage(); }
     void onPrepare(const ResultNode & result, bool useForInit) override;
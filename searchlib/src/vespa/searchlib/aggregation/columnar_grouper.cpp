@@ -0,0 +1,235 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnar_grouper.h"
+#include "grouping.h"
+#include "countaggregationresult.h"
+#include "sumaggregationresult.h"
+#include "minaggregationresult.h"
+#include "maxaggregationresult.h"
+#include "averageaggregationresult.h"
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/enumresultnode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <cmath>
+#include <limits>
+
+namespace search::aggregation {
+
+using search::attribute::BasicType;
+using search::attribute::IAttributeVector;
+using search::expression::AttributeNode;
+using search::expression::EnumResultNode;
+using search::expression::ExpressionNode;
+using search::expression::FloatResultNode;
+using search::expression::Int64ResultNode;
+
+namespace {
+
+const IAttributeVector *
+singleValueNumericAttribute(const ExpressionNode * node)
+{
+    if ((node == nullptr) || (node->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const IAttributeVector * attr = static_cast<const AttributeNode &>(*node).getAttribute();
+    if ((attr == nullptr) || attr->hasMultiValue() || (attr->getBasicType() == BasicType::BOOL)) {
+        return nullptr;
+    }
+    if (! attr->isIntegerType() && ! attr->isFloatingPointType()) {
+        return nullptr;
+    }
+    return attr;
+}
+
+bool
+hasResultType(const AggregationResult & aggr, uint32_t classId)
+{
+    return (aggr.getExpression()->getResult().getClass().id() == classId) &&
+           (aggr.getResult().getClass().id() == classId);
+}
+
+}
+
+ColumnarGrouper::Column::Column(Kind kind, bool isFloat, const IAttributeVector * attr)
+    : _kind(kind),
+      _isFloat(isFloat),
+      _attr(attr),
+      _ints(),
+      _floats()
+{ }
+
+ColumnarGrouper::Column::Column(Column &&) noexcept = default;
+ColumnarGrouper::Column::~Column() = default;
+
+void
+ColumnarGrouper::Column::addSlot()
+{
+    // Initial values match the reset state of the corresponding aggregation result.
+    switch (_kind) {
+    case Kind::MIN:
+        _ints.push_back(std::numeric_limits<int64_t>::max());
+        _floats.push_back(std::numeric_limits<double>::max());
+        break;
+    case Kind::MAX:
+        _ints.push_back(std::numeric_limits<int64_t>::min());
+        _floats.push_back(-std::numeric_limits<double>::max());
+        break;
+    case Kind::SUM:
+    case Kind::AVERAGE:
+        _ints.push_back(0);
+        _floats.push_back(0.0);
+        break;
+    case Kind::COUNT:
+        break;
+    }
+}
+
+ColumnarGrouper::ColumnarGrouper(Group & root, const GroupingLevel & level, const SingleValueEnumAttributeBase & attr)
+    : _root(root),
+      _level(level),
+      _attr(attr),
+      _rootAggregators(),
+      _slots(),
+      _enums(),
+      _ranks(),
+      _counts(),
+      _columns()
+{ }
+
+ColumnarGrouper::~ColumnarGrouper() = default;
+
+ColumnarGrouper::UP
+ColumnarGrouper::create(Grouping & grouping)
+{
+    const Grouping::GroupingLevelList & levels = grouping.getLevels();
+    if ((levels.size() != 1) || (grouping.getFirstLevel() != 0) || (grouping.getLastLevel() < 1)) {
+        return UP();
+    }
+    Group & root = grouping.root();
+    if (root.getChildrenSize() != 0) {
+        return UP();
+    }
+    const GroupingLevel & level = levels[0];
+    const ExpressionNode * classify = level.getExpression().getRoot();
+    if ((classify == nullptr) || (classify->getClass().id() != AttributeNode::classId) ||
+        (level.getExpression().getResult().getClass().id() != EnumResultNode::classId))
+    {
+        return UP();
+    }
+    const auto * attr = dynamic_cast<const SingleValueEnumAttributeBase *>(static_cast<const AttributeNode &>(*classify).getAttribute());
+    if (attr == nullptr) {
+        return UP();
+    }
+    const Group & proto = level.getGroupPrototype();
+    if (proto.getChildrenSize() != 0) {
+        return UP();
+    }
+    UP grouper(new ColumnarGrouper(root, level, *attr));
+    for (size_t i(0), m(proto.getAggrSize()); i < m; i++) {
+        const AggregationResult & aggr = proto.getAggregationResult(i);
+        const ExpressionNode * expr = aggr.getExpression();
+        uint32_t id = aggr.getClass().id();
+        if (expr == nullptr) {
+            return UP();
+        }
+        if (id == CountAggregationResult::classId) {
+            if (expr->getResult().isMultiValue()) {
+                return UP();
+            }
+            grouper->_columns.emplace_back(Kind::COUNT, false, nullptr);
+            continue;
+        }
+        Kind kind;
+        if (id == SumAggregationResult::classId) {
+            kind = Kind::SUM;
+        } else if (id == MinAggregationResult::classId) {
+            kind = Kind::MIN;
+        } else if (id == MaxAggregationResult::classId) {
+            kind = Kind::MAX;
+        } else if (id == AverageAggregationResult::classId) {
+            kind = Kind::AVERAGE;
+        } else {
+            return UP();
+        }
+        const IAttributeVector * valueAttr = singleValueNumericAttribute(expr);
+        if (valueAttr == nullptr) {
+            return UP();
+        }
+        bool isFloat = valueAttr->isFloatingPointType();
+        if ( ! hasResultType(aggr, isFloat ? FloatResultNode::classId : Int64ResultNode::classId)) {
+            return UP();
+        }
+        grouper->_columns.emplace_back(kind, isFloat, valueAttr);
+    }
+    for (size_t i(0), m(root.getAggrSize()); i < m; i++) {
+        grouper->_rootAggregators.push_back(&root.getAggregationResult(i));
+    }
+    return grouper;
+}
+
+uint32_t
+ColumnarGrouper::addSlot(uint32_t enumHandle)
+{
+    uint32_t slot = _enums.size();
+    _slots[enumHandle] = slot;
+    _enums.push_back(enumHandle);
+    _ranks.push_back(-HUGE_VAL);
+    _counts.push_back(0);
+    for (Column & column : _columns) {
+        column.addSlot();
+    }
+    return slot;
+}
+
+void
+ColumnarGrouper::fill(AggregationResult & aggr, const Column & column, uint32_t slot) const
+{
+    uint64_t count = _counts[slot];
+    if (column._kind == Kind::COUNT) {
+        auto & countAggr = static_cast<CountAggregationResult &>(aggr);
+        countAggr.setCount(countAggr.getCount() + count);
+        return;
+    }
+    std::unique_ptr<expression::NumericResultNode> value;
+    if (column._isFloat) {
+        value = std::make_unique<FloatResultNode>(column._floats[slot]);
+    } else {
+        value = std::make_unique<Int64ResultNode>(column._ints[slot]);
+    }
+    auto & result = static_cast<expression::SingleResultNode &>(aggr.getResult());
+    switch (column._kind) {
+    case Kind::SUM:
+        result.add(*value);
+        break;
+    case Kind::MIN:
+        result.min(*value);
+        break;
+    case Kind::MAX:
+        result.max(*value);
+        break;
+    case Kind::AVERAGE:
+        static_cast<AverageAggregationResult &>(aggr).add(*value, count);
+        break;
+    case Kind::COUNT:
+        break;
+    }
+}
+
+void
+ColumnarGrouper::materialize()
+{
+    const Group & proto = _level.getGroupPrototype();
+    for (uint32_t slot(0), m(_enums.size()); slot < m; slot++) {
+        auto group = std::make_unique<Group>(proto);
+        group->setId(EnumResultNode(_enums[slot]));
+        group->setRank(_ranks[slot]);
+        for (size_t i(0); i < _columns.size(); i++) {
+            fill(group->getAggregationResult(i), _columns[i], slot);
+        }
+        _root.addChild(std::move(group));
+    }
+}
+
+}
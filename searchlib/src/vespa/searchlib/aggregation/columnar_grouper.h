@@ -0,0 +1,127 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "groupinglevel.h"
+#include <vespa/searchlib/attribute/singleenumattribute.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <memory>
+#include <vector>
+
+namespace search::aggregation {
+
+class Grouping;
+
+/**
+ * Fast path for single level grouping on a single-value enum attribute.
+ *
+ * Hits are grouped on the raw enum handle of the attribute, and the
+ * aggregation results (count, sum, min, max and average over single-value
+ * numeric attributes) are accumulated in one column per aggregation with
+ * one slot per group. The Group objects are only created when all hits have
+ * been collected. Use create() to check whether a grouping request can use
+ * this path; everything else is handled by the generic grouping engine.
+ **/
+class ColumnarGrouper
+{
+public:
+    using UP = std::unique_ptr<ColumnarGrouper>;
+    using DocId = uint32_t;
+
+    /**
+     * Returns a grouper for the given (pre-aggregated) grouping request, or
+     * nullptr if the request must be handled by the generic engine.
+     **/
+    static UP create(Grouping & grouping);
+    ~ColumnarGrouper();
+
+    void aggregate(DocId docId, HitRank rank) {
+        for (AggregationResult * aggr : _rootAggregators) {
+            aggr->aggregate(docId, rank);
+        }
+        uint32_t enumHandle = _attr.getE(docId);
+        auto found = _slots.find(enumHandle);
+        uint32_t slot;
+        if (found == _slots.end()) {
+            if ( ! _level.allowMoreGroups(_enums.size())) {
+                return;
+            }
+            slot = addSlot(enumHandle);
+        } else {
+            slot = found->second;
+        }
+        if (rank > _ranks[slot]) {
+            _ranks[slot] = rank;
+        }
+        ++_counts[slot];
+        for (Column & column : _columns) {
+            column.aggregate(slot, docId);
+        }
+    }
+
+    /**
+     * Creates one child group of the root group for each slot, in the
+     * order the groups were first seen.
+     **/
+    void materialize();
+
+    size_t numGroups() const { return _enums.size(); }
+
+private:
+    enum class Kind : uint8_t { COUNT, SUM, MIN, MAX, AVERAGE };
+
+    struct Column {
+        Kind                                       _kind;
+        bool                                       _isFloat;
+        const search::attribute::IAttributeVector *_attr;
+        std::vector<int64_t>                       _ints;
+        std::vector<double>                        _floats;
+
+        Column(Kind kind, bool isFloat, const search::attribute::IAttributeVector * attr);
+        Column(Column &&) noexcept;
+        ~Column();
+        void addSlot();
+        void aggregate(uint32_t slot, DocId docId) {
+            if (_kind == Kind::COUNT) {
+                return;
+            }
+            if (_isFloat) {
+                update(_floats[slot], _attr->getFloat(docId));
+            } else {
+                update(_ints[slot], _attr->getInt(docId));
+            }
+        }
+        template <typename T>
+        void update(T & acc, T value) {
+            switch (_kind) {
+            case Kind::SUM:
+            case Kind::AVERAGE:
+                acc += value;
+                break;
+            case Kind::MIN:
+                if (value < acc) { acc = value; }
+                break;
+            case Kind::MAX:
+                if (value > acc) { acc = value; }
+                break;
+            case Kind::COUNT:
+                break;
+            }
+        }
+    };
+
+    ColumnarGrouper(Group & root, const GroupingLevel & level, const SingleValueEnumAttributeBase & attr);
+    uint32_t addSlot(uint32_t enumHandle);
+    void fill(AggregationResult & aggr, const Column & column, uint32_t slot) const;
+
+    Group                                & _root;
+    const GroupingLevel                  & _level;
+    const SingleValueEnumAttributeBase   & _attr;
+    std::vector<AggregationResult *>       _rootAggregators;
+    vespalib::hash_map<uint32_t, uint32_t> _slots;
+    std::vector<uint32_t>                  _enums;
+    std::vector<double>                    _ranks;
+    std::vector<uint64_t>                  _counts;
+    std::vector<Column>                    _columns;
+};
+
+}
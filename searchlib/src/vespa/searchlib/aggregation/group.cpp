@@ -205,6 +205,14 @@ Group & Group::operator = (const Group & rhs) = default;
 
 Group::~Group() = default;
 
+std::vector<Group>
+Group::partitionChildren(uint32_t numPartitions)
+{
+    std::vector<Group> partitions(numPartitions);
+    _aggr.partitionChildren(partitions);
+    return partitions;
+}
+
 Group &
 Group::partialCopy(const Group & rhs) {
     setId(*rhs._id);
@@ -419,6 +427,45 @@ Group::Value::merge(const std::vector<GroupingLevel> &levels,
     _childInfo._allChildren = 0;
 }
 
+void
+Group::Value::partitionChildren(std::vector<Group> & partitions)
+{
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        partitions[(*it)->getId().hash() % partitions.size()]._aggr.addChild(*it);
+        reset(*it);
+    }
+    destruct(_children, getAllChildrenSize());
+    setChildrenSize(0);
+    _childInfo._allChildren = 0;
+}
+
+void
+Group::Value::adoptChildren(const std::vector<Group *> & groups)
+{
+    size_t total(getChildrenSize());
+    for (const Group * group : groups) {
+        total += group->getChildrenSize();
+    }
+    auto z = new ChildP[total];
+    size_t kept(0);
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        z[kept++] = *it;
+        reset(*it);
+    }
+    for (Group * group : groups) {
+        Value & b = group->_aggr;
+        for (ChildP *it(b._children), *mt(b._children + b.getChildrenSize()); it != mt; ++it) {
+            z[kept++] = *it;
+            reset(*it);
+        }
+    }
+    std::swap(_children, z);
+    destruct(z, getAllChildrenSize());
+    setChildrenSize(kept);
+    _childInfo._allChildren = 0;
+    std::sort(_children, _children + kept, SortByGroupId());
+}
+
 void
 Group::Value::prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel) {
     auto keep = new ChildP[b.getChildrenSize()];
@@ -94,6 +94,8 @@ private:
         void merge(const GroupingLevelList & levels, uint32_t firstLevel, uint32_t currentLevel, const Value & rhs);
         void prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel);
         void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel);
+        void partitionChildren(std::vector<Group> & partitions);
+        void adoptChildren(const std::vector<Group *> & groups);
         void partialCopy(const Value & rhs);
         VESPA_DLL_LOCAL Group * groupSingle(const ResultNode & selectResult, HitRank rank, const GroupingLevel & level);
 
@@ -263,6 +265,24 @@ public:
     void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel) {
         _aggr.postMerge(levels, firstLevel, currentLevel);
     }
+
+    /**
+     * Moves the children of this group into the given number of new
+     * groups, selecting the partition by the hash of the child id. The
+     * relative order of the children is kept.
+     *
+     * @param numPartitions The number of partitions.
+     **/
+    std::vector<Group> partitionChildren(uint32_t numPartitions);
+
+    /**
+     * Takes over the children of the given groups and sorts them by
+     * id. The groups must not share any child ids, which holds for the
+     * partitions created by partitionChildren.
+     *
+     * @param groups The groups to take the children from.
+     **/
+    void adoptChildren(const std::vector<Group *> & groups) { _aggr.adoptChildren(groups); }
 };
 
 }
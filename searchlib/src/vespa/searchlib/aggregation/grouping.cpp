@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "grouping.h"
+#include "columnar_grouper.h"
 #include "hitsaggregationresult.h"
 #include <vespa/searchlib/expression/stringresultnode.h>
 #include <vespa/searchlib/expression/enumresultnode.h>
@@ -154,6 +155,18 @@ Grouping::merge(Grouping & b)
     _root.merge(_levels, _firstLevel, 0, b._root);
 }
 
+Group
+Grouping::mergePartition(const std::vector<Group *> & parts) const
+{
+    Group merged;
+    for (Group * part : parts) {
+        merged.merge(_levels, _firstLevel, 0, *part);
+    }
+    merged.postMerge(_levels, _firstLevel, 0);
+    merged.sortById();
+    return merged;
+}
+
 void
 Grouping::postMerge()
 {
@@ -204,67 +217,82 @@ void Grouping::postProcess()
     sortById();
 }
 
-void Grouping::aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len) {
+template <typename Collector>
+void Grouping::aggregateWithoutClock(Collector & collector, const RankedHit * rankedHit, unsigned int len) {
     for(unsigned int i(0); i < len; i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+        collector.aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
 }
 
-void Grouping::aggregateWithClock(const RankedHit * rankedHit, unsigned int len) {
+template <typename Collector>
+void Grouping::aggregateWithClock(Collector & collector, const RankedHit * rankedHit, unsigned int len) {
     for(unsigned int i(0); (i < len) && !hasExpired(); i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+        collector.aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
 }
 
-void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
+template <typename Collector>
+void Grouping::aggregateHits(Collector & collector, const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
 {
-    bool isOrdered(! needResort());
-    preAggregate(isOrdered);
-    HitsAggregationResult::SetOrdered pred;
-    select(pred, pred);
     if (_clock == NULL) {
-        aggregateWithoutClock(rankedHit, getMaxN(len));
+        aggregateWithoutClock(collector, rankedHit, getMaxN(len));
     } else {
-        aggregateWithClock(rankedHit, getMaxN(len));
-    }
-    postProcess();
-}
-
-void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
-{
-    preAggregate(false);
-    if (_clock == NULL) {
-        aggregateWithoutClock(rankedHit, getMaxN(len));
-    } else {
-        aggregateWithClock(rankedHit, getMaxN(len));
+        aggregateWithClock(collector, rankedHit, getMaxN(len));
     }
     if (bVec != NULL) {
         unsigned int sz(bVec->size());
         if (_clock == NULL) {
             if (getTopN() > 0) {
                 for(DocId d(bVec->getFirstTrueBit()), i(0), m(getMaxN(sz)); (d < sz) && (i < m); d = bVec->getNextTrueBit(d+1), i++) {
-                    aggregate(d, 0.0);
+                    collector.aggregate(d, 0.0);
                 }
             } else {
                 for(DocId d(bVec->getFirstTrueBit()); d < sz; d = bVec->getNextTrueBit(d+1)) {
-                    aggregate(d, 0.0);
+                    collector.aggregate(d, 0.0);
                 }
             }
         } else {
             if (getTopN() > 0) {
                 for(DocId d(bVec->getFirstTrueBit()), i(0), m(getMaxN(sz)); (d < sz) && (i < m) && !hasExpired(); d = bVec->getNextTrueBit(d+1), i++) {
-                    aggregate(d, 0.0);
+                    collector.aggregate(d, 0.0);
                 }
             } else {
                 for(DocId d(bVec->getFirstTrueBit()); (d < sz) && !hasExpired(); d = bVec->getNextTrueBit(d+1)) {
-                    aggregate(d, 0.0);
+                    collector.aggregate(d, 0.0);
                 }
             }
         }
     }
+}
+
+void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
+{
+    bool isOrdered(! needResort());
+    preAggregate(isOrdered);
+    HitsAggregationResult::SetOrdered pred;
+    select(pred, pred);
+    aggregateHits(rankedHit, len, nullptr);
+    postProcess();
+}
+
+void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
+{
+    preAggregate(false);
+    aggregateHits(rankedHit, len, bVec);
     postProcess();
 }
 
+void Grouping::aggregateHits(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
+{
+    ColumnarGrouper::UP columnar = ColumnarGrouper::create(*this);
+    if (columnar) {
+        aggregateHits(*columnar, rankedHit, len, bVec);
+        columnar->materialize();
+    } else {
+        aggregateHits(*this, rankedHit, len, bVec);
+    }
+}
+
 void Grouping::aggregate(DocId docId, HitRank rank)
 {
     _root.aggregate(*this, 0, docId, rank);
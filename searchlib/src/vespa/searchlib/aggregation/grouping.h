@@ -34,8 +34,13 @@ private:
     vespalib::steady_time    _timeOfDoom; // Used if clock is specified. This is time when request expires.
 
     bool hasExpired() const { return _clock->getTimeNS() > _timeOfDoom; }
-    void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
-    void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    template <typename Collector>
+    void aggregateWithoutClock(Collector & collector, const RankedHit * rankedHit, unsigned int len);
+    template <typename Collector>
+    void aggregateWithClock(Collector & collector, const RankedHit * rankedHit, unsigned int len);
+    template <typename Collector>
+    void aggregateHits(Collector & collector, const RankedHit * rankedHit, unsigned int len, const BitVector * bVec);
+    void aggregateHits(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec);
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
@@ -79,6 +84,22 @@ public:
                        vespalib::ObjectOperation &operation) override;
 
     void merge(Grouping & b);
+
+    /**
+     * Moves the first level groups into the given number of partitions
+     * by the hash of the group id. Together with mergePartition this
+     * lets several threads merge groupings in parallel; the merged
+     * partitions are put back with merge and Group::adoptChildren.
+     **/
+    std::vector<Group> partition(uint32_t numPartitions) { return _root.partitionChildren(numPartitions); }
+
+    /**
+     * Merges the same partition of several groupings into one group and
+     * prunes it like postMerge does. Since a partition holds all the
+     * data of its groups, this does not change which groups survive the
+     * final prune. Different partitions may be merged concurrently.
+     **/
+    Group mergePartition(const std::vector<Group *> & parts) const;
     void mergePartial(const Grouping & b);
     void postMerge();
     void preAggregate(bool isOrdered);
@@ -0,0 +1,41 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/tdigest.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Estimates quantiles (e.g. the median or the 99th percentile) of the
+ * values of an expression. The values are kept in a t-digest sketch,
+ * which is serialized and merged across threads and nodes. The rank of
+ * this aggregator is the estimate for the first requested quantile.
+ */
+class QuantileAggregationResult : public AggregationResult
+{
+public:
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    ~QuantileAggregationResult();
+
+    QuantileAggregationResult & setQuantiles(std::vector<double> quantiles) {
+        _quantiles = std::move(quantiles);
+        return *this;
+    }
+    const std::vector<double> & getQuantiles() const { return _quantiles; }
+    const TDigest & getDigest() const { return _digest; }
+    double getQuantile(double q) const { return _digest.quantile(q); }
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+private:
+    const ResultNode & onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+
+    std::vector<double>                 _quantiles;
+    TDigest                             _digest;
+    mutable expression::FloatResultNode _rank;
+};
+
+}
@@ -735,12 +735,14 @@ public:
         }
         std::unique_ptr<DenseTensorView> dense_query_tensor_up(dense_query_tensor);
         query_tensor.release();
+        const auto& params = getRequestContext().get_attribute_blueprint_params();
         setResult(std::make_unique<queryeval::NearestNeighborBlueprint>(_field, *dense_attr_tensor,
                                                                         std::move(dense_query_tensor_up),
                                                                         n.get_target_num_hits(),
                                                                         n.get_allow_approximate(),
                                                                         n.get_explore_additional_hits(),
-                                                                        getRequestContext().get_attribute_blueprint_params().nearest_neighbor_brute_force_limit));
+                                                                        params.nearest_neighbor_brute_force_limit,
+                                                                        params.nearest_neighbor_explore_k_max_adjustment_factor));
     }
 };
 
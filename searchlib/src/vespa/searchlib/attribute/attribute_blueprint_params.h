@@ -10,14 +10,17 @@ namespace search::attribute {
 struct AttributeBlueprintParams
 {
     double nearest_neighbor_brute_force_limit;
+    double nearest_neighbor_explore_k_max_adjustment_factor;
     
-    AttributeBlueprintParams(double nearest_neighbor_brute_force_limit_in)
-        : nearest_neighbor_brute_force_limit(nearest_neighbor_brute_force_limit_in)
+    AttributeBlueprintParams(double nearest_neighbor_brute_force_limit_in,
+                             double nearest_neighbor_explore_k_max_adjustment_factor_in)
+        : nearest_neighbor_brute_force_limit(nearest_neighbor_brute_force_limit_in),
+          nearest_neighbor_explore_k_max_adjustment_factor(nearest_neighbor_explore_k_max_adjustment_factor_in)
     {
     }
 
     AttributeBlueprintParams()
-        : AttributeBlueprintParams(0.05)
+        : AttributeBlueprintParams(0.05, 20.0)
     {
     }
 };
@@ -372,8 +372,13 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor *executor) {
     assert(!_loaded);
-    bool loaded = onLoad();
+    bool loaded = onLoad(executor);
     if (loaded) {
         commit();
     }
@@ -381,7 +386,7 @@ AttributeVector::load() {
     return _loaded;
 }
 
-bool AttributeVector::onLoad() { return false; }
+bool AttributeVector::onLoad(vespalib::Executor *) { return false; }
 int32_t AttributeVector::getWeight(DocId, uint32_t) const { return 1; }
 
 bool AttributeVector::findEnum(const char *, EnumHandle &) const { return false; }
@@ -36,6 +36,7 @@ namespace document {
 }
 
 namespace vespalib {
+    class Executor;
     class GenericHeader;
 }
 
@@ -447,6 +448,11 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads this attribute vector from file(s). The given executor (if not nullptr) can be used
+     * to parallelize costly parts of the load, e.g. building a nearest neighbor index.
+     */
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -569,7 +575,7 @@ private:
     virtual bool applyWeight(DocId doc, const FieldValue &fv, const ArithmeticValueUpdate &wAdjust);
     virtual bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
-    virtual bool onLoad();
+    virtual bool onLoad(vespalib::Executor *executor);
 
 
     BaseName                              _baseFileName;
@@ -69,6 +69,8 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
+    retval.setPaged(cfg.paged);
+    retval.setSortedIndex(cfg.sortedindex);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -94,9 +96,24 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     }
     retval.set_distance_metric(dm);
     if (cfg.index.hnsw.enabled) {
+        using CfgVq = AttributesConfig::Attribute::Index::Hnsw::Quantization;
+        VectorQuantization vq(VectorQuantization::None);
+        switch (cfg.index.hnsw.quantization) {
+            case CfgVq::NONE:
+                vq = VectorQuantization::None;
+                break;
+            case CfgVq::INT8:
+                vq = VectorQuantization::Int8;
+                break;
+            case CfgVq::PRODUCT:
+                vq = VectorQuantization::Product;
+                break;
+        }
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+                                                     dm, cfg.index.hnsw.multithreadedindexing, vq,
+                                                     cfg.index.hnsw.quantizationsubspacedims,
+                                                     cfg.index.hnsw.quantizationcentroids));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
@@ -5,6 +5,7 @@
 #include "imported_attribute_vector.h"
 #include "reference_attribute.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/common/compressed_bitvector_iterator.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/executeinfo.h>
@@ -57,6 +58,10 @@ unsigned int ImportedSearchContext::approximateHits() const {
 std::unique_ptr<queryeval::SearchIterator>
 ImportedSearchContext::createIterator(fef::TermFieldMatchData* matchData, bool strict) {
     if (_searchCacheLookup) {
+        if (_searchCacheLookup->compressedBitVector) {
+            return CompressedBitVectorIterator::create(_searchCacheLookup->compressedBitVector.get(),
+                                                       _searchCacheLookup->docIdLimit, *matchData, strict);
+        }
         return BitVectorIterator::create(_searchCacheLookup->bitVector.get(), _searchCacheLookup->docIdLimit, *matchData, strict);
     }
     if (_merger.hasArray()) {
@@ -232,7 +237,14 @@ ImportedSearchContext::considerAddSearchCacheEntry()
 {
     if (_useSearchCache && _merger.hasBitVector()) {
         assert(_dmsReadGuard);
-        auto cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
+        // Keep a compressed copy instead when it saves at least half of the memory
+        std::shared_ptr<CompressedBitVector> compressed = CompressedBitVector::create(*_merger.getBitVector());
+        BitVectorSearchCache::Entry::SP cacheEntry;
+        if (compressed->getMemoryUsage() * 2 <= _merger.getBitVector()->sizeBytes()) {
+            cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), std::move(compressed), _merger.getDocIdLimit());
+        } else {
+            cacheEntry = std::make_shared<BitVectorSearchCache::Entry>(std::move(_dmsReadGuard), _merger.getBitVectorSP(), _merger.getDocIdLimit());
+        }
         _imported_attribute.getSearchCache()->insert(_queryTerm, std::move(cacheEntry));
     }
 }
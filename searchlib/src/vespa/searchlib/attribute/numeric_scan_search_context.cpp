@@ -0,0 +1,65 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numeric_scan_search_context.h"
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+
+namespace search::attribute {
+
+using queryeval::SearchIterator;
+
+template <typename T>
+NumericScanSearchContext<T>::NumericScanSearchContext(const T *data, uint32_t docIdLimit, T low, T high)
+    : _data(data),
+      _docIdLimit(docIdLimit),
+      _low(low),
+      _high(high),
+      _bitVector()
+{ }
+
+template <typename T>
+NumericScanSearchContext<T>::~NumericScanSearchContext() = default;
+
+template <typename T>
+void
+NumericScanSearchContext<T>::fetchPostings(const queryeval::ExecuteInfo &execInfo)
+{
+    if (_bitVector || !execInfo.isStrict()) {
+        return;
+    }
+    _bitVector = BitVector::create(_docIdLimit);
+    // Whole words are written by the kernel, the last partial word also holds the guard bit.
+    uint32_t scanLimit = _docIdLimit & ~63u;
+    const auto &accel = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+    accel.inRange(_data, _low, _high, scanLimit, static_cast<uint64_t *>(_bitVector->getStart()));
+    for (uint32_t docId = scanLimit; docId < _docIdLimit; ++docId) {
+        if ((_low <= _data[docId]) && (_data[docId] <= _high)) {
+            _bitVector->setBit(docId);
+        }
+    }
+    if (_docIdLimit > 0u) {
+        _bitVector->clearBit(0u);
+    }
+    _bitVector->invalidateCachedCount();
+}
+
+template <typename T>
+SearchIterator::UP
+NumericScanSearchContext<T>::createPostingIterator(fef::TermFieldMatchData *matchData, bool strict)
+{
+    if (!_bitVector) {
+        // returning nullptr will trigger fallback to filter iterator
+        return SearchIterator::UP();
+    }
+    return BitVectorIterator::create(_bitVector.get(), _docIdLimit, *matchData, strict);
+}
+
+template class NumericScanSearchContext<int8_t>;
+template class NumericScanSearchContext<int16_t>;
+template class NumericScanSearchContext<int32_t>;
+template class NumericScanSearchContext<int64_t>;
+template class NumericScanSearchContext<float>;
+template class NumericScanSearchContext<double>;
+
+}
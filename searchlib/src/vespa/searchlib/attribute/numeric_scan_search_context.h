@@ -0,0 +1,34 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "ipostinglistsearchcontext.h"
+#include <vespa/searchlib/common/bitvector.h>
+
+namespace search::attribute {
+
+/**
+ * Search context helper for single value numeric attributes without
+ * any dictionary. When the term is strict, the value array is scanned
+ * once with the vectorized range kernel into a bitvector, instead of
+ * testing each document while the strict iterator seeks.
+ */
+template <typename T>
+class NumericScanSearchContext : public IPostingListSearchContext
+{
+    const T       *_data;
+    uint32_t       _docIdLimit;
+    T              _low;
+    T              _high;
+    BitVector::UP  _bitVector;
+
+public:
+    NumericScanSearchContext(const T *data, uint32_t docIdLimit, T low, T high);
+    ~NumericScanSearchContext() override;
+
+    void fetchPostings(const queryeval::ExecuteInfo &execInfo) override;
+    std::unique_ptr<queryeval::SearchIterator> createPostingIterator(fef::TermFieldMatchData *matchData, bool strict) override;
+    unsigned int approximateHits() const override { return _docIdLimit; }
+};
+
+}
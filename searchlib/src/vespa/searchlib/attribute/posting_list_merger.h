@@ -67,6 +67,7 @@ public:
     // Until diversity handling has been rewritten
     PostingVector &getWritableArray() { return _array; }
     StartVector   &getWritableStartPos() { return _startPos; }
+    BitVector     *getWritableBitVector() { return _bitVector.get(); }
 };
 
 }
@@ -4,16 +4,23 @@
 
 #include "integerbase.h"
 #include "floatbase.h"
+#include "sorted_value_index.h"
 #include <vespa/vespalib/util/rcuvector.h>
 #include <limits>
 
 namespace search {
 
+namespace attribute {
+template <typename T> class NumericScanSearchContext;
+template <typename T> class SortedValueIndexSearchContext;
+}
+
 template <typename B>
 class SingleValueNumericAttribute final : public B {
 private:
     using T = typename B::BaseType;
     using DataVector = vespalib::RcuVectorBase<T>;
+    using SortedIndex = attribute::SortedValueIndex<T>;
     using DocId = typename B::DocId;
     using EnumHandle = typename B::EnumHandle;
     using Weighted = typename B::Weighted;
@@ -26,6 +33,9 @@ private:
     using B::getGenerationHolder;
 
     DataVector _data;
+    std::unique_ptr<SortedIndex> _sortedIndex;
+
+    void buildSortedIndex();
 
     T getFromEnum(EnumHandle e) const override {
         (void) e;
@@ -40,6 +50,8 @@ private:
     {
     private:
         const T * _data;
+        std::unique_ptr<attribute::SortedValueIndexSearchContext<T>> _sortedSearch;
+        std::unique_ptr<attribute::NumericScanSearchContext<T>> _scanSearch;
 
         int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
             return find(docId, elemId, weight);
@@ -53,6 +65,7 @@ private:
 
     public:
     SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
+        ~SingleSearchContext() override;
         int32_t find(DocId docId, int32_t elemId, int32_t & weight) const {
             if ( elemId != 0) return -1;
             const T v = _data[docId];
@@ -101,7 +114,7 @@ public:
     void removeOldGenerations(generation_t firstUsed) override;
     void onGenerationChange(generation_t generation) override;
     bool addDoc(DocId & doc) override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
 
@@ -109,9 +122,14 @@ public:
     getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
 
     void set(DocId doc, T v) {
+        if (_sortedIndex) {
+            _sortedIndex->update(doc, _data[doc], v);
+        }
         _data[doc] = v;
     }
 
+    const SortedIndex * getSortedIndex() const { return _sortedIndex.get(); }
+
     T getFast(DocId doc) const {
         return _data[doc];
     }
@@ -4,9 +4,11 @@
 #include "attributeiterators.hpp"
 #include "attributevector.hpp"
 #include "load_utils.h"
+#include "numeric_scan_search_context.h"
 #include "primitivereader.h"
 #include "singlenumericattribute.h"
 #include "singlenumericattributesaver.h"
+#include "sorted_value_index_search_context.h"
 #include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 
@@ -19,8 +21,13 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
-{ }
+          getGenerationHolder()),
+    _sortedIndex()
+{
+    if (c.sortedIndex()) {
+        _sortedIndex = std::make_unique<SortedIndex>();
+    }
+}
 
 template <typename B>
 SingleValueNumericAttribute<B>::~SingleValueNumericAttribute()
@@ -28,6 +35,15 @@ SingleValueNumericAttribute<B>::~SingleValueNumericAttribute()
     getGenerationHolder().clearHoldLists();
 }
 
+template <typename B>
+void
+SingleValueNumericAttribute<B>::buildSortedIndex()
+{
+    if (_sortedIndex) {
+        _sortedIndex->build(&_data[0], _data.size());
+    }
+}
+
 template <typename B>
 void
 SingleValueNumericAttribute<B>::onCommit()
@@ -38,6 +54,7 @@ SingleValueNumericAttribute<B>::onCommit()
         // apply updates
         typename B::ValueModifier valueGuard(this->getValueModifier());
         for (const auto & change : this->_changes) {
+            T oldValue = _data[change._doc];
             if (change._type == ChangeBase::UPDATE) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = change._data;
@@ -48,6 +65,9 @@ SingleValueNumericAttribute<B>::onCommit()
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->_defaultValue._data;
             }
+            if (_sortedIndex) {
+                _sortedIndex->update(change._doc, oldValue, _data[change._doc]);
+            }
         }
     }
 
@@ -64,6 +84,9 @@ SingleValueNumericAttribute<B>::onUpdateStat()
     vespalib::MemoryUsage usage = _data.getMemoryUsage();
     usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     usage.merge(this->getChangeVectorMemoryUsage());
+    if (_sortedIndex) {
+        usage.merge(_sortedIndex->getMemoryUsage());
+    }
     this->updateStatistics(_data.size(), _data.size(),
                            usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
 }
@@ -95,6 +118,9 @@ void
 SingleValueNumericAttribute<B>::removeOldGenerations(generation_t firstUsed)
 {
     getGenerationHolder().trimHoldLists(firstUsed);
+    if (_sortedIndex) {
+        _sortedIndex->trimHoldLists(firstUsed);
+    }
 }
 
 template <typename B>
@@ -102,6 +128,10 @@ void
 SingleValueNumericAttribute<B>::onGenerationChange(generation_t generation)
 {
     getGenerationHolder().transferHoldLists(generation - 1);
+    if (_sortedIndex) {
+        _sortedIndex->freeze();
+        _sortedIndex->transferHoldLists(generation - 1);
+    }
 }
 
 template <typename B>
@@ -120,13 +150,14 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, attribute::NoSaveLoadedEnum());
+    buildSortedIndex();
     return true;
 }
 
 
 template <typename B>
 bool
-SingleValueNumericAttribute<B>::onLoad()
+SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -149,6 +180,7 @@ SingleValueNumericAttribute<B>::onLoad()
 
     B::setNumDocs(sz);
     B::setCommittedDocIdLimit(sz);
+    buildSortedIndex();
 
     return true;
 }
@@ -216,8 +248,42 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
-    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
-{ }
+    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0]),
+    _sortedSearch(),
+    _scanSearch()
+{
+    const SortedIndex * sortedIndex = static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched).getSortedIndex();
+    if ((sortedIndex != nullptr) && valid()) {
+        QueryTermSimple::RangeResult<T> res = qTerm->getRange<T>();
+        _sortedSearch = std::make_unique<attribute::SortedValueIndexSearchContext<T>>
+                        (*sortedIndex, *this, toBeSearched.getCommittedDocIdLimit(), getIsFilter(),
+                         res.low, res.high, qTerm->getRangeLimit());
+        if constexpr (std::is_same_v<M, NumericAttribute::Range<T>>) {
+            if (qTerm->getRangeLimit() != 0) {
+                // Keep filtering consistent with the range narrowed by the limit
+                this->_low = _sortedSearch->getLow();
+                this->_high = _sortedSearch->getHigh();
+            }
+        }
+        this->_plsc = _sortedSearch.get();
+    } else if (valid() && getIsFilter()) {
+        // Strict filter terms are resolved by a single vectorized scan of the values
+        T low, high;
+        if constexpr (std::is_same_v<M, NumericAttribute::Range<T>>) {
+            low = this->_low;
+            high = this->_high;
+        } else {
+            low = high = qTerm->getRange<T>().high;
+        }
+        _scanSearch = std::make_unique<attribute::NumericScanSearchContext<T>>
+                      (_data, toBeSearched.getCommittedDocIdLimit(), low, high);
+        this->_plsc = _scanSearch.get();
+    }
+}
+
+template <typename B>
+template <typename M>
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::~SingleSearchContext() = default;
 
 
 template <typename B>
@@ -96,7 +96,7 @@ public:
     ~SingleValueNumericEnumAttribute();
 
     void onCommit() override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
 
@@ -0,0 +1,187 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sorted_value_index.h"
+#include <vespa/searchcommon/common/undefinedvalues.h>
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/datastore/datastore.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace search::attribute {
+
+using vespalib::btree::BTreeNoLeafData;
+
+namespace {
+
+constexpr uint32_t MAX_DOCID = std::numeric_limits<uint32_t>::max();
+
+}
+
+template <typename T>
+SortedValueIndex<T>::SortedValueIndex()
+    : _tree()
+{ }
+
+template <typename T>
+SortedValueIndex<T>::~SortedValueIndex()
+{
+    _tree.clear();
+    _tree.getAllocator().freeze();
+    _tree.getAllocator().clearHoldLists();
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::update(uint32_t docId, T oldValue, T newValue)
+{
+    if (oldValue == newValue) {
+        return;
+    }
+    if (!isUndefined(oldValue)) {
+        _tree.remove(Entry(oldValue, docId));
+    }
+    if (!isUndefined(newValue)) {
+        _tree.insert(Entry(newValue, docId), BTreeNoLeafData());
+    }
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::build(const T *values, uint32_t numDocs)
+{
+    std::vector<Entry> entries;
+    entries.reserve(numDocs);
+    for (uint32_t docId = 0; docId < numDocs; ++docId) {
+        if (!isUndefined(values[docId])) {
+            entries.emplace_back(values[docId], docId);
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    typename Tree::Builder builder(_tree.getAllocator());
+    for (const Entry &entry : entries) {
+        builder.insert(entry, BTreeNoLeafData::_instance);
+    }
+    _tree.clear();
+    _tree.assign(builder);
+    freeze();
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::freeze()
+{
+    _tree.getAllocator().freeze();
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::transferHoldLists(generation_t generation)
+{
+    _tree.getAllocator().transferHoldLists(generation);
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::trimHoldLists(generation_t firstUsed)
+{
+    _tree.getAllocator().trimHoldLists(firstUsed);
+}
+
+template <typename T>
+size_t
+SortedValueIndex<T>::size() const
+{
+    return _tree.size();
+}
+
+template <typename T>
+vespalib::MemoryUsage
+SortedValueIndex<T>::getMemoryUsage() const
+{
+    return _tree.getMemoryUsage();
+}
+
+template <typename T>
+size_t
+SortedValueIndex<T>::lookupRange(T &low, T &high, int limit) const
+{
+    if (!(low <= high)) {
+        return 0u;
+    }
+    auto view = _tree.getFrozenView();
+    auto lowIt = view.lowerBound(Entry(low, 0u));
+    auto highIt = view.upperBound(Entry(high, MAX_DOCID));
+    size_t numHits = highIt - lowIt;
+    if ((limit == 0) || (numHits == 0u)) {
+        return numHits;
+    }
+    size_t wanted = std::abs(limit);
+    if (wanted < numHits) {
+        if (limit > 0) {
+            auto it = lowIt;
+            for (size_t n = 1; n < wanted; ++n) {
+                ++it;
+            }
+            // Include all documents having the boundary value
+            highIt = view.upperBound(Entry(it.getKey()._value, MAX_DOCID));
+        } else {
+            auto it = highIt;
+            for (size_t n = 0; n < wanted; ++n) {
+                --it;
+            }
+            lowIt = view.lowerBound(Entry(it.getKey()._value, 0u));
+        }
+        numHits = highIt - lowIt;
+    }
+    low = lowIt.getKey()._value;
+    auto last = highIt;
+    --last;
+    high = last.getKey()._value;
+    return numHits;
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::fillArray(T low, T high, Merger &merger) const
+{
+    auto view = _tree.getFrozenView();
+    auto it = view.lowerBound(Entry(low, 0u));
+    auto highIt = view.upperBound(Entry(high, MAX_DOCID));
+    auto &array = merger.getWritableArray();
+    for (; it != highIt; ++it) {
+        array.emplace_back(it.getKey()._docId, BTreeNoLeafData());
+    }
+    std::sort(array.begin(), array.end());
+}
+
+template <typename T>
+void
+SortedValueIndex<T>::fillBitVector(T low, T high, Merger &merger) const
+{
+    auto view = _tree.getFrozenView();
+    auto it = view.lowerBound(Entry(low, 0u));
+    auto highIt = view.upperBound(Entry(high, MAX_DOCID));
+    BitVector &bv = *merger.getWritableBitVector();
+    uint32_t docIdLimit = merger.getDocIdLimit();
+    for (; it != highIt; ++it) {
+        uint32_t docId = it.getKey()._docId;
+        if (__builtin_expect(docId < docIdLimit, true)) {
+            bv.setBit(docId);
+        }
+    }
+}
+
+template class SortedValueIndex<int8_t>;
+template class SortedValueIndex<int16_t>;
+template class SortedValueIndex<int32_t>;
+template class SortedValueIndex<int64_t>;
+template class SortedValueIndex<float>;
+template class SortedValueIndex<double>;
+
+}
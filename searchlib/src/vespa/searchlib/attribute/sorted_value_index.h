@@ -0,0 +1,81 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "posting_list_merger.h"
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+
+namespace search::attribute {
+
+/**
+ * Index of the documents in a single value numeric attribute, ordered
+ * by (value, docid). Documents with undefined value are not indexed.
+ *
+ * All documents with values in a given range form a contiguous slice
+ * of the index, so range terms are answered by two lookups instead of
+ * a scan of the attribute, and the documents with the lowest or highest
+ * values in a range are found directly.
+ *
+ * The index is updated by the single writer thread, readers use the
+ * frozen view of the tree.
+ */
+template <typename T>
+class SortedValueIndex
+{
+public:
+    struct Entry {
+        T        _value;
+        uint32_t _docId;
+        Entry() : _value(), _docId(0u) { }
+        Entry(T value, uint32_t docId) : _value(value), _docId(docId) { }
+        bool operator<(const Entry &rhs) const {
+            return (_value < rhs._value) || ((_value == rhs._value) && (_docId < rhs._docId));
+        }
+    };
+    using Tree = vespalib::btree::BTree<Entry, vespalib::btree::BTreeNoLeafData>;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using Merger = PostingListMerger<vespalib::btree::BTreeNoLeafData>;
+
+private:
+    Tree _tree;
+
+public:
+    SortedValueIndex();
+    ~SortedValueIndex();
+
+    /**
+     * Move a document from its old value to its new value.
+     */
+    void update(uint32_t docId, T oldValue, T newValue);
+
+    /**
+     * Rebuild the index from all values in the attribute, e.g. after load.
+     */
+    void build(const T *values, uint32_t numDocs);
+
+    void freeze();
+    void transferHoldLists(generation_t generation);
+    void trimHoldLists(generation_t firstUsed);
+    size_t size() const;
+    vespalib::MemoryUsage getMemoryUsage() const;
+
+    /**
+     * Lookup the slice of documents with values in [low, high] and
+     * return the number of documents in it. A positive limit keeps
+     * only the lowest values in the slice, a negative limit only the
+     * highest values, until at least abs(limit) documents are covered.
+     * The range is narrowed to the values actually covered.
+     */
+    size_t lookupRange(T &low, T &high, int limit) const;
+
+    /**
+     * Add the documents with values in [low, high] to the merger,
+     * either as an array ordered by docid or as a bitvector.
+     */
+    void fillArray(T low, T high, Merger &merger) const;
+    void fillBitVector(T low, T high, Merger &merger) const;
+};
+
+}
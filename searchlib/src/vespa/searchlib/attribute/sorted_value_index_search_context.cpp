@@ -0,0 +1,90 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sorted_value_index_search_context.h"
+#include "attributeiterators.hpp"
+#include "dociditerator.h"
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+
+namespace search::attribute {
+
+using queryeval::EmptySearch;
+using queryeval::SearchIterator;
+
+template <typename T>
+SortedValueIndexSearchContext<T>::SortedValueIndexSearchContext(const SortedValueIndex<T> &index,
+                                                                const ISearchContext &baseSearchCtx,
+                                                                uint32_t docIdLimit, bool isFilter,
+                                                                T low, T high, int rangeLimit)
+    : _index(index),
+      _baseSearchCtx(baseSearchCtx),
+      _docIdLimit(docIdLimit),
+      _isFilter(isFilter),
+      _limited(rangeLimit != 0),
+      _low(low),
+      _high(high),
+      _numHits(index.lookupRange(_low, _high, rangeLimit)),
+      _merger(docIdLimit)
+{ }
+
+template <typename T>
+SortedValueIndexSearchContext<T>::~SortedValueIndexSearchContext() = default;
+
+template <typename T>
+void
+SortedValueIndexSearchContext<T>::fetchPostings(const queryeval::ExecuteInfo &execInfo)
+{
+    // A limited range is always materialized, as the limit is not applied when filtering.
+    if (_merger.merge_done() || (_numHits == 0u) || !(execInfo.isStrict() || _limited)) {
+        return;
+    }
+    if (_numHits < _docIdLimit / 64) {
+        _merger.reserveArray(1u, _numHits);
+        _index.fillArray(_low, _high, _merger);
+    } else {
+        _merger.allocBitVector();
+        _index.fillBitVector(_low, _high, _merger);
+    }
+    _merger.merge();
+}
+
+template <typename T>
+SearchIterator::UP
+SortedValueIndexSearchContext<T>::createPostingIterator(fef::TermFieldMatchData *matchData, bool strict)
+{
+    if (_numHits == 0u) {
+        return std::make_unique<EmptySearch>();
+    }
+    if (!_merger.merge_done()) {
+        // returning nullptr will trigger fallback to filter iterator
+        return SearchIterator::UP();
+    }
+    if (_merger.hasArray()) {
+        if (_merger.emptyArray()) {
+            return std::make_unique<EmptySearch>();
+        }
+        using Posting = vespalib::btree::BTreeKeyData<uint32_t, vespalib::btree::BTreeNoLeafData>;
+        using DocIt = DocIdIterator<Posting>;
+        DocIt postings;
+        vespalib::ConstArrayRef<Posting> array = _merger.getArray();
+        postings.set(&array[0], &array[array.size()]);
+        if (_isFilter) {
+            return std::make_unique<FilterAttributePostingListIteratorT<DocIt>>(_baseSearchCtx, matchData, postings);
+        } else {
+            return std::make_unique<AttributePostingListIteratorT<DocIt>>(_baseSearchCtx, false, matchData, postings);
+        }
+    }
+    const BitVector *bv(_merger.getBitVector());
+    assert(bv != nullptr);
+    return BitVectorIterator::create(bv, bv->size(), *matchData, strict);
+}
+
+template class SortedValueIndexSearchContext<int8_t>;
+template class SortedValueIndexSearchContext<int16_t>;
+template class SortedValueIndexSearchContext<int32_t>;
+template class SortedValueIndexSearchContext<int64_t>;
+template class SortedValueIndexSearchContext<float>;
+template class SortedValueIndexSearchContext<double>;
+
+}
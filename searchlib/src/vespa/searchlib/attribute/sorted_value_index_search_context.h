@@ -0,0 +1,49 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "ipostinglistsearchcontext.h"
+#include "sorted_value_index.h"
+
+namespace search::attribute {
+
+class ISearchContext;
+
+/**
+ * Search context helper for single value numeric attributes with a
+ * sorted value index. The documents matching a range or equality term
+ * are collected from a slice of the index into an array or bitvector
+ * instead of testing the value of every document.
+ */
+template <typename T>
+class SortedValueIndexSearchContext : public IPostingListSearchContext
+{
+    using Merger = typename SortedValueIndex<T>::Merger;
+
+    const SortedValueIndex<T> &_index;
+    const ISearchContext      &_baseSearchCtx;
+    uint32_t                   _docIdLimit;
+    bool                       _isFilter;
+    bool                       _limited;
+    T                          _low;
+    T                          _high;
+    size_t                     _numHits;
+    Merger                     _merger;
+
+public:
+    SortedValueIndexSearchContext(const SortedValueIndex<T> &index, const ISearchContext &baseSearchCtx,
+                                  uint32_t docIdLimit, bool isFilter, T low, T high, int rangeLimit);
+    ~SortedValueIndexSearchContext() override;
+
+    void fetchPostings(const queryeval::ExecuteInfo &execInfo) override;
+    std::unique_ptr<queryeval::SearchIterator> createPostingIterator(fef::TermFieldMatchData *matchData, bool strict) override;
+    unsigned int approximateHits() const override { return _numHits; }
+
+    /**
+     * The range actually searched, narrowed when a range limit is given.
+     */
+    T getLow() const { return _low; }
+    T getHigh() const { return _high; }
+};
+
+}
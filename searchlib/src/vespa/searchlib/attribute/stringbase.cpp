@@ -358,7 +358,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
     return true;
 }
 
-bool StringAttribute::onLoad()
+bool StringAttribute::onLoad(vespalib::Executor *)
 {
     ReaderBase attrReader(*this);
     bool ok(attrReader.getHasLoadData());
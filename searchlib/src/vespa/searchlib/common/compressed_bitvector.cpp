@@ -0,0 +1,438 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_bitvector.h"
+#include <vespa/vespalib/util/optimized.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace search {
+
+using vespalib::Optimized;
+using Word = BitWord::Word;
+
+namespace {
+
+constexpr uint32_t ChunkSize = CompressedBitVector::ChunkSize;
+constexpr uint32_t ChunkWords = CompressedBitVector::ChunkWords;
+
+uint32_t
+nextSetBit(const Word *words, uint32_t pos, Word invert)
+{
+    if (pos >= ChunkSize) {
+        return ChunkSize;
+    }
+    uint32_t wordIdx = pos / 64;
+    Word word = (words[wordIdx] ^ invert) & (~Word(0) << (pos % 64));
+    while (word == 0) {
+        if (++wordIdx == ChunkWords) {
+            return ChunkSize;
+        }
+        word = words[wordIdx] ^ invert;
+    }
+    return wordIdx * 64 + Optimized::lsbIdx(word);
+}
+
+void
+setRange(Word *words, uint32_t first, uint32_t last)
+{
+    uint32_t firstWord = first / 64;
+    uint32_t lastWord = last / 64;
+    Word firstMask = ~Word(0) << (first % 64);
+    Word lastMask = ~Word(0) >> (63 - (last % 64));
+    if (firstWord == lastWord) {
+        words[firstWord] |= firstMask & lastMask;
+    } else {
+        words[firstWord] |= firstMask;
+        for (uint32_t i = firstWord + 1; i < lastWord; ++i) {
+            words[i] = ~Word(0);
+        }
+        words[lastWord] |= lastMask;
+    }
+}
+
+// Returns end of chunk clamped to limit, avoiding overflow for the last chunk
+BitWord::Index
+chunkEnd(BitWord::Index chunkStart, BitWord::Index limit)
+{
+    return (limit - chunkStart > ChunkSize) ? (chunkStart + ChunkSize) : limit;
+}
+
+}
+
+bool
+CompressedBitVector::Container::contains(uint32_t low) const
+{
+    switch (type) {
+    case Type::ARRAY:
+        return std::binary_search(values.begin(), values.end(), low);
+    case Type::BITMAP:
+        return (bitmap[low / 64] & (Word(1) << (low % 64))) != 0;
+    case Type::RUN:
+        return next(low) == low;
+    }
+    return false;
+}
+
+uint32_t
+CompressedBitVector::Container::next(uint32_t low) const
+{
+    switch (type) {
+    case Type::ARRAY: {
+        auto itr = std::lower_bound(values.begin(), values.end(), low);
+        return (itr != values.end()) ? *itr : ChunkSize;
+    }
+    case Type::BITMAP:
+        return nextSetBit(bitmap.data(), low, 0);
+    case Type::RUN: {
+        // find first run ending at or after low
+        size_t lo = 0;
+        size_t hi = values.size() / 2;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (values[mid * 2 + 1] < low) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return (lo < values.size() / 2) ? std::max(uint32_t(values[lo * 2]), low) : ChunkSize;
+    }
+    }
+    return ChunkSize;
+}
+
+void
+CompressedBitVector::Container::materialize(Word *words) const
+{
+    if (type == Type::BITMAP) {
+        memcpy(words, bitmap.data(), ChunkWords * sizeof(Word));
+        return;
+    }
+    memset(words, 0, ChunkWords * sizeof(Word));
+    if (type == Type::ARRAY) {
+        for (uint16_t value : values) {
+            words[value / 64] |= Word(1) << (value % 64);
+        }
+    } else {
+        for (size_t i = 0; i < values.size(); i += 2) {
+            setRange(words, values[i], values[i + 1]);
+        }
+    }
+}
+
+size_t
+CompressedBitVector::Container::getMemoryUsage() const
+{
+    return values.capacity() * sizeof(uint16_t) + bitmap.capacity() * sizeof(Word);
+}
+
+bool
+CompressedBitVector::Container::fromBitmap(Container &container, const Word *words)
+{
+    uint32_t numBits = 0;
+    uint32_t numRuns = 0;
+    Word carry = 0;
+    for (uint32_t i = 0; i < ChunkWords; ++i) {
+        Word word = words[i];
+        numBits += Optimized::popCount(word);
+        numRuns += Optimized::popCount(word & ~((word << 1) | carry));
+        carry = word >> 63;
+    }
+    if (numBits == 0) {
+        return false;
+    }
+    container.cardinality = numBits;
+    size_t arrayBytes = numBits * sizeof(uint16_t);
+    size_t bitmapBytes = ChunkWords * sizeof(Word);
+    size_t runBytes = numRuns * 2 * sizeof(uint16_t);
+    if ((runBytes < arrayBytes) && (runBytes < bitmapBytes)) {
+        container.type = Type::RUN;
+        container.values.reserve(numRuns * 2);
+        uint32_t pos = nextSetBit(words, 0, 0);
+        while (pos < ChunkSize) {
+            uint32_t end = nextSetBit(words, pos, ~Word(0));
+            container.values.push_back(pos);
+            container.values.push_back(end - 1);
+            pos = nextSetBit(words, end, 0);
+        }
+    } else if (numBits <= MaxArraySize) {
+        container.type = Type::ARRAY;
+        container.values.reserve(numBits);
+        for (uint32_t i = 0; i < ChunkWords; ++i) {
+            for (Word word = words[i]; word != 0; word &= word - 1) {
+                container.values.push_back(i * 64 + Optimized::lsbIdx(word));
+            }
+        }
+    } else {
+        container.type = Type::BITMAP;
+        container.bitmap.assign(words, words + ChunkWords);
+    }
+    return true;
+}
+
+CompressedBitVector::CompressedBitVector(Index sz)
+    : _sz(sz),
+      _numTrueBits(0),
+      _containers()
+{
+}
+
+CompressedBitVector::~CompressedBitVector() = default;
+
+void
+CompressedBitVector::add(Container &&container)
+{
+    _numTrueBits += container.cardinality;
+    _containers.push_back(std::move(container));
+}
+
+std::vector<CompressedBitVector::Container>::const_iterator
+CompressedBitVector::findContainer(uint32_t key) const
+{
+    return std::lower_bound(_containers.begin(), _containers.end(), key,
+                            [](const Container &container, uint32_t k) { return container.key < k; });
+}
+
+size_t
+CompressedBitVector::getMemoryUsage() const
+{
+    size_t usage = sizeof(CompressedBitVector) + _containers.capacity() * sizeof(Container);
+    for (const auto &container : _containers) {
+        usage += container.getMemoryUsage();
+    }
+    return usage;
+}
+
+bool
+CompressedBitVector::testBit(Index idx) const
+{
+    auto itr = findContainer(idx >> ChunkBits);
+    return (itr != _containers.end()) && (itr->key == (idx >> ChunkBits)) && itr->contains(idx & (ChunkSize - 1));
+}
+
+CompressedBitVector::Index
+CompressedBitVector::getNextTrueBit(Index start) const
+{
+    if (start >= _sz) {
+        return _sz;
+    }
+    auto itr = findContainer(start >> ChunkBits);
+    if ((itr != _containers.end()) && (itr->key == (start >> ChunkBits))) {
+        uint32_t low = itr->next(start & (ChunkSize - 1));
+        if (low < ChunkSize) {
+            return (Index(itr->key) << ChunkBits) + low;
+        }
+        ++itr;
+    }
+    if (itr == _containers.end()) {
+        return _sz;
+    }
+    return (Index(itr->key) << ChunkBits) + itr->next(0);
+}
+
+template <bool isAnd>
+void
+CompressedBitVector::mergeInto(BitVector &result) const
+{
+    const Index lo = result.getStartIndex();
+    const Index hi = std::min(result.size(), _sz);
+    Word *words = static_cast<Word *>(result.getStart());
+    Index prev = lo;
+    alignas(64) Word tmp[ChunkWords];
+    for (const auto &container : _containers) {
+        const Index chunkStart = Index(container.key) << ChunkBits;
+        if (chunkStart >= hi) {
+            break;
+        }
+        const Index begin = std::max(chunkStart, lo);
+        const Index end = chunkEnd(chunkStart, hi);
+        if (begin >= end) {
+            continue;
+        }
+        if (isAnd && (prev < begin)) {
+            result.clearInterval(prev, begin);
+        }
+        prev = end;
+        if (!isAnd && (container.type == Container::Type::ARRAY)) {
+            for (uint16_t value : container.values) {
+                Index docId = chunkStart + value;
+                if ((docId >= begin) && (docId < end)) {
+                    words[wordNum(docId)] |= mask(docId);
+                }
+            }
+            continue;
+        }
+        const Word *src = tmp;
+        if (container.type == Container::Type::BITMAP) {
+            src = container.bitmap.data();
+        } else {
+            container.materialize(tmp);
+        }
+        const Index baseWord = wordNum(chunkStart);
+        const Index firstWord = wordNum(begin);
+        const Index lastWord = wordNum(end - 1);
+        for (Index i = firstWord; i <= lastWord; ++i) {
+            Word inside = ~Word(0);
+            if (i == firstWord) {
+                inside &= checkTab(begin);
+            }
+            if (i == lastWord) {
+                inside &= ~endBits(end - 1);
+            }
+            if (isAnd) {
+                words[i] &= (src[i - baseWord] | ~inside);
+            } else {
+                words[i] |= (src[i - baseWord] & inside);
+            }
+        }
+    }
+    if (isAnd && (prev < result.size())) {
+        result.clearInterval(prev, result.size());
+    }
+    result.invalidateCachedCount();
+}
+
+void
+CompressedBitVector::andInto(BitVector &result) const
+{
+    mergeInto<true>(result);
+}
+
+void
+CompressedBitVector::orInto(BitVector &result) const
+{
+    mergeInto<false>(result);
+}
+
+CompressedBitVector::UP
+CompressedBitVector::create(const BitVector &bv)
+{
+    UP result(new CompressedBitVector(bv.size()));
+    const Index lo = bv.getStartIndex();
+    const Index hi = bv.size();
+    if (lo >= hi) {
+        return result;
+    }
+    const Word *words = static_cast<const Word *>(bv.getStart());
+    alignas(64) Word tmp[ChunkWords];
+    for (uint32_t key = lo >> ChunkBits; key <= ((hi - 1) >> ChunkBits); ++key) {
+        const Index chunkStart = Index(key) << ChunkBits;
+        const Index begin = std::max(chunkStart, lo);
+        const Index end = chunkEnd(chunkStart, hi);
+        const Index baseWord = wordNum(chunkStart);
+        const Index firstWord = wordNum(begin);
+        const Index lastWord = wordNum(end - 1);
+        memset(tmp, 0, sizeof(tmp));
+        memcpy(tmp + (firstWord - baseWord), words + firstWord, (lastWord + 1 - firstWord) * sizeof(Word));
+        tmp[firstWord - baseWord] &= checkTab(begin);
+        tmp[lastWord - baseWord] &= ~endBits(end - 1);
+        Container container(key);
+        if (Container::fromBitmap(container, tmp)) {
+            result->add(std::move(container));
+        }
+    }
+    result->_containers.shrink_to_fit();
+    return result;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::create(vespalib::ConstArrayRef<uint32_t> docIds, Index size)
+{
+    UP result(new CompressedBitVector(size));
+    alignas(64) Word tmp[ChunkWords];
+    for (size_t i = 0; i < docIds.size(); ) {
+        uint32_t key = docIds[i] >> ChunkBits;
+        memset(tmp, 0, sizeof(tmp));
+        for (; (i < docIds.size()) && ((docIds[i] >> ChunkBits) == key); ++i) {
+            assert(docIds[i] < size);
+            uint32_t low = docIds[i] & (ChunkSize - 1);
+            tmp[low / 64] |= Word(1) << (low % 64);
+        }
+        Container container(key);
+        if (Container::fromBitmap(container, tmp)) {
+            result->add(std::move(container));
+        }
+    }
+    result->_containers.shrink_to_fit();
+    return result;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::andOf(const CompressedBitVector &a, const CompressedBitVector &b)
+{
+    UP result(new CompressedBitVector(std::min(a._sz, b._sz)));
+    alignas(64) Word tmpA[ChunkWords];
+    alignas(64) Word tmpB[ChunkWords];
+    auto ai = a._containers.begin();
+    auto bi = b._containers.begin();
+    while ((ai != a._containers.end()) && (bi != b._containers.end())) {
+        if (ai->key < bi->key) {
+            ++ai;
+        } else if (bi->key < ai->key) {
+            ++bi;
+        } else {
+            Container container(ai->key);
+            if ((ai->type == Container::Type::ARRAY) || (bi->type == Container::Type::ARRAY)) {
+                // sparse side drives the intersection
+                const Container &sparse = (ai->type == Container::Type::ARRAY) ? *ai : *bi;
+                const Container &other = (&sparse == &*ai) ? *bi : *ai;
+                for (uint16_t value : sparse.values) {
+                    if (other.contains(value)) {
+                        container.values.push_back(value);
+                    }
+                }
+                container.values.shrink_to_fit();
+                container.cardinality = container.values.size();
+                if (container.cardinality != 0) {
+                    result->add(std::move(container));
+                }
+            } else {
+                ai->materialize(tmpA);
+                bi->materialize(tmpB);
+                for (uint32_t i = 0; i < ChunkWords; ++i) {
+                    tmpA[i] &= tmpB[i];
+                }
+                if (Container::fromBitmap(container, tmpA)) {
+                    result->add(std::move(container));
+                }
+            }
+            ++ai;
+            ++bi;
+        }
+    }
+    result->_containers.shrink_to_fit();
+    return result;
+}
+
+CompressedBitVector::UP
+CompressedBitVector::orOf(const CompressedBitVector &a, const CompressedBitVector &b)
+{
+    UP result(new CompressedBitVector(std::max(a._sz, b._sz)));
+    alignas(64) Word tmpA[ChunkWords];
+    alignas(64) Word tmpB[ChunkWords];
+    auto ai = a._containers.begin();
+    auto bi = b._containers.begin();
+    while ((ai != a._containers.end()) || (bi != b._containers.end())) {
+        if ((bi == b._containers.end()) || ((ai != a._containers.end()) && (ai->key < bi->key))) {
+            result->add(Container(*ai++));
+        } else if ((ai == a._containers.end()) || (bi->key < ai->key)) {
+            result->add(Container(*bi++));
+        } else {
+            Container container(ai->key);
+            ai->materialize(tmpA);
+            bi->materialize(tmpB);
+            for (uint32_t i = 0; i < ChunkWords; ++i) {
+                tmpA[i] |= tmpB[i];
+            }
+            Container::fromBitmap(container, tmpA);
+            result->add(std::move(container));
+            ++ai;
+            ++bi;
+        }
+    }
+    result->_containers.shrink_to_fit();
+    return result;
+}
+
+}
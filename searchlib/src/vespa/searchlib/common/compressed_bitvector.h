@@ -0,0 +1,95 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bitvector.h"
+#include <vespa/vespalib/util/arrayref.h>
+#include <memory>
+#include <vector>
+
+namespace search {
+
+/**
+ * Compressed bit vector using roaring style containers.
+ *
+ * The docid space is split in chunks of 2^16 bits. Each non-empty chunk is
+ * stored in the smallest of three container types: a sorted array of the low
+ * 16 bits, a plain bitmap or a sorted list of runs. Memory usage thus follows
+ * the number of set bits (or runs) instead of the size of the docid space.
+ **/
+class CompressedBitVector : protected BitWord
+{
+public:
+    using Index = BitWord::Index;
+    using UP = std::unique_ptr<CompressedBitVector>;
+    using SP = std::shared_ptr<CompressedBitVector>;
+
+    static constexpr uint32_t ChunkBits = 16;
+    static constexpr uint32_t ChunkSize = 1u << ChunkBits;
+    static constexpr uint32_t ChunkWords = ChunkSize / WordLen;
+    static constexpr uint32_t MaxArraySize = 4096;
+
+    CompressedBitVector(const CompressedBitVector &) = delete;
+    CompressedBitVector & operator = (const CompressedBitVector &) = delete;
+    ~CompressedBitVector();
+
+    Index size() const { return _sz; }
+    Index countTrueBits() const { return _numTrueBits; }
+    size_t getMemoryUsage() const;
+    bool testBit(Index idx) const;
+    /**
+     * Returns the first set bit at or after start, or size() if none.
+     */
+    Index getNextTrueBit(Index start) const;
+
+    /**
+     * Clear all bits in result that are not set in this bit vector.
+     */
+    void andInto(BitVector &result) const;
+    /**
+     * Set all bits in result that are set in this bit vector.
+     */
+    void orInto(BitVector &result) const;
+
+    /**
+     * Compress the active range of the given bit vector.
+     */
+    static UP create(const BitVector &bv);
+    /**
+     * Create from sorted unique docids, all less than size.
+     */
+    static UP create(vespalib::ConstArrayRef<uint32_t> docIds, Index size);
+    static UP andOf(const CompressedBitVector &a, const CompressedBitVector &b);
+    static UP orOf(const CompressedBitVector &a, const CompressedBitVector &b);
+private:
+    struct Container {
+        enum class Type : uint8_t { ARRAY, BITMAP, RUN };
+        uint16_t              key;
+        Type                  type;
+        uint32_t              cardinality;
+        std::vector<uint16_t> values; // sorted values or [first, last] run pairs
+        std::vector<Word>     bitmap;
+
+        explicit Container(uint16_t key_in)
+            : key(key_in), type(Type::ARRAY), cardinality(0), values(), bitmap()
+        { }
+        bool contains(uint32_t low) const;
+        // Returns ChunkSize if no bits are set at or after low
+        uint32_t next(uint32_t low) const;
+        void materialize(Word *words) const;
+        size_t getMemoryUsage() const;
+        static bool fromBitmap(Container &container, const Word *words);
+    };
+
+    explicit CompressedBitVector(Index sz);
+    void add(Container &&container);
+    std::vector<Container>::const_iterator findContainer(uint32_t key) const;
+    template <bool isAnd>
+    void mergeInto(BitVector &result) const;
+
+    Index                  _sz;
+    Index                  _numTrueBits;
+    std::vector<Container> _containers;
+};
+
+}
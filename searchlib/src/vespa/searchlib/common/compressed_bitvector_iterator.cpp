@@ -0,0 +1,128 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_bitvector_iterator.h"
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/objects/visit.h>
+
+namespace search {
+
+using fef::TermFieldMatchData;
+using vespalib::Trinary;
+
+CompressedBitVectorIterator::CompressedBitVectorIterator(const CompressedBitVector & bv, uint32_t docIdLimit,
+                                                         TermFieldMatchData & matchData)
+    : _docIdLimit(std::min(docIdLimit, bv.size())),
+      _bv(bv),
+      _tfmd(matchData)
+{
+    _tfmd.reset(0);
+}
+
+void
+CompressedBitVectorIterator::initRange(uint32_t begin, uint32_t end)
+{
+    SearchIterator::initRange(begin, end);
+    if (begin >= _docIdLimit) {
+        setAtEnd();
+    }
+}
+
+void
+CompressedBitVectorIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    SearchIterator::visitMembers(visitor);
+    visit(visitor, "docIdLimit", _docIdLimit);
+    visit(visitor, "numTrueBits", _bv.countTrueBits());
+    visit(visitor, "termfieldmatchdata.fieldId", _tfmd.getFieldId());
+    visit(visitor, "termfieldmatchdata.docid", _tfmd.getDocId());
+}
+
+BitVector::UP
+CompressedBitVectorIterator::get_hits(uint32_t begin_id)
+{
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    _bv.orInto(*result);
+    if (begin_id < getDocId()) {
+        result->clearInterval(begin_id, std::min(getDocId(), getEndId()));
+    }
+    uint32_t limit = std::max(begin_id, _docIdLimit);
+    if (limit < result->size()) {
+        result->clearInterval(limit, result->size());
+    }
+    return result;
+}
+
+void
+CompressedBitVectorIterator::or_hits_into(BitVector &result, uint32_t)
+{
+    _bv.orInto(result);
+}
+
+void
+CompressedBitVectorIterator::and_hits_into(BitVector &result, uint32_t)
+{
+    _bv.andInto(result);
+}
+
+namespace {
+
+template <bool strict>
+class CompressedBitVectorIteratorT : public CompressedBitVectorIterator
+{
+public:
+    CompressedBitVectorIteratorT(const CompressedBitVector & bv, uint32_t docIdLimit, TermFieldMatchData & matchData)
+        : CompressedBitVectorIterator(bv, docIdLimit, matchData)
+    { }
+private:
+    void initRange(uint32_t begin, uint32_t end) override;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return strict ? Trinary::True : Trinary::False; }
+    void seekNext(uint32_t docId) {
+        docId = _bv.getNextTrueBit(docId);
+        if (__builtin_expect(docId >= _docIdLimit, false)) {
+            setAtEnd();
+        } else {
+            setDocId(docId);
+        }
+    }
+};
+
+template <bool strict>
+void
+CompressedBitVectorIteratorT<strict>::initRange(uint32_t begin, uint32_t end)
+{
+    CompressedBitVectorIterator::initRange(begin, end);
+    if (strict && !isAtEnd()) {
+        seekNext(begin);
+    }
+}
+
+template <bool strict>
+void
+CompressedBitVectorIteratorT<strict>::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId >= _docIdLimit, false)) {
+        setAtEnd();
+    } else if (strict) {
+        seekNext(docId);
+    } else if (_bv.testBit(docId)) {
+        setDocId(docId);
+    }
+}
+
+}
+
+queryeval::SearchIterator::UP
+CompressedBitVectorIterator::create(const CompressedBitVector *const bv, uint32_t docIdLimit,
+                                    TermFieldMatchData &matchData, bool strict)
+{
+    if (bv == nullptr) {
+        return std::make_unique<queryeval::EmptySearch>();
+    } else if (strict) {
+        return std::make_unique<CompressedBitVectorIteratorT<true>>(*bv, docIdLimit, matchData);
+    } else {
+        return std::make_unique<CompressedBitVectorIteratorT<false>>(*bv, docIdLimit, matchData);
+    }
+}
+
+} // namespace search
@@ -0,0 +1,38 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "compressed_bitvector.h"
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+namespace search {
+
+/**
+ * Search iterator over a compressed bit vector. Hits are merged directly
+ * from the compressed containers when and/or-ing into a bit vector.
+ **/
+class CompressedBitVectorIterator : public queryeval::SearchIterator
+{
+protected:
+    CompressedBitVectorIterator(const CompressedBitVector & bv, uint32_t docIdLimit, fef::TermFieldMatchData &matchData);
+    void initRange(uint32_t begin, uint32_t end) override;
+
+    uint32_t                    _docIdLimit;
+    const CompressedBitVector & _bv;
+private:
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    void doUnpack(uint32_t docId) override final {
+        _tfmd.resetOnlyDocId(docId);
+    }
+    BitVector::UP get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    fef::TermFieldMatchData  &_tfmd;
+public:
+    uint32_t getDocIdLimit() const { return _docIdLimit; }
+    static UP create(const CompressedBitVector *const bv, uint32_t docIdLimit,
+                     fef::TermFieldMatchData &matchData, bool strict);
+};
+
+} // namespace search
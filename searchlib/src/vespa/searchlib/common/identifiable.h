@@ -100,6 +100,7 @@
 #define CID_search_aggregation_FS4Hit                     SEARCHLIB_CID(95)
 #define CID_search_aggregation_VdsHit                     SEARCHLIB_CID(96)
 #define CID_search_aggregation_HitList                    SEARCHLIB_CID(97)
+#define CID_search_aggregation_QuantileAggregationResult  SEARCHLIB_CID(98)
 
 #define CID_search_expression_BucketResultNode              SEARCHLIB_CID(100)
 #define CID_search_expression_IntegerBucketResultNode       SEARCHLIB_CID(101)
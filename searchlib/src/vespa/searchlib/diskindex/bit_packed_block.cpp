@@ -0,0 +1,82 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bit_packed_block.h"
+#include "zcbuf.h"
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace search::diskindex {
+
+namespace {
+
+using UnpackFunction = void (*)(const uint8_t *valI, uint32_t *values);
+
+/*
+ * Unpack a block with a fixed bit width. All offsets and shifts are
+ * compile time constants, allowing the compiler to fully unroll and
+ * vectorize the loop. Assumes a little endian host.
+ */
+template <uint32_t width>
+void
+unpack(const uint8_t *valI, uint32_t *values)
+{
+    constexpr uint64_t mask = (static_cast<uint64_t>(1) << width) - 1;
+    for (uint32_t i = 0; i < BitPackedBlock::block_size; ++i) {
+        uint64_t word;
+        memcpy(&word, valI + ((i * width) >> 3), sizeof(word));
+        values[i] = (word >> ((i * width) & 7)) & mask;
+    }
+}
+
+template <size_t... widths>
+constexpr std::array<UnpackFunction, sizeof...(widths)>
+make_unpack_functions(std::index_sequence<widths...>)
+{
+    return {{ &unpack<widths>... }};
+}
+
+constexpr auto unpack_functions = make_unpack_functions(std::make_index_sequence<33>());
+
+}
+
+void
+BitPackedBlock::encode(ZcBuf &zc_buf, const uint32_t *values)
+{
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        merged |= values[i];
+    }
+    uint32_t width = (merged != 0) ? (32 - __builtin_clz(merged)) : 0;
+    zc_buf.encode_byte(width);
+    uint64_t pending = 0;
+    uint32_t pending_bits = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        pending |= static_cast<uint64_t>(values[i]) << pending_bits;
+        pending_bits += width;
+        while (pending_bits >= 8) {
+            zc_buf.encode_byte(pending & 0xff);
+            pending >>= 8;
+            pending_bits -= 8;
+        }
+    }
+    // block_size * width is a multiple of 8, i.e. no partial byte
+}
+
+void
+BitPackedBlock::encode_padding(ZcBuf &zc_buf)
+{
+    for (uint32_t i = 0; i < padding_size; ++i) {
+        zc_buf.encode_byte(0);
+    }
+}
+
+uint32_t
+BitPackedBlock::decode(const uint8_t *valI, uint32_t *values)
+{
+    uint32_t width = valI[0];
+    unpack_functions[width](valI + 1, values);
+    return 1 + width * (block_size / 8);
+}
+
+}
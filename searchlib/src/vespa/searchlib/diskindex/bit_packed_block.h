@@ -0,0 +1,45 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::diskindex {
+
+class ZcBuf;
+
+/*
+ * Fixed size block of bit packed values, used as an alternative to
+ * variable length byte encoding of document id deltas (and interleaved
+ * features) in zc4 posting lists.
+ *
+ * A block contains block_size values. It is encoded as one byte with the
+ * bit width followed by 2 * width bytes with the values packed least
+ * significant bit first. The block size matches the L1 skip stride, thus
+ * skip entries always point to the start of a block.
+ *
+ * The decoder uses unaligned 64-bit loads and might read up to
+ * padding_size bytes past the end of the last block.
+ */
+class BitPackedBlock {
+public:
+    static constexpr uint32_t block_size = 16;
+    static constexpr uint32_t padding_size = 8;
+
+    static void encode(ZcBuf &zc_buf, const uint32_t *values);
+    static void encode_padding(ZcBuf &zc_buf);
+    // Returns number of bytes used by encoded block
+    static uint32_t decode(const uint8_t *valI, uint32_t *values);
+
+    /*
+     * Convert decoded document id deltas to document ids.
+     */
+    static void prefix_sum(uint32_t prev_doc_id, uint32_t *values) {
+        for (uint32_t i = 0; i < block_size; ++i) {
+            prev_doc_id += values[i] + 1;
+            values[i] = prev_doc_id;
+        }
+    }
+};
+
+}
@@ -65,6 +65,10 @@ FieldWriter::open(const vespalib::string &prefix,
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
     }
+    params.set("block_max_weights", true);
+    if (schema.getIndexField(indexId).use_bit_packed_doc_ids()) {
+        params.set("bit_packed_doc_ids", true);
+    }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
@@ -3,6 +3,7 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -44,15 +45,55 @@ Zc4PostingReaderBase::NoSkipBase::check_end(uint32_t last_doc_id)
 Zc4PostingReaderBase::NoSkip::NoSkip()
     : NoSkipBase(),
       _field_length(1),
-      _num_occs(1)
+      _num_occs(1),
+      _bit_packed_doc_ids(false),
+      _block_pos(BitPackedBlock::block_size)
 {
 }
 
 Zc4PostingReaderBase::NoSkip::~NoSkip() = default;
 
+void
+Zc4PostingReaderBase::NoSkip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id)
+{
+    NoSkipBase::setup(decode_context, size, doc_id);
+    if (_bit_packed_doc_ids) {
+        // Padding after last block is not part of the document id deltas
+        assert(size >= BitPackedBlock::padding_size);
+        _zc_buf._valE -= BitPackedBlock::padding_size;
+        _block_pos = BitPackedBlock::block_size;
+    }
+}
+
+void
+Zc4PostingReaderBase::NoSkip::read_block(bool decode_interleaved_features)
+{
+    assert(_zc_buf._valI < _zc_buf._valE);
+    _zc_buf._valI += BitPackedBlock::decode(_zc_buf._valI, _block_doc_id_deltas);
+    if (decode_interleaved_features) {
+        _zc_buf._valI += BitPackedBlock::decode(_zc_buf._valI, _block_field_lengths);
+        _zc_buf._valI += BitPackedBlock::decode(_zc_buf._valI, _block_num_occs);
+    }
+    assert(_zc_buf._valI <= _zc_buf._valE);
+    _doc_id_pos = _zc_buf.pos();
+    _block_pos = 0;
+}
+
 void
 Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features)
 {
+    if (_bit_packed_doc_ids) {
+        if (_block_pos == BitPackedBlock::block_size) {
+            read_block(decode_interleaved_features);
+        }
+        _doc_id += (_block_doc_id_deltas[_block_pos] + 1);
+        if (decode_interleaved_features) {
+            _field_length = _block_field_lengths[_block_pos] + 1;
+            _num_occs = _block_num_occs[_block_pos] + 1;
+        }
+        ++_block_pos;
+        return;
+    }
     assert(_zc_buf._valI < _zc_buf._valE);
     _doc_id += (_zc_buf.decode()+ 1);
     if (decode_interleaved_features) {
@@ -66,12 +107,14 @@ void
 Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 {
     assert(_doc_id < last_doc_id);
-    assert(_zc_buf._valI < _zc_buf._valE);
+    assert(_zc_buf._valI < _zc_buf._valE || (_bit_packed_doc_ids && _block_pos < BitPackedBlock::block_size));
 }
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
-      _l1_skip_pos(0)
+      _l1_skip_pos(0),
+      _block_max_weight(std::numeric_limits<int32_t>::max()),
+      _decode_block_max_weights(false)
 {
 }
 
@@ -106,6 +149,9 @@ void
 Zc4PostingReaderBase::L1Skip::next_skip_entry()
 {
     _doc_id += (_zc_buf.decode() + 1);
+    if (_decode_block_max_weights) {
+        _block_max_weight = DecodeContext64Base::convertToSigned(_zc_buf.decode());
+    }
 }
 
 Zc4PostingReaderBase::L2Skip::L2Skip()
@@ -248,7 +294,9 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
         assert(_num_docs == _counts._numDocs);
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
+    _no_skip.set_bit_packed_doc_ids(_posting_params._bit_packed_doc_ids);
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
+    _l1_skip.set_decode_block_max_weights(_posting_params._encode_block_max_weights);
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
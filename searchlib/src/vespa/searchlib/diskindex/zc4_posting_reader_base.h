@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "bit_packed_block.h"
 #include "zc4_posting_params.h"
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
@@ -42,26 +43,39 @@ protected:
     protected:
         uint32_t _field_length;
         uint32_t _num_occs;
+        bool     _bit_packed_doc_ids;
+        uint32_t _block_pos;
+        uint32_t _block_doc_id_deltas[BitPackedBlock::block_size];
+        uint32_t _block_field_lengths[BitPackedBlock::block_size];
+        uint32_t _block_num_occs[BitPackedBlock::block_size];
+
+        void read_block(bool decode_interleaved_features);
     public:
         NoSkip();
         ~NoSkip();
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id);
         void read(bool decode_interleaved_features);
         void check_not_end(uint32_t last_doc_id);
         uint32_t get_field_length() const { return _field_length; }
         uint32_t get_num_occs()     const { return _num_occs; }
         void set_field_length(uint32_t field_length) { _field_length = field_length; }
         void set_num_occs(uint32_t num_occs)         { _num_occs = num_occs; }
+        void set_bit_packed_doc_ids(bool bit_packed_doc_ids) { _bit_packed_doc_ids = bit_packed_doc_ids; }
     };
     // Helper class for L1 skip info
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        int32_t  _block_max_weight;
+        bool     _decode_block_max_weights;
     public:
         L1Skip();
         void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
         void next_skip_entry();
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
+        int32_t get_block_max_weight() const { return _block_max_weight; }
+        void set_decode_block_max_weights(bool decode_block_max_weights) { _decode_block_max_weights = decode_block_max_weights; }
     };
     class L2Skip : public L1Skip
     {
@@ -1,7 +1,9 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zc4_posting_writer_base.h"
+#include "bit_packed_block.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
+#include <limits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -26,27 +28,57 @@ public:
     }
 
     void write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features);
+    void flush(ZcBuf &, bool) { }
     void set_doc_id(uint32_t doc_id) { _doc_id = doc_id; }
     uint32_t get_doc_id() const { return _doc_id; }
     uint32_t get_doc_id_pos() const { return _doc_id_pos; }
     uint32_t get_feature_pos() const { return _feature_pos; }
 };
 
+/*
+ * Encoder for document id deltas (and interleaved features) using fixed size
+ * bit packed blocks. Document id position is only updated at block boundaries,
+ * which are aligned with L1 skip entries.
+ */
+class BitPackedDocIdEncoder : public DocIdEncoder {
+    uint32_t _num_pending;
+    uint32_t _doc_id_deltas[BitPackedBlock::block_size];
+    uint32_t _field_lengths[BitPackedBlock::block_size];
+    uint32_t _num_occs[BitPackedBlock::block_size];
+
+    void flush_block(ZcBuf &zc_buf, bool encode_interleaved_features);
+public:
+    BitPackedDocIdEncoder()
+        : DocIdEncoder(),
+          _num_pending(0u)
+    {
+    }
+
+    void write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features);
+    void flush(ZcBuf &zc_buf, bool encode_interleaved_features);
+};
+
 class L1SkipEncoder : public DocIdEncoder {
 protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
+    int32_t _block_max_weight;
     const bool _encode_features;
+    const bool _encode_block_max_weights;
 
+    void encode_block_max_weight(ZcBuf &zc_buf);
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max_weights)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _block_max_weight(std::numeric_limits<int32_t>::min()),
+          _encode_features(encode_features),
+          _encode_block_max_weights(encode_block_max_weights)
     {
     }
 
+    void update_block_max_weight(int32_t weight) { _block_max_weight = std::max(_block_max_weight, weight); }
     void encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
@@ -61,7 +93,7 @@ protected:
 
 public:
     L2SkipEncoder(bool encode_features)
-        : L1SkipEncoder(encode_features),
+        : L1SkipEncoder(encode_features, false),
           _l2_skip_pos(0u)
     {
     }
@@ -114,6 +146,50 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
     _doc_id_pos = zc_buf.size();
 }
 
+void
+BitPackedDocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features)
+{
+    _feature_pos += doc_id_and_feature_size._features_size;
+    _doc_id_deltas[_num_pending] = doc_id_and_feature_size._doc_id - _doc_id - 1;
+    _doc_id = doc_id_and_feature_size._doc_id;
+    if (encode_interleaved_features) {
+        assert(doc_id_and_feature_size._field_length > 0);
+        _field_lengths[_num_pending] = doc_id_and_feature_size._field_length - 1;
+        assert(doc_id_and_feature_size._num_occs > 0);
+        _num_occs[_num_pending] = doc_id_and_feature_size._num_occs - 1;
+    }
+    if (++_num_pending == BitPackedBlock::block_size) {
+        flush_block(zc_buf, encode_interleaved_features);
+    }
+}
+
+void
+BitPackedDocIdEncoder::flush_block(ZcBuf &zc_buf, bool encode_interleaved_features)
+{
+    BitPackedBlock::encode(zc_buf, _doc_id_deltas);
+    if (encode_interleaved_features) {
+        BitPackedBlock::encode(zc_buf, _field_lengths);
+        BitPackedBlock::encode(zc_buf, _num_occs);
+    }
+    _num_pending = 0;
+    _doc_id_pos = zc_buf.size();
+}
+
+void
+BitPackedDocIdEncoder::flush(ZcBuf &zc_buf, bool encode_interleaved_features)
+{
+    if (_num_pending != 0) {
+        // Pad last block, padding entries are never visited by readers
+        for (uint32_t i = _num_pending; i < BitPackedBlock::block_size; ++i) {
+            _doc_id_deltas[i] = 0;
+            _field_lengths[i] = 0;
+            _num_occs[i] = 0;
+        }
+        flush_block(zc_buf, encode_interleaved_features);
+    }
+    BitPackedBlock::encode_padding(zc_buf);
+}
+
 void
 L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
@@ -123,6 +199,9 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    if (_encode_block_max_weights) {
+        encode_block_max_weight(zc_buf);
+    }
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -145,9 +224,21 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
 {
     if (zc_buf.size() > 0) {
         zc_buf.encode(doc_id - _doc_id - 1);
+        if (_encode_block_max_weights) {
+            encode_block_max_weight(zc_buf);
+        }
     }
 }
 
+void
+L1SkipEncoder::encode_block_max_weight(ZcBuf &zc_buf)
+{
+    // max element weight for documents since previous skip entry
+    using EC = bitcompression::FeatureEncodeContext<true>;
+    zc_buf.encode(EC::convertToUnsigned(_block_max_weight));
+    _block_max_weight = std::numeric_limits<int32_t>::min();
+}
+
 void
 L2SkipEncoder::encode_skip(ZcBuf &zc_buf, const L1SkipEncoder &l1_skip)
 {
@@ -206,6 +297,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max_weights(false),
+      _bit_packed_doc_ids(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -234,11 +327,11 @@ Zc4PostingWriterBase::~Zc4PostingWriterBase()
 #define L3SKIPSTRIDE 8
 #define L4SKIPSTRIDE 8
 
+template <typename DocIdEncoderType>
 void
-Zc4PostingWriterBase::calc_skip_info(bool encode_features)
+Zc4PostingWriterBase::calc_skip_info(DocIdEncoderType &doc_id_encoder, bool encode_features)
 {
-    DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, _encode_block_max_weights);
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
@@ -265,7 +358,9 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
             }
         }
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        l1_skip_encoder.update_block_max_weight(doc_id_and_feature_size._max_element_weight);
     }
+    doc_id_encoder.flush(_zcDocIds, _encode_interleaved_features);
     // Extra partial entries for skip tables to simplify iterator during search
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
     l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
@@ -273,6 +368,18 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
 }
 
+void
+Zc4PostingWriterBase::calc_skip_info(bool encode_features)
+{
+    if (_bit_packed_doc_ids) {
+        BitPackedDocIdEncoder doc_id_encoder;
+        calc_skip_info(doc_id_encoder, encode_features);
+    } else {
+        DocIdEncoder doc_id_encoder;
+        calc_skip_info(doc_id_encoder, encode_features);
+    }
+}
+
 void
 Zc4PostingWriterBase::clear_skip_info()
 {
@@ -290,6 +397,8 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max_weights", _encode_block_max_weights);
+    params.get("bit_packed_doc_ids", _bit_packed_doc_ids);
 }
 
 }
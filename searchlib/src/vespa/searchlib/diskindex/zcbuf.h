@@ -48,6 +48,11 @@ public:
         maybeExpand();
     }
 
+    void encode_byte(uint8_t val) {
+        *_valI++ = val;
+        maybeExpand();
+    }
+
     uint32_t decode() {
         uint32_t res;
         uint8_t *valI = _valI;
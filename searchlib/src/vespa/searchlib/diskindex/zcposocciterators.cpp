@@ -35,12 +35,14 @@ ZcPosOccIterator<bigEndian, dynamic_k>::
 ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
                  bool decode_normal_features, bool decode_interleaved_features,
                  bool unpack_normal_features, bool unpack_interleaved_features,
+                 bool decode_block_max_weights, bool bit_packed_doc_ids,
                  uint32_t minChunkDocs, const PostingListCounts &counts,
                  const PosOccFieldsParams *fieldsParams,
                  const TermFieldMatchDataArray &matchData)
     : ZcPostingIterator<bigEndian>(minChunkDocs, dynamic_k, counts, matchData, start, docIdLimit,
                                    decode_normal_features, decode_interleaved_features,
-                                   unpack_normal_features, unpack_interleaved_features),
+                                   unpack_normal_features, unpack_interleaved_features,
+                                   decode_block_max_weights, bit_packed_doc_ids),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
     assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
@@ -67,9 +69,9 @@ create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Posit
         }
     } else {
         if (posting_params._dynamic_k) {
-            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._encode_block_max_weights, posting_params._bit_packed_doc_ids, posting_params._min_chunk_docs, counts, &fields_params, match_data);
         } else {
-            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, match_data);
+            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit, posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features, posting_params._encode_block_max_weights, posting_params._bit_packed_doc_ids, posting_params._min_chunk_docs, counts, &fields_params, match_data);
         }
     }
 }
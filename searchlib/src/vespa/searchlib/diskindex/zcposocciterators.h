@@ -40,6 +40,7 @@ public:
     ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
                      bool decode_normal_features, bool decode_interleaved_features,
                      bool unpack_normal_features, bool unpack_interleaved_features,
+                     bool decode_block_max_weights, bool bit_packed_doc_ids,
                      uint32_t minChunkDocs, const index::PostingListCounts &counts,
                      const bitcompression::PosOccFieldsParams *fieldsParams,
                      const fef::TermFieldMatchDataArray &matchData);
@@ -27,6 +27,8 @@ namespace {
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max_weights("block_max_weights");
+vespalib::string bit_packed_doc_ids("bit_packed_doc_ids");
 
 }
 
@@ -217,6 +219,12 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_weights) && (header.getTag(block_max_weights).asInteger() != 0)) {
+        _posting_params._encode_block_max_weights = true;
+    }
+    if (header.hasTag(bit_packed_doc_ids) && (header.getTag(bit_packed_doc_ids).asInteger() != 0)) {
+        _posting_params._bit_packed_doc_ids = true;
+    }
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -17,6 +17,8 @@ vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
 vespalib::string emptyId;
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max_weights("block_max_weights");
+vespalib::string bit_packed_doc_ids("bit_packed_doc_ids");
 
 }
 
@@ -124,6 +126,8 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max_weights, _reader.get_posting_params()._encode_block_max_weights);
+    params.set(bit_packed_doc_ids, _reader.get_posting_params()._bit_packed_doc_ids);
 }
 
 
@@ -170,6 +174,12 @@ Zc4PostingSeqRead::readHeader()
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
        posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_weights) && (header.getTag(block_max_weights).asInteger() != 0)) {
+       posting_params._encode_block_max_weights = true;
+    }
+    if (header.hasTag(bit_packed_doc_ids) && (header.getTag(bit_packed_doc_ids).asInteger() != 0)) {
+       posting_params._bit_packed_doc_ids = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -239,6 +249,8 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag("block_max_weights", _writer.get_encode_block_max_weights() ? 1 : 0));
+    header.putTag(Tag("bit_packed_doc_ids", _writer.get_bit_packed_doc_ids() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -359,6 +371,8 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max_weights, _writer.get_encode_block_max_weights());
+    params.set(bit_packed_doc_ids, _writer.get_bit_packed_doc_ids());
 }
 
 
@@ -11,6 +11,7 @@ using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchData;
 using search::bitcompression::FeatureDecodeContext;
 using search::bitcompression::FeatureEncodeContext;
+using search::bitcompression::DecodeContext64Base;
 using queryeval::RankedSearchIteratorBase;
 
 #define DEBUG_ZCPOSTING_PRINTF 0
@@ -187,9 +188,92 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
     clearUnpacked();
 }
 
+ZcPostingIteratorBase::BlockMax::BlockMax(uint32_t docIdLimit, bool decode_normal_features)
+    : BlockMaxPostingInfo(),
+      _valIBase(nullptr),
+      _prevDocId(0),
+      _lastDocId(0),
+      _docIdLimit(docIdLimit),
+      _hasMore(true), // No block max information before setup
+      _decode_normal_features(decode_normal_features),
+      _valI(nullptr),
+      _prevSkipDocId(0),
+      _skipDocId(0),
+      _maxWeight(std::numeric_limits<int32_t>::max())
+{
+}
+
+ZcPostingIteratorBase::BlockMax::~BlockMax() = default;
+
+void
+ZcPostingIteratorBase::BlockMax::setup(uint32_t prevDocId, uint32_t lastDocId, const uint8_t *bcompr, uint32_t skipSize, bool hasMore)
+{
+    _valIBase = (skipSize != 0) ? bcompr : nullptr;
+    _prevDocId = prevDocId;
+    _lastDocId = lastDocId;
+    _hasMore = hasMore;
+    restart();
+}
+
+void
+ZcPostingIteratorBase::BlockMax::restart() const
+{
+    _valI = _valIBase;
+    _prevSkipDocId = _prevDocId;
+    if (_valI != nullptr) {
+        _skipDocId = _prevDocId + 1;
+        ZCDECODE(_valI, _skipDocId +=);
+        uint32_t maxWeight;
+        ZCDECODE(_valI, maxWeight =);
+        _maxWeight = DecodeContext64Base::convertToSigned(maxWeight);
+    } else {
+        // Too few documents in chunk for skip info
+        _skipDocId = _lastDocId;
+        _maxWeight = std::numeric_limits<int32_t>::max();
+    }
+}
+
+void
+ZcPostingIteratorBase::BlockMax::nextSkipEntry() const
+{
+    ZCSKIP(_valI); // doc id pos
+    if (_decode_normal_features) {
+        ZCSKIP(_valI); // features pos
+    }
+    _prevSkipDocId = _skipDocId;
+    ZCDECODE(_valI, _skipDocId += 1 +);
+    uint32_t maxWeight;
+    ZCDECODE(_valI, maxWeight =);
+    _maxWeight = DecodeContext64Base::convertToSigned(maxWeight);
+}
+
+uint32_t
+ZcPostingIteratorBase::BlockMax::get_block_max_weight(uint32_t docId, int32_t &maxWeight) const
+{
+    if (docId <= _prevDocId || (docId > _lastDocId && _hasMore)) {
+        // Outside current chunk
+        maxWeight = std::numeric_limits<int32_t>::max();
+        return docId;
+    }
+    if (docId > _lastDocId) {
+        // No more documents in posting list
+        maxWeight = 0;
+        return _docIdLimit - 1;
+    }
+    if (docId <= _prevSkipDocId) {
+        restart();
+    }
+    while (docId > _skipDocId) {
+        nextSkipEntry();
+    }
+    maxWeight = _maxWeight;
+    return _skipDocId;
+}
+
 ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
-                                             bool unpack_normal_features, bool unpack_interleaved_features)
+                                             bool unpack_normal_features, bool unpack_interleaved_features,
+                                             bool decode_block_max_weights, bool bit_packed_doc_ids)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(nullptr),
       _valIBase(nullptr),
@@ -198,6 +282,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _l2(),
       _l3(),
       _l4(),
+      _blockMax(docIdLimit, decode_normal_features),
       _chunk(),
       _featuresSize(0),
       _hasMore(false),
@@ -205,10 +290,14 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _use_block_max_weights(decode_block_max_weights && decode_normal_features && unpack_normal_features),
+      _bit_packed_doc_ids(bit_packed_doc_ids),
       _chunkNo(0),
       _field_length(0),
-      _num_occs(0)
+      _num_occs(0),
+      _block_pos(0)
 {
+    _l1._decode_block_max_weights = decode_block_max_weights;
 }
 
 template <bool bigEndian>
@@ -219,10 +308,12 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   const search::fef::TermFieldMatchDataArray &matchData,
                   Position start, uint32_t docIdLimit,
                   bool decode_normal_features, bool decode_interleaved_features,
-                  bool unpack_normal_features, bool unpack_interleaved_features)
+                  bool unpack_normal_features, bool unpack_interleaved_features,
+                  bool decode_block_max_weights, bool bit_packed_doc_ids)
     : ZcPostingIteratorBase(matchData, start, docIdLimit,
                             decode_normal_features, decode_interleaved_features,
-                            unpack_normal_features, unpack_interleaved_features),
+                            unpack_normal_features, unpack_interleaved_features,
+                            decode_block_max_weights, bit_packed_doc_ids),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -310,6 +401,9 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     const uint8_t *bcompr = d.getByteCompr();
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
+    if (_use_block_max_weights) {
+        _blockMax.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize, hasMore);
+    }
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
@@ -526,12 +620,37 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
 }
 
 
+void
+ZcPostingIteratorBase::doBitPackedSeek(uint32_t docId)
+{
+    uint32_t oDocId = getDocId();
+    if (__builtin_expect(oDocId >= docId, false)) {
+        return; // Already positioned, or at end after skip seek
+    }
+    uint32_t blockPos = _block_pos;
+    // Seek target is never beyond last document in chunk, thus padding at end of last block is never visited
+    do {
+        if (__builtin_expect(blockPos == BitPackedBlock::block_size, false)) {
+            decodeDocIdBlock(oDocId);
+            blockPos = 0;
+        }
+        oDocId = _block_doc_ids[blockPos++];
+        incNeedUnpack();
+    } while (__builtin_expect(oDocId < docId, true));
+    _block_pos = blockPos - 1;
+    nextBlockDocId();
+}
+
 void
 ZcPostingIteratorBase::doSeek(uint32_t docId)
 {
     if (docId > _l1._skipDocId) {
         doL1SkipSeek(docId);
     }
+    if (_bit_packed_doc_ids) {
+        doBitPackedSeek(docId);
+        return;
+    }
     uint32_t oDocId = getDocId();
 #if DEBUG_ZCPOSTING_ASSERT
     assert(oDocId <= _l1._skipDocId);
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "bit_packed_block.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/fastos/dynamiclibrary.h>
 
 namespace search::diskindex {
@@ -41,6 +43,12 @@ do {                                                         \
     }                                                        \
 } while (0)
 
+#define ZCSKIP(valI)                                         \
+do {                                                         \
+    while (__builtin_expect(*valI++ >= (1 << 7), false)) {   \
+    }                                                        \
+} while (0)
+
 class ZcIteratorBase : public queryeval::RankedSearchIteratorBase
 {
 protected:
@@ -151,13 +159,15 @@ protected:
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
         const uint8_t *_valIBase;
+        bool _decode_block_max_weights;
 
         L1Skip()
             : _skipDocId(0),
               _valI(nullptr),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
-              _valIBase(nullptr)
+              _valIBase(nullptr),
+              _decode_block_max_weights(false)
         {
         }
 
@@ -167,6 +177,9 @@ protected:
                 bcompr += skipSize;
                 _skipDocId = prevDocId + 1;
                 ZCDECODE(_valI, _skipDocId +=);
+                if (_decode_block_max_weights) {
+                    ZCSKIP(_valI); // block max weight, only used by BlockMax helper class
+                }
             } else {
                 _valI = _valIBase = nullptr;
                 _skipDocId = lastDocId;
@@ -184,6 +197,9 @@ protected:
         }
         void nextDocId() {
             ZCDECODE(_valI, _skipDocId += 1 +);
+            if (_decode_block_max_weights) {
+                ZCSKIP(_valI);
+            }
         }
     };
 
@@ -257,6 +273,30 @@ protected:
         }
     };
 
+    // Helper class for block max weights stored in L1 skip info. It
+    // uses a separate cursor to avoid changing the iterator position.
+    class BlockMax : public queryeval::BlockMaxPostingInfo
+    {
+    public:
+        const uint8_t *_valIBase;
+        uint32_t _prevDocId;        // Last document id before chunk
+        uint32_t _lastDocId;        // Last document id in chunk
+        uint32_t _docIdLimit;
+        bool _hasMore;
+        bool _decode_normal_features;
+        mutable const uint8_t *_valI;
+        mutable uint32_t _prevSkipDocId;
+        mutable uint32_t _skipDocId;
+        mutable int32_t _maxWeight;
+
+        BlockMax(uint32_t docIdLimit, bool decode_normal_features);
+        ~BlockMax() override;
+        void setup(uint32_t prevDocId, uint32_t lastDocId, const uint8_t *bcompr, uint32_t skipSize, bool hasMore);
+        void restart() const;
+        void nextSkipEntry() const;
+        uint32_t get_block_max_weight(uint32_t docId, int32_t &maxWeight) const override;
+    };
+
     // Helper class for chunk skip info
     class ChunkSkip {
     public:
@@ -272,6 +312,7 @@ protected:
     L2Skip _l2;
     L3Skip _l3;
     L4Skip _l4;
+    BlockMax _blockMax;
     ChunkSkip _chunk;
     uint64_t _featuresSize;
     bool     _hasMore;
@@ -279,11 +320,41 @@ protected:
     bool     _decode_interleaved_features;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
+    bool     _use_block_max_weights;
+    bool     _bit_packed_doc_ids;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
-
+    // Decoded block when document id deltas are bit packed
+    uint32_t _block_pos;
+    uint32_t _block_doc_ids[BitPackedBlock::block_size];
+    uint32_t _block_field_lengths[BitPackedBlock::block_size];
+    uint32_t _block_num_occs[BitPackedBlock::block_size];
+
+    void decodeDocIdBlock(uint32_t prevDocId) {
+        _valI += BitPackedBlock::decode(_valI, _block_doc_ids);
+        BitPackedBlock::prefix_sum(prevDocId, _block_doc_ids);
+        if (_decode_interleaved_features) {
+            _valI += BitPackedBlock::decode(_valI, _block_field_lengths);
+            _valI += BitPackedBlock::decode(_valI, _block_num_occs);
+        }
+        _block_pos = 0;
+    }
+    void nextBlockDocId() {
+        setDocId(_block_doc_ids[_block_pos]);
+        if (_decode_interleaved_features) {
+            _field_length = _block_field_lengths[_block_pos] + 1;
+            _num_occs = _block_num_occs[_block_pos] + 1;
+        }
+        ++_block_pos;
+    }
     void nextDocId(uint32_t prevDocId) {
+        if (_bit_packed_doc_ids) {
+            // Always at start of a block (start of chunk or after skip)
+            decodeDocIdBlock(prevDocId);
+            nextBlockDocId();
+            return;
+        }
         uint32_t docId = prevDocId + 1;
         ZCDECODE(_valI, docId +=);
         setDocId(docId);
@@ -298,11 +369,16 @@ protected:
     VESPA_DLL_LOCAL void doL3SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL2SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL1SkipSeek(uint32_t docId);
+    VESPA_DLL_LOCAL void doBitPackedSeek(uint32_t docId);
     void doSeek(uint32_t docId) override;
 public:
     ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features);
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          bool decode_block_max_weights, bool bit_packed_doc_ids);
+    const queryeval::PostingInfo *getPostingInfo() const override {
+        return _use_block_max_weights ? &_blockMax : nullptr;
+    }
 };
 
 template <bool bigEndian>
@@ -331,7 +407,8 @@ public:
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       const search::fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                       bool decode_normal_features, bool decode_interleaved_features,
-                      bool unpack_normal_features, bool unpack_interleaved_features);
+                      bool unpack_normal_features, bool unpack_interleaved_features,
+                      bool decode_block_max_weights, bool bit_packed_doc_ids);
 
 
     void doUnpack(uint32_t docId) override;
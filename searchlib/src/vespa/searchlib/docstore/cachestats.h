@@ -13,13 +13,17 @@ struct CacheStats {
     size_t elements;
     size_t memory_used;
     size_t invalidations;
+    size_t admissions; // Objects let into the main cache by the admission policy.
+    size_t rejections; // Objects dropped by the admission policy.
 
     CacheStats()
         : hits(0),
           misses(0),
           elements(0),
           memory_used(0),
-          invalidations(0)
+          invalidations(0),
+          admissions(0),
+          rejections(0)
     { }
 
     CacheStats(size_t hits_, size_t misses_, size_t elements_, size_t memory_used_, size_t invalidations_)
@@ -27,7 +31,9 @@ struct CacheStats {
           misses(misses_),
           elements(elements_),
           memory_used(memory_used_),
-          invalidations(invalidations_)
+          invalidations(invalidations_),
+          admissions(0),
+          rejections(0)
     { }
 
     CacheStats &
@@ -38,6 +44,8 @@ struct CacheStats {
         elements += rhs.elements;
         memory_used += rhs.memory_used;
         invalidations += rhs.invalidations;
+        admissions += rhs.admissions;
+        rejections += rhs.rejections;
         return *this;
     }
 
@@ -48,10 +48,11 @@ Chunk::getMaxPackSize(const CompressionConfig & compression) const {
 }
 
 void
-Chunk::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression)
+Chunk::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+            const CompressionDictionary * dictionary)
 {
     _lastSerial = lastSerial;
-    _format->pack(_lastSerial, compressed, compression);
+    _format->pack(_lastSerial, compressed, compression, dictionary);
 }
 
 Chunk::Chunk(uint32_t id, const Config & config) :
@@ -62,10 +63,10 @@ Chunk::Chunk(uint32_t id, const Config & config) :
     _lids.reserve(4096/sizeof(Entry));
 }
 
-Chunk::Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc) :
+Chunk::Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc, const CompressionDictionary * dictionary) :
     _id(id),
     _lastSerial(static_cast<uint64_t>(-1l)),
-    _format(ChunkFormat::deserialize(buffer, len, skipcrc))
+    _format(ChunkFormat::deserialize(buffer, len, skipcrc, dictionary))
 {
     vespalib::nbostream &os = getData();
     while (os.size() > sizeof(_lastSerial)) {
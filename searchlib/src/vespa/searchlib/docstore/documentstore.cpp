@@ -9,6 +9,7 @@
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 
@@ -109,6 +110,47 @@ public:
     Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
 };
 
+/**
+ * Adds the documents read from the backing store as one batch to the cache,
+ * as the cache would have done when reading them one by one, before handing
+ * them to the visitor.
+ */
+class CachePopulatingVisitor : public IBufferVisitor
+{
+public:
+    CachePopulatingVisitor(Cache & cache, const BackingStore & store, const DocumentTypeRepo & repo,
+                           IDocumentVisitor & visitor)
+        : _cache(cache),
+          _store(store),
+          _repo(repo),
+          _visitor(visitor),
+          _found()
+    { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override;
+    const IDocumentStore::LidVector & getFound() const { return _found; }
+private:
+    Cache                     & _cache;
+    const BackingStore        & _store;
+    const DocumentTypeRepo    & _repo;
+    IDocumentVisitor          & _visitor;
+    IDocumentStore::LidVector   _found;
+};
+
+void
+CachePopulatingVisitor::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
+    if (buf.size() == 0) {
+        return;
+    }
+    vespalib::DataBuffer data(buf.size());
+    data.writeBytes(buf.c_str(), buf.size());
+    Value value;
+    value.set(std::move(data), buf.size(), _store.getCompression());
+    _cache.populate(lid, std::move(value));
+    _found.push_back(lid);
+    vespalib::nbostream is(buf.c_str(), buf.size());
+    _visitor.visit(lid, std::make_unique<document::Document>(_repo, is));
+}
+
 }
 
 using VisitCache = docstore::VisitCache;
@@ -120,6 +162,7 @@ DocumentStore::Config::operator == (const Config &rhs) const {
             (_allowVisitCaching == rhs._allowVisitCaching) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
             (_updateStrategy == rhs._updateStrategy) &&
+            (_cachePolicy == rhs._cachePolicy) &&
             (_compression == rhs._compression);
 }
 
@@ -130,10 +173,12 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _backingStore(store),
       _store(std::make_unique<docstore::BackingStore>(_backingStore, config.getCompression())),
       _cache(std::make_unique<docstore::Cache>(*_store, config.getMaxCacheBytes())),
-      _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression())),
+      _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression(),
+                                                         config.cachePolicy())),
       _uncached_lookups(0)
 {
     _cache->reserveElements(config.getInitialCacheEntries());
+    _cache->setPolicy(config.cachePolicy());
 }
 
 DocumentStore::~DocumentStore() = default;
@@ -161,11 +206,46 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
         for (DocumentIdT lid : lids) {
             adapter.visit(lid, blobSet.get(lid));
         }
+    } else if (useCache() && visitor.allowDocumentCaching()) {
+        // Serve what is already cached and read the rest as one batch from the backing store.
+        LidVector uncached;
+        uncached.reserve(lids.size());
+        for (DocumentIdT lid : lids) {
+            if (_cache->hasKey(lid)) {
+                visitCached(lid, repo, visitor);
+            } else {
+                uncached.push_back(lid);
+            }
+        }
+        if (uncached.empty()) {
+            return;
+        }
+        docstore::CachePopulatingVisitor populator(*_cache, *_store, repo, visitor);
+        _backingStore.read(uncached, populator);
+        if (populator.getFound().size() < uncached.size()) {
+            // Look up the missing ones through the cache, so they are accounted for as with read().
+            LidVector found(populator.getFound());
+            std::sort(found.begin(), found.end());
+            for (DocumentIdT lid : uncached) {
+                if ( ! std::binary_search(found.begin(), found.end(), lid)) {
+                    visitCached(lid, repo, visitor);
+                }
+            }
+        }
     } else {
         _store->visit(lids, repo, visitor);
     }
 }
 
+void
+DocumentStore::visitCached(DocumentIdT lid, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    DocumentUP doc = read(lid, repo);
+    if (doc) {
+        visitor.visit(lid, std::move(doc));
+    }
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
@@ -432,6 +512,8 @@ CacheStats DocumentStore::getCacheStats() const {
     CacheStats visitStats = _visitCache->getCacheStats();
     CacheStats singleStats(_cache->getHit(), _cache->getMiss() + _uncached_lookups,
                            _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    singleStats.admissions = _cache->getAdmit();
+    singleStats.rejections = _cache->getReject();
     singleStats += visitStats;
     return singleStats;
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idocumentstore.h"
+#include <vespa/vespalib/stllike/cache.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 
 namespace search::docstore {
@@ -25,19 +26,22 @@ public:
     public:
         enum UpdateStrategy {INVALIDATE, UPDATE };
         using CompressionConfig = vespalib::compression::CompressionConfig;
+        using CachePolicy = vespalib::CachePolicy;
         Config() :
             _compression(CompressionConfig::LZ4, 9, 70),
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _cachePolicy(CachePolicy::LRU)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _cachePolicy(CachePolicy::LRU)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
@@ -46,6 +50,8 @@ public:
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
         Config & updateStrategy(UpdateStrategy strategy) { _updateStrategy = strategy; return *this; }
         UpdateStrategy updateStrategy() const { return _updateStrategy; }
+        Config & cachePolicy(CachePolicy policy) { _cachePolicy = policy; return *this; }
+        CachePolicy cachePolicy() const { return _cachePolicy; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
@@ -53,6 +59,7 @@ public:
         size_t _initialCacheEntries;
         UpdateStrategy _updateStrategy;
         bool   _allowVisitCaching;
+        CachePolicy _cachePolicy;
     };
 
     /**
@@ -104,6 +111,7 @@ public:
 
 private:
     bool useCache() const;
+    void visitCached(DocumentIdT lid, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     template <class> class WrapVisitor;
     class WrapVisitorProgress;
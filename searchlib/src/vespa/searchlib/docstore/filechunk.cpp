@@ -13,6 +13,8 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/array.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/fastos/file.h>
 #include <future>
 
@@ -29,6 +31,9 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string COMPRESSION_DICTIONARY_KEY("compressionDictionary");
+const vespalib::string COMPRESSION_DICTIONARY_LEVEL_KEY("compressionDictionaryLevel");
+constexpr size_t MAX_SAMPLED_CHUNKS = 256;
 
 }
 
@@ -83,7 +88,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _compressionDictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -276,6 +282,21 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if (frozen()) {
+        // Writeable file chunks get their dictionary when the file is created or reopened.
+        loadCompressionDictionary();
+    }
+}
+
+void
+FileChunk::loadCompressionDictionary()
+{
+    vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+    FileRandRead::FSP keepAlive(_file->read(0, h, _dataHeaderLen));
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    _compressionDictionary = readCompressionDictionary(header);
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -351,7 +372,8 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false,
+                                                      _compressionDictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -386,7 +408,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _compressionDictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -411,7 +433,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _compressionDictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -473,6 +495,50 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::CompressionDictionarySP
+FileChunk::readCompressionDictionary(const vespalib::GenericHeader &header)
+{
+    if (header.hasTag(COMPRESSION_DICTIONARY_KEY)) {
+        const vespalib::string & encoded = header.getTag(COMPRESSION_DICTIONARY_KEY).asString();
+        std::string content = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+        int level = header.hasTag(COMPRESSION_DICTIONARY_LEVEL_KEY)
+                    ? header.getTag(COMPRESSION_DICTIONARY_LEVEL_KEY).asInteger()
+                    : vespalib::compression::CompressionConfig(vespalib::compression::CompressionConfig::ZSTD).compressionLevel;
+        return std::make_shared<CompressionDictionary>(vespalib::ConstBufferRef(content.data(), content.size()), level);
+    }
+    return CompressionDictionarySP();
+}
+
+void
+FileChunk::writeCompressionDictionary(vespalib::GenericHeader &header, const CompressionDictionary &dictionary)
+{
+    vespalib::ConstBufferRef content = dictionary.getContent();
+    std::string encoded = vespalib::Base64::encode(content.c_str(), content.size());
+    header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_DICTIONARY_KEY, vespalib::string(encoded)));
+    header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_DICTIONARY_LEVEL_KEY, int32_t(dictionary.getCompressionLevel())));
+}
+
+void
+FileChunk::sample(size_t maxBytes, IBufferVisitor & visitor) const
+{
+    assert(frozen());
+    size_t stride = std::max(1ul, _chunkInfo.size() / MAX_SAMPLED_CHUNKS);
+    size_t sampledBytes(0);
+    for (size_t chunkId(0); (chunkId < _chunkInfo.size()) && (sampledBytes < maxBytes); chunkId += stride) {
+        const ChunkInfo & ci(_chunkInfo[chunkId]);
+        vespalib::DataBuffer whole(0ul, ALIGNMENT);
+        FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+        Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _compressionDictionary.get());
+        for (const Chunk::Entry & entry : chunk.getUniqueLids()) {
+            vespalib::ConstBufferRef buf = chunk.getLid(entry.getLid());
+            if (buf.size() != 0) {
+                visitor.visit(entry.getLid(), buf);
+                sampledBytes += buf.size();
+            }
+        }
+    }
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -487,7 +553,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _compressionDictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -106,6 +106,8 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using CompressionDictionary = Chunk::CompressionDictionary;
+    using CompressionDictionarySP = std::shared_ptr<const CompressionDictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -166,6 +168,16 @@ public:
     void compact(const IGetLid & iGetLid);
     void appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
                   uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress);
+    /**
+     * Visit entries from chunks spread evenly over the file until at least
+     * maxBytes have been visited. Used to train compression dictionaries.
+     * Only allowed on frozen files.
+     */
+    void sample(size_t maxBytes, IBufferVisitor & visitor) const;
+    /**
+     * The dictionary used for zstd compressed chunks in this file, if any.
+     */
+    const CompressionDictionarySP & getCompressionDictionary() const { return _compressionDictionary; }
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
@@ -202,6 +214,7 @@ public:
 private:
     typedef std::unique_ptr<FileRandRead> File;
     void loadChunkInfo();
+    void loadCompressionDictionary();
     const FileId           _fileId;
     const NameId           _nameId;
     const vespalib::string _name;
@@ -238,6 +251,8 @@ protected:
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static CompressionDictionarySP readCompressionDictionary(const vespalib::GenericHeader &header);
+    static void writeCompressionDictionary(vespalib::GenericHeader &header, const CompressionDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -252,6 +267,7 @@ protected:
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    CompressionDictionarySP _compressionDictionary;
 };
 
 } // namespace search
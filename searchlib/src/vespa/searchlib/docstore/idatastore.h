@@ -7,9 +7,11 @@
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/time.h>
+#include <memory>
 #include <vector>
 
 namespace vespalib { class DataBuffer; }
+namespace vespalib::compression { class ZStdDictionary; }
 namespace search {
 
 class IBufferVisitor;
@@ -39,6 +41,7 @@ class IDataStore : public common::ICompactableLidSpace
 {
 public:
     typedef std::vector<uint32_t> LidVector;
+    using CompressionDictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     /**
      * Construct an idata store.
      * A data store has a base directory. The rest is up to the implementation.
@@ -127,6 +130,13 @@ public:
      */
     virtual size_t getMaxCompactGain() const { return getDiskBloat(); }
 
+    /**
+     * The zstd dictionary currently used when writing data, trained from stored data.
+     * Can be used to compress other representations of the same data.
+     * @return the dictionary, or empty if there is none.
+     */
+    virtual CompressionDictionarySP getCompressionDictionary() const { return CompressionDictionarySP(); }
+
 
     /**
      * The sync token used for the last successful flush() operation,
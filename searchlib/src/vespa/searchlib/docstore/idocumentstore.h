@@ -50,6 +50,11 @@ public:
     virtual ~IDocumentVisitor() { }
     virtual void visit(uint32_t lid, DocumentUP doc) = 0;
     virtual bool allowVisitCaching() const = 0;
+    /**
+     * Return true to have the documents looked up in and added to the
+     * document cache, as if each of them was fetched with read().
+     */
+    virtual bool allowDocumentCaching() const { return false; }
 private:
 };
 
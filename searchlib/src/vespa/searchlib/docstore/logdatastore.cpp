@@ -9,6 +9,10 @@
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/rcuvector.hpp>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <future>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -19,6 +23,58 @@ namespace search {
 namespace {
     constexpr size_t DEFAULT_MAX_FILESIZE = 1000000000ul;
     constexpr uint32_t DEFAULT_MAX_LIDS_PER_FILE = 32 * 1024 * 1024;
+    constexpr uint32_t READ_EXECUTOR_STACK_SIZE = 128 * 1024;
+    // zstd recommends roughly 100 times as much sample data as the wanted dictionary size.
+    constexpr size_t DICTIONARY_SAMPLE_FACTOR = 100;
+
+/**
+ * Keeps copies of the buffers visited by a chunk read running in the read
+ * executor, so they can be handed to the real visitor by the calling thread.
+ */
+class BufferCollector : public IBufferVisitor {
+public:
+    BufferCollector() : _entries(), _data() { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        _entries.emplace_back(lid, _data.size(), buffer.size());
+        _data.insert(_data.end(), buffer.c_str(), buffer.c_str() + buffer.size());
+    }
+    void replay(IBufferVisitor & visitor) const {
+        for (const Entry & entry : _entries) {
+            visitor.visit(entry.lid, vespalib::ConstBufferRef(&_data[entry.offset], entry.size));
+        }
+    }
+private:
+    struct Entry {
+        Entry(uint32_t lid_in, size_t offset_in, size_t size_in) : lid(lid_in), offset(offset_in), size(size_in) { }
+        uint32_t lid;
+        size_t   offset;
+        size_t   size;
+    };
+    std::vector<Entry> _entries;
+    std::vector<char>  _data;
+};
+
+class SampleCollector : public IBufferVisitor {
+public:
+    SampleCollector() : _offsets(), _data() { }
+    void visit(uint32_t, vespalib::ConstBufferRef buffer) override {
+        _offsets.push_back(_data.size());
+        _data.insert(_data.end(), buffer.c_str(), buffer.c_str() + buffer.size());
+    }
+    std::vector<vespalib::ConstBufferRef> getSamples() const {
+        std::vector<vespalib::ConstBufferRef> samples;
+        samples.reserve(_offsets.size());
+        for (size_t i(0); i < _offsets.size(); i++) {
+            size_t end = ((i + 1) < _offsets.size()) ? _offsets[i + 1] : _data.size();
+            samples.emplace_back(_data.data() + _offsets[i], end - _offsets[i]);
+        }
+        return samples;
+    }
+private:
+    std::vector<size_t> _offsets;
+    std::vector<char>   _data;
+};
+
 }
 
 using vespalib::LockGuard;
@@ -40,6 +96,8 @@ LogDataStore::Config::Config()
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
+      _readConcurrency(1),
+      _compressionDictionarySize(0),
       _skipCrcOnRead(false),
       _compactCompression(CompressionConfig::LZ4),
       _fileConfig()
@@ -51,6 +109,8 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_readConcurrency == rhs._readConcurrency) &&
+            (_compressionDictionarySize == rhs._compressionDictionarySize) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
             (_fileConfig == rhs._fileConfig);
@@ -74,15 +134,21 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _prevActive(FileId::active()),
       _readOnly(readOnly),
       _executor(executor),
+      _readExecutor(),
       _initFlushSyncToken(0),
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _compressionDictionary()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
     _holdFileChunks.resize(LidInfo::getFileIdLimit());
+    if (config.getReadConcurrency() > 1) {
+        _readExecutor = std::make_unique<vespalib::ThreadStackExecutor>(config.getReadConcurrency(),
+                                                                        READ_EXECUTOR_STACK_SIZE);
+    }
 
     preload();
     updateLidMap(getLastFileChunkDocIdLimit());
@@ -143,6 +209,10 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
     if (orderedLids.empty()) { return; }
 
     std::sort(orderedLids.begin(), orderedLids.end());
+    if (_readExecutor && (orderedLids.front() < orderedLids.back())) {
+        readConcurrently(orderedLids, visitor);
+        return;
+    }
     uint32_t prevFile = orderedLids[0].getFileId();
     uint32_t start = 0;
     for (size_t curr(1); curr < orderedLids.size(); curr++) {
@@ -158,6 +228,64 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
     fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
 }
 
+void
+LogDataStore::readConcurrently(const LidInfoWithLidV & orderedLids, IBufferVisitor & visitor) const
+{
+    // Split in groups of lids sharing the same chunk, each read and decompressed by one task.
+    std::vector<std::pair<uint32_t, uint32_t>> groups;
+    uint32_t start = 0;
+    for (size_t curr(1); curr < orderedLids.size(); curr++) {
+        if (orderedLids[start] < orderedLids[curr]) {
+            groups.emplace_back(start, curr - start);
+            start = curr;
+        }
+    }
+    groups.emplace_back(start, orderedLids.size() - start);
+
+    std::vector<std::future<BufferCollector>> pending;
+    pending.reserve(groups.size() - 1);
+    for (size_t i(1); i < groups.size(); i++) {
+        auto begin = orderedLids.begin() + groups[i].first;
+        uint32_t count = groups[i].second;
+        const FileChunk & fc(*_fileChunks[begin->getFileId()]);
+        auto promise = std::make_shared<std::promise<BufferCollector>>();
+        pending.push_back(promise->get_future());
+        _readExecutor->execute(vespalib::makeLambdaTask([promise, &fc, begin, count]() {
+            try {
+                BufferCollector collector;
+                fc.read(begin, count, collector);
+                promise->set_value(std::move(collector));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        }));
+    }
+    // The first chunk is read by this thread while the others are in flight.
+    std::exception_ptr failure;
+    try {
+        auto begin = orderedLids.begin() + groups[0].first;
+        _fileChunks[begin->getFileId()]->read(begin, groups[0].second, visitor);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    for (auto & future : pending) {
+        // All tasks must complete before returning, as they refer to orderedLids and the file chunks.
+        try {
+            BufferCollector collector = future.get();
+            if ( ! failure) {
+                collector.replay(visitor);
+            }
+        } catch (...) {
+            if ( ! failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
 ssize_t
 LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
 {
@@ -477,6 +605,11 @@ void LogDataStore::compactFile(FileId fileId)
     NameId compactedNameId = fc->getNameId();
     LOG(info, "Compacting file '%s' which has bloat '%2.2f' and bucket-spread '%1.4f",
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
+    if ((_config.getCompressionDictionarySize() > 0) && !getCompressionDictionary() && fc->frozen() &&
+        (_config.getFileConfig().getCompression().type == CompressionConfig::ZSTD))
+    {
+        trainCompressionDictionary(*fc);
+    }
     IWriteData::UP compacter;
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
@@ -534,6 +667,31 @@ void LogDataStore::compactFile(FileId fileId)
     _currentlyCompacting.erase(compactedNameId);
 }
 
+void
+LogDataStore::trainCompressionDictionary(const FileChunk & source)
+{
+    const size_t dictionarySize = _config.getCompressionDictionarySize();
+    SampleCollector collector;
+    source.sample(dictionarySize * DICTIONARY_SAMPLE_FACTOR, collector);
+    auto dictionary = vespalib::compression::ZStdDictionary::train(collector.getSamples(), dictionarySize,
+                                                                   _config.getFileConfig().getCompression().compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained compression dictionary of %zu bytes from file '%s'. It will be used for new files.",
+            dictionary->getContent().size(), source.getName().c_str());
+        LockGuard guard(_updateLock);
+        _compressionDictionary = std::move(dictionary);
+    } else {
+        LOG(debug, "Not enough data in file '%s' to train a compression dictionary", source.getName().c_str());
+    }
+}
+
+LogDataStore::CompressionDictionarySP
+LogDataStore::getCompressionDictionary() const
+{
+    LockGuard guard(_updateLock);
+    return _compressionDictionary;
+}
+
 size_t
 LogDataStore::memoryUsed() const
 {
@@ -660,7 +818,9 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(),
+                                              (_config.getCompressionDictionarySize() > 0)
+                                                  ? _compressionDictionary : CompressionDictionarySP()));
     file->enableRead();
     return file;
 }
@@ -792,6 +952,9 @@ LogDataStore::preload()
         typedef NameIdSet::const_iterator It;
         for (It it(partList.begin()), mt(--partList.end()); it != mt; it++) {
             _fileChunks.push_back(createReadOnlyFile(FileId(_fileChunks.size()), *it));
+            if (_fileChunks.back()->getCompressionDictionary()) {
+                _compressionDictionary = _fileChunks.back()->getCompressionDictionary();
+            }
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
@@ -44,6 +44,8 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        Config & setReadConcurrency(uint32_t v) { _readConcurrency = v; return *this; }
+        Config & setCompressionDictionarySize(size_t v) { _compressionDictionarySize = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -53,6 +55,8 @@ public:
         double getMaxBucketSpread() const { return _maxBucketSpread; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
         uint32_t getMaxNumLids() const { return _maxNumLids; }
+        uint32_t getReadConcurrency() const { return _readConcurrency; }
+        size_t getCompressionDictionarySize() const { return _compressionDictionarySize; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         const CompressionConfig & compactCompression() const { return _compactCompression; }
@@ -67,6 +71,8 @@ public:
         double                      _maxBucketSpread;
         double                      _minFileSizeFactor;
         uint32_t                    _maxNumLids;
+        uint32_t                    _readConcurrency;
+        size_t                      _compressionDictionarySize;
         bool                        _skipCrcOnRead;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
@@ -96,6 +102,12 @@ public:
 
     // Implements IDataStore API
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
+    /**
+     * Read a batch of lids. When configured with a read concurrency above 1,
+     * the chunks touched are read and decompressed in parallel by a dedicated
+     * read executor, while the visitor is still called from this thread in
+     * file and chunk order.
+     */
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
     void remove(uint64_t serialNum, uint32_t lid) override;
@@ -110,6 +122,7 @@ public:
     size_t getDiskHeaderFootprint() const override;
     size_t getDiskBloat() const override;
     size_t getMaxCompactGain() const override;
+    CompressionDictionarySP getCompressionDictionary() const override;
 
     /**
      * Will compact the docsummary up to a lower limit of 5% bloat.
@@ -189,6 +202,7 @@ private:
 
     void compactWorst(double bloatLimit, double spreadLimit, bool prioritizeDiskBloat);
     void compactFile(FileId chunkId);
+    void trainCompressionDictionary(const FileChunk & source);
 
     typedef vespalib::RcuVector<uint64_t> LidInfoVector;
     typedef std::vector<FileChunk::UP> FileChunkVector;
@@ -197,6 +211,7 @@ private:
     void preload();
     uint32_t getLastFileChunkDocIdLimit();
     void verifyModificationTime(const NameIdSet & partList);
+    void readConcurrently(const LidInfoWithLidV & orderedLids, IBufferVisitor & visitor) const;
 
     void eraseDanglingDatFiles(const NameIdSet &partList, const NameIdSet &datPartList);
     NameIdSet eraseEmptyIdxFiles(NameIdSet partList);
@@ -285,11 +300,13 @@ private:
     vespalib::Lock                           _updateLock;
     bool                                     _readOnly;
     vespalib::ThreadExecutor                &_executor;
+    std::unique_ptr<vespalib::ThreadExecutor> _readExecutor;
     SerialNum                                _initFlushSyncToken;
     transactionlog::SyncProxy               &_tlSyncer;
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    CompressionDictionarySP                  _compressionDictionary;
 };
 
 } // namespace search
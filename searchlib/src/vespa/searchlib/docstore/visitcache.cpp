@@ -76,22 +76,25 @@ BlobSet::get(uint32_t lid) const
 CompressedBlobSet::CompressedBlobSet() :
     _compression(CompressionConfig::Type::LZ4),
     _positions(),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
 }
 
 CompressedBlobSet::~CompressedBlobSet() = default;
 
 
-CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed) :
+CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed,
+                                     CompressionDictionarySP dictionary) :
     _compression(compression.type),
     _positions(uncompressed.getPositions()),
-    _buffer()
+    _buffer(),
+    _dictionary(std::move(dictionary))
 {
     if ( ! _positions.empty() ) {
         DataBuffer compressed;
         ConstBufferRef org = uncompressed.getBuffer();
-        _compression = vespalib::compression::compress(compression, org, compressed, false);
+        _compression = vespalib::compression::compress(compression, org, compressed, false, _dictionary.get());
         _buffer = std::make_shared<vespalib::MallocPtr>(compressed.getDataLen());
         memcpy(*_buffer, compressed.getData(), compressed.getDataLen());
     } else {
@@ -107,7 +110,7 @@ CompressedBlobSet::getBlobSet() const
     DataBuffer uncompressed(0, 1, Alloc::alloc(0, 16 * MemoryAllocator::HUGEPAGE_SIZE));
     if ( ! _positions.empty() ) {
         decompress(_compression, getBufferSize(_positions),
-                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false);
+                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false, _dictionary.get());
     }
     return BlobSet(_positions, std::move(uncompressed).stealBuffer());
 }
@@ -143,7 +146,7 @@ bool
 VisitCache::BackingStore::read(const KeySet &key, CompressedBlobSet &blobs) const {
     VisitCollector collector;
     _backingStore.read(key.getKeys(), collector);
-    blobs = CompressedBlobSet(_compression, collector.getBlobSet());
+    blobs = CompressedBlobSet(_compression, collector.getBlobSet(), _backingStore.getCompressionDictionary());
     return ! blobs.empty();
 }
 
@@ -153,10 +156,12 @@ VisitCache::BackingStore::reconfigure(const CompressionConfig &compression) {
 }
 
 
-VisitCache::VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression) :
+VisitCache::VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression,
+                       CachePolicy policy) :
     _store(store, compression),
     _cache(std::make_unique<Cache>(_store, cacheSize))
 {
+    _cache->setPolicy(policy);
 }
 
 void
@@ -221,7 +226,10 @@ VisitCache::remove(uint32_t key) {
 
 CacheStats
 VisitCache::getCacheStats() const {
-    return CacheStats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    CacheStats stats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    stats.admissions = _cache->getAdmit();
+    stats.rejections = _cache->getReject();
+    return stats;
 }
 
 VisitCache::Cache::Cache(BackingStore & b, size_t maxBytes) :
@@ -70,13 +70,16 @@ private:
  * This is a compressed representation of the above BlobSet.
  * It carries everything necessary to regenerate a BlobSet.
  * It has efficient move constructor/operator since they will be stored
- * in stl containers.
+ * in stl containers. If a compression dictionary is given it is kept
+ * alive for as long as the compressed set needs it.
  **/
 class CompressedBlobSet {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using CompressionDictionarySP = IDataStore::CompressionDictionarySP;
     CompressedBlobSet();
-    CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed);
+    CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed,
+                      CompressionDictionarySP dictionary = CompressionDictionarySP());
     CompressedBlobSet(CompressedBlobSet && rhs) = default;
     CompressedBlobSet & operator=(CompressedBlobSet && rhs) = default;
     CompressedBlobSet(const CompressedBlobSet & rhs) = default;
@@ -89,6 +92,7 @@ private:
     CompressionConfig::Type _compression;
     BlobSet::Positions      _positions;
     std::shared_ptr<vespalib::MallocPtr> _buffer;
+    CompressionDictionarySP _dictionary;
 };
 
 /**
@@ -99,7 +103,9 @@ private:
 class VisitCache {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
-    VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression);
+    using CachePolicy = vespalib::CachePolicy;
+    VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression,
+               CachePolicy policy = CachePolicy::LRU);
 
     CompressedBlobSet read(const IDocumentStore::LidVector & keys) const;
     void remove(uint32_t key);
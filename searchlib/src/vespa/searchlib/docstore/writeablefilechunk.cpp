@@ -83,7 +83,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   CompressionDictionarySP compressionDictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -118,6 +119,10 @@ WriteableFileChunk(vespalib::Executor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            // The dictionary is only of use for zstd, and must then be used for all chunks in the file.
+            if (config.getCompression().type == Config::CompressionConfig::ZSTD) {
+                _compressionDictionary = std::move(compressionDictionary);
+            }
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -290,7 +295,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _compressionDictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -724,6 +729,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _compressionDictionary = readCompressionDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -790,6 +796,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_compressionDictionary) {
+        writeCompressionDictionary(h, *_compressionDictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
@@ -121,6 +121,9 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t output,
+                       vespalib::ArrayRef<feature_t> dst) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -133,6 +136,13 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t,
+                       vespalib::ArrayRef<feature_t> dst) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            dst[i] = _attribute.getFloat(docids[i]);
+        }
+    }
 };
 
 /**
@@ -237,6 +247,23 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t output,
+                                          vespalib::ArrayRef<feature_t> dst)
+{
+    if (output != 0) {
+        std::fill(dst.begin(), dst.begin() + docids.size(), outputs().get_number(output));
+        return;
+    }
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        dst[i] = __builtin_expect(attribute::isUndefined(v), false)
+                 ? attribute::getUndefined<feature_t>()
+                 : util::getAsFeature(v);
+    }
+}
+
 template <typename T>
 void
 MultiAttributeExecutor<T>::execute(uint32_t docId)
@@ -52,11 +52,15 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    std::vector<double> _batch_input;
+    std::vector<float> _batch_params;
 
 public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, size_t output, ArrayRef<double> dst) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -70,11 +74,14 @@ private:
     typedef double (*arr_function)(const double *);
     arr_function _ranking_function;
     std::vector<double> _params;
+    std::vector<double> _batch_params;
 
 public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, size_t output, ArrayRef<double> dst) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -132,7 +139,9 @@ public:
 FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_input(),
+      _batch_params()
 {
 }
 
@@ -152,11 +161,28 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids, size_t, ArrayRef<double> dst)
+{
+    const size_t num_docs = docids.size();
+    _batch_input.resize(num_docs);
+    _batch_params.resize(_params.size() * num_docs);
+    for (size_t i = 0; i < _params.size(); ++i) {
+        inputs().get_numbers(i, docids, _batch_input);
+        float *column = &_batch_params[i * num_docs];
+        for (size_t d = 0; d < num_docs; ++d) {
+            column[d] = _batch_input[d];
+        }
+    }
+    _forest.eval_batch(*_ctx, &_batch_params[0], num_docs, &dst[0]);
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
     : _ranking_function(compiled_function.get_function()),
-      _params(compiled_function.num_params(), 0.0)
+      _params(compiled_function.num_params(), 0.0),
+      _batch_params()
 {
 }
 
@@ -176,6 +202,24 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, size_t, ArrayRef<double> dst)
+{
+    // gather each input as a column, then evaluate one row at a time
+    const size_t num_docs = docids.size();
+    const size_t num_params = _params.size();
+    _batch_params.resize(num_params * num_docs);
+    for (size_t p = 0; p < num_params; ++p) {
+        inputs().get_numbers(p, docids, ArrayRef<double>(&_batch_params[p * num_docs], num_docs));
+    }
+    for (size_t i = 0; i < num_docs; ++i) {
+        for (size_t p = 0; p < num_params; ++p) {
+            _params[p] = _batch_params[p * num_docs + i];
+        }
+        dst[i] = _ranking_function(&_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -20,6 +20,22 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t output,
+                               vespalib::ArrayRef<feature_t> dst)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        lazy_execute(docids[i]);
+        dst[i] = _outputs.get_number(output);
+    }
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
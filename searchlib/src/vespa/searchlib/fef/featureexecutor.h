@@ -6,6 +6,7 @@
 #include "matchdata.h"
 #include "number_or_object.h"
 #include <vespa/vespalib/util/arrayref.h>
+#include <algorithm>
 
 namespace search::fef {
 
@@ -33,6 +34,7 @@ public:
     }
     inline double as_number(uint32_t docid) const;
     inline vespalib::eval::Value::CREF as_object(uint32_t docid) const;
+    inline void as_numbers(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> dst) const;
 };
 
 /**
@@ -54,6 +56,9 @@ public:
         void bind(vespalib::ConstArrayRef<LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        void get_numbers(size_t idx, vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> dst) const {
+            _inputs[idx].as_numbers(docids, dst);
+        }
         size_t size() const { return _inputs.size(); }
     };
 
@@ -150,6 +155,34 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor supports batch execution. A
+     * feature executor claiming to support batch execution must not
+     * depend on match data unpacked for the document being
+     * evaluated, and its number outputs must be possible to calculate
+     * for a block of documents at once by calling execute_batch. This
+     * is used to evaluate cheap rank programs (typically over
+     * attributes and query values) for multiple documents without
+     * unpacking match data and without calling execute for each
+     * document. This method returns false by default.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Calculate the number value of a single output for a block of
+     * documents. The outputs bound to this executor must not be
+     * modified. The default implementation executes this executor
+     * for one document at a time.
+     *
+     * @param docids the local document ids being evaluated
+     * @param output index of the output to calculate
+     * @param dst where to store the calculated values (one per docid)
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t output,
+                               vespalib::ArrayRef<feature_t> dst);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -183,6 +216,14 @@ vespalib::eval::Value::CREF LazyValue::as_object(uint32_t docid) const {
     return _value->as_object;
 }
 
+void LazyValue::as_numbers(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> dst) const {
+    if (_executor != nullptr) {
+        _executor->execute_batch(docids, (_value - _executor->outputs().get_raw(0)), dst);
+    } else {
+        std::fill(dst.begin(), dst.begin() + docids.size(), _value->as_number);
+    }
+}
+
 feature_t FeatureExecutor::Inputs::get_number(size_t idx) const {
     return _inputs[idx].as_number(_docid);
 }
@@ -259,6 +259,21 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string WorkStealingScheduler::NAME("vespa.matching.work_stealing_scheduler");
+const bool WorkStealingScheduler::DEFAULT_VALUE(false);
+
+bool
+WorkStealingScheduler::check(const Properties &props)
+{
+    return check(props, DEFAULT_VALUE);
+}
+
+bool
+WorkStealingScheduler::check(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -290,6 +305,22 @@ NearestNeighborBruteForceLimit::lookup(const Properties &props, double defaultVa
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string NearestNeighborExploreKMaxAdjustmentFactor::NAME("vespa.matching.nearest_neighbor.explore_k_max_adjustment_factor");
+
+const double NearestNeighborExploreKMaxAdjustmentFactor::DEFAULT_VALUE(20.0);
+
+double
+NearestNeighborExploreKMaxAdjustmentFactor::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+NearestNeighborExploreKMaxAdjustmentFactor::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const vespalib::string GlobalFilterLimit::NAME("vespa.matching.global_filter_limit");
 
 const double GlobalFilterLimit::DEFAULT_VALUE(0.0);
@@ -205,6 +205,20 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * When enabled, match threads share the docid space with a work
+     * stealing scheduler, where idle threads take over the unmatched
+     * part of the range of busy threads. This replaces the scheduler
+     * otherwise selected by the number of search partitions. The
+     * default value is false.
+     **/
+    struct WorkStealingScheduler {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props);
+        static bool check(const Properties &props, bool defaultValue);
+    };
+
     /**
      * Property to control fallback to brute force search for nearest
      * neighbor query terms.  If the ratio of candidates in the global
@@ -219,6 +233,20 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property to control how much the number of neighbors to explore
+     * is increased for nearest neighbor query terms searching the
+     * index with a global filter. The number of neighbors to explore
+     * is divided by the ratio of candidates in the global filter, but
+     * never increased by more than this factor.
+     **/
+    struct NearestNeighborExploreKMaxAdjustmentFactor {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -112,6 +112,25 @@ RankProgram::run_const(FeatureExecutor *executor)
     }
 }
 
+bool
+RankProgram::check_batch(BlueprintResolver::FeatureRef ref, std::vector<bool> &checked) const
+{
+    FeatureExecutor *executor = _executors[ref.executor];
+    if (check_const(executor->outputs().get_raw(ref.output)) || checked[ref.executor]) {
+        return true;
+    }
+    if (!executor->supports_batch()) {
+        return false;
+    }
+    checked[ref.executor] = true;
+    for (const auto &input: _resolver->getExecutorSpecs()[ref.executor].inputs) {
+        if (!check_batch(input, checked)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 RankProgram::unbox(BlueprintResolver::FeatureRef seed, const MatchData &md)
 {
@@ -245,6 +264,20 @@ RankProgram::get_seeds(bool unbox_seeds) const
     return resolve(_resolver->getSeedMap(), unbox_seeds);
 }
 
+bool
+RankProgram::can_batch_seeds() const
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    std::vector<bool> checked(_executors.size(), false);
+    for (const auto &seed_entry: _resolver->getSeedMap()) {
+        auto seed = seed_entry.second;
+        if (specs[seed.executor].output_types[seed.output].is_object() || !check_batch(seed, checked)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 FeatureResolver
 RankProgram::get_all_features(bool unbox_seeds) const
 {
@@ -44,6 +44,7 @@ private:
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
     void run_const(FeatureExecutor *executor);
+    bool check_batch(BlueprintResolver::FeatureRef ref, std::vector<bool> &checked) const;
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
 
@@ -80,6 +81,15 @@ public:
      **/
     FeatureResolver get_seeds(bool unbox_seeds = true) const;
 
+    /**
+     * Check if all seed features can be calculated for a block of
+     * documents at once (see LazyValue::as_numbers) without
+     * unpacking match data for each document. This is the case when
+     * all seeds are numbers and all non-const executors needed to
+     * calculate them support batch execution.
+     **/
+    bool can_batch_seeds() const;
+
     /**
      * Obtain the names and storage locations of all features for this
      * rank program. This method is intended for debugging and
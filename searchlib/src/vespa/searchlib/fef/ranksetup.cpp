@@ -40,6 +40,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _work_stealing_scheduler(false),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -63,6 +64,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutTailCost(0.1),
       _softTimeoutFactor(0.5),
       _nearest_neighbor_brute_force_limit(0.05),
+      _nearest_neighbor_explore_k_max_adjustment_factor(20.0),
       _global_filter_limit(0.0)
 { }
 
@@ -88,6 +90,7 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    set_work_stealing_scheduler(matching::WorkStealingScheduler::check(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -107,6 +110,7 @@ RankSetup::configure()
     setSoftTimeoutTailCost(softtimeout::TailCost::lookup(_indexEnv.getProperties()));
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_nearest_neighbor_brute_force_limit(matching::NearestNeighborBruteForceLimit::lookup(_indexEnv.getProperties()));
+    set_nearest_neighbor_explore_k_max_adjustment_factor(matching::NearestNeighborExploreKMaxAdjustmentFactor::lookup(_indexEnv.getProperties()));
     set_global_filter_limit(matching::GlobalFilterLimit::lookup(_indexEnv.getProperties()));
 }
 
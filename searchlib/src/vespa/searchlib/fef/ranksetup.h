@@ -37,6 +37,7 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    bool                     _work_stealing_scheduler;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -60,6 +61,7 @@ private:
     double                   _softTimeoutTailCost;
     double                   _softTimeoutFactor;
     double                   _nearest_neighbor_brute_force_limit;
+    double                   _nearest_neighbor_explore_k_max_adjustment_factor;
     double                   _global_filter_limit;
 
 
@@ -167,6 +169,10 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    /** whether match threads should use the work stealing docid range scheduler **/
+    void set_work_stealing_scheduler(bool value) { _work_stealing_scheduler = value; }
+    bool use_work_stealing_scheduler() const { return _work_stealing_scheduler; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -370,6 +376,9 @@ public:
     void set_nearest_neighbor_brute_force_limit(double v) { _nearest_neighbor_brute_force_limit = v; }
     double get_nearest_neighbor_brute_force_limit() const { return _nearest_neighbor_brute_force_limit; }
 
+    void set_nearest_neighbor_explore_k_max_adjustment_factor(double v) { _nearest_neighbor_explore_k_max_adjustment_factor = v; }
+    double get_nearest_neighbor_explore_k_max_adjustment_factor() const { return _nearest_neighbor_explore_k_max_adjustment_factor; }
+
     void set_global_filter_limit(double v) { _global_filter_limit = v; }
     double get_global_filter_limit() const { return _global_filter_limit; }
 
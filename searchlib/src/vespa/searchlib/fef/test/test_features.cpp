@@ -38,6 +38,12 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, size_t, vespalib::ArrayRef<feature_t> dst) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            dst[i] = docids[i];
+        }
+    }
 };
 
 bool
@@ -0,0 +1,192 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tdigest.h"
+#include <vespa/vespalib/objects/serializer.h>
+#include <vespa/vespalib/objects/deserializer.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace search {
+
+namespace {
+
+struct ByMean {
+    bool operator()(const TDigest::Centroid &a, const TDigest::Centroid &b) const { return a.mean < b.mean; }
+};
+
+/**
+ * The upper quantile limit of a centroid starting at quantile q, using
+ * the arcsine scale function k(q) = compression / (2 * pi) * asin(2q - 1).
+ * Each centroid may span at most one unit of k.
+ */
+double
+quantileLimit(double q, double compression)
+{
+    double k = compression / (2.0 * M_PI) * std::asin(2.0 * q - 1.0) + 1.0;
+    if (k >= compression / 4.0) {
+        return 1.0;
+    }
+    return (std::sin(k * 2.0 * M_PI / compression) + 1.0) / 2.0;
+}
+
+}
+
+TDigest::TDigest(double compression)
+    : _compression(compression),
+      _count(0.0),
+      _min(std::numeric_limits<double>::infinity()),
+      _max(-std::numeric_limits<double>::infinity()),
+      _centroids(),
+      _buffer()
+{ }
+
+TDigest::TDigest(const TDigest &) = default;
+TDigest & TDigest::operator=(const TDigest &) = default;
+TDigest::TDigest(TDigest &&) noexcept = default;
+TDigest & TDigest::operator=(TDigest &&) noexcept = default;
+TDigest::~TDigest() = default;
+
+void
+TDigest::add(double value, double weight)
+{
+    if (std::isnan(value) || (weight <= 0.0)) {
+        return;
+    }
+    _buffer.emplace_back(value, weight);
+    _count += weight;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    if (_buffer.size() >= 5 * _compression) {
+        flush();
+    }
+}
+
+void
+TDigest::merge(const TDigest &rhs)
+{
+    if (rhs.empty()) {
+        return;
+    }
+    for (const Centroid &c : rhs.getCentroids()) {
+        _buffer.push_back(c);
+    }
+    _count += rhs._count;
+    _min = std::min(_min, rhs._min);
+    _max = std::max(_max, rhs._max);
+    if (_buffer.size() >= 5 * _compression) {
+        flush();
+    }
+}
+
+void
+TDigest::flush() const
+{
+    if (_buffer.empty()) {
+        return;
+    }
+    std::vector<Centroid> all;
+    all.reserve(_centroids.size() + _buffer.size());
+    all.insert(all.end(), _centroids.begin(), _centroids.end());
+    all.insert(all.end(), _buffer.begin(), _buffer.end());
+    _buffer.clear();
+    std::sort(all.begin(), all.end(), ByMean());
+    double total = 0.0;
+    for (const Centroid &c : all) {
+        total += c.weight;
+    }
+    _centroids.clear();
+    Centroid current = all[0];
+    double weightSoFar = 0.0;
+    double limit = quantileLimit(0.0, _compression);
+    for (size_t i(1); i < all.size(); i++) {
+        const Centroid &next = all[i];
+        if ((weightSoFar + current.weight + next.weight) <= (limit * total)) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            limit = quantileLimit(weightSoFar / total, _compression);
+            current = next;
+        }
+    }
+    _centroids.push_back(current);
+}
+
+const std::vector<TDigest::Centroid> &
+TDigest::getCentroids() const
+{
+    flush();
+    return _centroids;
+}
+
+double
+TDigest::quantile(double q) const
+{
+    const std::vector<Centroid> &c = getCentroids();
+    if (c.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (c.size() == 1) {
+        return c[0].mean;
+    }
+    q = std::max(0.0, std::min(1.0, q));
+    double index = q * _count;
+    // Interpolate between the minimum and the center of the first centroid
+    if (index < c[0].weight / 2.0) {
+        return _min + (c[0].mean - _min) * index / (c[0].weight / 2.0);
+    }
+    double weightSoFar = c[0].weight / 2.0;
+    for (size_t i(0); (i + 1) < c.size(); i++) {
+        double delta = (c[i].weight + c[i + 1].weight) / 2.0;
+        if ((weightSoFar + delta) > index) {
+            return c[i].mean + (c[i + 1].mean - c[i].mean) * (index - weightSoFar) / delta;
+        }
+        weightSoFar += delta;
+    }
+    // Interpolate between the center of the last centroid and the maximum
+    const Centroid &last = c.back();
+    double z = std::min(index - weightSoFar, last.weight / 2.0);
+    return last.mean + (_max - last.mean) * z / (last.weight / 2.0);
+}
+
+void
+TDigest::serialize(vespalib::Serializer &os) const
+{
+    const std::vector<Centroid> &c = getCentroids();
+    os << _compression << _min << _max << static_cast<uint32_t>(c.size());
+    for (const Centroid &centroid : c) {
+        os << centroid.mean << centroid.weight;
+    }
+}
+
+void
+TDigest::deserialize(vespalib::Deserializer &is)
+{
+    uint32_t numCentroids(0);
+    is >> _compression >> _min >> _max >> numCentroids;
+    _buffer.clear();
+    _centroids.clear();
+    _centroids.reserve(numCentroids);
+    _count = 0.0;
+    for (uint32_t i(0); i < numCentroids; i++) {
+        double mean(0.0);
+        double weight(0.0);
+        is >> mean >> weight;
+        _centroids.emplace_back(mean, weight);
+        _count += weight;
+    }
+}
+
+bool
+TDigest::operator==(const TDigest &rhs) const
+{
+    return (_compression == rhs._compression) &&
+           (_count == rhs._count) &&
+           (_min == rhs._min) &&
+           (_max == rhs._max) &&
+           (getCentroids() == rhs.getCentroids());
+}
+
+}  // namespace search
@@ -0,0 +1,72 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace vespalib {
+    class Serializer;
+    class Deserializer;
+}
+
+namespace search {
+
+/**
+ * Mergeable sketch of a value distribution used to estimate quantiles
+ * (the merging variant of the t-digest). Values are clustered into
+ * centroids that are small near the tails of the distribution and
+ * larger near the median, so extreme quantiles stay accurate while the
+ * number of centroids is bounded by about the compression factor.
+ *
+ * Added values are buffered and folded into the centroids when the
+ * buffer is full, or when the centroids are needed.
+ */
+class TDigest {
+public:
+    struct Centroid {
+        double mean;
+        double weight;
+        Centroid(double mean_in, double weight_in) : mean(mean_in), weight(weight_in) {}
+        bool operator==(const Centroid &rhs) const { return (mean == rhs.mean) && (weight == rhs.weight); }
+    };
+    static constexpr double DEFAULT_COMPRESSION = 100.0;
+
+    explicit TDigest(double compression = DEFAULT_COMPRESSION);
+    TDigest(const TDigest &);
+    TDigest & operator=(const TDigest &);
+    TDigest(TDigest &&) noexcept;
+    TDigest & operator=(TDigest &&) noexcept;
+    ~TDigest();
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest &rhs);
+
+    /**
+     * Estimates the value at quantile q (0 <= q <= 1). Returns NaN if
+     * no values have been added.
+     */
+    double quantile(double q) const;
+
+    double getCompression() const { return _compression; }
+    double getCount() const { return _count; }
+    double getMin() const { return _min; }
+    double getMax() const { return _max; }
+    bool empty() const { return _count == 0.0; }
+    const std::vector<Centroid> &getCentroids() const;
+
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+    bool operator==(const TDigest &rhs) const;
+private:
+    void flush() const;
+
+    double                        _compression;
+    double                        _count;
+    double                        _min;
+    double                        _max;
+    mutable std::vector<Centroid> _centroids; // ordered by mean
+    mutable std::vector<Centroid> _buffer;
+};
+
+}  // namespace search
@@ -15,6 +15,7 @@ DocIdAndFeatures::DocIdAndFeatures()
       _blob(),
       _bit_offset(0u),
       _bit_length(0u),
+      _max_element_weight(1),
       _has_raw_data(false)
 {
 }
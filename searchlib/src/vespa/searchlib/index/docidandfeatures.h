@@ -104,6 +104,7 @@ protected:
     RawData _blob; // Feature data for (word, docid) pair
     uint32_t _bit_offset; // Offset of feature start ([0..63])
     uint32_t _bit_length; // Length of features
+    int32_t _max_element_weight; // Max element weight, tracked when reading raw data
     bool _has_raw_data;
 
 public:
@@ -159,6 +160,8 @@ public:
     uint32_t bit_offset() const { return _bit_offset; }
     uint32_t bit_length() const { return _bit_length; }
     void set_bit_length(uint32_t val) { _bit_length = val; }
+    int32_t max_element_weight() const { return _max_element_weight; }
+    void set_max_element_weight(int32_t val) { _max_element_weight = val; }
     bool has_raw_data() const { return _has_raw_data; }
     void set_has_raw_data(bool val) { _has_raw_data = val; }
 };
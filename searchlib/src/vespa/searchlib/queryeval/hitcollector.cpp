@@ -186,10 +186,17 @@ HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
                          -std::numeric_limits<feature_t>::max());
 
     std::sort(hits.begin(), hits.end()); // sort on docId
-    for (auto &hit : hits) {
-        hit.second = scorer.score(hit.first);
-        finalScores.low = std::min(finalScores.low, hit.second);
-        finalScores.high = std::max(finalScores.high, hit.second);
+    std::vector<uint32_t> docIds;
+    std::vector<feature_t> scores(hits.size());
+    docIds.reserve(hits.size());
+    for (const auto &hit : hits) {
+        docIds.push_back(hit.first);
+    }
+    scorer.score_batch(docIds, scores);
+    for (size_t i = 0; i < hits.size(); ++i) {
+        hits[i].second = scores[i];
+        finalScores.low = std::min(finalScores.low, scores[i]);
+        finalScores.high = std::max(finalScores.high, scores[i]);
     }
     _reRankedHits = std::move(hits);
     _hasReRanked = true;
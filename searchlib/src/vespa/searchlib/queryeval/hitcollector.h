@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <vector>
 #include <vespa/vespalib/util/sort.h>
+#include <vespa/vespalib/util/arrayref.h>
 #include <vespa/fastos/dynamiclibrary.h>
 #include "sorted_hit_sequence.h"
 
@@ -26,6 +27,16 @@ public:
     struct DocumentScorer {
         virtual ~DocumentScorer() {}
         virtual feature_t score(uint32_t docId) = 0;
+        /**
+         * Calculate the score for multiple documents given in
+         * increasing doc id order. Override to score documents in
+         * batch; the default calls score() for each document.
+         */
+        virtual void score_batch(vespalib::ConstArrayRef<uint32_t> docIds, vespalib::ArrayRef<feature_t> scores) {
+            for (size_t i = 0; i < docIds.size(); ++i) {
+                scores[i] = score(docIds[i]);
+            }
+        }
     };
 
 private:
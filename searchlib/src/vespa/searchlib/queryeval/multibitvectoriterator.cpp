@@ -20,16 +20,20 @@ template<typename Update>
 class MultiBitVectorIterator : public MultiBitVectorIteratorBase
 {
 public:
-    explicit MultiBitVectorIterator(Children children)
+    MultiBitVectorIterator(Children children, uint32_t maxBlocksInBatch)
         : MultiBitVectorIteratorBase(std::move(children)),
           _update(),
           _accel(IAccelrated::getAccelerator()),
+          _maxBlocksInBatch(maxBlocksInBatch),
           _lastWords()
     {
-        static_assert(sizeof(_lastWords) == 64, "Lastwords should have 64 byte size");
-        static_assert(NumWordsInBatch == 8, "Batch size should be 8 words.");
+        static_assert(sizeof(_lastWords) == 4*64, "Lastwords should have 4 cache lines");
+        static_assert(NumWordsInBlock == 8, "Block size should be 8 words.");
         memset(_lastWords, 0, sizeof(_lastWords));
     }
+    explicit MultiBitVectorIterator(Children children)
+        : MultiBitVectorIterator(std::move(children), 1)
+    { }
 protected:
     void updateLastValue(uint32_t docId);
     void strictSeek(uint32_t docId);
@@ -37,18 +41,30 @@ private:
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::False; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
+    BitVector::UP get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    template <bool mergeWithAnd>
+    void mergeHitsInto(BitVector &result, uint32_t begin_id);
+    uint32_t numBlocksToFetch(uint32_t block, uint32_t maxBlocks) const {
+        uint32_t lastBlock = wordNum(_numDocs - 1) / NumWordsInBlock;
+        return std::min(maxBlocks, lastBlock + 1 - block);
+    }
+    static constexpr uint32_t NumWordsInBlock = 64 / sizeof(Word);
+    static constexpr uint32_t MaxBlocksInBatch = 4;
     Update              _update;
     const IAccelrated & _accel;
-    alignas(64) Word    _lastWords[8];
-    static constexpr size_t NumWordsInBatch = sizeof(_lastWords) / sizeof(Word);
+    uint32_t            _maxBlocksInBatch;
+    alignas(64) Word    _lastWords[NumWordsInBlock * MaxBlocksInBatch];
 };
 
 template<typename Update>
 class MultiBitVectorIteratorStrict : public MultiBitVectorIterator<Update>
 {
 public:
+    // Strict iteration visits all blocks, fetch several at a time
     explicit MultiBitVectorIteratorStrict(MultiSearch::Children  children)
-        : MultiBitVectorIterator<Update>(std::move(children))
+        : MultiBitVectorIterator<Update>(std::move(children), 4)
     { }
 private:
     void doSeek(uint32_t docId) override { this->strictSeek(docId); }
@@ -57,16 +73,16 @@ private:
 
 struct And {
     using Word = BitWord::Word;
-    void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
-        accel.and64(offset, src, dest);
+    void operator () (const IAccelrated & accel, size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
+        accel.and64Batch(offset, numBlocks, src, dest);
     }
     static bool isAnd() { return true; }
 };
 
 struct Or {
     using Word = BitWord::Word;
-    void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
-        accel.or64(offset, src, dest);
+    void operator () (const IAccelrated & accel, size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
+        accel.or64Batch(offset, numBlocks, src, dest);
     }
     static bool isAnd() { return false; }
 };
@@ -81,11 +97,13 @@ void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
         }
         const uint32_t index(wordNum(docId));
         if (docId >= _lastMaxDocIdLimitRequireFetch) {
-            uint32_t baseIndex = index & ~(NumWordsInBatch - 1);
-            _update(_accel, baseIndex*sizeof(Word), _bvs, _lastWords);
-            _lastMaxDocIdLimitRequireFetch = (baseIndex + NumWordsInBatch) * WordLen;
+            uint32_t baseIndex = index & ~(NumWordsInBlock - 1);
+            uint32_t numBlocks = numBlocksToFetch(baseIndex / NumWordsInBlock, _maxBlocksInBatch);
+            _update(_accel, baseIndex*sizeof(Word), numBlocks, _bvs, _lastWords);
+            _lastMaxDocIdLimitBatchStart = baseIndex * WordLen;
+            _lastMaxDocIdLimitRequireFetch = (baseIndex + numBlocks * NumWordsInBlock) * WordLen;
         }
-        _lastValue = _lastWords[index % NumWordsInBatch];
+        _lastValue = _lastWords[index - wordNum(_lastMaxDocIdLimitBatchStart)];
         _lastMaxDocIdLimit = (index + 1) * WordLen;
     }
 }
@@ -119,6 +137,73 @@ MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
     }
 }
 
+template<typename Update>
+template<bool mergeWithAnd>
+void
+MultiBitVectorIterator<Update>::mergeHitsInto(BitVector &result, uint32_t begin_id)
+{
+    begin_id = std::max(begin_id, result.getStartIndex());
+    uint32_t end_id = std::min(result.size(), _numDocs);
+    if (mergeWithAnd && (end_id < result.size())) {
+        result.clearInterval(std::max(begin_id, end_id), result.size());
+    }
+    if (begin_id < end_id) {
+        Word * words = static_cast<Word *>(result.getStart());
+        const uint32_t firstWord = wordNum(begin_id);
+        const uint32_t lastWord = wordNum(end_id - 1);
+        const Word firstMask = checkTab(begin_id);
+        const Word lastMask = ~endBits(end_id - 1);
+        alignas(64) Word tmp[NumWordsInBlock * MaxBlocksInBatch];
+        for (uint32_t block = firstWord / NumWordsInBlock; block * NumWordsInBlock <= lastWord; ) {
+            const uint32_t numBlocks = numBlocksToFetch(block, MaxBlocksInBatch);
+            const uint32_t baseWord = block * NumWordsInBlock;
+            _update(_accel, baseWord * sizeof(Word), numBlocks, _bvs, tmp);
+            const uint32_t wordEnd = std::min(baseWord + numBlocks * NumWordsInBlock, lastWord + 1);
+            for (uint32_t i = std::max(baseWord, firstWord); i < wordEnd; ++i) {
+                Word inside = std::numeric_limits<Word>::max();
+                if (i == firstWord) {
+                    inside &= firstMask;
+                }
+                if (i == lastWord) {
+                    inside &= lastMask;
+                }
+                if (mergeWithAnd) {
+                    words[i] &= (tmp[i - baseWord] | ~inside);
+                } else {
+                    words[i] |= (tmp[i - baseWord] & inside);
+                }
+            }
+            block += numBlocks;
+        }
+    }
+    result.invalidateCachedCount();
+}
+
+template<typename Update>
+BitVector::UP
+MultiBitVectorIterator<Update>::get_hits(uint32_t begin_id)
+{
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    mergeHitsInto<false>(*result, begin_id);
+    if (begin_id < getDocId()) {
+        result->clearInterval(begin_id, std::min(getDocId(), getEndId()));
+    }
+    return result;
+}
+
+template<typename Update>
+void
+MultiBitVectorIterator<Update>::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    mergeHitsInto<false>(result, begin_id);
+}
+
+template<typename Update>
+void
+MultiBitVectorIterator<Update>::and_hits_into(BitVector &result, uint32_t begin_id)
+{
+    mergeHitsInto<true>(result, begin_id);
+}
 
 typedef MultiBitVectorIterator<And> AndBVIterator;
 typedef MultiBitVectorIteratorStrict<And> AndBVIteratorStrict;
@@ -154,6 +239,7 @@ MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(Children children) :
     _numDocs(std::numeric_limits<unsigned int>::max()),
     _lastMaxDocIdLimit(0),
     _lastMaxDocIdLimitRequireFetch(0),
+    _lastMaxDocIdLimitBatchStart(0),
     _lastValue(0),
     _bvs()
 {
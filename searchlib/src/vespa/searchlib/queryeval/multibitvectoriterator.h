@@ -26,6 +26,7 @@ protected:
     uint32_t                _numDocs;
     uint32_t                _lastMaxDocIdLimit; // next documentid requiring recomputation.
     uint32_t                _lastMaxDocIdLimitRequireFetch;
+    uint32_t                _lastMaxDocIdLimitBatchStart; // first documentid covered by fetched words.
     Word                    _lastValue; // Last value computed
     std::vector<MetaWord>   _bvs;
 private:
@@ -9,6 +9,7 @@
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <ostream>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.queryeval.nearest_neighbor_blueprint");
@@ -48,12 +49,26 @@ struct ConvertCellsSelector
     static auto invoke() { return convert_cells<LCT, RCT>; }
 };
 
+const char *
+to_string(NearestNeighborBlueprint::Algorithm algorithm)
+{
+    using Algorithm = NearestNeighborBlueprint::Algorithm;
+    switch (algorithm) {
+    case Algorithm::EXACT: return "exact";
+    case Algorithm::EXACT_FALLBACK: return "exact_fallback";
+    case Algorithm::INDEX_TOP_K: return "index_top_k";
+    case Algorithm::INDEX_TOP_K_WITH_FILTER: return "index_top_k_with_filter";
+    }
+    return "unknown";
+}
+
 } // namespace <unnamed>
 
 NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                                                    const tensor::DenseTensorAttribute& attr_tensor,
                                                    std::unique_ptr<vespalib::tensor::DenseTensorView> query_tensor,
-                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit)
+                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                                                   double brute_force_limit, double explore_k_max_adjustment_factor)
     : ComplexLeafBlueprint(field),
       _attr_tensor(attr_tensor),
       _query_tensor(std::move(query_tensor)),
@@ -61,9 +76,13 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _approximate(approximate),
       _explore_additional_hits(explore_additional_hits),
       _brute_force_limit(brute_force_limit),
+      _explore_k_max_adjustment_factor(explore_k_max_adjustment_factor),
+      _explore_k(target_num_hits + explore_additional_hits),
+      _algorithm(Algorithm::EXACT),
       _fallback_dist_fun(),
       _distance_heap(target_num_hits),
       _found_hits(),
+      _page_faults(),
       _global_filter(GlobalFilter::create())
 {
     auto lct = _query_tensor->cellsRef().type;
@@ -95,24 +114,63 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter)
         (_global_filter->has_filter() ? "has_filter" : "no_filter"));
     if (_approximate && nns_index) {
         uint32_t est_hits = _attr_tensor.getNumDocs();
+        uint32_t max_hits = est_hits;
+        _algorithm = Algorithm::INDEX_TOP_K;
         if (_global_filter->has_filter()) {
-            uint32_t max_hits = _global_filter->filter()->countTrueBits();
+            max_hits = _global_filter->filter()->countTrueBits();
             LOG(debug, "set_global_filter getNumDocs: %u / max_hits %u", est_hits, max_hits);
-            double max_hit_ratio = static_cast<double>(max_hits) / est_hits;
-            if (max_hit_ratio < _brute_force_limit) {
-                _approximate = false;
-                LOG(debug, "too many hits filtered out, using brute force implementation");
-            } else {
-                est_hits = std::min(est_hits, max_hits);
+            select_algorithm_with_filter(est_hits, max_hits);
+        }
+        if (_algorithm == Algorithm::INDEX_TOP_K || _algorithm == Algorithm::INDEX_TOP_K_WITH_FILTER) {
+            perform_top_k();
+            LOG(debug, "perform_top_k found %zu hits", _found_hits.size());
+            if ((_algorithm == Algorithm::INDEX_TOP_K_WITH_FILTER) && (_found_hits.size() < std::min(_target_num_hits, max_hits))) {
+                // The graph search did not find enough hits passing the filter, so all candidates are scored instead.
+                LOG(debug, "too few hits found by index search, using brute force implementation");
+                _found_hits.clear();
+                use_exact_fallback();
             }
         }
+        est_hits = std::min(est_hits, max_hits);
         if (_approximate) {
             est_hits = std::min(est_hits, _target_num_hits);
-            setEstimate(HitEstimate(est_hits, false));
-            perform_top_k();
-            LOG(debug, "perform_top_k found %zu hits", _found_hits.size());
         }
+        setEstimate(HitEstimate(est_hits, false));
+        LOG(debug, "set_global_filter selected algorithm %s with estimate %u", to_string(_algorithm), est_hits);
+    }
+}
+
+void
+NearestNeighborBlueprint::use_exact_fallback()
+{
+    _approximate = false;
+    _algorithm = Algorithm::EXACT_FALLBACK;
+}
+
+void
+NearestNeighborBlueprint::select_algorithm_with_filter(uint32_t num_docs, uint32_t max_hits)
+{
+    double max_hit_ratio = (num_docs > 0) ? (static_cast<double>(max_hits) / num_docs) : 0.0;
+    if (max_hit_ratio < _brute_force_limit) {
+        use_exact_fallback();
+        LOG(debug, "too many hits filtered out, using brute force implementation");
+        return;
+    }
+    // Searching the graph visits roughly explore_k / max_hit_ratio documents to collect explore_k hits
+    // passing the filter. If fewer documents pass the filter, calculating the distance to each of them is cheaper.
+    // This uses explore_k as given by the query, as the adjustment below is the same compensation for the filter.
+    double inverse_hit_ratio = static_cast<double>(num_docs) / max_hits;
+    double estimated_visited = _explore_k * inverse_hit_ratio;
+    if (max_hits <= estimated_visited) {
+        use_exact_fallback();
+        LOG(debug, "max_hits %u <= estimated visited %.0f by index search, using brute force implementation",
+            max_hits, estimated_visited);
+        return;
     }
+    // The fewer documents passing the filter, the more of the graph must be explored to find enough hits.
+    double adjustment = std::max(1.0, std::min(inverse_hit_ratio, _explore_k_max_adjustment_factor));
+    _explore_k = static_cast<uint32_t>(_explore_k * adjustment);
+    _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
 }
 
 void
@@ -126,11 +184,16 @@ NearestNeighborBlueprint::perform_top_k()
         if (lhs_type == rhs_type) {
             auto lhs = _query_tensor->cellsRef();
             uint32_t k = _target_num_hits;
+            bool track_page_faults = _attr_tensor.getConfig().paged();
+            auto before = track_page_faults ? search::tensor::PageFaults::sample_thread() : search::tensor::PageFaults();
             if (_global_filter->has_filter()) {
                 auto filter = _global_filter->filter();
-                _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, k + _explore_additional_hits);
+                _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, _explore_k);
             } else {
-                _found_hits = nns_index->find_top_k(k, lhs, k + _explore_additional_hits);
+                _found_hits = nns_index->find_top_k(k, lhs, _explore_k);
+            }
+            if (track_page_faults) {
+                _page_faults = search::tensor::PageFaults::sample_thread() - before;
             }
         }
     }
@@ -158,6 +221,10 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitInt("target_num_hits", _target_num_hits);
     visitor.visitBool("approximate", _approximate);
     visitor.visitInt("explore_additional_hits", _explore_additional_hits);
+    visitor.visitString("algorithm", to_string(_algorithm));
+    visitor.visitInt("explore_k", _explore_k);
+    visitor.visitInt("major_page_faults", _page_faults.major);
+    visitor.visitInt("minor_page_faults", _page_faults.minor);
 }
 
 bool
@@ -166,4 +233,11 @@ NearestNeighborBlueprint::always_needs_unpack() const
     return true;
 }
 
+std::ostream&
+operator<<(std::ostream& out, NearestNeighborBlueprint::Algorithm algorithm)
+{
+    out << to_string(algorithm);
+    return out;
+}
+
 }
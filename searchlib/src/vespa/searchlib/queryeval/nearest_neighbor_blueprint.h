@@ -5,6 +5,8 @@
 #include "nearest_neighbor_distance_heap.h"
 #include <vespa/searchlib/tensor/distance_function.h>
 #include <vespa/searchlib/tensor/nearest_neighbor_index.h>
+#include <vespa/searchlib/tensor/page_faults.h>
+#include <iosfwd>
 
 namespace vespalib::tensor { class DenseTensorView; }
 namespace search::tensor { class DenseTensorAttribute; }
@@ -16,8 +18,20 @@ namespace search::queryeval {
  *
  * The search iterator matches the K nearest neighbors in a multi-dimensional vector space,
  * where the query point and document points are dense tensors of order 1.
+ *
+ * When a global filter is set, the algorithm used is selected based on the ratio of documents
+ * passing the filter. The selected algorithm is exposed via visitMembers() (and thereby the query trace).
+ * So are the page faults taken by the index search of this query when the attribute is paged out to disk,
+ * which show the cost of paging. They are not sampled for attributes kept in memory.
  */
 class NearestNeighborBlueprint : public ComplexLeafBlueprint {
+public:
+    enum class Algorithm {
+        EXACT,
+        EXACT_FALLBACK,
+        INDEX_TOP_K,
+        INDEX_TOP_K_WITH_FILTER
+    };
 private:
     const tensor::DenseTensorAttribute& _attr_tensor;
     std::unique_ptr<vespalib::tensor::DenseTensorView> _query_tensor;
@@ -25,18 +39,25 @@ private:
     bool _approximate;
     uint32_t _explore_additional_hits;
     double _brute_force_limit;
+    double _explore_k_max_adjustment_factor;
+    uint32_t _explore_k;
+    Algorithm _algorithm;
     search::tensor::DistanceFunction::UP _fallback_dist_fun;
     const search::tensor::DistanceFunction *_dist_fun;
     mutable NearestNeighborDistanceHeap _distance_heap;
     std::vector<search::tensor::NearestNeighborIndex::Neighbor> _found_hits;
+    search::tensor::PageFaults _page_faults;
     std::shared_ptr<const GlobalFilter> _global_filter;
 
+    void use_exact_fallback();
+    void select_algorithm_with_filter(uint32_t num_docs, uint32_t max_hits);
     void perform_top_k();
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              const tensor::DenseTensorAttribute& attr_tensor,
                              std::unique_ptr<vespalib::tensor::DenseTensorView> query_tensor,
-                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit);
+                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                             double brute_force_limit, double explore_k_max_adjustment_factor);
     NearestNeighborBlueprint(const NearestNeighborBlueprint&) = delete;
     NearestNeighborBlueprint& operator=(const NearestNeighborBlueprint&) = delete;
     ~NearestNeighborBlueprint();
@@ -45,6 +66,9 @@ public:
     uint32_t get_target_num_hits() const { return _target_num_hits; }
     void set_global_filter(const GlobalFilter &global_filter) override;
     bool may_approximate() const { return _approximate; }
+    Algorithm get_algorithm() const { return _algorithm; }
+    uint32_t get_explore_k() const { return _explore_k; }
+    const search::tensor::PageFaults& get_page_faults() const { return _page_faults; }
 
     std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
                                                      bool strict) const override;
@@ -52,4 +76,6 @@ public:
     bool always_needs_unpack() const override;
 };
 
+std::ostream& operator<<(std::ostream& out, NearestNeighborBlueprint::Algorithm algorithm);
+
 }
@@ -38,4 +38,26 @@ public:
     int32_t getMaxWeight() const { return _maxWeight; }
 };
 
+
+/**
+ * Class for getting an upper bound for the weights in the part (block) of a
+ * posting list containing a given document.
+ *
+ * Such posting lists store the max weight for each block of documents together
+ * with the skip information. This can be used to skip entire blocks of
+ * documents that cannot get a high enough score.
+ */
+class BlockMaxPostingInfo : public PostingInfo {
+public:
+    /**
+     * Get the max weight for the block containing the given document,
+     * which should not be below the current position of the search iterator.
+     * Returns the last document id in the block, the max weight is applicable
+     * for all documents up to and including this document.
+     * Calling this function does not change the position of the search
+     * iterator.
+     */
+    virtual uint32_t get_block_max_weight(uint32_t docId, int32_t &maxWeight) const = 0;
+};
+
 }
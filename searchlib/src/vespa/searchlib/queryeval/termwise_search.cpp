@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "termwise_search.h"
+#include "multibitvectoriterator.h"
 #include <vespa/vespalib/objects/visit.h>
 #include <vespa/searchlib/common/bitvector.h>
 
@@ -56,6 +57,8 @@ struct TermwiseSearch : public SearchIterator {
 SearchIterator::UP
 make_termwise(SearchIterator::UP search, bool strict)
 {
+    // let bitvector children be combined block-wise when fetching hits
+    search = MultiBitVectorIteratorBase::optimize(std::move(search));
     if (strict) {
         return SearchIterator::UP(new TermwiseSearch<true>(std::move(search)));
     } else {
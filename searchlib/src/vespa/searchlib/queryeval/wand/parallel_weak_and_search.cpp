@@ -41,14 +41,24 @@ private:
         }
     }
 
+    bool check_block_max(docid_t &next_candidate) {
+        if (!_terms.has_block_max()) {
+            return true;
+        }
+        return _algo.check_block_max(_terms, _heaps, GreaterThan(_boostedThreshold), next_candidate);
+    }
+
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            docid_t next_candidate = _algo.get_candidate() + 1;
+            if (check_block_max(next_candidate) &&
+                _algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold)))
+            {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
-                _algo.set_candidate(_terms, _heaps, _algo.get_candidate() + 1);
+                _algo.set_candidate(_terms, _heaps, next_candidate);
             }
         }
         setAtEnd();
@@ -57,7 +67,10 @@ private:
     void seek_unstrict(uint32_t docid) {
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
-            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            docid_t next_candidate = 0;
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold)) &&
+                check_block_max(next_candidate))
+            {
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
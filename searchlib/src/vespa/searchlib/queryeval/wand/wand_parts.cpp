@@ -10,6 +10,23 @@ VectorizedIteratorTerms::visit_members(vespalib::ObjectVisitor &visitor) const {
     visit(visitor, "children", _terms);
 }
 
+void
+VectorizedIteratorTerms::init_block_max() {
+    _hasBlockMax = false;
+    _blockMax.clear();
+    for (size_t i = 0; i < _terms.size(); ++i) {
+        const BlockMaxPostingInfo *info = nullptr;
+        if (weight(i) > 0) {
+            info = dynamic_cast<const BlockMaxPostingInfo *>(_terms[i].search->getPostingInfo());
+        }
+        _blockMax.push_back(info);
+        _hasBlockMax = _hasBlockMax || (info != nullptr);
+    }
+    _blockBegin.assign(_terms.size(), search::endDocId);
+    _blockEnd.assign(_terms.size(), 0);
+    _blockScore.assign(_terms.size(), 0);
+}
+
 VectorizedIteratorTerms::VectorizedIteratorTerms(VectorizedIteratorTerms &&) noexcept = default;
 VectorizedIteratorTerms & VectorizedIteratorTerms::operator=(VectorizedIteratorTerms &&) noexcept = default;
 VectorizedIteratorTerms::~VectorizedIteratorTerms() = default;
@@ -236,6 +236,13 @@ class VectorizedIteratorTerms : public VectorizedState<SearchIteratorPack>
 {
 private:
     Terms _terms; // TODO: want to get rid of this
+    std::vector<const BlockMaxPostingInfo *> _blockMax;
+    std::vector<docid_t>                     _blockBegin; // first docid known to be covered by cached block bound
+    std::vector<docid_t>                     _blockEnd;   // last docid covered by cached block bound
+    std::vector<score_t>                     _blockScore;
+    bool                                     _hasBlockMax;
+
+    void init_block_max();
 
 public:
     template <typename Scorer>
@@ -248,18 +255,48 @@ public:
     void unpack(uint16_t ref, uint32_t docid) { iteratorPack().unpack(ref, docid); }
     void visit_members(vespalib::ObjectVisitor &visitor) const;
     const Terms &input_terms() const { return _terms; }
+
+    bool has_block_max() const { return _hasBlockMax; }
+
+    /**
+     * Returns an upper bound for the score contribution of the given
+     * term for all documents in the range [docid, block_end]. Terms
+     * without block max information are bounded by their max score
+     * for the entire document id space.
+     **/
+    score_t block_max_score(ref_t ref, docid_t docid, docid_t &block_end) {
+        const BlockMaxPostingInfo *info = _blockMax[ref];
+        if (info == nullptr) {
+            block_end = search::endDocId;
+            return maxScore(ref);
+        }
+        if (docid < _blockBegin[ref] || docid > _blockEnd[ref]) {
+            int32_t maxWeight = 0;
+            _blockBegin[ref] = docid;
+            _blockEnd[ref] = info->get_block_max_weight(docid, maxWeight);
+            _blockScore[ref] = std::min(maxScore(ref), weight(ref) * (score_t)maxWeight);
+        }
+        block_end = _blockEnd[ref];
+        return _blockScore[ref];
+    }
 };
 
 template <typename Scorer>
 VectorizedIteratorTerms::VectorizedIteratorTerms(const Terms &t, const Scorer &, uint32_t docIdLimit,
                                                  fef::MatchData::UP childrenMatchData)
-    : _terms()
+    : _terms(),
+      _blockMax(),
+      _blockBegin(),
+      _blockEnd(),
+      _blockScore(),
+      _hasBlockMax(false)
 {
     std::vector<ref_t> order = init_state<Scorer>(TermInput(t), docIdLimit);
     _terms = assemble([&t](ref_t ref){ return t[ref]; }, order);
     iteratorPack() = SearchIteratorPack(assemble([&t](ref_t ref){ return t[ref].search; }, order),
                                         assemble([&t](ref_t ref){ return t[ref].matchData; }, order),
                                         std::move(childrenMatchData));
+    init_block_max();
 }
 
 //-----------------------------------------------------------------------------
@@ -282,6 +319,11 @@ struct VectorizedAttributeTerms : VectorizedState<AttributeIteratorPack> {
         iteratorPack() = AttributeIteratorPack(std::move(iterators));
     }
     void visit_members(vespalib::ObjectVisitor &) const {}
+    bool has_block_max() const { return false; }
+    score_t block_max_score(ref_t ref, docid_t, docid_t &block_end) {
+        block_end = search::endDocId;
+        return maxScore(ref);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -338,6 +380,7 @@ public:
     }
     ref_t *present_begin() const { return _present; }
     ref_t *present_end() const { return _past; }
+    ref_t *past_end() const { return _trash; }
     vespalib::string stringify() const;
 };
 
@@ -618,6 +661,31 @@ public:
         return true;
     }
 
+    /**
+     * Check whether the block max scores of the terms that may match
+     * the current candidate can reach the threshold. If not, no
+     * document before 'next_candidate' can be a hit either.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename AboveThreshold>
+    bool check_block_max(VectorizedTerms &terms, Heaps &heaps, AboveThreshold &&aboveThreshold, docid_t &next_candidate) {
+        score_t max_score = 0;
+        docid_t block_end = search::endDocId;
+        ref_t *end = heaps.past_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            docid_t term_block_end;
+            max_score += terms.block_max_score(*ref, _candidate, term_block_end);
+            block_end = std::min(block_end, term_block_end);
+        }
+        if (aboveThreshold(max_score)) {
+            return true;
+        }
+        next_candidate = (block_end < search::endDocId) ? (block_end + 1) : search::endDocId;
+        if (heaps.has_future()) {
+            next_candidate = std::min(next_candidate, terms.docId(heaps.future()));
+        }
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
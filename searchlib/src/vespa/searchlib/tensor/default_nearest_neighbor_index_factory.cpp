@@ -5,6 +5,7 @@
 #include "random_level_generator.h"
 #include "inv_log_level_generator.h"
 #include "distance_function_factory.h"
+#include "vector_quantizer_factory.h"
 #include <vespa/searchcommon/attribute/config.h>
 
 namespace search::tensor {
@@ -29,9 +30,9 @@ std::unique_ptr<NearestNeighborIndex>
 DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          size_t vector_size,
                                          vespalib::eval::ValueType::CellType cell_type,
-                                         const search::attribute::HnswIndexParams& params) const
+                                         const search::attribute::HnswIndexParams& params,
+                                         std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const
 {
-    (void) vector_size;
     uint32_t m = params.max_links_per_node();
     HnswIndex::Config cfg(m * 2,
                           m,
@@ -41,7 +42,10 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
-                                       cfg);
+                                       cfg,
+                                       make_vector_quantizer(params.vector_quantization(), params.distance_metric(), vector_size,
+                                                             params.quantization_subspace_dims(), params.quantization_centroids()),
+                                       std::move(memory_allocator));
 }
 
 }
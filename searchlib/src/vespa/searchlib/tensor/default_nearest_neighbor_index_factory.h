@@ -14,7 +14,8 @@ public:
     std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                size_t vector_size,
                                                vespalib::eval::ValueType::CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override;
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override;
 };
 
 }
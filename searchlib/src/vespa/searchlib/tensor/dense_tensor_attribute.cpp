@@ -12,12 +12,19 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <condition_variable>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
 
 using search::attribute::LoadUtils;
 using vespalib::eval::ValueType;
+using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MmapFileAllocatorFactory;
 using vespalib::slime::ObjectInserter;
 using vespalib::tensor::DenseTensorView;
 using vespalib::tensor::MutableDenseTensorView;
@@ -30,6 +37,15 @@ namespace {
 constexpr uint32_t DENSE_TENSOR_ATTRIBUTE_VERSION = 1;
 const vespalib::string tensorTypeTag("tensortype");
 
+std::unique_ptr<MemoryAllocator>
+make_memory_allocator(const vespalib::string& name, bool paged)
+{
+    if (paged) {
+        return MmapFileAllocatorFactory::instance().make_memory_allocator(name);
+    }
+    return {};
+}
+
 class BlobSequenceReader : public ReaderBase
 {
 private:
@@ -61,6 +77,109 @@ BlobSequenceReader::is_present() {
     return true;
 }
 
+/**
+ * Builds the nearest neighbor index for loaded documents using an executor.
+ *
+ * The costly prepare step of adding a document (searching the graph for neighbors)
+ * is done by the executor threads, while the complete step (linking the new node into the graph)
+ * is done by the loading thread, which acts as the single writer of the index.
+ * Each prepare step holds a read guard, so data replaced by the writer is kept alive until no longer used.
+ * Neighbors that are no longer valid when a document is completed are filtered away by the index.
+ */
+class ThreadedIndexBuilder {
+private:
+    using PreparedDoc = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
+
+    // Bounds the number of read guards and prepare results alive at the same time.
+    static constexpr uint32_t max_pending = 1000;
+    // The number of completed documents between each generation change, allowing held memory to be freed.
+    static constexpr uint32_t completes_per_generation = 10000;
+
+    DenseTensorAttribute& _attr;
+    const vespalib::GenerationHandler& _generation_handler;
+    NearestNeighborIndex& _index;
+    vespalib::Executor& _executor;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<PreparedDoc> _prepared;
+    uint32_t _pending;
+    uint32_t _completes_since_generation_change;
+
+    void complete(std::vector<PreparedDoc>& prepared);
+    void drain_until_pending(uint32_t wanted_pending);
+
+public:
+    ThreadedIndexBuilder(DenseTensorAttribute& attr, const vespalib::GenerationHandler& generation_handler,
+                         NearestNeighborIndex& index, vespalib::Executor& executor);
+    ~ThreadedIndexBuilder();
+    void add(uint32_t lid);
+    void wait_complete() { drain_until_pending(0); }
+};
+
+ThreadedIndexBuilder::ThreadedIndexBuilder(DenseTensorAttribute& attr, const vespalib::GenerationHandler& generation_handler,
+                                           NearestNeighborIndex& index, vespalib::Executor& executor)
+    : _attr(attr),
+      _generation_handler(generation_handler),
+      _index(index),
+      _executor(executor),
+      _mutex(),
+      _cond(),
+      _prepared(),
+      _pending(0),
+      _completes_since_generation_change(0)
+{
+}
+
+ThreadedIndexBuilder::~ThreadedIndexBuilder()
+{
+    assert(_pending == 0);
+}
+
+void
+ThreadedIndexBuilder::add(uint32_t lid)
+{
+    auto task = vespalib::makeLambdaTask([this, lid, guard = _generation_handler.takeGuard()]() mutable {
+        auto prepared = _index.prepare_add_document(lid, _attr.get_vector(lid), std::move(guard));
+        std::lock_guard<std::mutex> lock(_mutex);
+        _prepared.emplace_back(lid, std::move(prepared));
+        _cond.notify_one();
+    });
+    ++_pending;
+    auto rejected = _executor.execute(std::move(task));
+    if (rejected) {
+        rejected->run();
+    }
+    drain_until_pending(max_pending);
+}
+
+void
+ThreadedIndexBuilder::complete(std::vector<PreparedDoc>& prepared)
+{
+    for (auto& entry : prepared) {
+        _index.complete_add_document(entry.first, std::move(entry.second));
+        --_pending;
+        if (++_completes_since_generation_change >= completes_per_generation) {
+            _attr.incGeneration();
+            _completes_since_generation_change = 0;
+        }
+    }
+    prepared.clear();
+}
+
+void
+ThreadedIndexBuilder::drain_until_pending(uint32_t wanted_pending)
+{
+    std::vector<PreparedDoc> prepared;
+    while (_pending > wanted_pending) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this]() { return !_prepared.empty(); });
+            prepared.swap(_prepared);
+        }
+        complete(prepared);
+    }
+}
+
 bool
 can_use_index_save_file(const search::attribute::Config &config, const search::attribute::AttributeHeader &header)
 {
@@ -108,7 +227,7 @@ DenseTensorAttribute::memory_usage() const
 DenseTensorAttribute::DenseTensorAttribute(vespalib::stringref baseFileName, const Config& cfg,
                                            const NearestNeighborIndexFactory& index_factory)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType()),
+      _denseTensorStore(cfg.tensorType(), make_memory_allocator(getName() + ".tensor", cfg.paged())),
       _index()
 {
     if (cfg.hnsw_index_params().has_value()) {
@@ -116,7 +235,8 @@ DenseTensorAttribute::DenseTensorAttribute(vespalib::stringref baseFileName, con
         assert(tensor_type.dimensions().size() == 1);
         assert(tensor_type.is_dense());
         size_t vector_size = tensor_type.dimensions()[0].size;
-        _index = index_factory.make(*this, vector_size, tensor_type.cell_type(), cfg.hnsw_index_params().value());
+        _index = index_factory.make(*this, vector_size, tensor_type.cell_type(), cfg.hnsw_index_params().value(),
+                                    make_memory_allocator(getName() + ".hnsw", cfg.paged()));
     }
 }
 
@@ -188,7 +308,7 @@ DenseTensorAttribute::extract_dense_view(DocId docId, MutableDenseTensorView &te
 }
 
 bool
-DenseTensorAttribute::onLoad()
+DenseTensorAttribute::onLoad(vespalib::Executor *executor)
 {
     BlobSequenceReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -202,6 +322,7 @@ DenseTensorAttribute::onLoad()
     assert(getConfig().tensorType().to_spec() ==
            tensorReader.getDatHeader().getTag(tensorTypeTag).asString());
     uint32_t numDocs(tensorReader.getDocIdLimit());
+    bool build_index_in_load_loop = _index && !use_index_file && (executor == nullptr);
     _refVector.reset();
     _refVector.unsafe_reserve(numDocs);
     for (uint32_t lid = 0; lid < numDocs; ++lid) {
@@ -209,7 +330,7 @@ DenseTensorAttribute::onLoad()
             auto raw = _denseTensorStore.allocRawBuffer();
             tensorReader.readTensor(raw.data, _denseTensorStore.getBufSize());
             _refVector.push_back(raw.ref);
-            if (_index && !use_index_file) {
+            if (build_index_in_load_loop) {
                 // This ensures that get_vector() (via getTensor()) is able to find the newly added tensor.
                 setCommittedDocIdLimit(lid + 1);
                 _index->add_document(lid);
@@ -220,6 +341,17 @@ DenseTensorAttribute::onLoad()
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    if (_index && !use_index_file && (executor != nullptr)) {
+        // All tensors are loaded before building the index, as the ref vector must be stable
+        // while get_vector() is used by the executor threads.
+        ThreadedIndexBuilder builder(*this, getGenerationHandler(), *_index, *executor);
+        for (uint32_t lid = 0; lid < numDocs; ++lid) {
+            if (_refVector[lid].valid()) {
+                builder.add(lid);
+            }
+        }
+        builder.wait_complete();
+    }
     if (_index && use_index_file) {
         auto buffer = LoadUtils::loadFile(*this, DenseTensorAttributeSaver::index_file_suffix());
         if (!_index->load(*buffer)) {
@@ -39,7 +39,7 @@ public:
     std::unique_ptr<Tensor> getTensor(DocId docId) const override;
     void extract_dense_view(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor) const override;
     bool supports_extract_dense_view() const override { return true; }
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
     uint32_t getVersion() const override;
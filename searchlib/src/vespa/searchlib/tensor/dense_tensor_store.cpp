@@ -52,8 +52,10 @@ DenseTensorStore::TensorSizeCalc::alignedSize() const
     return my_align(bufSize(), DENSE_TENSOR_ALIGNMENT);
 }
 
-DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc)
-    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize())
+DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc,
+                                         const vespalib::alloc::MemoryAllocator *allocator)
+    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize(),
+                                            0u, DEFAULT_ALLOC_GROW_FACTOR, allocator)
 {}
 
 DenseTensorStore::BufferType::~BufferType() = default;
@@ -66,10 +68,16 @@ DenseTensorStore::BufferType::cleanHold(void *buffer, size_t offset,
 }
 
 DenseTensorStore::DenseTensorStore(const ValueType &type)
+    : DenseTensorStore(type, std::unique_ptr<vespalib::alloc::MemoryAllocator>())
+{
+}
+
+DenseTensorStore::DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator)
     : TensorStore(_concreteStore),
+      _allocator(std::move(allocator)),
       _concreteStore(),
       _tensorSizeCalc(type),
-      _bufferType(_tensorSizeCalc),
+      _bufferType(_tensorSizeCalc, _allocator.get()),
       _type(type),
       _emptySpace()
 {
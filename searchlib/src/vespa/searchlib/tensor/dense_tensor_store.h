@@ -5,6 +5,7 @@
 #include "tensor_store.h"
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/util/alloc.h>
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -35,11 +36,13 @@ public:
     {
         using CleanContext = vespalib::datastore::BufferType<char>::CleanContext;
     public:
-        BufferType(const TensorSizeCalc &tensorSizeCalc);
+        BufferType(const TensorSizeCalc &tensorSizeCalc, const vespalib::alloc::MemoryAllocator *allocator);
         ~BufferType() override;
         void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext cleanCtx) override;
     };
 private:
+    // Must outlive the buffers in _concreteStore
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> _allocator;
     DataStoreType _concreteStore;
     TensorSizeCalc _tensorSizeCalc;
     BufferType _bufferType;
@@ -54,6 +57,11 @@ private:
 
 public:
     DenseTensorStore(const ValueType &type);
+    /**
+     * Tensor buffers are allocated by the given memory allocator if set,
+     * e.g. to let them be paged out to disk.
+     */
+    DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator);
     ~DenseTensorStore() override;
 
     const ValueType &type() const { return _type; }
@@ -15,7 +15,7 @@ public:
     virtual ~DirectTensorAttribute();
     virtual void setTensor(DocId docId, const Tensor &tensor) override;
     virtual std::unique_ptr<Tensor> getTensor(DocId docId) const override;
-    virtual bool onLoad() override;
+    virtual bool onLoad(vespalib::Executor *executor) override;
     virtual std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     virtual void compactWorst() override;
 
@@ -51,7 +51,8 @@ public:
 };
 
 /**
- * Calculates angular distance between vectors
+ * Calculates angular distance between vectors.
+ * Will compute the dot product and both norms in a single pass when the cpu supports it.
  */
 template <typename FloatType>
 class AngularDistance : public DistanceFunction {
@@ -64,14 +65,7 @@ public:
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        auto a = &lhs_vector[0];
-        auto b = &rhs_vector[0];
-        double a_norm_sq = _computer.dotProduct(a, a, sz);
-        double b_norm_sq = _computer.dotProduct(b, b, sz);
-        double squared_norms = a_norm_sq * b_norm_sq;
-        double dot_product = _computer.dotProduct(a, b, sz);
-        double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
-        double cosine_similarity = dot_product / div;
+        double cosine_similarity = _computer.cosineSimilarity(&lhs_vector[0], &rhs_vector[0], sz);
         double distance = 1.0 - cosine_similarity; // in range [0,2]
         return distance;
     }
@@ -181,21 +175,20 @@ public:
 /**
  * Calculates the Hamming distance defined as
  * "number of cells where the values are different"
+ * Will use instruction optimal for the cpu it is running on.
  */
 template <typename FloatType>
 class HammingDistance : public DistanceFunction {
 public:
-    HammingDistance() {}
+    HammingDistance()
+        : _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
     double calc(const vespalib::tensor::TypedCells& lhs, const vespalib::tensor::TypedCells& rhs) const override {
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        size_t sum = 0;
-        for (size_t i = 0; i < sz; ++i) {
-            sum += (lhs_vector[i] == rhs_vector[i]) ? 0 : 1;
-        }
-        return (double)sum;
+        return (double)_computer.hammingDistance(&lhs_vector[0], &rhs_vector[0], sz);
     }
     double to_rawscore(double distance) const override {
         double score = 1.0 / (1.0 + distance);
@@ -215,6 +208,8 @@ public:
         }
         return (double)sum;
     }
+
+    const vespalib::hwaccelrated::IAccelrated & _computer;
 };
 
 
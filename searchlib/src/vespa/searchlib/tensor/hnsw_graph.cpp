@@ -7,10 +7,10 @@
 
 namespace search::tensor {
 
-HnswGraph::HnswGraph()
+HnswGraph::HnswGraph(std::unique_ptr<vespalib::alloc::MemoryAllocator> link_allocator)
   : node_refs(),
     nodes(HnswIndex::make_default_node_store_config()),
-    links(HnswIndex::make_default_link_store_config()),
+    links(HnswIndex::make_default_link_store_config(), std::move(link_allocator)),
     entry_docid_and_level()
 {
     node_refs.ensure_size(1, AtomicEntryRef());
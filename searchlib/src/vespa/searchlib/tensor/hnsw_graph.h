@@ -42,7 +42,11 @@ struct HnswGraph {
 
     std::atomic<uint64_t> entry_docid_and_level;
 
-    HnswGraph();
+    /**
+     * Link arrays are allocated by the given memory allocator if set,
+     * e.g. to let them be paged out to disk.
+     */
+    HnswGraph(std::unique_ptr<vespalib::alloc::MemoryAllocator> link_allocator = {});
 
     ~HnswGraph();
 
@@ -4,12 +4,15 @@
 #include "hnsw_index.h"
 #include "hnsw_index_loader.h"
 #include "hnsw_index_saver.h"
+#include "page_faults.h"
 #include "random_level_generator.h"
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/rcuvector.hpp>
 #include <vespa/log/log.h>
 
@@ -199,8 +202,9 @@ HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
     return _distance_func->calc(lhs, rhs);
 }
 
+template <class DistanceCalc>
 HnswCandidate
-HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex::find_nearest_in_layer(const DistanceCalc& dist_calc, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -208,7 +212,7 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
         keep_searching = false;
         for (uint32_t neighbor_docid : _graph.get_link_array(nearest.node_ref, level)) {
             auto neighbor_ref = _graph.get_node_ref(neighbor_docid);
-            double dist = calc_distance(input, neighbor_docid);
+            double dist = dist_calc.calc(neighbor_docid);
             if (_graph.still_valid(neighbor_docid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -220,8 +224,9 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
     return nearest;
 }
 
+template <class DistanceCalc>
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex::search_layer(const DistanceCalc& dist_calc, uint32_t neighbors_to_find,
                         FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
 {
     NearestPriQ candidates;
@@ -258,7 +263,7 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
                 continue;
             }
             visited.mark(neighbor_docid);
-            double dist_to_input = calc_distance(input, neighbor_docid);
+            double dist_to_input = dist_calc.calc(neighbor_docid);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
                 if ((!filter) || filter->testBit(neighbor_docid)) {
@@ -274,17 +279,31 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
 }
 
 HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-                     RandomLevelGenerator::UP level_generator, const Config& cfg)
+                     RandomLevelGenerator::UP level_generator, const Config& cfg,
+                     VectorQuantizer::UP quantizer,
+                     std::unique_ptr<vespalib::alloc::MemoryAllocator> link_allocator)
     :
-      _graph(),
+      _graph(std::move(link_allocator)),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
       _level_generator(std::move(level_generator)),
-      _cfg(cfg)
+      _cfg(cfg),
+      _quantized_vectors(),
+      _untrained_docs(0),
+      _quantizer_trained(false),
+      _training_executor(),
+      _query_major_page_faults(0),
+      _query_minor_page_faults(0)
 {
+    if (quantizer) {
+        _quantized_vectors = std::make_unique<QuantizedVectorStore>(std::move(quantizer));
+    }
 }
 
-HnswIndex::~HnswIndex() = default;
+HnswIndex::~HnswIndex()
+{
+    sync_quantizer_training();
+}
 
 void
 HnswIndex::add_document(uint32_t docid)
@@ -306,11 +325,12 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
         return op;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(input_vector, entry.docid);
+    ExactDistance dist_calc(*this, input_vector);
+    double entry_dist = dist_calc.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > op.max_level) {
-        entry_point = find_nearest_in_layer(input_vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(dist_calc, entry_point, search_level);
         --search_level;
     }
 
@@ -320,7 +340,7 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
 
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(input_vector, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        search_layer(dist_calc, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
         auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         op.connections[search_level].reserve(neighbors.used.size());
         for (const auto & neighbor : neighbors.used) {
@@ -359,6 +379,8 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    // The quantized vector must be in place before the node is reachable by readers.
+    quantize_document(docid);
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -367,6 +389,92 @@ HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
     if (op.max_level > get_entry_level()) {
         _graph.set_entry_node({docid, node_ref, op.max_level});
     }
+    consider_train_quantizer();
+}
+
+void
+HnswIndex::quantize_document(uint32_t docid)
+{
+    if (_quantized_vectors && _quantized_vectors->ready()) {
+        _quantized_vectors->set(docid, get_vector(docid));
+    }
+}
+
+void
+HnswIndex::consider_train_quantizer()
+{
+    if (_quantized_vectors && !_quantized_vectors->ready() && !_training_executor) {
+        ++_untrained_docs;
+        if (_untrained_docs >= _quantized_vectors->quantizer().wanted_training_samples()) {
+            // The samples are copied, as the original cells can change while training.
+            auto samples = sample_training_vectors();
+            if (samples.empty()) {
+                return;
+            }
+            LOG(info, "Training %s vector quantizer in background using %zu samples",
+                _quantized_vectors->quantizer().name(), samples.size());
+            _training_executor = std::make_unique<vespalib::ThreadStackExecutor>(1, 128 * 1024);
+            _training_executor->execute(vespalib::makeLambdaTask([this, samples = std::move(samples)]() {
+                train_quantizer(samples);
+                _quantizer_trained.store(true, std::memory_order_release);
+            }));
+        }
+    }
+    consider_install_quantizer();
+}
+
+void
+HnswIndex::consider_install_quantizer()
+{
+    if (_quantized_vectors && !_quantized_vectors->ready() && _quantizer_trained.load(std::memory_order_acquire)) {
+        quantize_all_documents();
+        _quantized_vectors->set_ready();
+        _untrained_docs = 0;
+    }
+}
+
+std::vector<std::vector<float>>
+HnswIndex::sample_training_vectors() const
+{
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid < _graph.size(); ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            docids.push_back(docid);
+        }
+    }
+    // Samples are picked evenly across the document id space.
+    size_t num_samples = std::min(docids.size(), size_t(_quantized_vectors->quantizer().wanted_training_samples()));
+    std::vector<std::vector<float>> samples(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        auto vector = get_vector(docids[(i * docids.size()) / num_samples]);
+        samples[i].resize(vector.size);
+        for (size_t j = 0; j < vector.size; ++j) {
+            samples[i][j] = vector.get(j);
+        }
+    }
+    return samples;
+}
+
+void
+HnswIndex::train_quantizer(const std::vector<std::vector<float>>& samples)
+{
+    // Readers and the writer thread do not use the quantizer until the quantized vectors are ready.
+    std::vector<TypedCells> cells;
+    cells.reserve(samples.size());
+    for (const auto& sample : samples) {
+        cells.emplace_back(vespalib::ConstArrayRef<float>(sample));
+    }
+    _quantized_vectors->train(cells);
+}
+
+void
+HnswIndex::quantize_all_documents()
+{
+    for (uint32_t docid = 1; docid < _graph.size(); ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            _quantized_vectors->set(docid, get_vector(docid));
+        }
+    }
 }
 
 std::unique_ptr<PrepareResult>
@@ -454,11 +562,16 @@ HnswIndex::remove_document(uint32_t docid)
 void
 HnswIndex::transfer_hold_lists(generation_t current_gen)
 {
+    // Completes background training of the quantizer, also when no more documents are added.
+    consider_install_quantizer();
     // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
     //       We need to set the next generation here, as it is incremented on a higher level right after this call.
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -467,6 +580,9 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
 }
 
 vespalib::MemoryUsage
@@ -477,6 +593,9 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -509,12 +628,25 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    if (_quantized_vectors) {
+        auto& quantization = object.setObject("quantization");
+        quantization.setString("type", _quantized_vectors->quantizer().name());
+        quantization.setLong("code_size", _quantized_vectors->quantizer().code_size());
+        quantization.setBool("ready", _quantized_vectors->ready());
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), quantization.setObject("memory_usage"));
+    }
+    object.setBool("paged", paged());
+    if (paged()) {
+        auto& page_faults = object.setObject("query_page_faults");
+        page_faults.setLong("major", _query_major_page_faults.load(std::memory_order_relaxed));
+        page_faults.setLong("minor", _query_minor_page_faults.load(std::memory_order_relaxed));
+    }
 }
 
 std::unique_ptr<NearestNeighborIndexSaver>
 HnswIndex::make_saver() const
 {
-    return std::make_unique<HnswIndexSaver>(_graph);
+    return std::make_unique<HnswIndexSaver>(_graph, _quantized_vectors.get());
 }
 
 bool
@@ -522,7 +654,36 @@ HnswIndex::load(const fileutil::LoadedBuffer& buf)
 {
     assert(get_entry_docid() == 0); // cannot load after index has data
     HnswIndexLoader loader(_graph);
-    return loader.load(buf);
+    if (!loader.load(buf)) {
+        return false;
+    }
+    if (_quantized_vectors) {
+        auto saved = loader.quantized_vectors();
+        vespalib::nbostream is(saved.begin(), saved.size());
+        if (!saved.empty() && _quantized_vectors->load(is)) {
+            return true;
+        }
+        // Quantized vectors are missing or saved using other quantizer parameters, and are recreated from the original cells.
+        // Training is done in this thread, as the index is not in use while loading.
+        if (_quantized_vectors->ready()) {
+            quantize_all_documents();
+        } else {
+            _untrained_docs = 0;
+            for (uint32_t docid = 1; docid < _graph.size(); ++docid) {
+                if (_graph.get_node_ref(docid).valid()) {
+                    ++_untrained_docs;
+                }
+            }
+            if (_untrained_docs >= _quantized_vectors->quantizer().wanted_training_samples()) {
+                auto samples = sample_training_vectors();
+                LOG(info, "Training %s vector quantizer using %zu samples", _quantized_vectors->quantizer().name(), samples.size());
+                train_quantizer(samples);
+                _quantizer_trained.store(true, std::memory_order_release);
+                consider_install_quantizer();
+            }
+        }
+    }
+    return true;
 }
 
 struct NeighborsByDocId {
@@ -538,7 +699,14 @@ HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
                           const BitVector *filter, uint32_t explore_k) const
 {
     std::vector<Neighbor> result;
+    bool track_page_faults = paged();
+    PageFaults before = track_page_faults ? PageFaults::sample_thread() : PageFaults();
     FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter);
+    if (track_page_faults) {
+        PageFaults taken = PageFaults::sample_thread() - before;
+        _query_major_page_faults.fetch_add(taken.major, std::memory_order_relaxed);
+        _query_minor_page_faults.fetch_add(taken.minor, std::memory_order_relaxed);
+    }
     while (candidates.size() > k) {
         candidates.pop();
     }
@@ -563,8 +731,9 @@ HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
     return top_k_by_docid(k, vector, &filter, explore_k);
 }
 
+template <class DistanceCalc>
 FurthestPriQ
-HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+HnswIndex::top_k_candidates_helper(const DistanceCalc& dist_calc, uint32_t k, const BitVector *filter) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -573,18 +742,33 @@ HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVecto
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.docid);
+    double entry_dist = dist_calc.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(dist_calc, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
+    search_layer(dist_calc, k, best_neighbors, 0, filter);
     return best_neighbors;
 }
 
+FurthestPriQ
+HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+{
+    if (_quantized_vectors && _quantized_vectors->ready()) {
+        auto distance = _quantized_vectors->make_distance(vector);
+        auto candidates = top_k_candidates_helper(QuantizedVectorDistance(*_quantized_vectors, *distance), k, filter);
+        FurthestPriQ rescored;
+        for (const HnswCandidate & candidate : candidates.peek()) {
+            rescored.emplace(candidate.docid, candidate.node_ref, calc_distance(vector, candidate.docid));
+        }
+        return rescored;
+    }
+    return top_k_candidates_helper(ExactDistance(*this, vector), k, filter);
+}
+
 HnswNode
 HnswIndex::get_node(uint32_t docid) const
 {
@@ -608,6 +792,7 @@ HnswIndex::set_node(uint32_t docid, const HnswNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    quantize_document(docid);
     auto node_ref = _graph.make_node_for_document(docid, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(docid, node.level(level), level);
@@ -7,6 +7,7 @@
 #include "hnsw_index_utils.h"
 #include "hnsw_node.h"
 #include "nearest_neighbor_index.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
 #include <vespa/eval/tensor/dense/typed_cells.h>
@@ -16,6 +17,7 @@
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/util/rcuvector.h>
 #include <vespa/vespalib/util/reusable_set_pool.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 namespace search::tensor {
 
@@ -30,6 +32,15 @@ namespace search::tensor {
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
  * but some adjustments are made to support proper removes.
  *
+ * Optionally, a quantized (compressed) representation of the vectors is kept alongside the graph.
+ * When present, it is used to calculate approximate distances during graph traversal in queries,
+ * and the candidates found are re-scored using the original cells.
+ * A quantizer that needs training is trained in a background thread, and the writer thread
+ * encodes all documents when training is done. The quantized vectors are saved together with the graph.
+ *
+ * The link arrays can be allocated by a memory allocator backed by a file (see HnswGraph),
+ * letting the OS page cold parts of the graph out to disk. Page faults taken by queries are then tracked.
+ *
  * TODO: Add details on how to handle removes.
  */
 class HnswIndex : public NearestNeighborIndex {
@@ -80,6 +91,41 @@ protected:
     RandomLevelGenerator::UP _level_generator;
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
+    // Number of documents added while waiting for enough documents to train the quantizer.
+    uint32_t _untrained_docs;
+    // Set by the background thread when the quantizer is trained.
+    std::atomic<bool> _quantizer_trained;
+    // Runs quantizer training. Created when training starts.
+    std::unique_ptr<vespalib::ThreadStackExecutor> _training_executor;
+    // Page faults taken by queries, only tracked when the graph is paged.
+    mutable std::atomic<uint64_t> _query_major_page_faults;
+    mutable std::atomic<uint64_t> _query_minor_page_faults;
+
+    /**
+     * Calculates the distance between an input vector and documents in the index using the original cells.
+     */
+    class ExactDistance {
+    private:
+        const HnswIndex& _index;
+        const TypedCells& _input;
+    public:
+        ExactDistance(const HnswIndex& index, const TypedCells& input) : _index(index), _input(input) {}
+        double calc(uint32_t docid) const { return _index.calc_distance(_input, docid); }
+    };
+
+    /**
+     * Calculates the approximate distance between an input vector and documents in the index using quantized vectors.
+     */
+    class QuantizedVectorDistance {
+    private:
+        const QuantizedVectorStore& _store;
+        const QuantizedDistance& _distance;
+    public:
+        QuantizedVectorDistance(const QuantizedVectorStore& store, const QuantizedDistance& distance)
+            : _store(store), _distance(distance) {}
+        double calc(uint32_t docid) const { return _distance.calc(_store.get(docid)); }
+    };
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -119,9 +165,13 @@ protected:
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+    template <class DistanceCalc>
+    HnswCandidate find_nearest_in_layer(const DistanceCalc& dist_calc, const HnswCandidate& entry_point, uint32_t level) const;
+    template <class DistanceCalc>
+    void search_layer(const DistanceCalc& dist_calc, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                       uint32_t level, const search::BitVector *filter = nullptr) const;
+    template <class DistanceCalc>
+    FurthestPriQ top_k_candidates_helper(const DistanceCalc& dist_calc, uint32_t k, const BitVector *filter) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const BitVector *filter, uint32_t explore_k) const;
 
@@ -144,9 +194,19 @@ protected:
                                         vespalib::GenerationHandler::Guard read_guard) const;
     LinkArray filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t me);
     void internal_complete_add(uint32_t docid, PreparedAddDoc &op);
+
+    void quantize_document(uint32_t docid);
+    void consider_train_quantizer();
+    void consider_install_quantizer();
+    std::vector<std::vector<float>> sample_training_vectors() const;
+    void train_quantizer(const std::vector<std::vector<float>>& samples);
+    void quantize_all_documents();
+    bool paged() const { return _graph.links.get_memory_allocator() != nullptr; }
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-              RandomLevelGenerator::UP level_generator, const Config& cfg);
+              RandomLevelGenerator::UP level_generator, const Config& cfg,
+              VectorQuantizer::UP quantizer = VectorQuantizer::UP(),
+              std::unique_ptr<vespalib::alloc::MemoryAllocator> link_allocator = {});
     ~HnswIndex() override;
 
     const Config& config() const { return _cfg; }
@@ -171,12 +231,22 @@ public:
                                                  const BitVector &filter, uint32_t explore_k) const override;
     const DistanceFunction *distance_function() const override { return _distance_func.get(); }
 
+    /**
+     * Returns the k (or fewer) candidates nearest the given vector, with distances calculated using the original cells.
+     * If quantized vectors are ready, they are used during graph traversal and the candidates found are re-scored.
+     */
     FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const;
+    const QuantizedVectorStore* quantized_vectors() const { return _quantized_vectors.get(); }
 
     uint32_t get_entry_docid() const { return _graph.get_entry_node().docid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
     // Should only be used by unit tests.
+    void sync_quantizer_training() {
+        if (_training_executor) {
+            _training_executor->sync();
+        }
+    }
     HnswNode get_node(uint32_t docid) const;
     void set_node(uint32_t docid, const HnswNode &node);
     bool check_link_symmetry() const;
@@ -9,7 +9,7 @@ namespace search::tensor {
 HnswIndexLoader::~HnswIndexLoader() {}
 
 HnswIndexLoader::HnswIndexLoader(HnswGraph &graph)
-    : _graph(graph), _ptr(nullptr), _end(nullptr), _failed(false)
+    : _graph(graph), _ptr(nullptr), _end(nullptr), _failed(false), _quantized_vectors()
 {
 }
 
@@ -38,6 +38,14 @@ HnswIndexLoader::load(const fileutil::LoadedBuffer& buf)
         }
     }
     if (_failed) return false;
+    if (_ptr != _end) {
+        uint32_t num_bytes = next_int();
+        const char *start = reinterpret_cast<const char *>(_ptr);
+        const char *buf_end = static_cast<const char *>(buf.buffer()) + buf.size();
+        if (num_bytes <= size_t(buf_end - start)) {
+            _quantized_vectors = vespalib::ConstArrayRef<char>(start, num_bytes);
+        }
+    }
     _graph.node_refs.ensure_size(num_nodes);
     auto entry_node_ref = _graph.get_node_ref(entry_docid);
     _graph.set_entry_node({entry_docid, entry_node_ref, entry_level});
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/arrayref.h>
 #include <cstdint>
 
 namespace search::fileutil { class LoadedBuffer; }
@@ -12,17 +13,21 @@ struct HnswGraph;
 
 /**
  * Implements loading of HNSW graph structure from binary format.
+ * Quantized vectors saved after the graph are made available, but not loaded.
  **/
 class HnswIndexLoader {
 public:
     HnswIndexLoader(HnswGraph &graph);
     ~HnswIndexLoader();
     bool load(const fileutil::LoadedBuffer& buf);
+    // Empty if the index was saved without quantized vectors. Only valid while the loaded buffer is alive.
+    vespalib::ConstArrayRef<char> quantized_vectors() const { return _quantized_vectors; }
 private:
     HnswGraph &_graph;
     const uint32_t *_ptr;
     const uint32_t *_end;
     bool _failed;
+    vespalib::ConstArrayRef<char> _quantized_vectors;
     uint32_t next_int() {
         if (__builtin_expect((_ptr == _end), false)) {
             _failed = true;
@@ -2,14 +2,16 @@
 
 #include "hnsw_index_saver.h"
 #include "hnsw_graph.h"
+#include "quantized_vector_store.h"
 #include <vespa/searchlib/util/bufferwriter.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 namespace search::tensor {
 
 HnswIndexSaver::~HnswIndexSaver() {}
 
-HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
-    : _graph_links(graph.links), _meta_data()
+HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph, const QuantizedVectorStore *quantized_vectors)
+    : _graph_links(graph.links), _meta_data(), _quantized_vectors(nullptr), _quantized_codes()
 {
     auto entry = graph.get_entry_node();
     _meta_data.entry_docid = entry.docid;
@@ -28,6 +30,10 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
         }
         _meta_data.nodes.emplace_back(std::move(node));
     }
+    if (quantized_vectors != nullptr && quantized_vectors->ready()) {
+        _quantized_vectors = quantized_vectors;
+        _quantized_codes = quantized_vectors->get_codes();
+    }
 }
 
 void
@@ -52,6 +58,14 @@ HnswIndexSaver::save(BufferWriter& writer) const
             }
         }
     }
+    if (_quantized_vectors != nullptr) {
+        vespalib::nbostream header;
+        _quantized_vectors->save_header(header, _quantized_codes);
+        uint32_t num_bytes = header.size() + _quantized_codes.size();
+        writer.write(&num_bytes, sizeof(uint32_t));
+        writer.write(header.peek(), header.size());
+        writer.write(_quantized_codes.cbegin(), _quantized_codes.size());
+    }
     writer.flush();
 }
 
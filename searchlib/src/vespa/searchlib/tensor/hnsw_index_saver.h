@@ -5,21 +5,28 @@
 #include "nearest_neighbor_index_saver.h"
 #include "hnsw_graph.h"
 #include <vespa/vespalib/datastore/entryref.h>
+#include <vespa/vespalib/util/arrayref.h>
 #include <vector>
 
 namespace search::tensor {
 
+class QuantizedVectorStore;
+
 /**
  * Implements saving of HNSW graph structure in binary format.
  * The constructor takes a snapshot of all meta-data, but
  * the links will be fetched from the graph in the save()
  * method.
+ *
+ * If quantized vectors are ready, the codes present when the saver is
+ * created are saved after the graph, prefixed by their size in bytes.
+ * Like the links, the codes are fetched from the store in the save() method.
  **/
 class HnswIndexSaver : public NearestNeighborIndexSaver {
 public:
     using LevelVector = std::vector<vespalib::datastore::EntryRef>;
 
-    HnswIndexSaver(const HnswGraph &graph);
+    HnswIndexSaver(const HnswGraph &graph, const QuantizedVectorStore *quantized_vectors = nullptr);
     ~HnswIndexSaver();
     void save(BufferWriter& writer) const override;
 
@@ -32,6 +39,8 @@ private:
     };
     const HnswGraph::LinkStore &_graph_links;
     MetaData _meta_data;
+    const QuantizedVectorStore *_quantized_vectors;
+    vespalib::ConstArrayRef<uint8_t> _quantized_codes;
 };
 
 }
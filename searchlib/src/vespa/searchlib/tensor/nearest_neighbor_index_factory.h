@@ -6,6 +6,7 @@
 #include <memory>
 
 namespace search::attribute { class HnswIndexParams; }
+namespace vespalib::alloc { class MemoryAllocator; }
 
 namespace search::tensor {
 
@@ -14,6 +15,8 @@ class NearestNeighborIndex;
 
 /**
  * Factory interface used to instantiate an index used for (approximate) nearest neighbor search.
+ *
+ * The memory allocator (if set) should be used for the parts of the index that are allowed to be paged out to disk.
  */
 class NearestNeighborIndexFactory {
 public:
@@ -21,7 +24,8 @@ public:
     virtual std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors,
                                                        size_t vector_size,
                                                        vespalib::eval::ValueType::CellType cell_type,
-                                                       const search::attribute::HnswIndexParams& params) const = 0;
+                                                       const search::attribute::HnswIndexParams& params,
+                                                       std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const = 0;
 };
 
 }
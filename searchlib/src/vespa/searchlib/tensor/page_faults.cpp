@@ -0,0 +1,20 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "page_faults.h"
+#include <sys/resource.h>
+
+namespace search::tensor {
+
+PageFaults
+PageFaults::sample_thread()
+{
+    PageFaults result;
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        result.major = usage.ru_majflt;
+        result.minor = usage.ru_minflt;
+    }
+    return result;
+}
+
+}
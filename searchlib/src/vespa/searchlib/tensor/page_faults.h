@@ -0,0 +1,29 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::tensor {
+
+/**
+ * Number of page faults taken by a thread.
+ *
+ * Used to see how much of a nearest neighbor search is spent paging in
+ * data structures kept in swap files (see vespalib::alloc::MmapFileAllocator).
+ */
+struct PageFaults {
+    uint64_t major;
+    uint64_t minor;
+    PageFaults() : major(0), minor(0) {}
+    PageFaults(uint64_t major_in, uint64_t minor_in) : major(major_in), minor(minor_in) {}
+    PageFaults operator-(const PageFaults &rhs) const {
+        return PageFaults(major - rhs.major, minor - rhs.minor);
+    }
+    /**
+     * Samples the page faults taken so far by the calling thread.
+     */
+    static PageFaults sample_thread();
+};
+
+}
@@ -0,0 +1,253 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "product_quantizer.h"
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using search::attribute::DistanceMetric;
+using vespalib::tensor::TypedCells;
+
+namespace search::tensor {
+
+namespace {
+
+double
+squared_distance(const float* a, const float* b, size_t sz)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < sz; ++i) {
+        double diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+double
+dot_product(const float* a, const float* b, size_t sz)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < sz; ++i) {
+        sum += double(a[i]) * b[i];
+    }
+    return sum;
+}
+
+class LookupTableDistance : public QuantizedDistance {
+private:
+    DistanceMetric _metric;
+    size_t _num_subspaces;
+    uint32_t _num_centroids;
+    // Entry [i * num_centroids + c] is the distance (euclidean) or dot product (angular, inner product)
+    // between sub-vector i of the query and centroid c in subspace i.
+    std::vector<float> _table;
+    double _norm_sq;
+
+public:
+    LookupTableDistance(DistanceMetric metric, size_t num_subspaces, uint32_t num_centroids,
+                        std::vector<float> table, double norm_sq)
+        : _metric(metric),
+          _num_subspaces(num_subspaces),
+          _num_centroids(num_centroids),
+          _table(std::move(table)),
+          _norm_sq(norm_sq)
+    {}
+    double calc(const uint8_t* code) const override {
+        float norm_sq;
+        memcpy(&norm_sq, code, sizeof(norm_sq));
+        const uint8_t* idx = code + ProductQuantizer::header_size;
+        const float* table = _table.data();
+        double sum = 0.0;
+        for (size_t i = 0; i < _num_subspaces; ++i) {
+            sum += table[idx[i]];
+            table += _num_centroids;
+        }
+        switch (_metric) {
+        case DistanceMetric::Euclidean:
+            return sum;
+        case DistanceMetric::InnerProduct:
+            return std::max(0.0, 1.0 - sum);
+        default: {
+            double squared_norms = _norm_sq * norm_sq;
+            double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+            return 1.0 - sum / div;
+        }
+        }
+    }
+};
+
+}
+
+ProductQuantizer::ProductQuantizer(DistanceMetric metric, size_t dims, size_t sub_dims, uint32_t num_centroids,
+                                   uint32_t training_samples, uint32_t kmeans_iterations)
+    : _metric(metric),
+      _dims(dims),
+      _sub_dims(std::min(sub_dims, dims)),
+      _num_subspaces((dims + _sub_dims - 1) / _sub_dims),
+      _num_centroids(std::clamp(num_centroids, 1u, max_centroids)),
+      _training_samples(std::max(training_samples, 1u)),
+      _kmeans_iterations(kmeans_iterations),
+      _codebooks(_num_subspaces * _num_centroids * _sub_dims, 0.0)
+{
+    assert(supports(metric));
+    assert(_sub_dims > 0);
+}
+
+ProductQuantizer::~ProductQuantizer() = default;
+
+uint32_t
+ProductQuantizer::find_nearest(size_t subspace, const float* sub_vector) const
+{
+    size_t sz = subspace_size(subspace);
+    uint32_t best = 0;
+    double best_dist = std::numeric_limits<double>::max();
+    for (uint32_t c = 0; c < _num_centroids; ++c) {
+        double dist = squared_distance(sub_vector, centroid(subspace, c), sz);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = c;
+        }
+    }
+    return best;
+}
+
+void
+ProductQuantizer::train_subspace(size_t subspace, const std::vector<std::vector<float>>& samples)
+{
+    size_t offset = subspace * _sub_dims;
+    size_t sz = subspace_size(subspace);
+    float* centroids = &_codebooks[subspace * _num_centroids * _sub_dims];
+    // Initial centroids are picked evenly from the samples, making training deterministic.
+    for (uint32_t c = 0; c < _num_centroids; ++c) {
+        const auto& sample = samples[(size_t(c) * samples.size()) / _num_centroids];
+        std::copy(sample.begin() + offset, sample.begin() + offset + sz, centroids + c * _sub_dims);
+    }
+    if (samples.size() <= _num_centroids) {
+        return;
+    }
+    std::vector<double> sums(_num_centroids * sz);
+    std::vector<uint32_t> counts(_num_centroids);
+    for (uint32_t iter = 0; iter < _kmeans_iterations; ++iter) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+        for (const auto& sample : samples) {
+            const float* sub_vector = sample.data() + offset;
+            uint32_t c = find_nearest(subspace, sub_vector);
+            for (size_t i = 0; i < sz; ++i) {
+                sums[c * sz + i] += sub_vector[i];
+            }
+            ++counts[c];
+        }
+        for (uint32_t c = 0; c < _num_centroids; ++c) {
+            // Empty clusters keep their previous centroid.
+            if (counts[c] > 0) {
+                for (size_t i = 0; i < sz; ++i) {
+                    centroids[c * _sub_dims + i] = sums[c * sz + i] / counts[c];
+                }
+            }
+        }
+    }
+}
+
+void
+ProductQuantizer::train(const std::vector<TypedCells>& samples)
+{
+    if (samples.empty()) {
+        return;
+    }
+    std::vector<std::vector<float>> float_samples(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        assert(samples[i].size == _dims);
+        to_float_cells(samples[i], float_samples[i]);
+    }
+    for (size_t subspace = 0; subspace < _num_subspaces; ++subspace) {
+        train_subspace(subspace, float_samples);
+    }
+}
+
+void
+ProductQuantizer::save_state(vespalib::nbostream& os) const
+{
+    os << uint32_t(_dims) << uint32_t(_sub_dims) << _num_centroids;
+    for (float cell : _codebooks) {
+        os << cell;
+    }
+}
+
+bool
+ProductQuantizer::load_state(vespalib::nbostream& is)
+{
+    uint32_t dims, sub_dims, num_centroids;
+    is >> dims >> sub_dims >> num_centroids;
+    if (dims != _dims || sub_dims != _sub_dims || num_centroids != _num_centroids ||
+        is.size() < _codebooks.size() * sizeof(float))
+    {
+        return false;
+    }
+    for (float& cell : _codebooks) {
+        is >> cell;
+    }
+    return true;
+}
+
+void
+ProductQuantizer::encode(const TypedCells& vector, uint8_t* code) const
+{
+    assert(vector.size == _dims);
+    std::vector<float> cells;
+    to_float_cells(vector, cells);
+    uint8_t* idx = code + header_size;
+    double norm_sq = 0.0;
+    for (size_t subspace = 0; subspace < _num_subspaces; ++subspace) {
+        uint32_t c = find_nearest(subspace, &cells[subspace * _sub_dims]);
+        idx[subspace] = c;
+        const float* cent = centroid(subspace, c);
+        norm_sq += dot_product(cent, cent, subspace_size(subspace));
+    }
+    float header = norm_sq;
+    memcpy(code, &header, sizeof(header));
+}
+
+QuantizedDistance::UP
+ProductQuantizer::make_distance(const TypedCells& query) const
+{
+    std::vector<float> cells;
+    to_float_cells(query, cells);
+    assert(cells.size() == _dims);
+    std::vector<float> table(_num_subspaces * _num_centroids);
+    for (size_t subspace = 0; subspace < _num_subspaces; ++subspace) {
+        const float* sub_vector = &cells[subspace * _sub_dims];
+        size_t sz = subspace_size(subspace);
+        float* dst = &table[subspace * _num_centroids];
+        for (uint32_t c = 0; c < _num_centroids; ++c) {
+            if (_metric == DistanceMetric::Euclidean) {
+                dst[c] = squared_distance(sub_vector, centroid(subspace, c), sz);
+            } else {
+                dst[c] = dot_product(sub_vector, centroid(subspace, c), sz);
+            }
+        }
+    }
+    double norm_sq = dot_product(cells.data(), cells.data(), _dims);
+    return std::make_unique<LookupTableDistance>(_metric, _num_subspaces, _num_centroids, std::move(table), norm_sq);
+}
+
+vespalib::MemoryUsage
+ProductQuantizer::memory_usage() const
+{
+    size_t bytes = _codebooks.capacity() * sizeof(float);
+    return vespalib::MemoryUsage(bytes, bytes, 0, 0);
+}
+
+bool
+ProductQuantizer::supports(DistanceMetric metric)
+{
+    return (metric == DistanceMetric::Euclidean ||
+            metric == DistanceMetric::Angular ||
+            metric == DistanceMetric::InnerProduct);
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <algorithm>
+
+namespace search::tensor {
+
+/**
+ * Product quantizer that splits each vector into sub-vectors of (at most) sub_dims cells,
+ * and represents each sub-vector by the index of the nearest of num_centroids (at most 256) centroids
+ * in the codebook for that subspace.
+ *
+ * Code layout: [float squared norm of reconstructed vector][uint8 centroid index per subspace].
+ * The codebooks are trained using k-means on a sample of the vectors.
+ * Distances are calculated using per-query lookup tables with the distance
+ * (or dot product) between the query sub-vectors and all centroids (asymmetric distance computation).
+ * Supports the euclidean, angular and inner product distance metrics.
+ */
+class ProductQuantizer : public VectorQuantizer {
+public:
+    // Centroid indexes are stored as one byte per subspace.
+    static constexpr uint32_t max_centroids = 256;
+    static constexpr size_t header_size = sizeof(float);
+
+private:
+    search::attribute::DistanceMetric _metric;
+    size_t _dims;
+    size_t _sub_dims;
+    size_t _num_subspaces;
+    uint32_t _num_centroids;
+    uint32_t _training_samples;
+    uint32_t _kmeans_iterations;
+    // Centroids for subspace i are stored at offset i * _num_centroids * _sub_dims.
+    // Cells beyond the end of the last (partial) subspace are zero.
+    std::vector<float> _codebooks;
+
+    const float* centroid(size_t subspace, uint32_t idx) const {
+        return &_codebooks[(subspace * _num_centroids + idx) * _sub_dims];
+    }
+    size_t subspace_size(size_t subspace) const {
+        return std::min(_sub_dims, _dims - subspace * _sub_dims);
+    }
+    uint32_t find_nearest(size_t subspace, const float* sub_vector) const;
+    void train_subspace(size_t subspace, const std::vector<std::vector<float>>& samples);
+
+public:
+    ProductQuantizer(search::attribute::DistanceMetric metric, size_t dims, size_t sub_dims = 4,
+                     uint32_t num_centroids = max_centroids, uint32_t training_samples = 8192,
+                     uint32_t kmeans_iterations = 8);
+    ~ProductQuantizer() override;
+    const char* name() const override { return "product"; }
+    size_t code_size() const override { return header_size + _num_subspaces; }
+    uint32_t wanted_training_samples() const override { return _training_samples; }
+    void train(const std::vector<vespalib::tensor::TypedCells>& samples) override;
+    void save_state(vespalib::nbostream& os) const override;
+    bool load_state(vespalib::nbostream& is) override;
+    void encode(const vespalib::tensor::TypedCells& vector, uint8_t* code) const override;
+    QuantizedDistance::UP make_distance(const vespalib::tensor::TypedCells& query) const override;
+    vespalib::MemoryUsage memory_usage() const override;
+
+    size_t num_subspaces() const { return _num_subspaces; }
+    uint32_t num_centroids() const { return _num_centroids; }
+    static bool supports(search::attribute::DistanceMetric metric);
+};
+
+}
@@ -0,0 +1,80 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <cstring>
+
+namespace search::tensor {
+
+QuantizedVectorStore::QuantizedVectorStore(VectorQuantizer::UP quantizer)
+    : _quantizer(std::move(quantizer)),
+      _code_size(_quantizer->code_size()),
+      _codes(),
+      _ready(!needs_training())
+{
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+void
+QuantizedVectorStore::set(uint32_t docid, const vespalib::tensor::TypedCells& vector)
+{
+    _codes.ensure_size((size_t(docid) + 1) * _code_size, 0);
+    _quantizer->encode(vector, &_codes[size_t(docid) * _code_size]);
+}
+
+vespalib::ConstArrayRef<uint8_t>
+QuantizedVectorStore::get_codes() const
+{
+    size_t num_bytes = (_codes.size() / _code_size) * _code_size;
+    return vespalib::ConstArrayRef<uint8_t>((num_bytes > 0) ? &_codes[0] : nullptr, num_bytes);
+}
+
+void
+QuantizedVectorStore::save_header(vespalib::nbostream& os, vespalib::ConstArrayRef<uint8_t> codes) const
+{
+    uint32_t num_docs = codes.size() / _code_size;
+    os << _quantizer->name();
+    _quantizer->save_state(os);
+    os << uint32_t(_code_size) << num_docs;
+}
+
+bool
+QuantizedVectorStore::load(vespalib::nbostream& is)
+{
+    try {
+        vespalib::string name;
+        is >> name;
+        if (name != _quantizer->name() || !_quantizer->load_state(is)) {
+            return false;
+        }
+        uint32_t code_size, num_docs;
+        is >> code_size >> num_docs;
+        size_t num_bytes = size_t(num_docs) * _code_size;
+        if (code_size != _code_size || is.size() < num_bytes) {
+            return false;
+        }
+        if (num_docs > 0) {
+            _codes.ensure_size(num_bytes, 0);
+            memcpy(&_codes[0], is.peek(), num_bytes);
+            is.adjustReadPos(num_bytes);
+        }
+    } catch (const vespalib::IllegalStateException&) {
+        return false;
+    }
+    set_ready();
+    return true;
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result = _codes.getMemoryUsage();
+    result.merge(_quantizer->memory_usage());
+    return result;
+}
+
+}
@@ -0,0 +1,76 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+
+namespace vespalib { class nbostream; }
+
+namespace search::tensor {
+
+/**
+ * Storage of quantized (compressed) vectors for all documents in a nearest neighbor index,
+ * together with the quantizer used to produce and interpret them.
+ *
+ * Codes are stored with a fixed size per document id, and the store supports 1 write thread and multiple reader threads.
+ * The codes are not used by readers until the store is ready, i.e. the quantizer is trained
+ * and all documents present at that time are encoded.
+ * The quantizer might be trained by a background thread, but only the writer thread makes the store ready.
+ */
+class QuantizedVectorStore {
+private:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    VectorQuantizer::UP _quantizer;
+    size_t _code_size;
+    vespalib::RcuVector<uint8_t> _codes;
+    std::atomic<bool> _ready;
+
+public:
+    QuantizedVectorStore(VectorQuantizer::UP quantizer);
+    ~QuantizedVectorStore();
+
+    const VectorQuantizer& quantizer() const { return *_quantizer; }
+    bool needs_training() const { return _quantizer->wanted_training_samples() > 0; }
+    bool ready() const { return _ready.load(std::memory_order_acquire); }
+    void train(const std::vector<vespalib::tensor::TypedCells>& samples) { _quantizer->train(samples); }
+    void set_ready() { _ready.store(true, std::memory_order_release); }
+
+    void set(uint32_t docid, const vespalib::tensor::TypedCells& vector);
+    const uint8_t* get(uint32_t docid) const { return &_codes[size_t(docid) * _code_size]; }
+    QuantizedDistance::UP make_distance(const vespalib::tensor::TypedCells& query) const {
+        return _quantizer->make_distance(query);
+    }
+
+    /**
+     * Returns the codes of all documents encoded so far. Must be called by the writer thread.
+     * Other threads can read the codes as long as a generation guard taken before this call is held.
+     */
+    vespalib::ConstArrayRef<uint8_t> get_codes() const;
+
+    /**
+     * Saves the quantizer state of a ready store and the header of the given codes (from get_codes()).
+     * The caller writes the codes right after it. As the quantizer state does not change when the store is ready,
+     * this can be called by any thread.
+     */
+    void save_header(vespalib::nbostream& os, vespalib::ConstArrayRef<uint8_t> codes) const;
+
+    /**
+     * Loads the quantizer state and the codes saved by save(), making the store ready.
+     * Returns false if the saved data does not match the quantizer of this store.
+     */
+    bool load(vespalib::nbostream& is);
+
+    void transfer_hold_lists(generation_t current_gen) {
+        // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+        //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+        _codes.setGeneration(current_gen + 1);
+    }
+    void trim_hold_lists(generation_t first_used_gen) { _codes.removeOldGenerations(first_used_gen); }
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
@@ -0,0 +1,130 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "scalar_int8_quantizer.h"
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+using search::attribute::DistanceMetric;
+using vespalib::hwaccelrated::IAccelrated;
+using vespalib::tensor::TypedCells;
+
+namespace search::tensor {
+
+namespace {
+
+/**
+ * Quantizes the given cells into int8 values, returning the scale needed to restore them.
+ */
+float
+quantize(const std::vector<float>& cells, int8_t* dst)
+{
+    float max_abs = 0.0;
+    for (float cell : cells) {
+        max_abs = std::max(max_abs, std::abs(cell));
+    }
+    float scale = (max_abs > 0.0) ? (max_abs / 127.0) : 1.0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        float value = std::round(cells[i] / scale);
+        dst[i] = static_cast<int8_t>(std::clamp(value, -127.0f, 127.0f));
+    }
+    return scale;
+}
+
+class Int8Distance : public QuantizedDistance {
+private:
+    DistanceMetric _metric;
+    const IAccelrated& _computer;
+    std::vector<int8_t> _query;
+    float _scale;
+    double _norm_sq;
+
+public:
+    Int8Distance(DistanceMetric metric, const IAccelrated& computer, const std::vector<float>& query)
+        : _metric(metric),
+          _computer(computer),
+          _query(query.size()),
+          _scale(quantize(query, _query.data())),
+          _norm_sq(0.0)
+    {
+        for (float cell : query) {
+            _norm_sq += double(cell) * cell;
+        }
+    }
+    double calc(const uint8_t* code) const override {
+        float header[2];
+        memcpy(header, code, sizeof(header));
+        const int8_t* cells = reinterpret_cast<const int8_t*>(code + ScalarInt8Quantizer::header_size);
+        double dot_product = double(_scale) * header[0] * _computer.dotProduct(_query.data(), cells, _query.size());
+        double norm_sq = header[1];
+        switch (_metric) {
+        case DistanceMetric::Euclidean:
+            return std::max(0.0, _norm_sq + norm_sq - 2.0 * dot_product);
+        case DistanceMetric::InnerProduct:
+            return std::max(0.0, 1.0 - dot_product);
+        default: {
+            double squared_norms = _norm_sq * norm_sq;
+            double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+            return 1.0 - dot_product / div;
+        }
+        }
+    }
+};
+
+}
+
+ScalarInt8Quantizer::ScalarInt8Quantizer(DistanceMetric metric, size_t dims)
+    : _metric(metric),
+      _dims(dims),
+      _computer(IAccelrated::getAccelerator())
+{
+    assert(supports(metric));
+}
+
+ScalarInt8Quantizer::~ScalarInt8Quantizer() = default;
+
+void
+ScalarInt8Quantizer::train(const std::vector<TypedCells>&)
+{
+}
+
+void
+ScalarInt8Quantizer::encode(const TypedCells& vector, uint8_t* code) const
+{
+    assert(vector.size == _dims);
+    std::vector<float> cells;
+    to_float_cells(vector, cells);
+    int8_t* dst = reinterpret_cast<int8_t*>(code + header_size);
+    float header[2];
+    header[0] = quantize(cells, dst);
+    header[1] = double(header[0]) * header[0] * _computer.dotProduct(dst, dst, _dims);
+    memcpy(code, header, sizeof(header));
+}
+
+QuantizedDistance::UP
+ScalarInt8Quantizer::make_distance(const TypedCells& query) const
+{
+    std::vector<float> cells;
+    to_float_cells(query, cells);
+    assert(cells.size() == _dims);
+    return std::make_unique<Int8Distance>(_metric, _computer, cells);
+}
+
+vespalib::MemoryUsage
+ScalarInt8Quantizer::memory_usage() const
+{
+    return vespalib::MemoryUsage();
+}
+
+bool
+ScalarInt8Quantizer::supports(DistanceMetric metric)
+{
+    return (metric == DistanceMetric::Euclidean ||
+            metric == DistanceMetric::Angular ||
+            metric == DistanceMetric::InnerProduct);
+}
+
+}
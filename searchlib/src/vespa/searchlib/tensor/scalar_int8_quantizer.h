@@ -0,0 +1,45 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+#include <vespa/searchcommon/attribute/distance_metric.h>
+
+namespace vespalib::hwaccelrated { class IAccelrated; }
+
+namespace search::tensor {
+
+/**
+ * Quantizer that represents each vector cell as an int8 value, scaled
+ * by a per-vector factor so that the largest absolute cell value maps to 127.
+ *
+ * Code layout: [float scale][float squared norm][int8 cells].
+ * No training is needed.
+ * Distances are calculated using the int8 dot product between the quantized query and the code.
+ * Supports the euclidean, angular and inner product distance metrics.
+ */
+class ScalarInt8Quantizer : public VectorQuantizer {
+private:
+    search::attribute::DistanceMetric _metric;
+    size_t _dims;
+    const vespalib::hwaccelrated::IAccelrated& _computer;
+
+public:
+    static constexpr size_t header_size = 2 * sizeof(float);
+
+    ScalarInt8Quantizer(search::attribute::DistanceMetric metric, size_t dims);
+    ~ScalarInt8Quantizer() override;
+    const char* name() const override { return "int8"; }
+    size_t code_size() const override { return header_size + _dims; }
+    uint32_t wanted_training_samples() const override { return 0; }
+    void train(const std::vector<vespalib::tensor::TypedCells>& samples) override;
+    void save_state(vespalib::nbostream&) const override {}
+    bool load_state(vespalib::nbostream&) override { return true; }
+    void encode(const vespalib::tensor::TypedCells& vector, uint8_t* code) const override;
+    QuantizedDistance::UP make_distance(const vespalib::tensor::TypedCells& query) const override;
+    vespalib::MemoryUsage memory_usage() const override;
+
+    static bool supports(search::attribute::DistanceMetric metric);
+};
+
+}
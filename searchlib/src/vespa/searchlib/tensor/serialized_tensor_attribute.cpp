@@ -56,7 +56,7 @@ SerializedTensorAttribute::getTensor(DocId docId) const
 }
 
 bool
-SerializedTensorAttribute::onLoad()
+SerializedTensorAttribute::onLoad(vespalib::Executor *)
 {
     BlobSequenceReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -0,0 +1,23 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "vector_quantizer.h"
+#include <vespa/eval/tensor/dense/typed_cells.h>
+
+namespace search::tensor {
+
+void
+VectorQuantizer::to_float_cells(const vespalib::tensor::TypedCells& cells, std::vector<float>& result)
+{
+    result.resize(cells.size);
+    if (cells.type == vespalib::tensor::CellType::FLOAT) {
+        auto src = cells.typify<float>();
+        std::copy(src.begin(), src.end(), result.begin());
+    } else {
+        auto src = cells.typify<double>();
+        for (size_t i = 0; i < src.size(); ++i) {
+            result[i] = src[i];
+        }
+    }
+}
+
+}
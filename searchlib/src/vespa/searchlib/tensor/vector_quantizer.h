@@ -0,0 +1,72 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/memoryusage.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vespalib { class nbostream; }
+namespace vespalib::tensor { struct TypedCells; }
+
+namespace search::tensor {
+
+/**
+ * Interface used to calculate the approximate distance between a query vector
+ * (bound when the object is created) and a quantized document vector.
+ *
+ * The distances returned are only comparable with other distances calculated
+ * by the same object. They should follow the ordering of the distance function
+ * the quantizer was created for.
+ */
+class QuantizedDistance {
+public:
+    using UP = std::unique_ptr<QuantizedDistance>;
+    virtual ~QuantizedDistance() {}
+    virtual double calc(const uint8_t* code) const = 0;
+};
+
+/**
+ * Interface used to compress n-dimensional vectors into fixed size codes.
+ *
+ * A quantizer might need to be trained on a sample of the vectors before it can encode vectors.
+ * Training is done once, before any codes are produced, and might run in a background thread.
+ * The state produced by training is saved together with the codes, so the codes can be used after load.
+ */
+class VectorQuantizer {
+protected:
+    static void to_float_cells(const vespalib::tensor::TypedCells& cells, std::vector<float>& result);
+public:
+    using UP = std::unique_ptr<VectorQuantizer>;
+    virtual ~VectorQuantizer() {}
+    virtual const char* name() const = 0;
+
+    /**
+     * Returns the number of bytes used to represent one vector.
+     */
+    virtual size_t code_size() const = 0;
+
+    /**
+     * Returns the number of vectors wanted for training, or 0 if training is not needed.
+     */
+    virtual uint32_t wanted_training_samples() const = 0;
+    virtual void train(const std::vector<vespalib::tensor::TypedCells>& samples) = 0;
+
+    /**
+     * Saves / loads the state produced by training (e.g. codebooks).
+     * Loading returns false if the saved state does not match the parameters of this quantizer.
+     */
+    virtual void save_state(vespalib::nbostream& os) const = 0;
+    virtual bool load_state(vespalib::nbostream& is) = 0;
+
+    virtual void encode(const vespalib::tensor::TypedCells& vector, uint8_t* code) const = 0;
+    virtual QuantizedDistance::UP make_distance(const vespalib::tensor::TypedCells& query) const = 0;
+
+    /**
+     * Returns the memory used by codebooks and other state needed to interpret the codes.
+     */
+    virtual vespalib::MemoryUsage memory_usage() const = 0;
+};
+
+}
@@ -0,0 +1,43 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "vector_quantizer_factory.h"
+#include "product_quantizer.h"
+#include "scalar_int8_quantizer.h"
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.tensor.vector_quantizer_factory");
+
+using search::attribute::DistanceMetric;
+using search::attribute::VectorQuantization;
+
+namespace search::tensor {
+
+VectorQuantizer::UP
+make_vector_quantizer(VectorQuantization variant, DistanceMetric metric, size_t vector_size,
+                      uint32_t subspace_dims, uint32_t num_centroids)
+{
+    switch (variant) {
+        case VectorQuantization::None:
+            break;
+        case VectorQuantization::Int8:
+            if (ScalarInt8Quantizer::supports(metric)) {
+                return std::make_unique<ScalarInt8Quantizer>(metric, vector_size);
+            }
+            LOG(warning, "int8 vector quantization is not supported for this distance metric, using original cells only");
+            break;
+        case VectorQuantization::Product:
+            if (ProductQuantizer::supports(metric)) {
+                if (subspace_dims == 0 || num_centroids == 0 || num_centroids > ProductQuantizer::max_centroids) {
+                    LOG(warning, "product vector quantization with %u cells and %u centroids per subspace is not supported, "
+                        "using original cells only", subspace_dims, num_centroids);
+                    break;
+                }
+                return std::make_unique<ProductQuantizer>(metric, vector_size, subspace_dims, num_centroids);
+            }
+            LOG(warning, "product vector quantization is not supported for this distance metric, using original cells only");
+            break;
+    }
+    return VectorQuantizer::UP();
+}
+
+}
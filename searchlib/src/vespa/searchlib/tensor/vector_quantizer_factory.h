@@ -0,0 +1,23 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/searchcommon/attribute/vector_quantization.h>
+
+namespace search::tensor {
+
+/**
+ * Create a vector quantizer for the given quantization variant and distance metric.
+ * Product quantization uses the given number of cells per subspace and centroids per subspace (at most 256).
+ * Returns an empty pointer if no quantization is wanted or the distance metric is not supported.
+ **/
+VectorQuantizer::UP
+make_vector_quantizer(search::attribute::VectorQuantization variant,
+                      search::attribute::DistanceMetric metric,
+                      size_t vector_size,
+                      uint32_t subspace_dims = 4,
+                      uint32_t num_centroids = 256);
+
+}
@@ -172,6 +172,8 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max_weights", _posting_params._encode_block_max_weights);
+    params.set("bit_packed_doc_ids", _posting_params._bit_packed_doc_ids);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -796,6 +798,38 @@ public:
     }
 };
 
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBm : public FakeZc4SkipPosOcc<bigEndian>
+{
+    static Zc4PostingParams make_posting_params(const FakeWord &fw) {
+        Zc4PostingParams posting_params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+        posting_params._encode_block_max_weights = true;
+        return posting_params;
+    }
+public:
+    FakeZc4SkipPosOccCfBm(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, make_posting_params(fw),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bm" : ".zc4skipposoccle.cf.bm"))
+    {
+    }
+};
+
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBp : public FakeZc4SkipPosOcc<bigEndian>
+{
+    static Zc4PostingParams make_posting_params(const FakeWord &fw) {
+        Zc4PostingParams posting_params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+        posting_params._bit_packed_doc_ids = true;
+        return posting_params;
+    }
+public:
+    FakeZc4SkipPosOccCfBp(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, make_posting_params(fw),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bp" : ".zc4skipposoccle.cf.bp"))
+    {
+    }
+};
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
@@ -910,6 +944,24 @@ static FPFactoryInit
 initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBm<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbm(std::make_pair("Zc4SkipPosOccLE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBm<false> > >));
+
+static FPFactoryInit
+initSkipPos0becfbp(std::make_pair("Zc4SkipPosOccBE.cf.bp",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBp<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbp(std::make_pair("Zc4SkipPosOccLE.cf.bp",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBp<false> > >));
+
 static FPFactoryInit
 initSkipPos0becfnnu(std::make_pair("Zc4SkipPosOccBE.cf.nnu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack > >));
@@ -126,6 +126,7 @@ public:
     ~CommitChunk();
     bool empty() const { return _callBacks->empty(); }
     void add(const Packet & packet, Writer::DoneCallback onDone);
+    void addDoneCallback(Writer::DoneCallback onDone) { _callBacks->emplace_back(std::move(onDone)); }
     size_t sizeBytes() const { return _data.sizeBytes(); }
     const Packet & getPacket() const { return _data; }
     size_t getNumCallBacks() const { return _callBacks->size(); }
@@ -3,6 +3,7 @@
 #include "domain.h"
 #include "domainpart.h"
 #include "session.h"
+#include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/io/fileutil.h>
@@ -41,8 +42,14 @@ createCommitChunk(const DomainConfig &cfg) {
 Domain::Domain(const string &domainName, const string & baseDir, Executor & executor,
                const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
     : _config(cfg),
+      _groupCommit(cfg.getGroupCommit()),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
+      _lastCommitted(0),
+      _pendingCommit(false),
+      _commitNow(false),
+      _commitError(),
+      _failedChunks(),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, 128 * 1024)),
       _executor(executor),
       _sessionId(1),
@@ -55,6 +62,10 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & exec
       _sessionLock(),
       _sessions(),
       _maxSessionRunTime(),
+      _numCommits(0),
+      _numCommitEntries(0),
+      _numSyncs(0),
+      _totalSyncTime(),
       _baseDir(baseDir),
       _fileHeaderContext(fileHeaderContext),
       _markedDeleted(false)
@@ -113,13 +124,24 @@ Domain::addPart(SerialNum partId, bool isLastPart) {
     }
 }
 
-Domain::~Domain() { }
+Domain::~Domain() {
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        _commitNow = true;
+        guard.broadcast();
+    }
+    _singleCommitter->sync();
+}
 
 DomainInfo
 Domain::getDomainInfo() const
 {
     LockGuard guard(_lock);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.numCommits = _numCommits;
+    info.numCommitEntries = _numCommitEntries;
+    info.numSyncs = _numSyncs;
+    info.totalSyncTime = _totalSyncTime;
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -320,14 +342,38 @@ Domain::optionallyRotateFile(SerialNum serialNum) {
 
 Domain::CommitResult
 Domain::startCommit(DoneCallback onDone) {
-    (void) onDone;
-    return CommitResult();
+    if ( ! _groupCommit) {
+        return CommitResult();
+    }
+    MonitorGuard guard(_currentChunkMonitor);
+    throwIfCommitFailed(guard);
+    if (_currentChunk->empty()) {
+        return CommitResult();
+    }
+    _currentChunk->addDoneCallback(std::move(onDone));
+    scheduleGroupCommit(guard);
+    return _currentChunk->createCommitResult();
 }
 
 void
 Domain::append(const Packet & packet, Writer::DoneCallback onDone)
 {
-    (void) onDone;
+    if (_groupCommit) {
+        MonitorGuard guard(_currentChunkMonitor);
+        throwIfCommitFailed(guard);
+        if (_lastSerial >= packet.range().from()) {
+            throw runtime_error(fmt("Incoming serial number(%" PRIu64 ") must be bigger than the last one (%" PRIu64 ").",
+                                    packet.range().from(), _lastSerial));
+        }
+        _lastSerial = packet.range().to();
+        _currentChunk->add(packet, std::move(onDone));
+        if (_currentChunk->sizeBytes() > _config.getChunkSizeLimit()) {
+            _commitNow = true;
+            guard.broadcast();
+        }
+        scheduleGroupCommit(guard);
+        return;
+    }
     vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
     Packet::Entry entry;
     entry.deserialize(is);
@@ -336,6 +382,113 @@ Domain::append(const Packet & packet, Writer::DoneCallback onDone)
     cleanSessions();
 }
 
+void
+Domain::commitAndWait(const Packet & packet)
+{
+    append(packet, make_shared<IgnoreCallback>());
+    if ( ! _groupCommit) {
+        return;
+    }
+    MonitorGuard guard(_currentChunkMonitor);
+    _commitNow = true;
+    guard.broadcast();
+    while ((_lastCommitted < packet.range().to()) && _commitError.empty()) {
+        guard.wait();
+    }
+    if (_lastCommitted < packet.range().to()) {
+        throwIfCommitFailed(guard);
+    }
+}
+
+void
+Domain::throwIfCommitFailed(const MonitorGuard & guard) const
+{
+    (void) guard;
+    assert(guard.monitors(_currentChunkMonitor));
+    if ( ! _commitError.empty()) {
+        throw runtime_error(fmt("Domain '%s' stopped writing after a failed commit: %s", _name.c_str(), _commitError.c_str()));
+    }
+}
+
+void
+Domain::scheduleGroupCommit(const MonitorGuard & guard)
+{
+    assert(guard.monitors(_currentChunkMonitor));
+    if ( ! _pendingCommit) {
+        _pendingCommit = true;
+        _singleCommitter->execute(makeLambdaTask([this]() { groupCommit(); }));
+    }
+}
+
+void
+Domain::groupCommit()
+{
+    std::unique_ptr<CommitChunk> chunk;
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        auto deadline = std::chrono::steady_clock::now() + _config.getGroupCommitWindow();
+        for (auto now = std::chrono::steady_clock::now(); !_commitNow && (now < deadline); now = std::chrono::steady_clock::now()) {
+            guard.wait(deadline - now);
+        }
+        chunk = std::move(_currentChunk);
+        _currentChunk = createCommitChunk(_config);
+        _pendingCommit = false;
+        _commitNow = false;
+    }
+    // Only written by this thread, so it can be read without the monitor here.
+    vespalib::string error = _commitError;
+    if (error.empty()) {
+        try {
+            doCommit(*chunk);
+        } catch (const std::exception & e) {
+            error = e.what();
+            LOG(error, "Failed committing %zu entries to domain '%s', holding back %zu acks: %s",
+                chunk->getPacket().size(), _name.c_str(), chunk->getNumCallBacks(), e.what());
+        }
+    }
+    MonitorGuard guard(_currentChunkMonitor);
+    if (error.empty()) {
+        _lastCommitted = std::max(_lastCommitted, chunk->getPacket().range().to());
+    } else {
+        // Nothing after a failed write can be written either. Keep the callbacks alive so nothing is acked.
+        _commitError = error;
+        _failedChunks.push_back(std::move(chunk));
+    }
+    guard.broadcast();
+}
+
+void
+Domain::doCommit(const CommitChunk & chunk)
+{
+    const Packet & packet = chunk.getPacket();
+    if (packet.empty()) {
+        return;
+    }
+    vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
+    Packet::Entry entry;
+    entry.deserialize(is);
+    DomainPart::SP dp = optionallyRotateFile(entry.serial());
+    dp->commit(entry.serial(), packet);
+    DurationSeconds syncTime(0);
+    if (_config.getFSyncOnCommit()) {
+        auto start = std::chrono::steady_clock::now();
+        dp->sync();
+        syncTime = std::chrono::steady_clock::now() - start;
+    }
+    cleanSessions();
+    {
+        LockGuard guard(_lock);
+        _numCommits++;
+        _numCommitEntries += packet.size();
+        if (_config.getFSyncOnCommit()) {
+            _numSyncs++;
+            _totalSyncTime += syncTime;
+        }
+    }
+    LOG(debug, "Releasing %zu acks after committing %zu entries and %zu bytes.",
+        chunk.getNumCallBacks(), packet.size(), chunk.sizeBytes());
+}
+
 bool
 Domain::erase(SerialNum to)
 {
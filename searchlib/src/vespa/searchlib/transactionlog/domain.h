@@ -30,6 +30,11 @@ public:
 
     void append(const Packet & packet, Writer::DoneCallback onDone) override;
     [[nodiscard]] CommitResult startCommit(DoneCallback onDone) override;
+    /**
+     * Appends the packet and returns when it has been written, without waiting for the
+     * group commit window. Throws if the packet could not be written.
+     */
+    void commitAndWait(const Packet & packet);
     int visit(const Domain::SP & self, SerialNum from, SerialNum to, std::unique_ptr<Destination> dest);
 
     SerialNum begin() const;
@@ -64,6 +69,10 @@ private:
     vespalib::string dir() const { return getDir(_baseDir, _name); }
     void addPart(SerialNum partId, bool isLastPart);
     DomainPartSP optionallyRotateFile(SerialNum serialNum);
+    void scheduleGroupCommit(const vespalib::MonitorGuard & guard);
+    void groupCommit();
+    void doCommit(const CommitChunk & chunk);
+    void throwIfCommitFailed(const vespalib::MonitorGuard & guard) const;
 
     using SerialNumList = std::vector<SerialNum>;
 
@@ -74,8 +83,16 @@ private:
     using DurationSeconds = std::chrono::duration<double>;
 
     DomainConfig                 _config;
+    const bool                   _groupCommit;
     std::unique_ptr<CommitChunk> _currentChunk;
+    // Protected by _currentChunkMonitor
     SerialNum                    _lastSerial;
+    SerialNum                    _lastCommitted;
+    bool                         _pendingCommit;
+    bool                         _commitNow;
+    vespalib::string             _commitError;
+    // Chunks that could not be written. Their acks are held back until the domain is destroyed.
+    std::vector<std::unique_ptr<CommitChunk>> _failedChunks;
     std::unique_ptr<Executor>    _singleCommitter;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
@@ -88,6 +105,11 @@ private:
     vespalib::Lock               _sessionLock;
     SessionList                  _sessions;
     DurationSeconds              _maxSessionRunTime;
+    // Protected by _lock
+    size_t                       _numCommits;
+    size_t                       _numCommitEntries;
+    size_t                       _numSyncs;
+    DurationSeconds              _totalSyncTime;
     vespalib::string             _baseDir;
     const FileHeaderContext     &_fileHeaderContext;
     bool                         _markedDeleted;
@@ -8,8 +8,10 @@ DomainConfig::DomainConfig()
     : _encoding(Encoding::Crc::xxh64, Encoding::Compression::none),
       _compressionLevel(9),
       _fSyncOnCommit(false),
+      _groupCommit(false),
       _partSizeLimit(0x10000000), // 256M
-      _chunkSizeLimit(0x40000)   // 256k
+      _chunkSizeLimit(0x40000),   // 256k
+      _groupCommitWindow(vespalib::duration::zero())
 { }
 
 }
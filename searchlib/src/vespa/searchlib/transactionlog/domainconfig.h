@@ -16,17 +16,23 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommit(bool v)           { _groupCommit = v; return *this; }
+    DomainConfig & setGroupCommitWindow(duration v) { _groupCommitWindow = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    bool           getGroupCommit() const { return _groupCommit; }
+    duration getGroupCommitWindow() const { return _groupCommitWindow; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
+    bool         _groupCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    duration     _groupCommitWindow;
 };
 
 struct PartInfo {
@@ -48,11 +54,18 @@ struct DomainInfo {
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    // Accumulated group commit statistics.
+    size_t numCommits;
+    size_t numCommitEntries;
+    size_t numSyncs;
+    DurationSeconds totalSyncTime;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+              numCommits(0), numCommitEntries(0), numSyncs(0), totalSyncTime(), parts() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(),
+              numCommits(0), numCommitEntries(0), numSyncs(0), totalSyncTime(), parts() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
@@ -2,7 +2,6 @@
 #include "translogserver.h"
 #include "domain.h"
 #include "client_common.h"
-#include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/exceptions.h>
@@ -571,13 +570,8 @@ TransLogServer::domainCommit(FRT_RPCRequest *req)
     if (domain) {
         Packet packet(params[1]._data._buf, params[1]._data._len);
         try {
-            vespalib::Gate gate;
-            {
-                // Need to scope in order to drain out all the callbacks.
-                domain->append(packet, make_shared<GateCallback>(gate));
-                auto keep = domain->startCommit(make_shared<IgnoreCallback>());
-            }
-            gate.await();
+            // Requests are handled one at a time, so there is nothing to gain from waiting for more commits.
+            domain->commitAndWait(packet);
             ret.AddInt32(0);
             ret.AddString("ok");
         } catch (const std::exception & e) {
@@ -66,17 +66,21 @@ getDomainConfig(const searchlib::TranslogserverConfig & cfg) {
         .setCompressionLevel(cfg.compression.level)
         .setPartSizeLimit(cfg.filesizemax)
         .setChunkSizeLimit(cfg.chunk.sizelimit)
-        .setFSyncOnCommit(cfg.usefsync);
+        .setFSyncOnCommit(cfg.usefsync)
+        .setGroupCommit(cfg.groupcommit.enabled)
+        .setGroupCommitWindow(vespalib::from_s(cfg.groupcommit.window));
     return dcfg;
 }
 
 void
 logReconfig(const searchlib::TranslogserverConfig & cfg, const DomainConfig & dcfg) {
     LOG(config, "configure Transaction Log Server %s at port %d\n"
-                "DomainConfig {encoding={%d, %d}, compression_level=%d, part_limit=%ld, chunk_limit=%ld}",
+                "DomainConfig {encoding={%d, %d}, compression_level=%d, part_limit=%ld, chunk_limit=%ld, "
+                "group_commit=%s, group_commit_window=%1.3f}",
         cfg.servername.c_str(), cfg.listenport,
         dcfg.getEncoding().getCrc(), dcfg.getEncoding().getCompression(), dcfg.getCompressionlevel(),
-        dcfg.getPartSizeLimit(), dcfg.getChunkSizeLimit());
+        dcfg.getPartSizeLimit(), dcfg.getChunkSizeLimit(),
+        dcfg.getGroupCommit() ? "true" : "false", vespalib::to_s(dcfg.getGroupCommitWindow()));
 }
 
 }
@@ -136,4 +136,176 @@ TEST("testThatMultipleRemoveOnOverflowIsFine") {
     EXPECT_EQUAL(2924u, cache.sizeBytes());
 }
 
+using SizedCache = cache< CacheParam<P, B, zero<uint32_t>, size<string> > >;
+
+void
+fillBackingStore(B & m, uint32_t numKeys)
+{
+    for (uint32_t i(0); i < numKeys; i++) {
+        m[i] = "a";
+    }
+}
+
+void
+readHotThenScan(SizedCache & cache)
+{
+    for (size_t round(0); round < 3; round++) {
+        for (uint32_t i(1); i < 10; i++) {
+            EXPECT_EQUAL("a", cache.read(i));
+        }
+    }
+    for (uint32_t i(100); i < 500; i++) {
+        EXPECT_EQUAL("a", cache.read(i));
+    }
+}
+
+size_t
+countCached(const SizedCache & cache, uint32_t from, uint32_t to)
+{
+    size_t count(0);
+    for (uint32_t i(from); i < to; i++) {
+        count += cache.hasKey(i) ? 1 : 0;
+    }
+    return count;
+}
+
+TEST("require that a scan evicts the hot objects with lru policy") {
+    B m;
+    fillBackingStore(m, 1000);
+    SizedCache cache(m, 2000);
+    EXPECT_TRUE(CachePolicy::LRU == cache.getPolicy());
+    readHotThenScan(cache);
+    EXPECT_EQUAL(0u, countCached(cache, 1, 10));
+    EXPECT_EQUAL(0u, cache.getReject());
+}
+
+TEST("require that segmented lru keeps objects hit more than once during a scan") {
+    B m;
+    fillBackingStore(m, 1000);
+    SizedCache cache(m, 2000);
+    cache.setPolicy(CachePolicy::SLRU);
+    readHotThenScan(cache);
+    EXPECT_EQUAL(9u, countCached(cache, 1, 10));
+    EXPECT_EQUAL(25u, cache.size());
+    EXPECT_EQUAL(2025u, cache.sizeBytes());
+}
+
+TEST("require that segmented lru demotes from protected segment when it is full") {
+    B m;
+    fillBackingStore(m, 1000);
+    SizedCache cache(m, 2000);
+    cache.setPolicy(CachePolicy::SLRU);
+    for (size_t round(0); round < 2; round++) {
+        for (uint32_t i(0); i < 100; i++) {
+            cache.read(i);
+        }
+    }
+    EXPECT_EQUAL(25u, cache.size());
+    EXPECT_EQUAL(2025u, cache.sizeBytes());
+    EXPECT_EQUAL(25u, countCached(cache, 75, 100));
+}
+
+TEST("require that tiny lfu admission rejects objects seen once when cache is full") {
+    B m;
+    fillBackingStore(m, 1000);
+    SizedCache cache(m, 2000);
+    cache.setPolicy(CachePolicy::W_TINY_LFU);
+    readHotThenScan(cache);
+    EXPECT_EQUAL(9u, countCached(cache, 1, 10));
+    EXPECT_EQUAL(26u, cache.size()); // 1 in window and 25 in main segments
+    EXPECT_GREATER(cache.getAdmit(), 0u);
+    EXPECT_GREATER(cache.getReject(), 0u);
+    EXPECT_EQUAL(400u + 9u, cache.getMiss());
+}
+
+TEST("require that tiny lfu admits objects that become popular") {
+    B m;
+    fillBackingStore(m, 1000);
+    SizedCache cache(m, 2000);
+    cache.setPolicy(CachePolicy::W_TINY_LFU);
+    readHotThenScan(cache);
+    size_t rejected = cache.getReject();
+    for (size_t round(0); round < 5; round++) {
+        for (uint32_t i(600); i < 605; i++) {
+            cache.read(i);
+        }
+    }
+    // Rejected until read more often than the hot object they would evict.
+    EXPECT_EQUAL(5u, countCached(cache, 600, 605));
+    EXPECT_GREATER(cache.getReject(), rejected);
+}
+
+TEST("require that invalidate and write work with all policies") {
+    for (CachePolicy policy : {CachePolicy::LRU, CachePolicy::SLRU, CachePolicy::W_TINY_LFU}) {
+        B m;
+        fillBackingStore(m, 10);
+        SizedCache cache(m, 2000);
+        cache.setPolicy(policy);
+        for (size_t round(0); round < 2; round++) {
+            for (uint32_t i(0); i < 10; i++) {
+                cache.read(i);
+            }
+        }
+        EXPECT_EQUAL(10u, cache.size());
+        EXPECT_EQUAL(810u, cache.sizeBytes());
+        cache.write(3, "bbb");
+        EXPECT_EQUAL(812u, cache.sizeBytes());
+        EXPECT_EQUAL("bbb", cache.read(3));
+        cache.invalidate(3);
+        cache.invalidate(9);
+        EXPECT_EQUAL(8u, cache.size());
+        EXPECT_EQUAL(648u, cache.sizeBytes());
+        EXPECT_EQUAL("bbb", cache.read(3));
+        cache.erase(4);
+        EXPECT_FALSE(cache.hasKey(4));
+        EXPECT_EQUAL(8u, cache.size());
+        EXPECT_EQUAL(650u, cache.sizeBytes());
+    }
+}
+
+TEST("require that populate inserts without touching the backing store") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    cache.populate(1, "fetched");
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQUAL(1u, cache.getMiss());
+    EXPECT_EQUAL(1u, cache.getInsert());
+    cache.populate(1, "fetched again");
+    EXPECT_EQUAL(1u, cache.getRace());
+    EXPECT_EQUAL("fetched", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getHit());
+    EXPECT_EQUAL(2u, cache.getMiss());
+}
+
+TEST("require that frequency sketch estimates frequency") {
+    FrequencySketch sketch;
+    for (size_t i(0); i < 5; i++) {
+        sketch.increment(7);
+    }
+    sketch.increment(8);
+    EXPECT_EQUAL(5u, sketch.frequency(7));
+    EXPECT_EQUAL(1u, sketch.frequency(8));
+    EXPECT_EQUAL(0u, sketch.frequency(9));
+    for (size_t i(0); i < 20; i++) {
+        sketch.increment(7);
+    }
+    EXPECT_EQUAL(15u, sketch.frequency(7));
+}
+
+TEST("require that frequency sketch ages counters") {
+    FrequencySketch sketch;
+    EXPECT_EQUAL(64u, sketch.tableSize());
+    for (size_t i(0); i < 10; i++) {
+        sketch.increment(7);
+    }
+    for (uint64_t i(100); sketch.getResets() == 0; i++) {
+        sketch.increment(i);
+    }
+    EXPECT_EQUAL(5u, sketch.frequency(7));
+    sketch.ensureCapacity(1000);
+    EXPECT_EQUAL(1024u, sketch.tableSize());
+    EXPECT_EQUAL(0u, sketch.frequency(7));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
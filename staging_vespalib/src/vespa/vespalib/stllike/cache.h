@@ -2,6 +2,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/frequency_sketch.h>
 #include <vespa/vespalib/util/sync.h>
 #include <atomic>
 
@@ -31,18 +32,31 @@ struct CacheParam : public P
     typedef sizeV SizeV;
 };
 
+/**
+ * How the cache decides what to keep.
+ *
+ * LRU: A single lru list.
+ * SLRU: Segmented lru. New objects enter a probation segment and are promoted to a protected segment,
+ *       holding 80% of the capacity, when hit again. Objects demoted from the protected segment get
+ *       another round in probation. A burst of objects seen only once can then only flush the probation segment.
+ * W_TINY_LFU: New objects enter a small lru window holding 1% of the capacity. Objects leaving the window are
+ *             only admitted to the main SLRU if they have been accessed more often than the object they would
+ *             evict, as estimated by a @ref FrequencySketch over recent accesses.
+ */
+enum class CachePolicy { LRU, SLRU, W_TINY_LFU };
+
 /**
  * This is a cache using the underlying lru implementation as the store. It is modelled as a pure cache
  * with an backing store underneath it. That backing store is given to the constructor and must of course have
  * proper lifetime. The store must implement the same 3 methods as the @ref NullStore above.
  * Stuff is evicted from the cache if either number of elements or the accounted size passes the limits given.
+ * Which object to evict is decided by the @ref CachePolicy, default is LRU.
  * The cache is thread safe by a single lock for accessing the underlying Lru. In addition a striped locking with
  * 64 locks chosen by the hash of the key to enable a single fetch for any element required by multiple readers.
  */
 template< typename P >
-class cache : private lrucache_map<P>
+class cache
 {
-    typedef lrucache_map<P>   Lru;
 protected:
     typedef typename P::BackingStore   BackingStore;
     typedef typename P::Hash  Hash;
@@ -51,6 +65,24 @@ protected:
     typedef typename P::SizeK SizeK;
     typedef typename P::SizeV SizeV;
     typedef typename P::value_type value_type;
+private:
+    /**
+     * One lru segment of the cache. Eviction is decided by the owning cache.
+     */
+    class Segment : public lrucache_map<P> {
+    public:
+        using Evict = bool (cache::*)(const value_type &);
+        Segment(cache & owner, Evict evict);
+        ~Segment() override;
+        size_t sizeBytes() const { return _sizeBytes; }
+        void addBytes(size_t sz) { _sizeBytes += sz; }
+        void subBytes(size_t sz) { _sizeBytes -= sz; }
+    private:
+        bool removeOldest(const value_type & v) override { return (_owner.*_evict)(v); }
+        cache & _owner;
+        Evict   _evict;
+        size_t  _sizeBytes;
+    };
 public:
     /**
      * Will create a cache that populates on demand from the backing store.
@@ -61,7 +93,12 @@ public:
      * @maxBytes is the maximum limit of bytes the store can hold, before eviction starts.
      */
     cache(BackingStore & b, size_t maxBytes);
-    ~cache();
+    virtual ~cache();
+    /**
+     * Select the eviction policy. Can only be changed while the cache is empty.
+     */
+    cache & setPolicy(CachePolicy policy);
+    CachePolicy getPolicy() const { return _policy; }
     /**
      * Can be used for controlling max number of elements.
      */
@@ -73,11 +110,11 @@ public:
 
     cache & setCapacityBytes(size_t sz);
 
-    size_t capacity()                  const { return Lru::capacity(); }
+    size_t capacity()                  const { return _probation.capacity(); }
     size_t capacityBytes()             const { return _maxBytes; }
-    size_t size()                      const { return Lru::size(); }
-    size_t sizeBytes()                 const { return _sizeBytes; }
-    bool empty()                       const { return Lru::empty(); }
+    size_t size()                      const { return _probation.size() + _protected.size() + _window.size(); }
+    size_t sizeBytes()                 const { return _probation.sizeBytes() + _protected.sizeBytes() + _window.sizeBytes(); }
+    bool empty()                       const { return size() == 0; }
 
     /**
      * This simply erases the object.
@@ -91,7 +128,7 @@ public:
 
     /**
      * Return the object with the given key. If it does not exist, the backing store will be consulted.
-     * and the cache will be updated.
+     * and the cache will be updated, subject to admission by the policy.
      * If none exist an empty one will be created.
      * Object is then put at head of LRU list.
      */
@@ -103,6 +140,13 @@ public:
      */
     void write(const K & key, V value);
 
+    /**
+     * Insert an object the caller has read from the backing store itself, typically as part of a batch.
+     * It is accounted as a miss, like read() does, and is subject to admission by the policy.
+     * The backing store is neither consulted nor written to. An object already in the cache is kept.
+     */
+    void populate(const K & key, V value);
+
     /**
      * Tell if an object with given key exists in the cache.
      * Does not alter the LRU list.
@@ -118,20 +162,39 @@ public:
     size_t        getErase() const { return _erase; }
     size_t   getInvalidate() const { return _invalidate; }
     size_t       getlookup() const { return _lookup; }
+    /// Number of objects that passed the admission filter into the main cache.
+    size_t        getAdmit() const { return _admit; }
+    /// Number of objects that were dropped by the admission filter.
+    size_t       getReject() const { return _reject; }
 
 protected:
     vespalib::LockGuard getGuard();
     void invalidate(const vespalib::LockGuard & guard, const K & key);
     bool hasKey(const vespalib::LockGuard & guard, const K & key) const;
     bool hasLock() const;
+    /**
+     * Called when a new object is inserted in the cache, and when an object is
+     * explicitly erased or invalidated. Not called when objects are evicted.
+     */
+    virtual void onInsert(const K & key);
+    virtual void onRemove(const K & key);
 private:
     /**
-     * Called when an object is inserted, to see if the LRU should be removed.
+     * Called when an object is inserted, to see if the oldest object in a segment should be evicted.
      * Default is to obey the maxsize given in constructor.
-     * The obvious extension is when you are storing pointers and want to cap
-     * on the real size of the object pointed to.
      */
-    bool removeOldest(const value_type & v) override;
+    bool removeOldest(const value_type & v);
+    bool removeOldestProtected(const value_type & v);
+    bool removeOldestWindow(const value_type & v);
+    bool admit(const K & key) const;
+    size_t windowCapacityBytes() const;
+    size_t mainCapacityBytes() const { return capacityBytes() - windowCapacityBytes(); }
+    size_t protectedCapacityBytes() const { return (mainCapacityBytes() / 5) * 4; }
+    size_t estimatedMaxElements() const;
+    Segment * findSegment(const K & key);
+    bool lookup(const K & key, V & value);
+    void insertNew(const K & key, V value);
+    void recordAccess(const K & key);
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
     vespalib::Lock & getLock(const K & k) {
         size_t h(_hasher(k));
@@ -141,7 +204,7 @@ private:
     SizeK               _sizeK;
     SizeV               _sizeV;
     size_t              _maxBytes;
-    size_t              _sizeBytes;
+    CachePolicy         _policy;
     mutable size_t      _hit;
     mutable size_t      _miss;
     std::atomic<size_t> _noneExisting;
@@ -152,6 +215,12 @@ private:
     mutable size_t      _erase;
     mutable size_t      _invalidate;
     mutable size_t      _lookup;
+    size_t              _admit;
+    size_t              _reject;
+    Segment             _probation;
+    Segment             _protected;
+    Segment             _window;
+    FrequencySketch     _sketch;
     BackingStore      & _store;
     vespalib::Lock      _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
@@ -3,20 +3,32 @@
 
 #include "cache.h"
 #include "lrucache_map.hpp"
+#include <algorithm>
 
 namespace vespalib {
 
+template< typename P >
+cache<P>::Segment::Segment(cache & owner, Evict evict) :
+    lrucache_map<P>(lrucache_map<P>::UNLIMITED),
+    _owner(owner),
+    _evict(evict),
+    _sizeBytes(0)
+{ }
+
+template< typename P >
+cache<P>::Segment::~Segment() = default;
+
 template< typename P >
 cache<P> &
 cache<P>::maxElements(size_t elems) {
-    Lru::maxElements(elems);
+    _probation.maxElements(elems);
     return *this;
 }
 
 template< typename P >
 cache<P> &
 cache<P>::reserveElements(size_t elems) {
-    Lru::reserve(elems);
+    _probation.reserve(elems);
     return *this;
 }
 
@@ -27,6 +39,15 @@ cache<P>::setCapacityBytes(size_t sz) {
     return *this;
 }
 
+template< typename P >
+cache<P> &
+cache<P>::setPolicy(CachePolicy policy) {
+    vespalib::LockGuard guard(_hashLock);
+    assert(empty());
+    _policy = policy;
+    return *this;
+}
+
 template< typename P >
 void
 cache<P>::invalidate(const K & key) {
@@ -47,14 +68,25 @@ cache<P>::hasLock() const {
     return TryLock(_hashLock).hasLock();
 }
 
+template< typename P >
+void
+cache<P>::onInsert(const K & key) {
+    (void) key;
+}
+
+template< typename P >
+void
+cache<P>::onRemove(const K & key) {
+    (void) key;
+}
+
 template< typename P >
 cache<P>::~cache() { }
 
 template< typename P >
 cache<P>::cache(BackingStore & b, size_t maxBytes) :
-    Lru(Lru::UNLIMITED),
     _maxBytes(maxBytes),
-    _sizeBytes(0),
+    _policy(CachePolicy::LRU),
     _hit(0),
     _miss(0),
     _noneExisting(0),
@@ -65,19 +97,140 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _erase(0),
     _invalidate(0),
     _lookup(0),
+    _admit(0),
+    _reject(0),
+    _probation(*this, &cache::removeOldest),
+    _protected(*this, &cache::removeOldestProtected),
+    _window(*this, &cache::removeOldestWindow),
+    _sketch(),
     _store(b)
 { }
 
+template< typename P >
+size_t
+cache<P>::windowCapacityBytes() const {
+    return (_policy == CachePolicy::W_TINY_LFU) ? std::max(capacityBytes() / 100, size_t(1)) : 0;
+}
+
 template< typename P >
 bool
 cache<P>::removeOldest(const value_type & v) {
-    bool remove(Lru::removeOldest(v) || (sizeBytes() >= capacityBytes()));
+    bool remove((size() > capacity()) || ((sizeBytes() - _window.sizeBytes()) >= mainCapacityBytes()));
     if (remove) {
-        _sizeBytes -= calcSize(v.first, v.second._value);
+        _probation.subBytes(calcSize(v.first, v.second._value));
     }
     return remove;
 }
 
+template< typename P >
+bool
+cache<P>::removeOldestProtected(const value_type & v) {
+    bool remove(_protected.sizeBytes() >= protectedCapacityBytes());
+    if (remove) {
+        // Demoted objects get another chance in the probation segment.
+        size_t sz = calcSize(v.first, v.second._value);
+        _protected.subBytes(sz);
+        _probation.insert(v.first, v.second._value);
+        _probation.addBytes(sz);
+    }
+    return remove;
+}
+
+template< typename P >
+bool
+cache<P>::removeOldestWindow(const value_type & v) {
+    bool remove(_window.sizeBytes() >= windowCapacityBytes());
+    if (remove) {
+        size_t sz = calcSize(v.first, v.second._value);
+        _window.subBytes(sz);
+        if (admit(v.first)) {
+            _probation.insert(v.first, v.second._value);
+            _probation.addBytes(sz);
+            _admit++;
+        } else {
+            _reject++;
+        }
+    }
+    return remove;
+}
+
+template< typename P >
+bool
+cache<P>::admit(const K & key) const {
+    if (_probation.sizeBytes() + _protected.sizeBytes() < mainCapacityBytes()) {
+        return true;
+    }
+    const Segment & victims = _probation.empty() ? _protected : _probation;
+    if (victims.empty()) {
+        return true;
+    }
+    return _sketch.frequency(_hasher(key)) > _sketch.frequency(_hasher(victims.oldest().first));
+}
+
+template< typename P >
+size_t
+cache<P>::estimatedMaxElements() const {
+    size_t avgSize = std::max(sizeBytes() / std::max(size(), size_t(1)), size_t(1));
+    return std::min(capacity(), capacityBytes() / avgSize);
+}
+
+template< typename P >
+void
+cache<P>::recordAccess(const K & key) {
+    if (_policy == CachePolicy::W_TINY_LFU) {
+        _sketch.increment(_hasher(key));
+    }
+}
+
+template< typename P >
+typename cache<P>::Segment *
+cache<P>::findSegment(const K & key) {
+    if (_probation.hasKey(key)) {
+        return &_probation;
+    } else if (_protected.hasKey(key)) {
+        return &_protected;
+    } else if (_window.hasKey(key)) {
+        return &_window;
+    }
+    return nullptr;
+}
+
+template< typename P >
+bool
+cache<P>::lookup(const K & key, V & value) {
+    Segment * segment = findSegment(key);
+    if (segment == nullptr) {
+        return false;
+    }
+    if ((segment == &_probation) && (_policy != CachePolicy::LRU)) {
+        // Second hit, promote to the protected segment.
+        value = V(_probation.get(key));
+        size_t sz = calcSize(key, value);
+        _probation.erase(key);
+        _probation.subBytes(sz);
+        _protected.insert(key, value);
+        _protected.addBytes(sz);
+    } else {
+        value = V((*segment)[key]);
+    }
+    return true;
+}
+
+template< typename P >
+void
+cache<P>::insertNew(const K & key, V value) {
+    size_t sz = calcSize(key, value);
+    if (_policy == CachePolicy::W_TINY_LFU) {
+        _sketch.ensureCapacity(estimatedMaxElements());
+        _window.insert(key, std::move(value));
+        _window.addBytes(sz);
+    } else {
+        _probation.insert(key, std::move(value));
+        _probation.addBytes(sz);
+    }
+    onInsert(key);
+}
+
 template< typename P >
 vespalib::LockGuard
 cache<P>::getGuard() {
@@ -90,9 +243,11 @@ cache<P>::read(const K & key)
 {
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
+        recordAccess(key);
+        V value;
+        if (lookup(key, value)) {
             _hit++;
-            return (*this)[key];
+            return value;
         } else {
             _miss++;
         }
@@ -101,17 +256,17 @@ cache<P>::read(const K & key)
     vespalib::LockGuard storeGuard(getLock(key));
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
+        V value;
+        if (lookup(key, value)) {
             // Somebody else just fetched it ahead of me.
             _race++;
-            return (*this)[key];
+            return value;
         }
     }
     V value;
     if (_store.read(key, value)) {
         vespalib::LockGuard guard(_hashLock);
-        Lru::insert(key, value);
-        _sizeBytes += calcSize(key, value);
+        insertNew(key, value);
         _insert++;
     } else {
         _noneExisting.fetch_add(1);
@@ -125,21 +280,39 @@ cache<P>::write(const K & key, V value)
 {
     size_t newSize = calcSize(key, value);
     vespalib::LockGuard storeGuard(getLock(key));
+    _store.write(key, value);
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
-            _sizeBytes -= calcSize(key, (*this)[key]);
+        recordAccess(key);
+        Segment * segment = findSegment(key);
+        if (segment != nullptr) {
+            V & current = (*segment)[key];
+            segment->subBytes(calcSize(key, current));
+            current = std::move(value);
+            segment->addBytes(newSize);
             _update++;
+        } else {
+            insertNew(key, std::move(value));
         }
+        _write++;
     }
+}
 
-    _store.write(key, value);
-    {
-        vespalib::LockGuard guard(_hashLock);
-        (*this)[key] = std::move(value);
-        _sizeBytes += newSize;
-        _write++;
+template< typename P >
+void
+cache<P>::populate(const K & key, V value)
+{
+    vespalib::LockGuard storeGuard(getLock(key));
+    vespalib::LockGuard guard(_hashLock);
+    recordAccess(key);
+    _miss++;
+    if (findSegment(key) != nullptr) {
+        // Somebody else just fetched it ahead of me.
+        _race++;
+        return;
     }
+    insertNew(key, std::move(value));
+    _insert++;
 }
 
 template< typename P >
@@ -157,10 +330,12 @@ cache<P>::invalidate(const vespalib::LockGuard & guard, const K & key)
 {
     assert(guard.locks(_hashLock));
     (void) guard;
-    if (Lru::hasKey(key)) {
-        _sizeBytes -= calcSize(key, (*this)[key]);
+    Segment * segment = findSegment(key);
+    if (segment != nullptr) {
+        segment->subBytes(calcSize(key, segment->get(key)));
         _invalidate++;
-        Lru::erase(key);
+        onRemove(key);
+        segment->erase(key);
     }
 }
 
@@ -171,8 +346,7 @@ cache<P>::hasKey(const vespalib::LockGuard & guard, const K & key) const
     (void) guard;
     assert(guard.locks(_hashLock));
     _lookup++;
-    return Lru::hasKey(key);
+    return _probation.hasKey(key) || _protected.hasKey(key) || _window.hasKey(key);
 }
 
 }
-
@@ -0,0 +1,117 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "frequency_sketch.h"
+#include <algorithm>
+
+namespace vespalib {
+
+namespace {
+
+constexpr size_t MIN_TABLE_SIZE = 64;
+// Each table word holds the counters of one element, 8 bytes per tracked element.
+constexpr size_t MAX_TABLE_SIZE = 1ul << 20;
+constexpr uint64_t SEEDS[4] = { 0xc3a5c85c97cb3127ul, 0xb492b66fbe98f273ul, 0x9ae16a3b2f90404ful, 0xcbf29ce484222325ul };
+constexpr uint64_t RESET_MASK = 0x7777777777777777ul;
+
+size_t
+roundUp2inN(size_t v) {
+    size_t n(1);
+    while (n < v) {
+        n <<= 1;
+    }
+    return n;
+}
+
+}
+
+FrequencySketch::FrequencySketch()
+    : _table(),
+      _tableMask(0),
+      _sampleSize(0),
+      _size(0),
+      _resets(0)
+{
+    ensureCapacity(MIN_TABLE_SIZE);
+}
+
+FrequencySketch::~FrequencySketch() = default;
+
+void
+FrequencySketch::ensureCapacity(size_t maxElements)
+{
+    size_t wanted = roundUp2inN(std::min(std::max(maxElements, MIN_TABLE_SIZE), MAX_TABLE_SIZE));
+    if (wanted > _table.size()) {
+        _table.assign(wanted, 0);
+        _tableMask = wanted - 1;
+        _sampleSize = 10 * wanted;
+        _size = 0;
+    }
+}
+
+uint64_t
+FrequencySketch::spread(uint64_t hash)
+{
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdul;
+    hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53ul;
+    return hash ^ (hash >> 33);
+}
+
+size_t
+FrequencySketch::indexOf(uint64_t hash, uint32_t depth) const
+{
+    uint64_t h = (hash + SEEDS[depth]) * SEEDS[depth];
+    h += (h >> 32);
+    return h & _tableMask;
+}
+
+bool
+FrequencySketch::incrementAt(size_t index, uint32_t counter)
+{
+    uint32_t offset = counter << 2;
+    uint64_t mask = (0xful << offset);
+    if ((_table[index] & mask) != mask) {
+        _table[index] += (1ul << offset);
+        return true;
+    }
+    return false;
+}
+
+void
+FrequencySketch::increment(uint64_t hash)
+{
+    hash = spread(hash);
+    uint32_t start = (hash & 3) << 2;
+    bool added(false);
+    for (uint32_t i(0); i < 4; i++) {
+        added |= incrementAt(indexOf(hash, i), start + i);
+    }
+    if (added && (++_size == _sampleSize)) {
+        reset();
+    }
+}
+
+uint32_t
+FrequencySketch::frequency(uint64_t hash) const
+{
+    hash = spread(hash);
+    uint32_t start = (hash & 3) << 2;
+    uint32_t frequency(15);
+    for (uint32_t i(0); i < 4; i++) {
+        uint32_t offset = (start + i) << 2;
+        uint32_t count = (_table[indexOf(hash, i)] >> offset) & 0xf;
+        frequency = std::min(frequency, count);
+    }
+    return frequency;
+}
+
+void
+FrequencySketch::reset()
+{
+    for (uint64_t & word : _table) {
+        word = (word >> 1) & RESET_MASK;
+    }
+    _size /= 2;
+    _resets++;
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Approximate access frequency of keys, represented by their hash, using a
+ * count-min sketch of 4-bit counters. Each key maps to 4 counters within one
+ * 64-bit word, and the estimate is the smallest of them. All counters are
+ * halved after a sample period proportional to the table size, so that old
+ * popularity fades. Used by the cache to decide if a new entry is worth
+ * evicting an older one for (TinyLFU admission).
+ */
+class FrequencySketch
+{
+public:
+    FrequencySketch();
+    ~FrequencySketch();
+
+    /**
+     * Make sure the table is large enough to track the given number of
+     * elements. Growing the table forgets all recorded frequencies.
+     */
+    void ensureCapacity(size_t maxElements);
+    void increment(uint64_t hash);
+    /**
+     * Estimated number of times the hash has been seen, saturating at 15.
+     */
+    uint32_t frequency(uint64_t hash) const;
+
+    size_t tableSize() const { return _table.size(); }
+    size_t getResets() const { return _resets; }
+private:
+    static uint64_t spread(uint64_t hash);
+    size_t indexOf(uint64_t hash, uint32_t depth) const;
+    bool incrementAt(size_t index, uint32_t counter);
+    void reset();
+
+    std::vector<uint64_t> _table;
+    size_t                _tableMask;
+    size_t                _sampleSize;
+    size_t                _size;
+    size_t                _resets;
+};
+
+}
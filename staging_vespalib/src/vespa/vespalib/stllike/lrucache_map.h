@@ -110,6 +110,11 @@ public:
      */
     const V & get(const K & key) const { return HashTable::find(key)->second._value; }
 
+    /**
+     * This fetches the least recently used object. Map must not be empty.
+     */
+    const value_type & oldest() const { return HashTable::getByInternalIndex(_tail); }
+
     /**
      * This simply erases the object.
      */
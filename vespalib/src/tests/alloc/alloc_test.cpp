@@ -3,7 +3,10 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <cstddef>
+#include <cstring>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -279,4 +282,25 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("mmap file allocator maps allocations to swap file") {
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t big_size = ((10000 + page_size - 1) / page_size) * page_size;
+    MmapFileAllocator allocator("alloc_test_swapfile");
+    {
+        Alloc buf = Alloc::alloc_with_allocator(&allocator);
+        Alloc buf2 = buf.create(100);
+        EXPECT_EQUAL(page_size, buf2.size());
+        EXPECT_EQUAL(page_size, allocator.get_end_offset());
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        memset(buf2.get(), 0x5a, buf2.size());
+        Alloc buf3 = buf2.create(10000);
+        EXPECT_EQUAL(big_size, buf3.size());
+        EXPECT_EQUAL(page_size + big_size, allocator.get_end_offset());
+        EXPECT_EQUAL(2u, allocator.get_num_allocations());
+        EXPECT_FALSE(buf3.resize_inplace(big_size + page_size));
+        EXPECT_EQUAL(0x5a, static_cast<const unsigned char *>(buf2.get())[page_size - 1]);
+    }
+    EXPECT_EQUAL(0u, allocator.get_num_allocations());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +69,40 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+TEST("require that zstd compression/decompression works with trained dictionary") {
+    std::vector<vespalib::string> docs;
+    for (size_t i(0); i < 1000; i++) {
+        docs.push_back(make_string("{\"id\":\"id:test:music::%zu\",\"fields\":{\"title\":\"title number %zu\","
+                                   "\"artist\":\"artist %zu\",\"year\":%zu}}", i, i*7, i % 13, 1950 + i % 70));
+    }
+    std::vector<ConstBufferRef> samples;
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.c_str(), doc.size());
+    }
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(samples, 4096, 9);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->getId());
+    EXPECT_EQUAL(9, dictionary->getCompressionLevel());
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 9, 90);
+    const vespalib::string & doc = docs[17];
+    ConstBufferRef ref(doc.c_str(), doc.size());
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ref, compressed, false, dictionary.get()));
+    EXPECT_LESS(compressed.getDataLen(), doc.size() / 2);
+
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()),
+               decompressed, false, dictionary.get());
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("require that dictionary training fails gracefully without enough samples") {
+    std::vector<ConstBufferRef> samples;
+    samples.emplace_back(_G_compressableText.c_str(), 10);
+    EXPECT_FALSE(ZStdDictionary::train(samples, 4096, 9));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
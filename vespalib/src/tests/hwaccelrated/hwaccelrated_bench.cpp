@@ -0,0 +1,109 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+using namespace vespalib;
+using vespalib::hwaccelrated::IAccelrated;
+
+constexpr size_t num_vectors = 1000;
+constexpr double budget = 1.0;
+
+template<typename T>
+std::vector<T> createAndFill(size_t sz) {
+    std::vector<T> v(sz);
+    for (size_t i(0); i < sz; i++) {
+        v[i] = rand()%100;
+    }
+    return v;
+}
+
+template <typename T>
+struct Vectors {
+    size_t dims;
+    std::vector<T> query;
+    std::vector<T> docs;
+    Vectors(size_t dims_in)
+        : dims(dims_in),
+          query(createAndFill<T>(dims_in)),
+          docs(createAndFill<T>(dims_in * num_vectors))
+    {}
+    const T *doc(size_t i) const { return &docs[i * dims]; }
+};
+
+template <typename T, typename F>
+double benchmark(const Vectors<T> &vectors, F &&distance) {
+    double sum = 0.0;
+    double min_time_s = BenchmarkTimer::benchmark([&]() {
+            for (size_t i(0); i < num_vectors; i++) {
+                sum += distance(&vectors.query[0], vectors.doc(i), vectors.dims);
+            }
+        }, budget);
+    EXPECT_TRUE(sum != -1.0);
+    return min_time_s * 1000000000.0 / num_vectors;
+}
+
+template <typename T>
+void benchmark_kernels(const char *name, const IAccelrated &accel, const Vectors<T> &vectors) {
+    double dot = benchmark(vectors, [&](const T *a, const T *b, size_t sz) { return accel.dotProduct(a, b, sz); });
+    double cosine = benchmark(vectors, [&](const T *a, const T *b, size_t sz) { return accel.cosineSimilarity(a, b, sz); });
+    double hamming = benchmark(vectors, [&](const T *a, const T *b, size_t sz) { return accel.hammingDistance(a, b, sz); });
+    fprintf(stderr, "  %-12s dot product: %8.1f ns, cosine similarity: %8.1f ns, hamming distance: %8.1f ns\n",
+            name, dot, cosine, hamming);
+}
+
+template <typename T>
+void benchmark_cell_type(const char *cell_type, size_t dims) {
+    srand(1);
+    Vectors<T> vectors(dims);
+    hwaccelrated::GenericAccelrator generic;
+    fprintf(stderr, "%s cells, %zu dimensions (per vector):\n", cell_type, dims);
+    benchmark_kernels("generic", generic, vectors);
+    benchmark_kernels("accelerated", IAccelrated::getAccelerator(), vectors);
+}
+
+TEST("benchmark distance kernels") {
+    for (size_t dims : {64, 128, 384, 768}) {
+        benchmark_cell_type<float>("float", dims);
+        benchmark_cell_type<double>("double", dims);
+        benchmark_cell_type<int8_t>("int8", dims);
+    }
+}
+
+template <typename T>
+void benchmark_in_range(const char *cell_type) {
+    srand(1);
+    std::vector<T> values = createAndFill<T>(1000000);
+    std::vector<uint64_t> expected((values.size() + 63) / 64);
+    std::vector<uint64_t> bits(expected.size());
+    auto run = [&](auto &&scan) {
+        return BenchmarkTimer::benchmark([&]() { scan(); }, budget) * 1000000000.0 / values.size();
+    };
+    double scalar = run([&]() {
+            std::fill(expected.begin(), expected.end(), 0);
+            for (size_t i(0); i < values.size(); i++) {
+                if ((values[i] >= T(10)) && (values[i] <= T(20))) {
+                    expected[i / 64] |= uint64_t(1) << (i % 64);
+                }
+            }
+        });
+    hwaccelrated::GenericAccelrator generic;
+    double genericTime = run([&]() { generic.inRange(&values[0], T(10), T(20), values.size(), &bits[0]); });
+    const IAccelrated &accel = IAccelrated::getAccelerator();
+    double accelerated = run([&]() { accel.inRange(&values[0], T(10), T(20), values.size(), &bits[0]); });
+    EXPECT_TRUE(expected == bits);
+    fprintf(stderr, "%-8s in range (per value): scalar: %6.3f ns, generic: %6.3f ns, accelerated: %6.3f ns\n",
+            cell_type, scalar, genericTime, accelerated);
+}
+
+TEST("benchmark in range kernels") {
+    benchmark_in_range<int8_t>("int8");
+    benchmark_in_range<int32_t>("int32");
+    benchmark_in_range<int64_t>("int64");
+    benchmark_in_range<float>("float");
+    benchmark_in_range<double>("double");
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
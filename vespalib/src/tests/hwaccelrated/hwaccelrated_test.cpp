@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <cmath>
 
 using namespace vespalib;
 
@@ -37,4 +38,145 @@ TEST("test euclidean distance") {
     verifyEuclideanDistance<double >(genericAccelrator);
 }
 
+template<typename T>
+void verifyCosineSimilarity(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(1100);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        double dot(0), aa(0), bb(0);
+        for (size_t i(j); i < testLength; i++) {
+            dot += double(a[i]) * b[i];
+            aa += double(a[i]) * a[i];
+            bb += double(b[i]) * b[i];
+        }
+        EXPECT_APPROX(dot / std::sqrt(aa * bb), accel.cosineSimilarity(&a[j], &b[j], testLength - j), 1e-6);
+    }
+    std::vector<T> zero(testLength, 0);
+    EXPECT_EQUAL(0.0, accel.cosineSimilarity(&a[0], &zero[0], testLength));
+}
+
+template<typename T>
+void verifyHammingDistance(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(1100);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = createAndFill<T>(testLength);
+    for (size_t i(0); i < testLength; i += 2) {
+        b[i] = a[i];
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += (a[i] != b[i]) ? 1 : 0;
+        }
+        EXPECT_EQUAL(sum, accel.hammingDistance(&a[j], &b[j], testLength - j));
+    }
+}
+
+void verifyInt8DotProduct(const hwaccelrated::IAccelrated & accel) {
+    // long enough for the int32 lanes of the simd kernels to be flushed several times
+    const size_t testLength(1100000);
+    std::vector<int8_t> a(testLength, -128);
+    std::vector<int8_t> b(testLength, -128);
+    for (size_t i(0); i < testLength; i += 7) {
+        b[i] = 127;
+    }
+    for (size_t j(0); j < 4; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += a[i] * b[i];
+        }
+        EXPECT_EQUAL(sum, accel.dotProduct(&a[j], &b[j], testLength - j));
+    }
+}
+
+void verifyDistanceKernels(const hwaccelrated::IAccelrated & accel) {
+    verifyCosineSimilarity<float>(accel);
+    verifyCosineSimilarity<double>(accel);
+    verifyCosineSimilarity<int8_t>(accel);
+    verifyHammingDistance<float>(accel);
+    verifyHammingDistance<double>(accel);
+    verifyHammingDistance<int8_t>(accel);
+    verifyInt8DotProduct(accel);
+}
+
+TEST("test distance kernels") {
+    hwaccelrated::GenericAccelrator genericAccelrator;
+    TEST_DO(verifyDistanceKernels(genericAccelrator));
+    TEST_DO(verifyDistanceKernels(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
+void verifyBatchedAndOr(const hwaccelrated::IAccelrated & accel) {
+    const size_t numWords(8*7);
+    srand(1);
+    std::vector<std::vector<uint64_t>> vectors(3, std::vector<uint64_t>(numWords));
+    for (auto & v : vectors) {
+        for (auto & w : v) {
+            w = (uint64_t(rand()) << 32) | rand();
+        }
+    }
+    std::vector<std::pair<const void *, bool>> src;
+    for (size_t i(0); i < vectors.size(); i++) {
+        src.emplace_back(&vectors[i][0], i == 1);
+    }
+    for (size_t offset(0); offset < 8; offset++) {
+        for (size_t numBlocks(1); numBlocks <= 6; numBlocks++) {
+            std::vector<uint64_t> andResult(numBlocks * 8), orResult(numBlocks * 8);
+            accel.and64Batch(offset * sizeof(uint64_t), numBlocks, src, &andResult[0]);
+            accel.or64Batch(offset * sizeof(uint64_t), numBlocks, src, &orResult[0]);
+            for (size_t w(0); w < numBlocks * 8; w++) {
+                uint64_t a = vectors[0][offset + w];
+                uint64_t b = ~vectors[1][offset + w];
+                uint64_t c = vectors[2][offset + w];
+                EXPECT_EQUAL(a & b & c, andResult[w]);
+                EXPECT_EQUAL(a | b | c, orResult[w]);
+            }
+        }
+    }
+}
+
+TEST("test batched and/or") {
+    hwaccelrated::GenericAccelrator genericAccelrator;
+    TEST_DO(verifyBatchedAndOr(genericAccelrator));
+    TEST_DO(verifyBatchedAndOr(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
+template<typename T>
+void verifyInRange(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(1100);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x48; j++) {
+        const size_t sz = testLength - j;
+        // Garbage in the destination must be overwritten, including the bits beyond sz
+        std::vector<uint64_t> dest((sz + 63) / 64, ~uint64_t(0));
+        accel.inRange(&a[j], T(10), T(100), sz, &dest[0]);
+        for (size_t i(0); i < dest.size() * 64; i++) {
+            bool expected = (i < sz) && (a[j + i] >= T(10)) && (a[j + i] <= T(100));
+            EXPECT_EQUAL(expected, ((dest[i / 64] >> (i % 64)) & 1) != 0);
+        }
+    }
+}
+
+void verifyInRangeKernels(const hwaccelrated::IAccelrated & accel) {
+    verifyInRange<int8_t>(accel);
+    verifyInRange<int16_t>(accel);
+    verifyInRange<int32_t>(accel);
+    verifyInRange<int64_t>(accel);
+    verifyInRange<float>(accel);
+    verifyInRange<double>(accel);
+    std::vector<float> nans(70, std::nanf(""));
+    std::vector<uint64_t> dest(2);
+    accel.inRange(&nans[0], -1.0f, 1.0f, nans.size(), &dest[0]);
+    EXPECT_EQUAL(0u, dest[0] | dest[1]);
+}
+
+TEST("test in range kernels") {
+    hwaccelrated::GenericAccelrator genericAccelrator;
+    TEST_DO(verifyInRangeKernels(genericAccelrator));
+    TEST_DO(verifyInRangeKernels(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include "datastore.h"
 #include "entryref.h"
 #include "i_compaction_context.h"
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/array.h>
 
 namespace vespalib::datastore {
@@ -44,6 +45,8 @@ private:
     };
 
 
+    // Must outlive the buffers in _store, thus declared first
+    std::unique_ptr<alloc::MemoryAllocator> _memory_allocator;
     uint32_t _largeArrayTypeId;
     uint32_t _maxSmallArraySize;
     DataStoreType _store;
@@ -68,6 +71,11 @@ private:
 
 public:
     ArrayStore(const ArrayStoreConfig &cfg);
+    /**
+     * Small arrays are stored in buffers allocated by the given memory allocator (if set).
+     * Large arrays are always heap allocated.
+     */
+    ArrayStore(const ArrayStoreConfig &cfg, std::unique_ptr<alloc::MemoryAllocator> memory_allocator);
     ~ArrayStore();
     EntryRef add(const ConstArrayRef &array);
     ConstArrayRef get(EntryRef ref) const {
@@ -97,6 +105,7 @@ public:
     void remove(EntryRef ref);
     ICompactionContext::UP compactWorst(bool compactMemory, bool compactAddressSpace);
     vespalib::MemoryUsage getMemoryUsage() const { return _store.getMemoryUsage(); }
+    const alloc::MemoryAllocator* get_memory_allocator() const { return _memory_allocator.get(); }
 
     /**
      * Returns the address space usage by this store as the ratio between active buffers
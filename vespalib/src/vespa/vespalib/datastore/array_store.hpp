@@ -37,7 +37,8 @@ ArrayStore<EntryT, RefT>::initArrayTypes(const ArrayStoreConfig &cfg)
         const AllocSpec &spec = cfg.specForSize(arraySize);
         _smallArrayTypes.push_back(std::make_unique<SmallArrayType>
                                            (arraySize, spec.minArraysInBuffer, spec.maxArraysInBuffer,
-                                            spec.numArraysForNewBuffer, spec.allocGrowFactor));
+                                            spec.numArraysForNewBuffer, spec.allocGrowFactor,
+                                            _memory_allocator.get()));
         uint32_t typeId = _store.addType(_smallArrayTypes.back().get());
         assert(typeId == arraySize); // Enforce 1-to-1 mapping between type ids and sizes for small arrays
     }
@@ -45,7 +46,14 @@ ArrayStore<EntryT, RefT>::initArrayTypes(const ArrayStoreConfig &cfg)
 
 template <typename EntryT, typename RefT>
 ArrayStore<EntryT, RefT>::ArrayStore(const ArrayStoreConfig &cfg)
-    : _largeArrayTypeId(0),
+    : ArrayStore(cfg, std::unique_ptr<alloc::MemoryAllocator>())
+{
+}
+
+template <typename EntryT, typename RefT>
+ArrayStore<EntryT, RefT>::ArrayStore(const ArrayStoreConfig &cfg, std::unique_ptr<alloc::MemoryAllocator> memory_allocator)
+    : _memory_allocator(std::move(memory_allocator)),
+      _largeArrayTypeId(0),
       _maxSmallArraySize(cfg.maxSmallArraySize()),
       _store(),
       _smallArrayTypes(),
@@ -6,12 +6,6 @@
 
 namespace vespalib::datastore {
 
-namespace {
-
-constexpr float DEFAULT_ALLOC_GROW_FACTOR = 0.2;
-
-}
-
 void
 BufferTypeBase::CleanContext::extraBytesCleaned(size_t value)
 {
@@ -25,7 +19,8 @@ BufferTypeBase::BufferTypeBase(uint32_t arraySize,
                                uint32_t minArrays,
                                uint32_t maxArrays,
                                uint32_t numArraysForNewBuffer,
-                               float allocGrowFactor)
+                               float allocGrowFactor,
+                               const alloc::MemoryAllocator *memory_allocator)
     : _arraySize(arraySize),
       _minArrays(std::min(minArrays, maxArrays)),
       _maxArrays(maxArrays),
@@ -35,7 +30,8 @@ BufferTypeBase::BufferTypeBase(uint32_t arraySize,
       _holdBuffers(0),
       _activeUsedElems(0),
       _holdUsedElems(0),
-      _lastUsedElems(nullptr)
+      _lastUsedElems(nullptr),
+      _memory_allocator(memory_allocator)
 {
 }
 
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <cstddef>
 
+namespace vespalib::alloc { class MemoryAllocator; }
+
 namespace vespalib::datastore {
 
 /**
@@ -28,6 +30,7 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    const alloc::MemoryAllocator *_memory_allocator; // allocator used for buffers, default allocator if nullptr
 
 public:
     class CleanContext {
@@ -38,12 +41,15 @@ public:
         CleanContext(size_t &extraUsedBytes, size_t &extraHoldBytes) : _extraUsedBytes(extraUsedBytes), _extraHoldBytes(extraHoldBytes) {}
         void extraBytesCleaned(size_t value);
     };
-    
+
+    static constexpr float DEFAULT_ALLOC_GROW_FACTOR = 0.2;
+
     BufferTypeBase(const BufferTypeBase &rhs) = delete;
     BufferTypeBase & operator=(const BufferTypeBase &rhs) = delete;
     BufferTypeBase(uint32_t arraySize, uint32_t minArrays, uint32_t maxArrays);
     BufferTypeBase(uint32_t arraySize, uint32_t minArrays, uint32_t maxArrays,
-                   uint32_t numArraysForNewBuffer, float allocGrowFactor);
+                   uint32_t numArraysForNewBuffer, float allocGrowFactor,
+                   const alloc::MemoryAllocator *memory_allocator = nullptr);
     virtual ~BufferTypeBase();
     virtual void destroyElements(void *buffer, size_t numElems) = 0;
     virtual void fallbackCopy(void *newBuffer, const void *oldBuffer, size_t numElems) = 0;
@@ -71,6 +77,7 @@ public:
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     size_t getMaxArrays() const { return _maxArrays; }
     uint32_t getNumArraysForNewBuffer() const { return _numArraysForNewBuffer; }
+    const alloc::MemoryAllocator *get_memory_allocator() const { return _memory_allocator; }
 };
 
 /**
@@ -87,7 +94,8 @@ public:
     BufferType & operator=(const BufferType &rhs) = delete;
     BufferType(uint32_t arraySize, uint32_t minArrays, uint32_t maxArrays);
     BufferType(uint32_t arraySize, uint32_t minArrays, uint32_t maxArrays,
-               uint32_t numArraysForNewBuffer, float allocGrowFactor);
+               uint32_t numArraysForNewBuffer, float allocGrowFactor,
+               const alloc::MemoryAllocator *memory_allocator = nullptr);
     ~BufferType();
     void destroyElements(void *buffer, size_t numElems) override;
     void fallbackCopy(void *newBuffer, const void *oldBuffer, size_t numElems) override;
@@ -104,8 +112,9 @@ BufferType<EntryType>::BufferType(uint32_t arraySize, uint32_t minArrays, uint32
 
 template <typename EntryType>
 BufferType<EntryType>::BufferType(uint32_t arraySize, uint32_t minArrays, uint32_t maxArrays,
-                                  uint32_t numArraysForNewBuffer, float allocGrowFactor)
-    : BufferTypeBase(arraySize, minArrays, maxArrays, numArraysForNewBuffer, allocGrowFactor),
+                                  uint32_t numArraysForNewBuffer, float allocGrowFactor,
+                                  const alloc::MemoryAllocator *memory_allocator)
+    : BufferTypeBase(arraySize, minArrays, maxArrays, numArraysForNewBuffer, allocGrowFactor, memory_allocator),
       _emptyEntry()
 { }
 
@@ -5,6 +5,24 @@
 
 namespace vespalib::hwaccelrated {
 
+float
+Avx2Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
+{
+    return avx::dotProductSelectAlignment<float, 32>(af, bf, sz);
+}
+
+double
+Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) const
+{
+    return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
+}
+
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * af, const int8_t * bf, size_t sz) const
+{
+    return avx::dotProductInt8(af, bf, sz);
+}
+
 size_t
 Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -20,6 +38,36 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::cosineSimilarity(const float * a, const float * b, size_t sz) const {
+    return avx::cosineSimilaritySelectAlignment<float, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::cosineSimilarity(const double * a, const double * b, size_t sz) const {
+    return avx::cosineSimilaritySelectAlignment<double, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::cosineSimilarity(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::cosineSimilarityInt8(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::hammingDistance(const float * a, const float * b, size_t sz) const {
+    return avx::hammingDistanceT<float, 32>(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::hammingDistance(const double * a, const double * b, size_t sz) const {
+    return avx::hammingDistanceT<double, 32>(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::hammingDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::hammingDistanceT<int8_t, 32>(a, b, sz);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
@@ -30,4 +78,44 @@ Avx2Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bo
     helper::orChunks<32u, 2u>(offset, src, dest);
 }
 
+void
+Avx2Accelrator::and64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlocks<32u, 2u>(offset, numBlocks, src, dest);
+}
+
+void
+Avx2Accelrator::or64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlocks<32u, 2u>(offset, numBlocks, src, dest);
+}
+
+void
+Avx2Accelrator::inRange(const int8_t * a, int8_t low, int8_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx2Accelrator::inRange(const int16_t * a, int16_t low, int16_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx2Accelrator::inRange(const int32_t * a, int32_t low, int32_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx2Accelrator::inRange(const int64_t * a, int64_t low, int64_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx2Accelrator::inRange(const float * a, float low, float high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx2Accelrator::inRange(const double * a, double low, double high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
 }
@@ -7,16 +7,33 @@
 namespace vespalib::hwaccelrated {
 
 /**
- * Avx-512 implementation.
+ * Avx2 implementation.
  */
 class Avx2Accelrator : public GenericAccelrator
 {
 public:
+    float dotProduct(const float * a, const float * b, size_t sz) const override;
+    double dotProduct(const double * a, const double * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double cosineSimilarity(const float * a, const float * b, size_t sz) const override;
+    double cosineSimilarity(const double * a, const double * b, size_t sz) const override;
+    double cosineSimilarity(const int8_t * a, const int8_t * b, size_t sz) const override;
+    size_t hammingDistance(const float * a, const float * b, size_t sz) const override;
+    size_t hammingDistance(const double * a, const double * b, size_t sz) const override;
+    size_t hammingDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void and64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void or64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void inRange(const int8_t * a, int8_t low, int8_t high, size_t sz, uint64_t * dest) const override;
+    void inRange(const int16_t * a, int16_t low, int16_t high, size_t sz, uint64_t * dest) const override;
+    void inRange(const int32_t * a, int32_t low, int32_t high, size_t sz, uint64_t * dest) const override;
+    void inRange(const int64_t * a, int64_t low, int64_t high, size_t sz, uint64_t * dest) const override;
+    void inRange(const float * a, float low, float high, size_t sz, uint64_t * dest) const override;
+    void inRange(const double * a, double low, double high, size_t sz, uint64_t * dest) const override;
 };
 
 }
@@ -17,6 +17,12 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * af, const int8_t * bf, size_t sz) const
+{
+    return avx::dotProductInt8(af, bf, sz);
+}
+
 size_t
 Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -32,6 +38,36 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+double
+Avx512Accelrator::cosineSimilarity(const float * a, const float * b, size_t sz) const {
+    return avx::cosineSimilaritySelectAlignment<float, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::cosineSimilarity(const double * a, const double * b, size_t sz) const {
+    return avx::cosineSimilaritySelectAlignment<double, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::cosineSimilarity(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::cosineSimilarityInt8(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::hammingDistance(const float * a, const float * b, size_t sz) const {
+    return avx::hammingDistanceT<float, 64>(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::hammingDistance(const double * a, const double * b, size_t sz) const {
+    return avx::hammingDistanceT<double, 64>(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::hammingDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::hammingDistanceT<int8_t, 64>(a, b, sz);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
@@ -42,4 +78,44 @@ Avx512Accelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<64, 1>(offset, src, dest);
 }
 
+void
+Avx512Accelrator::and64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlocks<64, 1>(offset, numBlocks, src, dest);
+}
+
+void
+Avx512Accelrator::or64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlocks<64, 1>(offset, numBlocks, src, dest);
+}
+
+void
+Avx512Accelrator::inRange(const int8_t * a, int8_t low, int8_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx512Accelrator::inRange(const int16_t * a, int16_t low, int16_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx512Accelrator::inRange(const int32_t * a, int32_t low, int32_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx512Accelrator::inRange(const int64_t * a, int64_t low, int64_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx512Accelrator::inRange(const float * a, float low, float high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+Avx512Accelrator::inRange(const double * a, double low, double high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
 }
@@ -4,6 +4,8 @@
 
 #include "private_helpers.hpp"
 #include <vespa/fastos/dynamiclibrary.h>
+#include <algorithm>
+#include <utility>
 
 namespace vespalib::hwaccelrated::avx {
 
@@ -134,4 +136,139 @@ double euclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+template <typename T, unsigned VLEN, unsigned AlignA, unsigned AlignB>
+double
+cosineSimilarityT(const T * af, const T * bf, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 2;
+    constexpr unsigned ChunkSize = VLEN*VectorsPerChunk/sizeof(T);
+    typedef T V __attribute__ ((vector_size (VLEN)));
+    typedef T A __attribute__ ((vector_size (VLEN), aligned(AlignA)));
+    typedef T B __attribute__ ((vector_size (VLEN), aligned(AlignB)));
+    V dot[VectorsPerChunk];
+    V aa[VectorsPerChunk];
+    V bb[VectorsPerChunk];
+    memset(dot, 0, sizeof(dot));
+    memset(aa, 0, sizeof(aa));
+    memset(bb, 0, sizeof(bb));
+    const A * a = reinterpret_cast<const A *>(af);
+    const B * b = reinterpret_cast<const B *>(bf);
+
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            V av = a[VectorsPerChunk*i+j];
+            V bv = b[VectorsPerChunk*i+j];
+            dot[j] += av * bv;
+            aa[j] += av * av;
+            bb[j] += bv * bv;
+        }
+    }
+    double dotSum(0), aaSum(0), bbSum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        dotSum += af[i] * bf[i];
+        aaSum += af[i] * af[i];
+        bbSum += bf[i] * bf[i];
+    }
+    dotSum += sumT<T, V>(sumR<V, VectorsPerChunk>(dot));
+    aaSum += sumT<T, V>(sumR<V, VectorsPerChunk>(aa));
+    bbSum += sumT<T, V>(sumR<V, VectorsPerChunk>(bb));
+    return helper::cosineSimilarity(dotSum, aaSum, bbSum);
+}
+
+template <typename T, unsigned VLEN>
+double cosineSimilaritySelectAlignment(const T * af, const T * bf, size_t sz)
+{
+    constexpr unsigned ALIGN = 32;
+    if (validAlignment(af, ALIGN)) {
+        if (validAlignment(bf, ALIGN)) {
+            return cosineSimilarityT<T, VLEN, ALIGN, ALIGN>(af, bf, sz);
+        } else {
+            return cosineSimilarityT<T, VLEN, ALIGN, 1>(af, bf, sz);
+        }
+    } else {
+        if (validAlignment(bf, ALIGN)) {
+            return cosineSimilarityT<T, VLEN, 1, ALIGN>(af, bf, sz);
+        } else {
+            return cosineSimilarityT<T, VLEN, 1, 1>(af, bf, sz);
+        }
+    }
+}
+
+/**
+ * The int8 kernels accumulate products in plain int32 loops, which the compiler vectorizes
+ * for the target cpu. A product is at most 2^14, so the int32 sums are flushed every 2^16 cells.
+ */
+inline constexpr size_t Int8CellsPerFlush = 1u << 16;
+
+inline int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    int64_t sum(0);
+    for (size_t i(0); i < sz;) {
+        int32_t partial(0);
+        for (size_t end(std::min(sz, i + Int8CellsPerFlush)); i < end; i++) {
+            partial += a[i] * b[i];
+        }
+        sum += partial;
+    }
+    return sum;
+}
+
+inline double
+cosineSimilarityInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    int64_t dotSum(0), aaSum(0), bbSum(0);
+    for (size_t i(0); i < sz;) {
+        int32_t dot(0), aa(0), bb(0);
+        for (size_t end(std::min(sz, i + Int8CellsPerFlush)); i < end; i++) {
+            dot += a[i] * b[i];
+            aa += a[i] * a[i];
+            bb += b[i] * b[i];
+        }
+        dotSum += dot;
+        aaSum += aa;
+        bbSum += bb;
+    }
+    return helper::cosineSimilarity(dotSum, aaSum, bbSum);
+}
+
+/**
+ * Counts differing cells by accumulating the comparison masks, which are -1 where cells differ. The mask lanes
+ * have the same width as the cells, so they are flushed before an int8 lane can overflow.
+ */
+template <typename T, unsigned VLEN>
+size_t
+hammingDistanceT(const T * af, const T * bf, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr unsigned ChunkSize = VLEN*VectorsPerChunk/sizeof(T);
+    constexpr size_t ChunksPerFlush = 127;
+    typedef T A __attribute__ ((vector_size (VLEN), aligned(1)));
+    using M = decltype(std::declval<A>() != std::declval<A>());
+    const A * a = reinterpret_cast<const A *>(af);
+    const A * b = reinterpret_cast<const A *>(bf);
+
+    size_t sum(0);
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks;) {
+        M partial[VectorsPerChunk];
+        memset(partial, 0, sizeof(partial));
+        for (size_t end(std::min(numChunks, i + ChunksPerFlush)); i < end; i++) {
+            for (size_t j(0); j < VectorsPerChunk; j++) {
+                partial[j] += (a[VectorsPerChunk*i+j] != b[VectorsPerChunk*i+j]);
+            }
+        }
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            for (size_t k(0); k < VLEN/sizeof(T); k++) {
+                sum -= partial[j][k];
+            }
+        }
+    }
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += (af[i] != bf[i]) ? 1 : 0;
+    }
+    return sum;
+}
+
 }
@@ -56,6 +56,30 @@ euclideanDistanceT(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+template <typename T, size_t UNROLL>
+size_t
+hammingDistanceT(const T * a, const T * b, size_t sz)
+{
+    size_t partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += (a[i+j] != b[i+j]) ? 1 : 0;
+        }
+    }
+    for (;i < sz; i++) {
+        partial[i%UNROLL] += (a[i] != b[i]) ? 1 : 0;
+    }
+    size_t sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -165,6 +189,36 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return euclideanDistanceT<double, 4>(a, b, sz);
 }
 
+double
+GenericAccelrator::cosineSimilarity(const float * a, const float * b, size_t sz) const {
+    return helper::cosineSimilarity(dotProduct(a, b, sz), dotProduct(a, a, sz), dotProduct(b, b, sz));
+}
+
+double
+GenericAccelrator::cosineSimilarity(const double * a, const double * b, size_t sz) const {
+    return helper::cosineSimilarity(dotProduct(a, b, sz), dotProduct(a, a, sz), dotProduct(b, b, sz));
+}
+
+double
+GenericAccelrator::cosineSimilarity(const int8_t * a, const int8_t * b, size_t sz) const {
+    return helper::cosineSimilarity(dotProduct(a, b, sz), dotProduct(a, a, sz), dotProduct(b, b, sz));
+}
+
+size_t
+GenericAccelrator::hammingDistance(const float * a, const float * b, size_t sz) const {
+    return hammingDistanceT<float, 8>(a, b, sz);
+}
+
+size_t
+GenericAccelrator::hammingDistance(const double * a, const double * b, size_t sz) const {
+    return hammingDistanceT<double, 4>(a, b, sz);
+}
+
+size_t
+GenericAccelrator::hammingDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return hammingDistanceT<int8_t, 8>(a, b, sz);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
@@ -175,4 +229,44 @@ GenericAccelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<16,4>(offset, src, dest);
 }
 
+void
+GenericAccelrator::and64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlocks<16, 4>(offset, numBlocks, src, dest);
+}
+
+void
+GenericAccelrator::or64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlocks<16, 4>(offset, numBlocks, src, dest);
+}
+
+void
+GenericAccelrator::inRange(const int8_t * a, int8_t low, int8_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+GenericAccelrator::inRange(const int16_t * a, int16_t low, int16_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+GenericAccelrator::inRange(const int32_t * a, int32_t low, int32_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+GenericAccelrator::inRange(const int64_t * a, int64_t low, int64_t high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+GenericAccelrator::inRange(const float * a, float low, float high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
+void
+GenericAccelrator::inRange(const double * a, double low, double high, size_t sz, uint64_t * dest) const {
+    helper::inRange(a, low, high, sz, dest);
+}
+
 }
@@ -5,6 +5,7 @@
 #include "avx2.h"
 #include "avx512.h"
 #include <vespa/vespalib/util/memory.h>
+#include <cmath>
 #include <cstdio>
 #include <vector>
 
@@ -45,7 +46,7 @@ std::vector<T> createAndFill(size_t sz) {
     return v;
 }
 
-template<typename T>
+template<typename T, typename SUM = T>
 void
 verifyDotproduct(const IAccelrated & accel)
 {
@@ -54,11 +55,11 @@ verifyDotproduct(const IAccelrated & accel)
     std::vector<T> a = createAndFill<T>(testLength);
     std::vector<T> b = createAndFill<T>(testLength);
     for (size_t j(0); j < 0x20; j++) {
-        T sum(0);
+        SUM sum(0);
         for (size_t i(j); i < testLength; i++) {
             sum += a[i]*b[i];
         }
-        T hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        SUM hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
         if (sum != hwComputedSum) {
             fprintf(stderr, "Accelrator is not computing dotproduct correctly.\n");
             LOG_ABORT("should not be reached");
@@ -86,6 +87,72 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     }
 }
 
+template<typename T>
+void
+verifyCosineSimilarity(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        double dot(0), aa(0), bb(0);
+        for (size_t i(j); i < testLength; i++) {
+            dot += double(a[i]) * b[i];
+            aa += double(a[i]) * a[i];
+            bb += double(b[i]) * b[i];
+        }
+        double expected = dot / std::sqrt(aa * bb);
+        double hwComputed = accel.cosineSimilarity(&a[j], &b[j], testLength - j);
+        if (std::abs(expected - hwComputed) > 1e-6) {
+            fprintf(stderr, "Accelrator is not computing cosine similarity correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
+template<typename T>
+void
+verifyHammingDistance(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = a;
+    for (size_t i(0); i < testLength; i += 3) {
+        b[i] = a[i] + 1;
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += (a[i] != b[i]) ? 1 : 0;
+        }
+        size_t hwComputedSum(accel.hammingDistance(&a[j], &b[j], testLength - j));
+        if (sum != hwComputedSum) {
+            fprintf(stderr, "Accelrator is not computing hamming distance correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
+template<typename T>
+void
+verifyInRange(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        const size_t sz = testLength - j;
+        std::vector<uint64_t> dest((sz + 63) / 64);
+        accel.inRange(&a[j], T(20), T(50), sz, &dest[0]);
+        for (size_t i(0); i < dest.size() * 64; i++) {
+            bool expected = (i < sz) && (a[j + i] >= T(20)) && (a[j + i] <= T(50));
+            if (expected != (((dest[i / 64] >> (i % 64)) & 1) != 0)) {
+                fprintf(stderr, "Accelrator is not computing in range bits correctly.\n");
+                LOG_ABORT("should not be reached");
+            }
+        }
+    }
+}
+
 void
 verifyPopulationCount(const IAccelrated & accel)
 {
@@ -216,6 +283,57 @@ verifyAnd64(const IAccelrated & accel) {
     }
 }
 
+void
+verifyBatch64(const IAccelrated & accel, const std::vector<std::vector<uint64_t>> & vectors,
+              size_t offset, size_t num_blocks, size_t num_vectors, bool invertSome, bool isAnd)
+{
+    std::vector<std::pair<const void *, bool>> vRefs;
+    for (size_t j(0); j < num_vectors; j++) {
+        vRefs.emplace_back(&vectors[j][0], shouldInvert(invertSome));
+    }
+    std::vector<uint64_t> expected = optionallyInvert(vRefs[0].second, vectors[0]);
+    for (size_t j = 1; j < num_vectors; j++) {
+        if (isAnd) {
+            simpleAndWith(expected, optionallyInvert(vRefs[j].second, vectors[j]));
+        } else {
+            simpleOrWith(expected, optionallyInvert(vRefs[j].second, vectors[j]));
+        }
+    }
+
+    std::vector<uint64_t> dest(num_blocks * 8);
+    if (isAnd) {
+        accel.and64Batch(offset*sizeof(uint64_t), num_blocks, vRefs, &dest[0]);
+    } else {
+        accel.or64Batch(offset*sizeof(uint64_t), num_blocks, vRefs, &dest[0]);
+    }
+    int diff = memcmp(&expected[offset], &dest[0], dest.size() * sizeof(uint64_t));
+    if (diff != 0) {
+        if (isAnd) {
+            LOG_ABORT("Accelerator fails to compute correct batched AND");
+        } else {
+            LOG_ABORT("Accelerator fails to compute correct batched OR");
+        }
+    }
+}
+
+void
+verifyBatch64(const IAccelrated & accel) {
+    std::vector<std::vector<uint64_t>> vectors(3);
+    for (auto & v : vectors) {
+        fill(v, 48);
+    }
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t num_blocks = 1; num_blocks <= 5; num_blocks++) {
+            for (size_t i = 1; i < vectors.size(); i++) {
+                for (bool isAnd : {false, true}) {
+                    verifyBatch64(accel, vectors, offset, num_blocks, i, false, isAnd);
+                    verifyBatch64(accel, vectors, offset, num_blocks, i, true, isAnd);
+                }
+            }
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -224,13 +342,27 @@ private:
     void verify(const IAccelrated & accelrated) {
         verifyDotproduct<float>(accelrated);
         verifyDotproduct<double>(accelrated);
+        verifyDotproduct<int8_t, int64_t>(accelrated);
         verifyDotproduct<int32_t>(accelrated);
         verifyDotproduct<int64_t>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyCosineSimilarity<float>(accelrated);
+        verifyCosineSimilarity<double>(accelrated);
+        verifyCosineSimilarity<int8_t>(accelrated);
+        verifyHammingDistance<float>(accelrated);
+        verifyHammingDistance<double>(accelrated);
+        verifyHammingDistance<int8_t>(accelrated);
+        verifyInRange<int8_t>(accelrated);
+        verifyInRange<int16_t>(accelrated);
+        verifyInRange<int32_t>(accelrated);
+        verifyInRange<int64_t>(accelrated);
+        verifyInRange<float>(accelrated);
+        verifyInRange<double>(accelrated);
         verifyPopulationCount(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
+        verifyBatch64(accelrated);
     }
 };
 
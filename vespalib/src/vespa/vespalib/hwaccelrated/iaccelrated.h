@@ -30,10 +30,30 @@ public:
     virtual size_t populationCount(const uint64_t *a, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    // Cosine of the angle between a and b. The dot product is returned as is if a or b has zero norm.
+    virtual double cosineSimilarity(const float * a, const float * b, size_t sz) const = 0;
+    virtual double cosineSimilarity(const double * a, const double * b, size_t sz) const = 0;
+    virtual double cosineSimilarity(const int8_t * a, const int8_t * b, size_t sz) const = 0;
+    // Number of positions where a and b differ
+    virtual size_t hammingDistance(const float * a, const float * b, size_t sz) const = 0;
+    virtual size_t hammingDistance(const double * a, const double * b, size_t sz) const = 0;
+    virtual size_t hammingDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
     virtual void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    // AND numBlocks consecutive 64 byte blocks from multiple, optionally inverted sources
+    virtual void and64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    // OR numBlocks consecutive 64 byte blocks from multiple, optionally inverted sources
+    virtual void or64Batch(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+
+    // Set bit i in dest when low <= a[i] <= high, for (sz + 63) / 64 words. Bits beyond sz are cleared.
+    virtual void inRange(const int8_t * a, int8_t low, int8_t high, size_t sz, uint64_t * dest) const = 0;
+    virtual void inRange(const int16_t * a, int16_t low, int16_t high, size_t sz, uint64_t * dest) const = 0;
+    virtual void inRange(const int32_t * a, int32_t low, int32_t high, size_t sz, uint64_t * dest) const = 0;
+    virtual void inRange(const int64_t * a, int64_t low, int64_t high, size_t sz, uint64_t * dest) const = 0;
+    virtual void inRange(const float * a, float low, float high, size_t sz, uint64_t * dest) const = 0;
+    virtual void inRange(const double * a, double low, double high, size_t sz, uint64_t * dest) const = 0;
 
     static const IAccelrated & getAccelerator() __attribute__((noinline));
 };
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <vespa/vespalib/util/optimized.h>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace vespalib::hwaccelrated::helper {
@@ -24,6 +26,13 @@ populationCount(const uint64_t *a, size_t sz) {
     return count;
 }
 
+inline double
+cosineSimilarity(double dotProduct, double aNormSquared, double bNormSquared) {
+    double squaredNorms = aNormSquared * bNormSquared;
+    double div = (squaredNorms > 0) ? std::sqrt(squaredNorms) : 1.0;
+    return dotProduct / div;
+}
+
 template<typename T>
 T get(const void * base, bool invert) {
     T v;
@@ -36,43 +45,115 @@ const T * cast(const void * ptr, size_t offsetBytes) {
     return static_cast<const T *>(static_cast<const void *>(static_cast<const char *>(ptr) + offsetBytes));
 }
 
-template<unsigned ChunkSize, unsigned Chunks>
+struct AndOp {
+    template <typename T>
+    T operator()(T a, T b) const { return a & b; }
+};
+
+struct OrOp {
+    template <typename T>
+    T operator()(T a, T b) const { return a | b; }
+};
+
+template <typename T>
+uint64_t
+inRangeWord(const T * a, T low, T high, size_t n) {
+    // Collect the matches as bytes first, as that is what vectorizes well,
+    // then pack 8 bytes at a time into bits.
+    uint8_t matches[64];
+    if (__builtin_expect(n == 64, true)) {
+        for (size_t i(0); i < 64; i++) {
+            matches[i] = (a[i] >= low) & (a[i] <= high);
+        }
+    } else {
+        memset(matches, 0, sizeof(matches));
+        for (size_t i(0); i < n; i++) {
+            matches[i] = (a[i] >= low) & (a[i] <= high);
+        }
+    }
+    uint64_t word(0);
+    for (size_t i(0); i < 8; i++) {
+        uint64_t bytes;
+        memcpy(&bytes, matches + i*8, sizeof(bytes));
+        word |= ((bytes * 0x0102040810204080ul) >> 56) << (i*8);
+    }
+    return word;
+}
+
+template <typename T>
 void
-andChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
-    typedef uint64_t Chunk __attribute__ ((vector_size (ChunkSize)));
+inRange(const T * a, T low, T high, size_t sz, uint64_t * dest) {
+    for (size_t i(0); i < sz; i += 64) {
+        dest[i/64] = inRangeWord(a + i, low, high, std::min(size_t(64), sz - i));
+    }
+}
+
+template<unsigned ChunkSize>
+struct ChunkType {
+    typedef uint64_t type __attribute__ ((vector_size (ChunkSize)));
+};
+
+template<unsigned ChunkSize, unsigned Chunks, typename Op>
+void
+combineChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest, Op op) {
+    using Chunk = typename ChunkType<ChunkSize>::type;
     static_assert(sizeof(Chunk) == ChunkSize, "sizeof(Chunk) == ChunkSize");
-    static_assert(ChunkSize*Chunks == 64, "ChunkSize*Chunks == 64");
-    Chunk * chunk = static_cast<Chunk *>(dest);
+    static_assert((ChunkSize*Chunks) % 64 == 0, "(ChunkSize*Chunks) % 64 == 0");
+    // Accumulate in registers, dest might alias one of the sources
+    Chunk acc[Chunks];
     const Chunk * tmp = cast<Chunk>(src[0].first, offset);
     for (size_t n=0; n < Chunks; n++) {
-        chunk[n] = get<Chunk>(tmp+n, src[0].second);
+        acc[n] = get<Chunk>(tmp+n, src[0].second);
     }
     for (size_t i(1); i < src.size(); i++) {
         tmp = cast<Chunk>(src[i].first, offset);
         for (size_t n=0; n < Chunks; n++) {
-            chunk[n] &= get<Chunk>(tmp+n, src[i].second);
+            acc[n] = op(acc[n], get<Chunk>(tmp+n, src[i].second));
         }
     }
+    memcpy(dest, acc, sizeof(acc));
 }
 
-template<unsigned ChunkSize, unsigned Chunks>
+template<unsigned ChunkSize, unsigned Chunks, typename Op>
 void
-orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
-    typedef uint64_t Chunk __attribute__ ((vector_size (ChunkSize)));
-    static_assert(sizeof(Chunk) == ChunkSize, "sizeof(Chunk) == ChunkSize");
+combineBlocks(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> & src, void * dest, Op op) {
     static_assert(ChunkSize*Chunks == 64, "ChunkSize*Chunks == 64");
-    Chunk * chunk = static_cast<Chunk *>(dest);
-    const Chunk * tmp = cast<Chunk>(src[0].first, offset);
-    for (size_t n=0; n < Chunks; n++) {
-        chunk[n] = get<Chunk>(tmp+n, src[0].second);
+    char * d = static_cast<char *>(dest);
+    size_t i(0);
+    // Two cache lines per step gives more independent accumulators
+    for (; (i + 2) <= numBlocks; i += 2) {
+        combineChunks<ChunkSize, Chunks*2>(offset + i*64, src, d + i*64, op);
     }
-    for (size_t i(1); i < src.size(); i++) {
-        tmp = cast<Chunk>(src[i].first, offset);
-        for (size_t n=0; n < Chunks; n++) {
-            chunk[n] |= get<Chunk>(tmp+n, src[i].second);
-        }
+    if (i < numBlocks) {
+        combineChunks<ChunkSize, Chunks>(offset + i*64, src, d + i*64, op);
     }
 }
 
+template<unsigned ChunkSize, unsigned Chunks>
+void
+andChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    static_assert(ChunkSize*Chunks == 64, "ChunkSize*Chunks == 64");
+    combineChunks<ChunkSize, Chunks>(offset, src, dest, AndOp());
+}
+
+template<unsigned ChunkSize, unsigned Chunks>
+void
+orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    static_assert(ChunkSize*Chunks == 64, "ChunkSize*Chunks == 64");
+    combineChunks<ChunkSize, Chunks>(offset, src, dest, OrOp());
+}
+
+template<unsigned ChunkSize, unsigned Chunks>
+void
+andBlocks(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    combineBlocks<ChunkSize, Chunks>(offset, numBlocks, src, dest, AndOp());
+}
+
+template<unsigned ChunkSize, unsigned Chunks>
+void
+orBlocks(size_t offset, size_t numBlocks, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    combineBlocks<ChunkSize, Chunks>(offset, numBlocks, src, dest, OrOp());
+}
+
 }
 }
@@ -521,6 +521,12 @@ Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
     return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
 }
 
+Alloc
+Alloc::alloc_with_allocator(const MemoryAllocator* allocator)
+{
+    return Alloc(allocator);
+}
+
 }
 
 }
@@ -105,6 +105,11 @@ public:
      */
     static Alloc alloc(size_t sz, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
     static Alloc alloc();
+    /**
+     * Creates an empty allocation using the given allocator, which must outlive it and all
+     * allocations created from it.
+     */
+    static Alloc alloc_with_allocator(const MemoryAllocator* allocator);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     Alloc(const MemoryAllocator * allocator) : _alloc(nullptr, 0), _allocator(allocator) { }
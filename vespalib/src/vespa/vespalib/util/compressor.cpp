@@ -55,7 +55,7 @@ compress(ICompressor & compressor, const CompressionConfig & compression, const
 }
 
 CompressionConfig::Type
-docompress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest)
+docompress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, const ZStdDictionary * dictionary)
 {
     switch (compression.type) {
     case CompressionConfig::LZ4:
@@ -65,7 +65,7 @@ docompress(const CompressionConfig & compression, const ConstBufferRef & org, Da
         }
     case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             return compress(zstd, compression, org, dest);
         }
     case CompressionConfig::NONE_MULTI:
@@ -82,10 +82,17 @@ compress(CompressionConfig::Type compression, const ConstBufferRef & org, DataBu
 }
 CompressionConfig::Type
 compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    return compress(compression, org, dest, allowSwap, nullptr);
+}
+
+CompressionConfig::Type
+compress(const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap,
+         const ZStdDictionary * dictionary)
 {
     CompressionConfig::Type type(CompressionConfig::NONE);
     if (org.size() >= compression.minSize) {
-        type = docompress(compression, org, dest);
+        type = docompress(compression, org, dest, dictionary);
     }
     if ((type == CompressionConfig::NONE) || (type == CompressionConfig::NONE_MULTI)) {
         if (allowSwap) {
@@ -125,6 +132,13 @@ decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBuffer
 
 void
 decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap)
+{
+    decompress(type, uncompressedLen, org, dest, allowSwap, nullptr);
+}
+
+void
+decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap,
+           const ZStdDictionary * dictionary)
 {
     switch (type) {
     case CompressionConfig::LZ4:
@@ -135,7 +149,7 @@ decompress(const CompressionConfig::Type & type, size_t uncompressedLen, const C
         break;
         case CompressionConfig::ZSTD:
         {
-            ZStdCompressor zstd;
+            ZStdCompressor zstd(dictionary);
             decompress(zstd, uncompressedLen, org, dest, allowSwap);
         }
         break;
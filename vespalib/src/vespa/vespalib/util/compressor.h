@@ -9,6 +9,8 @@ namespace vespalib { class DataBuffer; }
 
 namespace vespalib::compression {
 
+class ZStdDictionary;
+
 class ICompressor
 {
 public:
@@ -29,6 +31,11 @@ public:
  */
 CompressionConfig::Type compress(CompressionConfig::Type compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
 CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
+/**
+ * As above, but zstd compression will use the given dictionary if it is not null.
+ */
+CompressionConfig::Type compress(const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                                 const ZStdDictionary * dictionary);
 
 /**
  * Will try to decompress a buffer according to the config.
@@ -42,6 +49,12 @@ CompressionConfig::Type compress(const CompressionConfig & compression, const ve
  * @param allowSwap will tell it the data must be appended or if it can be swapped in if compression type is NONE.
  */
 void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
+/**
+ * As above, but zstd decompression will use the given dictionary if it is not null.
+ * It must be the same dictionary as used for compression.
+ */
+void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap,
+                const ZStdDictionary * dictionary);
 
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
@@ -0,0 +1,130 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator.h"
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+#include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.mmap_file_allocator");
+
+namespace vespalib::alloc {
+
+namespace {
+
+const size_t page_size = getpagesize();
+
+size_t
+round_up_to_page_size(size_t sz)
+{
+    return (sz + (page_size - 1)) & ~(page_size - 1);
+}
+
+}
+
+MmapFileAllocator::MmapFileAllocator(const vespalib::string& file_name)
+    : _file_name(file_name),
+      _fd(::open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+      _lock(),
+      _end_offset(0),
+      _allocations()
+{
+    if (_fd < 0) {
+        int error = errno;
+        throw IoException(make_string("Failed to open swap file '%s', errno(%d)", _file_name.c_str(), error),
+                          IoException::getErrorType(error), VESPA_STRLOC);
+    }
+    if (::unlink(_file_name.c_str()) != 0) {
+        LOG(warning, "Failed to unlink swap file '%s', errno(%d)", _file_name.c_str(), errno);
+    }
+}
+
+MmapFileAllocator::~MmapFileAllocator()
+{
+    assert(_allocations.empty());
+    ::close(_fd);
+}
+
+MmapFileAllocator::PtrAndSize
+MmapFileAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    sz = round_up_to_page_size(sz);
+    std::lock_guard<std::mutex> guard(_lock);
+    uint64_t offset = _end_offset;
+    if (::ftruncate(_fd, offset + sz) != 0) {
+        int error = errno;
+        throw IoException(make_string("Failed to extend swap file '%s' to %" PRIu64 " bytes, errno(%d)",
+                                      _file_name.c_str(), offset + sz, error),
+                          IoException::getErrorType(error), VESPA_STRLOC);
+    }
+    void *buf = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, offset);
+    if (buf == MAP_FAILED) {
+        int error = errno;
+        throw OOMException(make_string("Failed mmaping %zu bytes at offset %" PRIu64 " of swap file '%s', errno(%d)",
+                                       sz, offset, _file_name.c_str(), error));
+    }
+    // Accesses to data kept in swap files are expected to be random, so read ahead only wastes memory.
+    if (::madvise(buf, sz, MADV_RANDOM) != 0) {
+        LOG(debug, "Failed madvise(%p, %zu, MADV_RANDOM), errno(%d)", buf, sz, errno);
+    }
+    _end_offset = offset + sz;
+    auto ins_res = _allocations.emplace(buf, SizeAndOffset(sz, offset));
+    assert(ins_res.second);
+    (void) ins_res;
+    return PtrAndSize(buf, sz);
+}
+
+void
+MmapFileAllocator::free(PtrAndSize alloc) const
+{
+    if (alloc.first == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _allocations.find(alloc.first);
+    assert(itr != _allocations.end());
+    size_t sz = itr->second.size;
+    uint64_t offset = itr->second.offset;
+    _allocations.erase(itr);
+    int retval = ::munmap(alloc.first, sz);
+    assert(retval == 0);
+    (void) retval;
+#ifdef __linux__
+    // Release the disk blocks backing the freed range.
+    if (::fallocate(_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, sz) != 0) {
+        LOG(debug, "Failed to punch hole at offset %" PRIu64 " with size %zu in swap file '%s', errno(%d)",
+            offset, sz, _file_name.c_str(), errno);
+    }
+#else
+    (void) offset;
+#endif
+}
+
+size_t
+MmapFileAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+size_t
+MmapFileAllocator::get_end_offset() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _end_offset;
+}
+
+size_t
+MmapFileAllocator::get_num_allocations() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _allocations.size();
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <mutex>
+#include <unordered_map>
+
+namespace vespalib::alloc {
+
+/**
+ * Class handling memory allocations backed by one file (i.e. a swap file
+ * for the allocations). Memory is mapped shared from the file, so the
+ * kernel can write cold pages back to disk and drop them from memory,
+ * paging them in again on demand.
+ *
+ * The file is unlinked when opened, and is only used as backing store
+ * while the allocator is alive. Freed ranges are punched out of the file.
+ */
+class MmapFileAllocator : public MemoryAllocator {
+    struct SizeAndOffset {
+        size_t size;
+        uint64_t offset;
+        SizeAndOffset() : size(0), offset(0) {}
+        SizeAndOffset(size_t size_in, uint64_t offset_in) : size(size_in), offset(offset_in) {}
+    };
+    using Allocations = std::unordered_map<const void *, SizeAndOffset>;
+    const vespalib::string _file_name;
+    int                    _fd;
+    mutable std::mutex     _lock;
+    mutable uint64_t       _end_offset;
+    mutable Allocations    _allocations;
+
+public:
+    MmapFileAllocator(const vespalib::string& file_name);
+    ~MmapFileAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+
+    // For unit testing
+    size_t get_end_offset() const;
+    size_t get_num_allocations() const;
+};
+
+}
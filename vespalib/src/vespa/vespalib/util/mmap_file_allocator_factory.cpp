@@ -0,0 +1,54 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator_factory.h"
+#include "mmap_file_allocator.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cinttypes>
+
+namespace vespalib::alloc {
+
+MmapFileAllocatorFactory::MmapFileAllocatorFactory()
+    : _lock(),
+      _dir_name(),
+      _dir_created(false),
+      _generation(0)
+{
+}
+
+MmapFileAllocatorFactory::~MmapFileAllocatorFactory() = default;
+
+void
+MmapFileAllocatorFactory::setup(const vespalib::string& dir_name)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _dir_name = dir_name;
+    _dir_created = false;
+}
+
+std::unique_ptr<MemoryAllocator>
+MmapFileAllocatorFactory::make_memory_allocator(const vespalib::string& name)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_dir_name.empty()) {
+        return {};
+    }
+    if (!_dir_created) {
+        // Only touch the directory when something is paged, removing swap files left behind by an earlier process.
+        vespalib::rmdir(_dir_name, true);
+        vespalib::mkdir(_dir_name, true);
+        _dir_created = true;
+    }
+    // Several allocators can be created for the same name, e.g. when an attribute is reloaded.
+    vespalib::string file_name = make_string("%s/%s.%" PRIu64, _dir_name.c_str(), name.c_str(), _generation++);
+    return std::make_unique<MmapFileAllocator>(file_name);
+}
+
+MmapFileAllocatorFactory&
+MmapFileAllocatorFactory::instance()
+{
+    static MmapFileAllocatorFactory instance;
+    return instance;
+}
+
+}
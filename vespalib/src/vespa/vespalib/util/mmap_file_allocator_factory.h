@@ -0,0 +1,48 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+
+namespace vespalib::alloc {
+
+/**
+ * Class for creating an mmap file allocator on demand, used for data
+ * structures that are allowed to be paged out to disk.
+ *
+ * Until setup() is called with a directory for the swap files, no
+ * allocators are created and the data structures stay in memory.
+ */
+class MmapFileAllocatorFactory {
+    std::mutex       _lock;
+    vespalib::string _dir_name;
+    bool             _dir_created;
+    std::atomic<uint64_t> _generation;
+
+    MmapFileAllocatorFactory();
+    MmapFileAllocatorFactory(const MmapFileAllocatorFactory &) = delete;
+    MmapFileAllocatorFactory& operator=(const MmapFileAllocatorFactory &) = delete;
+public:
+    ~MmapFileAllocatorFactory();
+
+    /**
+     * Sets the directory used for swap files. An empty name disables the
+     * factory. The directory is not created (and any swap files left
+     * behind by an earlier process are not removed) until the first
+     * allocator is made.
+     */
+    void setup(const vespalib::string &dir_name);
+
+    /**
+     * Returns a new allocator backed by a swap file with the given name
+     * prefix, or an empty pointer if the factory has not been set up.
+     */
+    std::unique_ptr<MemoryAllocator> make_memory_allocator(const vespalib::string& name);
+
+    static MmapFileAllocatorFactory& instance();
+};
+
+}
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <vector>
 #include <cassert>
 
@@ -35,6 +36,54 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(ConstBufferRef content, int compressionLevel)
+    : _content(content.c_str(), content.c_str() + content.size()),
+      _id(ZDICT_getDictID(content.c_str(), content.size())),
+      _compressionLevel(compressionLevel),
+      _cdictOnce(),
+      _cdict(nullptr),
+      _ddict(ZSTD_createDDict(_content.data(), _content.size()))
+{
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+const ZSTD_CDict_s *
+ZStdDictionary::getCompressDict() const
+{
+    std::call_once(_cdictOnce, [this]() {
+        _cdict = ZSTD_createCDict(_content.data(), _content.size(), _compressionLevel);
+    });
+    assert(_cdict != nullptr);
+    return _cdict;
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> flat;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        flat.insert(flat.end(), sample.c_str(), sample.c_str() + sample.size());
+        sizes.push_back(sample.size());
+    }
+    if (sizes.empty()) {
+        return SP();
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), flat.data(), sizes.data(), sizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dictionary.data(), sz), compressionLevel);
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -44,7 +93,10 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                           _dictionary->getCompressDict())
+                : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -56,7 +108,10 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                             _dictionary->getDecompressDict())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
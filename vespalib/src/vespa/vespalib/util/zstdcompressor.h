@@ -2,16 +2,61 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary trained on samples of small buffers with similar content.
+ * Compressing such buffers with the dictionary gives far better ratio than
+ * compressing them one by one. The very same dictionary must be used for
+ * decompression. The compression level is fixed when the dictionary is created,
+ * but the compression tables are only built on first use for compression.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    ZStdDictionary(ConstBufferRef content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    ConstBufferRef getContent() const { return ConstBufferRef(_content.data(), _content.size()); }
+    uint32_t getId() const { return _id; }
+    int getCompressionLevel() const { return _compressionLevel; }
+    const ZSTD_CDict_s * getCompressDict() const;
+    const ZSTD_DDict_s * getDecompressDict() const { return _ddict; }
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if the samples are not sufficient for training.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+private:
+    std::vector<char>      _content;
+    uint32_t               _id;
+    int                    _compressionLevel;
+    mutable std::once_flag _cdictOnce;
+    mutable ZSTD_CDict_s * _cdict;
+    ZSTD_DDict_s         * _ddict;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : _dictionary(nullptr) { }
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }
-